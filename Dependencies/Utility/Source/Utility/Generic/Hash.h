@@ -1,6 +1,7 @@
 #pragma once
 // Hash.h
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -36,6 +37,28 @@ namespace Internal
 
         return hash;
     }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Same as Fnv1aHashString(), but for a string that is not null terminated.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename UnsignedIntegralType>
+    constexpr UnsignedIntegralType Fnv1aHashString(const char* pStr, const size_t length, const UnsignedIntegralType initialHash, const UnsignedIntegralType primeMultiplier)
+    {
+        static_assert(std::is_integral_v<UnsignedIntegralType> && std::is_unsigned_v<UnsignedIntegralType>, "Initial hash and prime must be unsigned integral types!");
+
+        if (!pStr)
+            return initialHash;
+
+        auto hash = initialHash;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<UnsignedIntegralType>(pStr[i]);
+            hash *= primeMultiplier;
+        }
+
+        return hash;
+    }
 }
 
 //-----------------------------------------------------------------------------------------------------------------------------
@@ -64,4 +87,15 @@ constexpr uint64_t HashString64(const char* pStr)
     constexpr uint64_t kPrimeMultiplier = 0x100000001b3ull;
 
     return Internal::Fnv1aHashString(pStr, kInitialHash, kPrimeMultiplier);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Generate a uint64_t number based on a string of a given length. Matches HashString64() for the same characters.
+//-----------------------------------------------------------------------------------------------------------------------------
+constexpr uint64_t HashString64(const char* pStr, const size_t length)
+{
+    constexpr uint64_t kInitialHash = 0xcbf29ce484222325ull;
+    constexpr uint64_t kPrimeMultiplier = 0x100000001b3ull;
+
+    return Internal::Fnv1aHashString(pStr, length, kInitialHash, kPrimeMultiplier);
 }
\ No newline at end of file
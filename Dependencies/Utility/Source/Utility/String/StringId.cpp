@@ -1,106 +1,183 @@
 // StringId.cpp
 
 #include "StringId.h"
-#include "Generic/Hash.h"
 
-StringId::StringId(const char* str)
-    : m_pStrRef(GetStringPtr(str))
+#include <atomic>
+#include <cstring>
+#include <new>
+#include "Debug/Assert.h"
+
+namespace
 {
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The characters are stored right after the header, in the same allocation.
     //
+    ///		@brief : A string in the intern table.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct InternedString
+    {
+        uint64_t hash;
+        InternedString* pNext;  // Next string in the same bucket.
+        size_t length;
+
+        [[nodiscard]] const char* GetStr() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    struct ArenaBlock
+    {
+        ArenaBlock* pPrevious;
+        std::atomic<size_t> used;
+        size_t capacity;
+
+        [[nodiscard]] char* GetData() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    // The bucket count is fixed, so the table never needs to be rehashed. Chains just get longer.
+    // Blocks are never freed, so interned strings stay valid for as long as the program runs, even during static destruction.
+    constexpr size_t kBucketCount = 4096;
+    constexpr size_t kArenaBlockSize = 64 * 1024;
+
+    std::atomic<InternedString*> s_buckets[kBucketCount];
+    std::atomic<ArenaBlock*> s_pArena = nullptr;
+
+    ArenaBlock* CreateArenaBlock(const size_t capacity, ArenaBlock* pPrevious)
+    {
+        auto* pBlock = reinterpret_cast<ArenaBlock*>(new char[sizeof(ArenaBlock) + capacity]);
+        pBlock->pPrevious = pPrevious;
+        new (&pBlock->used) std::atomic<size_t>(0);
+        pBlock->capacity = capacity;
+        return pBlock;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Allocating is a single atomic add. When the block is full, every thread that ran out tries to swap in a new block,
+    //      and only one of them wins. The space left at the end of the old block is wasted.
+    //
+    ///		@brief : Allocate memory from the arena. Safe to call from any thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void* ArenaAllocate(size_t size)
+    {
+        // Keep every allocation aligned for the InternedString header.
+        size = (size + alignof(InternedString) - 1) & ~(alignof(InternedString) - 1);
+        const size_t blockCapacity = size > kArenaBlockSize ? size : kArenaBlockSize;
+
+        ArenaBlock* pBlock = s_pArena.load(std::memory_order_acquire);
+
+        while (true)
+        {
+            if (pBlock)
+            {
+                const size_t offset = pBlock->used.fetch_add(size, std::memory_order_relaxed);
+                if (offset + size <= pBlock->capacity)
+                    return pBlock->GetData() + offset;
+            }
+
+            ArenaBlock* pNewBlock = CreateArenaBlock(blockCapacity, pBlock);
+            if (s_pArena.compare_exchange_strong(pBlock, pNewBlock, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                pBlock = pNewBlock;
+                continue;
+            }
+
+            // Someone else added a block first. pBlock is now their block.
+            delete[] reinterpret_cast<char*>(pNewBlock);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Search a bucket's chain for the string, starting at pString and stopping at pEnd.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    const InternedString* FindString(const InternedString* pString, const InternedString* pEnd, [[maybe_unused]] const char* pStr, [[maybe_unused]] const size_t length, const uint64_t hash)
+    {
+        for (; pString != pEnd; pString = pString->pNext)
+        {
+            if (pString->hash != hash)
+                continue;
+
+            _CHECK_MSG(pString->length == length && std::memcmp(pString->GetStr(), pStr, length) == 0,
+                "StringId hash collision! '", pString->GetStr(), "' and '", std::string(pStr, length), "' have the same hash: ", hash);
+
+            return pString;
+        }
+
+        return nullptr;
+    }
 }
 
-StringId::StringId(const std::string& str)
-    : m_pStrRef(GetStringPtr(str))
+StringId::StringId(const char* str)
 {
-    //
+    // If we are being set to nullptr, then we are invalid.
+    if (!str)
+        return;
+
+    const size_t length = std::strlen(str);
+    m_hash = HashString64(str, length);
+    m_pStr = Intern(str, length, m_hash);
 }
 
-StringId::StringId(StringId&& right) noexcept
-    : m_pStrRef(right.m_pStrRef)
+StringId::StringId(const std::string& str)
+    : StringId(std::string_view(str))
 {
-    right.m_pStrRef = &s_invalidStringId;
+    //
 }
 
-StringId& StringId::operator=(StringId&& right) noexcept
+StringId::StringId(const std::string_view str)
 {
-    if (right != *this)
-    {
-        m_pStrRef = right.m_pStrRef;
-        right.m_pStrRef = &s_invalidStringId;
-    }
+    if (str.empty())
+        return;
 
-    return *this;
+    m_hash = HashString64(str.data(), str.size());
+    m_pStr = Intern(str.data(), str.size(), m_hash);
 }
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
-//		
-///		@brief : Get a copy of the internal string. If you just want a reference, use GetStringRef(). \n NOT THREAD SAFE.
+//
+///		@brief : Get a copy of the internal string. If you just want to read it, use GetStringView() or GetCStr().
 //-----------------------------------------------------------------------------------------------------------------------------
 std::string StringId::GetStringCopy() const
 {
-    return *m_pStrRef;
+    return std::string(**this);
 }
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
-//		
-///		@brief : Get a const reference to the internal string. If you want a copy, use GetStringCopy(). \n NOT THREAD SAFE.
+//      Lookups only read atomics, so they never wait on another thread. A new string is pushed onto the front of its bucket
+//      with a compare-exchange. If another thread pushed first, we only need to check the strings it added before trying
+//      again, since the rest of the chain was already searched.
+//
+///		@brief : Find the interned copy of a string, adding it if this is the first time we have seen it.
+///		@returns : Null terminated copy of the string, which is valid until the program exits.
 //-----------------------------------------------------------------------------------------------------------------------------
-const std::string& StringId::GetStringRef() const
+const char* StringId::Intern(const char* pStr, const size_t length, const uint64_t hash)
 {
-    return *m_pStrRef;
-}
+    auto& bucket = s_buckets[hash & (kBucketCount - 1)];
+    InternedString* pHead = bucket.load(std::memory_order_acquire);
 
-const std::string& StringId::operator*() const
-{
-    return *m_pStrRef;
-}
+    if (const auto* pFound = FindString(pHead, nullptr, pStr, length, hash))
+        return pFound->GetStr();
 
-const std::string* StringId::GetConstPtr() const
-{
-    return m_pStrRef;
-}
+    auto* pNewString = static_cast<InternedString*>(ArenaAllocate(sizeof(InternedString) + length + 1));
+    pNewString->hash = hash;
+    pNewString->length = length;
+    pNewString->pNext = pHead;
 
-const char* StringId::GetCStr() const
-{
-    if (!IsValid())
-        return nullptr;
+    char* pChars = const_cast<char*>(pNewString->GetStr());
+    std::memcpy(pChars, pStr, length);
+    pChars[length] = '\0';
 
-    return m_pStrRef->c_str();
-}
-
-
-std::string* StringId::GetStringPtr(const char* str)
-{
-    // If we are being set to nullptr, then return the address of the invalid string.
-    if (!str)
-        return &s_invalidStringId;
-
-    const uint32_t hash = HashString32(str);
-
-    std::lock_guard lock(s_stringMutex);
-
-    // If we don't have the string already, add it to our container.
-    if (s_strings.find(hash) == s_strings.end())
+    InternedString* pSearchedHead = pHead;
+    while (!bucket.compare_exchange_weak(pHead, pNewString, std::memory_order_release, std::memory_order_acquire))
     {
-        s_strings[hash] = str;
-    }
-
-    return &s_strings[hash];
-}
+        // Another thread may have added the same string. Our copy just stays unused in the arena.
+        if (const auto* pFound = FindString(pHead, pSearchedHead, pStr, length, hash))
+            return pFound->GetStr();
 
-std::string* StringId::GetStringPtr(const std::string& str)
-{
-    if (str.empty())
-        return &s_invalidStringId;
-
-    return GetStringPtr(str.c_str());
-}
-
-uint64_t StringIdHasher::operator()(const StringId id) const
-{
-    static std::hash<const std::string*> hash;
+        pSearchedHead = pHead;
+        pNewString->pNext = pHead;
+    }
 
-    return hash(id.GetConstPtr());
+    return pNewString->GetStr();
 }
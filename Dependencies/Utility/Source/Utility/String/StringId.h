@@ -1,59 +1,108 @@
 #pragma once
 // StringId.h
 
-#include <mutex>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include "../Generic/Hash.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
-//      This is an interned string implementation. The strings themselves are stored in a static container.
+//      This is an interned string implementation. A StringId is the 64-bit hash of its string, which is all that is used for
+//      comparing and hashing, plus a pointer to the string so that we can still read it. Strings that are created at runtime
+//      are copied into a global append-only arena the first time they are seen, and looking them up doesn't lock, so
+//      StringIds can be made on any thread.
 //
-//      It would be cool if I could have a 'scope' to the StringIds. Instead of one unified static container, it could have a
-//      pointer to a container. The only reason this would be nice is for dealing with Threads. I could setup a StringId scope
-//      to work on a single thread, for instance. Then we wouldn't have to lock. I am pretty sure I am going to have to make
-//      this thread safe.
+//      String literals don't need to be interned at all: use StringId::FromLiteral() or the _sid suffix ("Player"_sid) to make
+//      the id at compile time. Those point straight at the literal.
 //
-///		@brief : A StringId is a pointer to a std::string that lives in a static container of this class. Construction is the only
-///         intensive process of this class, because we have to hash the string and find/add it to the container. So construct as
-///         little as possible. Comparing, Copying, Moving, are all trivial. It's just a pointer. 
+//      Two different strings that hash to the same value are the same StringId. This is checked for in debug builds when
+//      strings are interned, but ids that are only made from literals are not checked.
+//
+///		@brief : A StringId is a hash and a pointer to an interned string. Construction from a runtime string is the only
+///         intensive process of this class, because we have to hash the string and find/add it to the arena. So construct as
+///         little as possible. Comparing, Copying, Moving, are all trivial.
 //-----------------------------------------------------------------------------------------------------------------------------
 class StringId
 {
-    // Easiest
-    inline static std::unordered_map<uint32_t, std::string> s_strings = std::unordered_map<uint32_t, std::string>(64);
-    inline static std::string s_invalidStringId = "Invalid StringId";
-    inline static std::mutex s_stringMutex;
+    static constexpr const char* kInvalidString = "Invalid StringId";
 
-    std::string* m_pStrRef = &s_invalidStringId;
+    uint64_t m_hash = 0;
+    const char* m_pStr = nullptr;
 
 public:
-    StringId() = default;
+    constexpr StringId() = default;
     StringId(const char* str);
     StringId(const std::string& str);
+    StringId(const std::string_view str);
 
-    StringId(const StringId& right) = default;
-    StringId(StringId&& right) noexcept;
-    StringId& operator=(const StringId& right) = default;
-    StringId& operator=(StringId&& right) noexcept;
+    constexpr StringId(const StringId& right) = default;
+    constexpr StringId(StringId&& right) noexcept;
+    constexpr StringId& operator=(const StringId& right) = default;
+    constexpr StringId& operator=(StringId&& right) noexcept;
     ~StringId() = default;
 
     [[nodiscard]] std::string GetStringCopy() const;
-    [[nodiscard]] const std::string& GetStringRef() const;
-    [[nodiscard]] const std::string* GetConstPtr() const;
-    [[nodiscard]] const char* GetCStr() const;
-    [[nodiscard]] bool IsValid() const { return m_pStrRef != &s_invalidStringId; }
+    [[nodiscard]] constexpr std::string_view GetStringView() const { return IsValid() ? std::string_view(m_pStr) : std::string_view(); }
+    [[nodiscard]] constexpr const char* GetCStr() const { return m_pStr; }
+    [[nodiscard]] constexpr uint64_t GetHash() const { return m_hash; }
+    [[nodiscard]] constexpr bool IsValid() const { return m_pStr != nullptr; }
 
-    const std::string& operator*() const;
-    constexpr bool operator==(const StringId& right) const { return m_pStrRef == right.m_pStrRef; }
+    constexpr std::string_view operator*() const { return IsValid() ? std::string_view(m_pStr) : std::string_view(kInvalidString); }
+    constexpr bool operator==(const StringId& right) const { return m_hash == right.m_hash && IsValid() == right.IsValid(); }
     constexpr bool operator!=(const StringId& right) const { return !(*this == right); }
 
+    static constexpr StringId FromLiteral(const char* pLiteral);
+
 private:
-    static std::string* GetStringPtr(const char* str);
-    static std::string* GetStringPtr(const std::string& str);
+    constexpr StringId(const uint64_t hash, const char* pStr) : m_hash(hash), m_pStr(pStr) {}
+    static const char* Intern(const char* pStr, const size_t length, const uint64_t hash);
 };
 
+constexpr StringId::StringId(StringId&& right) noexcept
+    : m_hash(right.m_hash)
+    , m_pStr(right.m_pStr)
+{
+    right.m_hash = 0;
+    right.m_pStr = nullptr;
+}
+
+constexpr StringId& StringId::operator=(StringId&& right) noexcept
+{
+    if (right != *this)
+    {
+        m_hash = right.m_hash;
+        m_pStr = right.m_pStr;
+        right.m_hash = 0;
+        right.m_pStr = nullptr;
+    }
+
+    return *this;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      The literal is not copied, so it must have static storage. Only use this for string literals.
+//
+///		@brief : Make a StringId at compile time, without interning the string.
+//-----------------------------------------------------------------------------------------------------------------------------
+constexpr StringId StringId::FromLiteral(const char* pLiteral)
+{
+    if (!pLiteral)
+        return StringId();
+
+    return StringId(HashString64(pLiteral), pLiteral);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Make a StringId from a string literal at compile time. Ex: constexpr StringId kPlayer = "Player"_sid;
+//-----------------------------------------------------------------------------------------------------------------------------
+constexpr StringId operator""_sid(const char* pLiteral, [[maybe_unused]] const size_t length)
+{
+    return StringId::FromLiteral(pLiteral);
+}
+
 struct StringIdHasher
 {
-    uint64_t operator()(const StringId id) const;
-};
\ No newline at end of file
+    constexpr uint64_t operator()(const StringId id) const { return id.GetHash(); }
+};
@@ -0,0 +1,111 @@
+#pragma once
+// SpscQueue.h
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Exactly one thread may push, and exactly one (other) thread may pop. Neither side ever locks or waits: a push onto
+//      a full queue, or a pop from an empty one, just returns false.
+//
+//      Each side keeps a cached copy of the other side's index, so it only has to read the shared index (and pull in the
+//      other thread's cache line) when the cached one says the queue is full or empty. The two indices are padded apart so
+//      the producer and consumer don't keep invalidating each other's cache line.
+//
+///		@brief : Fixed size, lock-free, single-producer/single-consumer ring buffer.
+///		@tparam Type : Type of the elements. Must be default constructible and move assignable.
+//-----------------------------------------------------------------------------------------------------------------------------
+template<typename Type>
+class SpscQueue
+{
+    static constexpr size_t kCacheLineSize = 64;
+
+    // Producer:
+    std::atomic<size_t> m_tail = 0;         // Next slot to write to. Only written by the producer.
+    size_t m_cachedHead = 0;                // Producer's last read of m_head.
+    char m_producerPadding[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    // Consumer:
+    std::atomic<size_t> m_head = 0;         // Next slot to read from. Only written by the consumer.
+    size_t m_cachedTail = 0;                // Consumer's last read of m_tail.
+    char m_consumerPadding[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    std::vector<Type> m_slots;
+    size_t m_mask;
+
+public:
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Create the queue. Capacity must be a power of 2.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    explicit SpscQueue(const size_t capacity)
+        : m_slots(capacity)
+        , m_mask(capacity - 1)
+    {
+        assert(capacity >= 2 && (capacity & (capacity - 1)) == 0 && "SpscQueue capacity must be a power of 2!");
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue(SpscQueue&&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Producer only. Push a value onto the back of the queue.
+    ///		@returns : False if the queue is full. The value is not moved from in that case.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool TryPush(Type&& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead > m_mask)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+                return false;
+        }
+
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const Type& value)
+    {
+        Type copy = value;
+        return TryPush(std::move(copy));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Consumer only. Pop the value at the front of the queue.
+    ///		@returns : False if the queue is empty.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool TryPop(Type& valueOut)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return false;
+        }
+
+        valueOut = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Approximate number of elements in the queue. Exact if called while neither side is pushing or popping.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    [[nodiscard]] size_t GetSize() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t GetCapacity() const { return m_slots.size(); }
+};
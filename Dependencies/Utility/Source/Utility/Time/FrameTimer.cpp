@@ -2,11 +2,41 @@
 
 #include "FrameTimer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if _WIN32
+#pragma warning (push)
+#pragma warning (disable : 5105)
+#include <Windows.h>
+#include <timeapi.h>
+#pragma warning (pop)
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace
+{
+    // The sleep estimate is never more than this fraction of the target frame time, so a coarse scheduler can't turn the
+    // whole wait into a spin.
+    constexpr double kMaxSleepEstimateFraction = 0.5;
+
+    // Sleep statistics are restarted after this many samples, keeping the mean and variance as if they were this many
+    // samples, so a change in the scheduler is picked up quickly.
+    constexpr uint64_t kMaxSleepSamples = 256;
+    constexpr uint64_t kSleepSamplesKeptOnReset = 8;
+}
+
 FrameTimer::FrameTimer()
 {
     m_timer.Start();
 }
 
+FrameTimer::~FrameTimer()
+{
+    SetTimerResolutionRaised(false);
+}
+
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
 //		
@@ -18,12 +48,208 @@ void FrameTimer::ResetTimer()
 }
 
 //-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      If a target frame rate is set, this will block until the target frame time has elapsed since the last frame.
+//		
 ///		@brief : Begins a new frame, and returns the time in milliseconds since the last frame.
 //-----------------------------------------------------------------------------------------------------------------------------
 double FrameTimer::NewFrame()
 {
+    // Everything since the last frame began is work, until we start waiting.
+    RecordWork(m_timer.GetTimer());
+
+    if (m_targetFrameMs > 0.0)
+        WaitForTargetFrameTime();
+
     const double deltaTimeMs = m_timer.GetTimer();
     m_timer.Start();
 
+    RecordFrame(deltaTimeMs);
+
     return deltaTimeMs;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Set the frame rate that NewFrame() will pace to. Pass 0 to run uncapped.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::SetTargetFps(const double fps)
+{
+    m_targetFrameMs = fps > 0.0 ? 1000.0 / fps : 0.0;
+    SetTimerResolutionRaised(m_targetFrameMs > 0.0);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      This is an exponential moving average: smoothed = lerp(delta, smoothed, factor). Higher values filter out more of the
+//      OS scheduling jitter, but react to real changes in frame time more slowly.
+//		
+///		@brief : Set how much GetSmoothedDeltaMs() is smoothed, in the range [0, 1). 0 disables smoothing.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::SetSmoothingFactor(const double factor)
+{
+    m_smoothingFactor = std::clamp(factor, 0.0, 0.99);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Clear the gathered frame time statistics.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::ResetStats()
+{
+    m_stats = {};
+    m_frameM2 = 0.0;
+    m_workHistoryIndex = 0;
+    m_workHistoryCount = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Unlike the delta time, this doesn't include the time spent waiting for the target frame rate, so it shows how much
+//      of the frame budget is actually being used.
+//		
+///		@brief : Get how long the last frame took to process, in milliseconds.
+//-----------------------------------------------------------------------------------------------------------------------------
+double FrameTimer::GetLastWorkMs() const
+{
+    if (m_workHistoryCount == 0)
+        return 0.0;
+
+    const size_t lastIndex = (m_workHistoryIndex + kWorkHistorySize - 1) % kWorkHistorySize;
+    return m_workHistoryMs[lastIndex];
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the average work time of the most recent frames, up to kWorkHistorySize. Returns 0 if there is no history.
+//-----------------------------------------------------------------------------------------------------------------------------
+double FrameTimer::GetAverageWorkMs(const size_t frameCount) const
+{
+    const size_t count = std::min({frameCount, m_workHistoryCount, kWorkHistorySize});
+    if (count == 0)
+        return 0.0;
+
+    double totalMs = 0.0;
+    for (size_t i = 1; i <= count; ++i)
+    {
+        totalMs += m_workHistoryMs[(m_workHistoryIndex + kWorkHistorySize - i) % kWorkHistorySize];
+    }
+
+    return totalMs / static_cast<double>(count);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Hybrid wait: sleep while the remaining time is larger than our estimate of how long a sleep takes, then spin until
+//      the target is hit.
+//		
+///		@brief : Wait until the target frame time has passed since the timer was last started.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::WaitForTargetFrameTime()
+{
+    while (m_targetFrameMs - m_timer.GetTimer() > m_sleepEstimateMs)
+    {
+        SleepOnce();
+    }
+
+    while (m_timer.GetTimer() < m_targetFrameMs)
+    {
+        std::this_thread::yield();
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Requests a 1ms sleep, and updates the running mean and standard deviation of how long it actually took (Welford's
+//      algorithm). Our estimate is mean + one standard deviation, so most sleeps finish before the estimate. It is capped
+//      to a fraction of the target frame time, so that we still sleep for most of the frame if sleeps are coarse.
+//		
+///		@brief : Sleep for a short time and refine our estimate of how long a sleep takes.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::SleepOnce()
+{
+    HighPrecisionTimer sleepTimer;
+    sleepTimer.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const double observedMs = sleepTimer.GetTimer();
+
+    ++m_sleepCount;
+    const double delta = observedMs - m_sleepMeanMs;
+    m_sleepMeanMs += delta / static_cast<double>(m_sleepCount);
+    m_sleepM2 += delta * (observedMs - m_sleepMeanMs);
+
+    const double variance = m_sleepM2 / static_cast<double>(m_sleepCount - 1);
+    m_sleepEstimateMs = std::min(m_sleepMeanMs + std::sqrt(variance), m_targetFrameMs * kMaxSleepEstimateFraction);
+
+    // Don't let a long history make us slow to react if the scheduler changes, ex: timer resolution changes. The mean is
+    // kept as it is, and the variance is kept by scaling its sum down to the samples that we keep.
+    if (m_sleepCount > kMaxSleepSamples)
+    {
+        m_sleepCount = kSleepSamplesKeptOnReset;
+        m_sleepM2 = variance * static_cast<double>(kSleepSamplesKeptOnReset - 1);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      timeBeginPeriod() is system wide and costs power, so it is only held while we are pacing. Does nothing on other
+//      platforms, where sleeps are already fine grained.
+//
+///		@brief : Raise the OS timer resolution to 1ms, or restore it.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::SetTimerResolutionRaised(const bool isRaised)
+{
+    if (isRaised == m_isTimerResolutionRaised)
+        return;
+
+    m_isTimerResolutionRaised = isRaised;
+
+#if _WIN32
+    if (isRaised)
+        timeBeginPeriod(1);
+    else
+        timeEndPeriod(1);
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Update the smoothed delta time and frame statistics with a new frame's raw delta time.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::RecordFrame(const double deltaTimeMs)
+{
+    // Smoothing
+    if (m_stats.frameCount == 0 || m_smoothingFactor <= 0.0)
+        m_smoothedDeltaMs = deltaTimeMs;
+
+    else
+        m_smoothedDeltaMs = deltaTimeMs + (m_smoothedDeltaMs - deltaTimeMs) * m_smoothingFactor;
+
+    // Running mean and variance.
+    ++m_stats.frameCount;
+    const double delta = deltaTimeMs - m_stats.averageFrameMs;
+    m_stats.averageFrameMs += delta / static_cast<double>(m_stats.frameCount);
+    m_frameM2 += delta * (deltaTimeMs - m_stats.averageFrameMs);
+    m_stats.frameTimeVariance = m_stats.frameCount > 1 ? m_frameM2 / static_cast<double>(m_stats.frameCount - 1) : 0.0;
+
+    if (m_stats.frameCount == 1)
+    {
+        m_stats.minFrameMs = deltaTimeMs;
+        m_stats.maxFrameMs = deltaTimeMs;
+    }
+
+    else
+    {
+        m_stats.minFrameMs = std::min(m_stats.minFrameMs, deltaTimeMs);
+        m_stats.maxFrameMs = std::max(m_stats.maxFrameMs, deltaTimeMs);
+    }
+
+    if (m_targetFrameMs > 0.0 && deltaTimeMs > m_targetFrameMs + m_missToleranceMs)
+        ++m_stats.pacingMisses;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a frame's work time to the history, overwriting the oldest entry once the history is full.
+//-----------------------------------------------------------------------------------------------------------------------------
+void FrameTimer::RecordWork(const double workTimeMs)
+{
+    m_workHistoryMs[m_workHistoryIndex] = workTimeMs;
+    m_workHistoryIndex = (m_workHistoryIndex + 1) % kWorkHistorySize;
+    m_workHistoryCount = std::min(m_workHistoryCount + 1, kWorkHistorySize);
 }
\ No newline at end of file
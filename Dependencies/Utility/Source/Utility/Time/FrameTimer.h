@@ -1,20 +1,93 @@
 #pragma once
 // FrameTimer.h
+#include <cstddef>
+#include <cstdint>
 #include "HighPrecisionTimer.h"
 
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Frame time statistics gathered by the FrameTimer since the last ResetStats() call.
+//-----------------------------------------------------------------------------------------------------------------------------
+struct FrameTimerStats
+{
+    uint64_t frameCount         = 0;    // Number of frames measured.
+    uint64_t pacingMisses       = 0;    // Number of frames that went over the target frame time (plus tolerance).
+    double averageFrameMs       = 0.0;  // Mean raw frame time.
+    double frameTimeVariance    = 0.0;  // Variance of the raw frame time, in ms^2.
+    double minFrameMs           = 0.0;
+    double maxFrameMs           = 0.0;
+};
+
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
+//      Frame Pacing: If a target frame rate is set, NewFrame() will wait until the target frame time has elapsed since the
+//      last frame. It sleeps while there is enough time left for the OS to wake us up reliably, then spins for the remainder.
+//      How long we can sleep for is learned from how long previous sleeps actually took, so we don't burn a core when the
+//      OS scheduler is accurate, and we don't miss frames when it isn't. On Windows, the system timer resolution is raised
+//      to 1ms while a target frame rate is set, otherwise every sleep would take a whole scheduler tick (~15.6ms).
 //		
 ///		@brief : Wraps the HighPrecisionTimer in a frame time API. You simply create this timer on the stack (its constructor
 ///         will start the timer) then call NewFrame() at the top of the main loop to get the delta time for that frame.
 //-----------------------------------------------------------------------------------------------------------------------------
 class FrameTimer
 {
+public:
+    static constexpr size_t kWorkHistorySize = 32;
+
+private:
     HighPrecisionTimer m_timer;
 
+    // Pacing
+    double m_targetFrameMs = 0.0;           // 0 means uncapped.
+    double m_missToleranceMs = 0.5;         // How far over the target a frame can be before it counts as a miss.
+
+    // Sleep estimation, measured in ms. Starts pessimistic and is refined as we sleep.
+    double m_sleepEstimateMs = 5.0;
+    double m_sleepMeanMs = 5.0;
+    double m_sleepM2 = 0.0;
+    uint64_t m_sleepCount = 1;
+    bool m_isTimerResolutionRaised = false;
+
+    // Smoothing
+    double m_smoothingFactor = 0.0;         // [0, 1). 0 is no smoothing.
+    double m_smoothedDeltaMs = 0.0;
+
+    // Stats
+    FrameTimerStats m_stats;
+    double m_frameM2 = 0.0;
+
+    // Work time: how long each frame took before any pacing wait. Stored in a ring buffer.
+    double m_workHistoryMs[kWorkHistorySize] = {};
+    size_t m_workHistoryIndex = 0;
+    size_t m_workHistoryCount = 0;
+
 public:
     FrameTimer();
+    ~FrameTimer();
+
+    FrameTimer(const FrameTimer&) = delete;
+    FrameTimer(FrameTimer&&) = delete;
+    FrameTimer& operator=(const FrameTimer&) = delete;
+    FrameTimer& operator=(FrameTimer&&) = delete;
 
     void ResetTimer();
     double NewFrame();
+
+    void SetTargetFps(const double fps);
+    void SetSmoothingFactor(const double factor);
+    void SetMissTolerance(const double toleranceMs) { m_missToleranceMs = toleranceMs; }
+    void ResetStats();
+
+    [[nodiscard]] double GetTargetFrameMs() const { return m_targetFrameMs; }
+    [[nodiscard]] double GetSmoothedDeltaMs() const { return m_smoothedDeltaMs; }
+    [[nodiscard]] const FrameTimerStats& GetStats() const { return m_stats; }
+    [[nodiscard]] double GetLastWorkMs() const;
+    [[nodiscard]] double GetAverageWorkMs(const size_t frameCount = kWorkHistorySize) const;
+    [[nodiscard]] size_t GetWorkHistoryCount() const { return m_workHistoryCount; }
+
+private:
+    void WaitForTargetFrameTime();
+    void SleepOnce();
+    void SetTimerResolutionRaised(const bool isRaised);
+    void RecordFrame(const double deltaTimeMs);
+    void RecordWork(const double workTimeMs);
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 ---@class ApplicationLib
 ---@field QuitGame function # Set active state of the passed in Widget.
 ---@field SetLanguage function
+---@field DumpResourceStats function
 
 ---@type ApplicationLib
 Application = {};
@@ -16,4 +17,11 @@ function Application.QuitGame() end
 --- Sets the Language based on the token
 ---@param token string Name of the language.
 ------------------------------------------------------------------
-function Application.SetLanguage(token) end
\ No newline at end of file
+function Application.SetLanguage(token) end
+
+------------------------------------------------------------------
+--- Writes the memory, load times and reference counts of every
+--- loaded resource to a CSV file.
+---@param filepath string Path of the file, relative to the working directory.
+------------------------------------------------------------------
+function Application.DumpResourceStats(filepath) end
\ No newline at end of file
@@ -0,0 +1,52 @@
+-- Graphics.lua
+
+---@class RenderStats
+---@field drawCalls integer
+---@field textureBinds integer
+---@field stateChanges integer
+---@field skippedStateChanges integer
+---@field quads integer
+---@field vertices integer
+---@field targetSwitches integer
+
+---@class GraphicsLib
+---@field GetRenderStats function
+---@field SetStatsLogInterval function
+---@field GetResolutionScale function
+---@field SetDynamicResolutionEnabled function
+---@field CaptureFrames function
+
+---@type GraphicsLib
+Graphics = {};
+
+------------------------------------------------------------------
+--- Get the render statistics of the last frame.
+---@return RenderStats
+------------------------------------------------------------------
+function Graphics.GetRenderStats() end
+
+------------------------------------------------------------------
+--- Log the render statistics every N frames.
+---@param frameInterval integer Number of frames between logs. 0 disables logging.
+------------------------------------------------------------------
+function Graphics.SetStatsLogInterval(frameInterval) end
+
+------------------------------------------------------------------
+--- Get the scale that the world is currently rendered at.
+---@return number scale 1 is native resolution.
+------------------------------------------------------------------
+function Graphics.GetResolutionScale() end
+
+------------------------------------------------------------------
+--- Enable or disable dynamic resolution scaling of the world.
+---@param isEnabled boolean
+------------------------------------------------------------------
+function Graphics.SetDynamicResolutionEnabled(isEnabled) end
+
+------------------------------------------------------------------
+--- Capture the render commands of the next frames to a file, to be run by the RenderReplay tool.
+---@param filepath string File that the capture is written to.
+---@param frameCount integer|nil Number of frames to capture. Defaults to 1.
+---@return boolean started False if a capture is already in progress.
+------------------------------------------------------------------
+function Graphics.CaptureFrames(filepath, frameCount) end
@@ -3,6 +3,7 @@ require("Engine.Scripts.Core.Class")
 require("Engine.Scripts.Core.Debug")
 require("Engine.Scripts.Core.Application")
 require("Engine.Scripts.Core.SceneManager")
+require("Engine.Scripts.Core.Graphics")
 require("Engine.Scripts.UI.Widget")
 require("Engine.Scripts.UI.BarWidget")
 require("Engine.Scripts.UI.ImageWidget")
@@ -2,6 +2,7 @@
 
 ---@class SceneManagerLib
 ---@field TransitionToScene function # Set active state of the passed in Widget.
+---@field PreloadScene function
 ---@field PauseWorld function
 ---@field ResumeWorld function
 
@@ -16,6 +17,13 @@ SceneManager = {};
 ------------------------------------------------------------------
 function SceneManager.TransitionToScene(sceneId) end
 
+------------------------------------------------------------------
+--- Start loading a scene's assets in the background, so that
+--- transitioning to it later is fast.
+---@param sceneId string Id of the scene you want to preload.
+------------------------------------------------------------------
+function SceneManager.PreloadScene(sceneId) end
+
 ------------------------------------------------------------------
 --- Pauses the World Layer in the active scene.
 ------------------------------------------------------------------
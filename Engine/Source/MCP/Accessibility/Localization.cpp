@@ -69,7 +69,7 @@ namespace mcp
     ///		@brief : Returns the localized version of the token for the currently set language. If the token isn't valid, it will
     ///         just return the token as a string.
     //-----------------------------------------------------------------------------------------------------------------------------
-    const std::string* LocalizationSystem::GetLocalized(const Token token)
+    std::string_view LocalizationSystem::GetLocalized(const Token token)
     {
         const auto result = m_data.tokenToIndexMap.find(token);
 
@@ -77,13 +77,13 @@ namespace mcp
         if ( result == m_data.tokenToIndexMap.end())
         {
             MCP_WARN("LocalizationSystem", "Failed to find localized text for token '", *token , "'. Returning token value...");
-            return token.GetConstPtr();
+            return token.GetStringView();
         }
 
         const size_t index = result->second;
         const auto& stringContainer = m_data.localizedTexts[m_currentLanguage];
         
-        return &stringContainer[index];
+        return stringContainer[index];
     }
 
     LocalizationSystem* LocalizationSystem::AddFromData(const XMLElement element)
@@ -377,10 +377,10 @@ namespace mcp
             size_t end = m_formatted.find("}%", start);
 
             const StringId token = m_formatted.substr(start + 3, end - (start + 3));
-            auto* replacedValue = pSystem->GetLocalized(token);
-            m_formatted = m_formatted.replace(start, end - (start) + 2, *replacedValue);
+            const auto replacedValue = pSystem->GetLocalized(token);
+            m_formatted = m_formatted.replace(start, end - (start) + 2, replacedValue);
 
-            end = start + replacedValue->size();
+            end = start + replacedValue.size();
             start = m_formatted.find("%L{", end);
         }
     }
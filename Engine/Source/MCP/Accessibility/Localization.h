@@ -47,7 +47,7 @@ namespace mcp
 
         void LoadLocalizedScript(const char* pFilepath);
         void SetLanguage(StringId language);
-        [[nodiscard]] const std::string* GetLocalized(const Token token);
+        [[nodiscard]] std::string_view GetLocalized(const Token token);
 
         static LocalizationSystem* Get();
         static LocalizationSystem* AddFromData(const XMLElement element);
@@ -2,8 +2,8 @@
 // AnimationCurve.h
 
 #include <functional>
-#include "ConceptTypes.h"
-#include "Vector2.h"
+#include "Utility/Generic/ConceptTypes.h"
+#include "Utility/Types/Vector2.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
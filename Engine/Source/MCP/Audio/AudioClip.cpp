@@ -2,6 +2,7 @@
 
 #include "AudioClip.h"
 
+#include "MCP/Core/Resource/PreloadManifest.h"
 #include "MCP/Core/Resource/ResourceManager.h"
 
 using KeyType = const char*;
@@ -12,6 +13,9 @@ struct Mix_Chunk;
 namespace mcp
 {
     using AudioClipType = Mix_Chunk;
+
+    // Clips are decoded straight from their package entry, without it being cached.
+    template<> struct StreamsFromPackage<AudioClipType> : std::true_type {};
 }
 #else
 #error "We don't have a resource implementation for Texture loading for current API!'"
@@ -19,8 +23,20 @@ namespace mcp
 
 namespace mcp
 {
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The load holds a reference until it is released with ResourceManager::ReleaseLoad().
+    //
+    ///		@brief : Start loading an audio clip in the background, without keeping a handle to it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceLoadHandle AudioClip::Preload(const DiskResourceRequest& request)
+    {
+        return ResourceManager::Get()->LoadAsync<AudioClipType>(request, LoadPriority::kBackground);
+    }
+
     void* AudioClip::LoadResourceType()
     {
+        PreloadManifest::Record(PreloadAssetType::kAudioClip, m_request);
         return ResourceManager::Get()->LoadFromDisk<AudioClipType>(m_request);
     }
 
@@ -2,6 +2,7 @@
 // AudioClip.h
 
 #include "MCP/Core/Resource/Resource.h"
+#include "MCP/Core/Resource/ResourceLoadHandle.h"
 
 namespace mcp
 {
@@ -10,6 +11,8 @@ namespace mcp
     public:
         MCP_DEFINE_RESOURCE_DESTRUCTOR(AudioClip)
 
+        static ResourceLoadHandle Preload(const DiskResourceRequest& request);
+
     protected:
         virtual void* LoadResourceType() override;
         virtual void Free() override;
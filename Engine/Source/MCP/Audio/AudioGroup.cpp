@@ -6,15 +6,6 @@
 #include "MCP/Debug/Log.h"
 #include "Utility/Generic/Hash.h"
 
-#if MCP_AUDIO_PLATFORM == MCP_AUDIO_PLATFORM_SDL
-// Disable SDL Warnings.
-#pragma warning(push, 0)    
-#include "Platform/SDL2/SDLAudio.h"
-#pragma warning(pop)
-
-using AudioPlatform = SDLAudioManager;
-#endif
-
 namespace mcp
 {
     AudioGroup::AudioGroup(const char* pName, const float defaultVolume, const bool isMuted, AudioGroup* pParent)
@@ -49,8 +40,7 @@ namespace mcp
     void AudioGroup::SetVolume(const float volume)
     {
         m_volume = std::clamp(volume, 0.f, 1.f);
-
-        // TODO: I need to update any audio resource channels that are currently being played on this group.
+        m_hasChanged = true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -72,32 +62,13 @@ namespace mcp
     void AudioGroup::Mute()
     {
         m_isMuted = true;
-
-        for (const auto channel : m_channels)
-        {
-            AudioPlatform::MuteChannel(channel);
-        }
-
-        for (auto* pChild : m_children)
-        {
-            pChild->OnParentMuteChanged(m_isMuted);
-        }
+        m_hasChanged = true;
     }
 
     void AudioGroup::UnMute()
     {
         m_isMuted = false;
-
-        // TODO: Un-mute every channel that this group owns.
-        //for (const auto channel : m_channels)
-        //{
-        //    //AudioPlatform::UnMuteChannel(channel, );
-        //}
-
-        for (auto* pChild : m_children)
-        {
-            pChild->OnParentMuteChanged(m_isMuted);
-        }
+        m_hasChanged = true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -113,81 +84,55 @@ namespace mcp
         return m_isMuted;
     }
 
-    void AudioGroup::AddChannel(const AudioHardwareChannel channel)
-    {
-        // TODO: Make sure that we don't have the channel already.
-
-        m_channels.emplace_back(channel);
-    }
-
-    void AudioGroup::RemoveChannel(const AudioHardwareChannel channel)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Child groups are paused through IsPaused(), which checks the parents.
+    //		
+    ///		@brief : Pauses all audio sources running on this AudioGroup, and any child AudioGroups
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioGroup::Pause()
     {
-        for (size_t i = 0; i < m_channels.size(); ++i)
-        {
-            if (channel == m_channels[i])
-            {
-                std::swap(m_channels[i], m_channels.back());
-                m_channels.pop_back();
-                break;
-            }
-        }
+        m_isPaused = true;
+        m_hasChanged = true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
-    ///		@brief : Pauses all audio sources running on this AudioGroup, and pauses any child AudioGroups
+    ///		@brief : Resumes all audio sources running on this AudioGroup, and any child AudioGroups that aren't paused themselves.
     //-----------------------------------------------------------------------------------------------------------------------------
-    void AudioGroup::Pause() const
+    void AudioGroup::Resume()
     {
-        for (auto channel : m_channels)
-        {
-            AudioPlatform::PauseChannel(channel);
-        }
-
-        for (auto* pChild : m_children)
-        {
-            pChild->Pause();
-        }
+        m_isPaused = false;
+        m_hasChanged = true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
-    ///		@brief : Resumes all audio sources running on this AudioGroup, and resumes all child AudioGroups.
+    ///		@brief : Returns if this AudioGroup is paused or not. If a parent group is paused, then this will return true.
     //-----------------------------------------------------------------------------------------------------------------------------
-    void AudioGroup::Resume() const
+    bool AudioGroup::IsPaused() const
     {
-        for (auto channel : m_channels)
-        {
-            AudioPlatform::ResumeChannel(channel);
-        }
+        if (m_pParent && m_pParent->IsPaused())
+            return true;
 
-        for (auto* pChild : m_children)
-        {
-            pChild->Resume();
-        }
+        return m_isPaused;
     }
 
-    // TODO:
-    void AudioGroup::OnParentMuteChanged(const bool parentIsMuted)
+    void AudioGroup::SetMaxVoices(const unsigned maxVoices)
     {
-        // If we are not muted
-        if (!m_isMuted)
-        {
-            // If the parent is now muted,
-            if (parentIsMuted)
-            {
-                // I need to call into the audio platform and mute this
-                //AudioPlatform::MuteGroup(static_cast<int>(m_id));
-            }
-
-            // If the parent is now un-muted,
-            else
-            {
-                //AudioPlatform::UnMuteGroup(static_cast<int>(m_id));
-            }
-        }
+        m_maxVoices = maxVoices;
+        m_hasChanged = true;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns true once after any change to this group's settings.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioGroup::ConsumeChanged()
+    {
+        const bool hasChanged = m_hasChanged;
+        m_hasChanged = false;
+        return hasChanged;
+    }
 }
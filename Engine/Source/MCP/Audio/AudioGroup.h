@@ -1,6 +1,7 @@
 #pragma once
 // AudioGroup.h
 #include <cstdint>
+#include <limits>
 #include <vector>
 #include "MCP/Core/Config.h"
 
@@ -15,6 +16,9 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //      TODO: Audio Groups can be parented. This allows you to have a Master group, and setting its volume will effect all child groups.
+    //
+    //      Groups don't touch the audio platform themselves. Any change marks the group as changed, and the AudioManager sends
+    //      the final state of every group to the audio thread on its next update.
     //		
     ///		@brief : An Audio Group is essentially a 'channel' in the final audio that the Audio Listener hears. Audio Groups could be
     ///         things like: Master, Music, Effects, etc. Each Group has a volume that can be set. 
@@ -25,26 +29,19 @@ namespace mcp
         // Id for this AudioGroup, used to get a reference to it from the AudioManager.
         using Id = uint32_t;
 
-        struct PlayAudioData
-        {
-            AudioGroup* pGroup;                 // The Group that the resource is being played from.
-            AudioSourceComponent* pSource;      // The audio source that is currently playing on this Channel
-            AudioHardwareChannel channel;       // The channel that this audio source was playing on.
-        };
-
     public:
         static constexpr Id kInvalidId = std::numeric_limits<Id>::max();
         constexpr static AudioHardwareChannel kNoChannel = -1;
 
     private:
-        constexpr static unsigned kDefaultChannelCount = 4;
-
-        std::vector<AudioHardwareChannel> m_channels;   // The channels that are currently playing through this audio group.
         std::vector<AudioGroup*> m_children;
         AudioGroup* m_pParent = nullptr;
         Id m_id;
         float m_volume; // The volume of this Audio Group, from a range of [0, 1]
+        unsigned m_maxVoices = 0;   // Max number of clips that can play in this group at once. 0 is no limit.
         bool m_isMuted;
+        bool m_isPaused = false;
+        bool m_hasChanged = true;   // Whether the audio thread needs our state. Starts true, so the initial state is sent.
 
     public:
         AudioGroup(const char* pName, const float defaultVolume, const bool isMuted = false, AudioGroup* pParent = nullptr);
@@ -60,16 +57,17 @@ namespace mcp
         [[nodiscard]] bool IsMuted() const;
 
         // Play/Pause
-        void Pause() const;
-        void Resume() const;
+        void Pause();
+        void Resume();
+        [[nodiscard]] bool IsPaused() const;
 
-        // INTERNAL: Managing active hardware channels
-        void AddChannel(const AudioHardwareChannel channel);
-        void RemoveChannel(const AudioHardwareChannel channel);
+        // Voices
+        void SetMaxVoices(const unsigned maxVoices);
+        [[nodiscard]] unsigned GetMaxVoices() const { return m_maxVoices; }
 
-        [[nodiscard]] Id GetId() const  { return m_id; }
+        // INTERNAL: Used by the AudioManager to know when to update the audio thread.
+        bool ConsumeChanged();
 
-    private:
-        void OnParentMuteChanged(const bool parentIsMuted);
+        [[nodiscard]] Id GetId() const  { return m_id; }
     };
 }
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include "AudioManager.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
 #include "MCP/Components/AudioSourceComponent.h"
 #include "MCP/Core/Config.h"
 #include "MCP/Debug/Log.h"
@@ -33,11 +37,36 @@ namespace mcp
             return false;
         }
 
+        if (!m_audioThread.Start())
+        {
+            MCP_ERROR("Audio", "Failed to initialize AudioManager! Failed to start the audio thread.");
+            return false;
+        }
+
+        // Every group starts out changed, so this sends their initial state.
+        SendGroupStates();
+        m_audioThread.Wake();
         return true;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This has to happen before the ResourceManager is closed, since the playing voices are holding references to their
+    //      resources.
+    //		
+    ///		@brief : Stop the audio thread, and release every voice that was still playing.
+    //-----------------------------------------------------------------------------------------------------------------------------
     void AudioManager::Close()
     {
+        m_audioThread.Stop();
+
+        for (auto&[id, request] : m_playingVoices)
+        {
+            AudioResource::RemoveReference(request);
+        }
+
+        m_playingVoices.clear();
+
         // Destroy all of our audio groups.
         for (auto&[id, pGroup] : m_audioGroups)
         {
@@ -50,13 +79,17 @@ namespace mcp
 
     void AudioManager::Mute()
     {
-        AudioPlatform::Mute();
+        AudioCommand command;
+        command.type = AudioCommand::Type::kMute;
+        SendCommand(command);
         m_isMuted = true;
     }
 
     void AudioManager::UnMute()
     {
-        AudioPlatform::UnMute();
+        AudioCommand command;
+        command.type = AudioCommand::Type::kUnMute;
+        SendCommand(command);
         m_isMuted = false;
     }
 
@@ -98,70 +131,198 @@ namespace mcp
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      This only queues the play for the audio thread. Clips are played through the AudioVoiceManager, so they may start
+    //      out virtual if there are more important clips playing, or be dropped if their group is full. Music is played on its
+    //      own channel, and replaces any music that was playing.
     //		
     ///		@brief : Play a piece of Audio.
     ///		@param pSource : The audio source component that is playing the piece of audio.
     ///		@param resource : The Resource we are going to play
     ///		@param groupId : The Id of the AudioGroup that this Audio Source belongs to.
     ///		@param volume : The volume to play the resource at.
-    ///		@returns : The hardware channel that this Audio Resource is playing on.
+    ///		@returns : The voice that the audio is playing on, or kInvalidVoiceId if it failed to play.
     //-----------------------------------------------------------------------------------------------------------------------------
-    AudioHardwareChannel AudioManager::PlayAudio(const AudioSourceComponent* pSource, const AudioResource& resource, const AudioGroup::Id groupId, const float volume)
+    AudioVoiceId AudioManager::PlayAudio(const AudioSourceComponent* pSource, const AudioResource& resource, const AudioGroup::Id groupId, const float volume)
     {
-        auto* pGroup = GetGroup(groupId);
-        MCP_CHECK(pGroup);
-
-        PlayingAudioData data;
-        data.groupId = groupId;
-        data.volume = pGroup->GetVolume() * volume;
+        MCP_CHECK(GetGroup(groupId));
 
-        if (resource.IsMusicResource())
+        if (!resource.IsValid())
         {
-            data.channel = AudioPlatform::PlayMusic(resource.Get(), data.volume, pSource->IsLooping());
+            MCP_ERROR("Audio", "Failed to play audio! The resource was invalid.");
+            return kInvalidVoiceId;
         }
 
-        else
+        // Nothing would ever report the voice as finished, so the reference would never be released.
+        if (!m_audioThread.IsRunning())
+            return kInvalidVoiceId;
+
+        AudioCommand command;
+        command.type = resource.IsMusicResource() ? AudioCommand::Type::kPlayMusic : AudioCommand::Type::kPlayClip;
+        command.voiceId = m_nextVoiceId++;
+        command.groupId = groupId;
+        command.pResource = resource.Get();
+        command.volume = volume;
+        command.priority = pSource->GetPriority();
+        command.isLooping = pSource->IsLooping();
+
+        // The audio thread is using the resource until it tells us that the voice has finished.
+        const auto request = resource.GetRequest();
+        AudioResource::AddReference(request);
+        m_playingVoices.emplace(command.voiceId, request);
+
+        SendCommand(command);
+        return command.voiceId;
+    }
+
+    void AudioManager::StopVoice(const AudioVoiceId id)
+    {
+        if (!IsVoicePlaying(id))
+            return;
+
+        AudioCommand command;
+        command.type = AudioCommand::Type::kStopVoice;
+        command.voiceId = id;
+        SendCommand(command);
+    }
+
+    void AudioManager::SetVoiceVolume(const AudioVoiceId id, const float volume)
+    {
+        if (!IsVoicePlaying(id))
+            return;
+
+        AudioCommand command;
+        command.type = AudioCommand::Type::kSetVoiceVolume;
+        command.voiceId = id;
+        command.volume = volume;
+        SendCommand(command);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      A voice counts as playing until the audio thread reports that it has finished, which can be up to a frame late.
+    //		
+    ///		@brief : Returns true if the voice has not finished, whether it is real or virtual.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioManager::IsVoicePlaying(const AudioVoiceId id) const
+    {
+        return m_playingVoices.find(id) != m_playingVoices.end();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the number of real and virtual voices, and how many voices have been stolen or dropped, as of the last
+    ///             event from the audio thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    AudioVoiceStats AudioManager::GetVoiceStats() const
+    {
+        return m_voiceStats;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is where finished voices release their resources, so it needs to be called every frame. The voices themselves
+    //      are updated on the audio thread.
+    //		
+    ///		@brief : Send this frame's changes to the audio thread, and apply what it has sent back.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioManager::Update([[maybe_unused]] const float deltaTimeMs)
+    {
+        SendGroupStates();
+
+        if (m_hasPendingCommands)
         {
-            data.channel = AudioPlatform::PlayClip(resource.Get(), data.volume, pSource->IsLooping());
+            m_audioThread.Wake();
+            m_hasPendingCommands = false;
         }
 
-        // Add the data to our currently playing audio:
-        m_activeChannels.emplace_back(data);
+        ProcessEvents();
+    }
 
-        // Add the channel to the group:
-        pGroup->AddChannel(data.channel);
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The queue only fills up if the audio thread has fallen far behind, so we wake it and wait for room rather than
+    //      dropping the command.
+    //		
+    ///		@brief : Push a command to the audio thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioManager::SendCommand(const AudioCommand& command)
+    {
+        if (!m_audioThread.IsRunning())
+            return;
 
-        // Return the channel
-        return data.channel;
+        if (!m_audioThread.PushCommand(command))
+        {
+            MCP_WARN("Audio", "Audio command queue is full! Waiting for the audio thread to catch up.");
+
+            do
+            {
+                m_audioThread.Wake();
+                std::this_thread::yield();
+            } while (!m_audioThread.PushCommand(command));
+        }
+
+        m_hasPendingCommands = true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      A change to one group can change the final state of all of its children, so if any group has changed, the state of
+    //      every group is sent.
     //		
-    ///		@brief : INTERNAL FUNCTION. Called when a audio resource finishes playing on a Channel.
+    ///		@brief : Send the final state of each group to the audio thread, if any of them have changed.
     //-----------------------------------------------------------------------------------------------------------------------------
-    void AudioManager::Internal_OnChannelFinished(const AudioHardwareChannel channel)
+    void AudioManager::SendGroupStates()
     {
-        for (size_t i = 0; i < m_activeChannels.size(); ++i)
+        bool hasChanged = false;
+        for (auto&[id, pGroup] : m_audioGroups)
         {
-            const auto& data = m_activeChannels[i];
+            // Consume every flag, not just the first.
+            hasChanged |= pGroup->ConsumeChanged();
+        }
 
-            if (channel == data.channel)
-            {
-                // Remove the AudioGroups channel
-                auto* pGroup = m_audioGroups[data.groupId];
-                MCP_CHECK(pGroup);
+        if (!hasChanged)
+            return;
+
+        for (const auto&[id, pGroup] : m_audioGroups)
+        {
+            AudioCommand command;
+            command.type = AudioCommand::Type::kSetGroupState;
+            command.groupId = id;
+            command.groupState.volume = pGroup->GetVolume();
+            command.groupState.maxVoices = pGroup->GetMaxVoices();
+            command.groupState.isMuted = pGroup->IsMuted();
+            command.groupState.isPaused = pGroup->IsPaused();
+            SendCommand(command);
+        }
+    }
 
-                pGroup->RemoveChannel(channel);
+    void AudioManager::ProcessEvents()
+    {
+        AudioEvent event;
+        while (m_audioThread.PopEvent(event))
+        {
+            switch (event.type)
+            {
+                case AudioEvent::Type::kVoiceFinished:
+                    ReleaseVoice(event.voiceId);
+                    break;
 
-                // Remove this audio data:
-                std::swap(m_activeChannels[i], m_activeChannels.back());
-                m_activeChannels.pop_back();
-                return;
+                case AudioEvent::Type::kStats:
+                    m_voiceStats = event.stats;
+                    break;
             }
         }
     }
 
+    void AudioManager::ReleaseVoice(const AudioVoiceId id)
+    {
+        const auto result = m_playingVoices.find(id);
+        if (result == m_playingVoices.end())
+            return;
+
+        AudioResource::RemoveReference(result->second);
+        m_playingVoices.erase(result);
+    }
+
     AudioManager* AudioManager::AddFromData(const XMLElement element)
     {
         const auto audioElement = element.GetChildElement("Audio");
@@ -202,7 +363,51 @@ namespace mcp
             }
         }
 
-        return BLEACH_NEW(AudioManager(std::move(audioGroups)));
+        LoadDeviceSettings(audioElement);
+
+        auto* pAudioManager = BLEACH_NEW(AudioManager(std::move(audioGroups)));
+        pAudioManager->m_audioThread.LoadSettings(audioElement);
+        return pAudioManager;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Clips are converted to the device's format when they are loaded, so the resampler quality only costs load time.
+    //      Missing values keep the platform's defaults.
+    //
+    //      Ex: <Device frequency="48000" channels="2" bufferSize="1024" resamplerQuality="best"/>, inside the <Audio> element.
+    //      resamplerQuality can be "default", "fast", "medium" or "best".
+    //		
+    ///		@brief : Load the settings for the audio device, which must happen before the device is opened in Init().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioManager::LoadDeviceSettings(const XMLElement audioElement)
+    {
+        const auto deviceElement = audioElement.GetChildElement("Device");
+        if (!deviceElement.IsValid())
+            return;
+
+#if MCP_AUDIO_PLATFORM == MCP_AUDIO_PLATFORM_SDL
+        static constexpr const char* kResamplerQualityNames[] = { "default", "fast", "medium", "best" };
+
+        SDLAudioDeviceSettings settings;
+        settings.frequency = deviceElement.GetAttributeValue<int>("frequency", settings.frequency);
+        settings.channels = deviceElement.GetAttributeValue<int>("channels", settings.channels);
+        settings.bufferSize = deviceElement.GetAttributeValue<int>("bufferSize", settings.bufferSize);
+
+        const auto* pQuality = deviceElement.GetAttributeValue<const char*>("resamplerQuality", nullptr);
+        if (pQuality)
+        {
+            const auto* pEnd = std::end(kResamplerQualityNames);
+            const auto* pFound = std::find_if(std::begin(kResamplerQualityNames), pEnd, [pQuality](const char* pName) { return std::strcmp(pName, pQuality) == 0; });
+
+            if (pFound == pEnd)
+                MCP_WARN("Audio", "Unknown resamplerQuality '", pQuality, "'. Using the default resampler.");
+            else
+                settings.resamplerQuality = static_cast<int>(pFound - std::begin(kResamplerQualityNames));
+        }
+
+        AudioPlatform::SetDeviceSettings(settings);
+#endif
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -219,9 +424,11 @@ namespace mcp
 
         const auto volume = groupElement.GetAttributeValue<float>("volume", 1.f);
         const auto isMuted = groupElement.GetAttributeValue<bool>("isMuted", false);
+        const auto maxVoices = groupElement.GetAttributeValue<int>("maxVoices", 0);
 
         // Create the Group as a child of pParent
         auto* pNewGroup = BLEACH_NEW(AudioGroup(name, volume, isMuted, pParent));
+        pNewGroup->SetMaxVoices(static_cast<unsigned>(std::max(maxVoices, 0)));
 
         // Add the group to our container
         container.emplace(pNewGroup->GetId(), pNewGroup);
@@ -4,6 +4,7 @@
 #include "AudioGroup.h"
 #include "AudioClip.h"
 #include "AudioResource.h"
+#include "AudioThread.h"
 #include "AudioTrack.h"
 #include "MCP/Core/System.h"
 
@@ -11,26 +12,31 @@ namespace mcp
 {
     class AudioResource;
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Everything that plays audio runs on the AudioThread. The AudioManager turns each call into a command for it, and
+    //      applies the events that come back once per frame in Update(). Each playing voice keeps a reference to its
+    //      resource until the audio thread reports that it has finished, so a clip can't be freed while it is being mixed.
+    //
+    ///		@brief : Main thread interface to the audio thread, and owner of the AudioGroups.
+    //-----------------------------------------------------------------------------------------------------------------------------
     class AudioManager final : public System
     {
     private:
-        struct PlayingAudioData
-        {
-            AudioGroup::Id groupId = AudioGroup::kInvalidId;
-            AudioHardwareChannel channel = AudioGroup::kNoChannel;
-            float volume = 0.f;
-        };
-
         using AudioGroupContainer = std::unordered_map<AudioGroup::Id, AudioGroup*>;
-        using ActiveChannelContainer = std::vector<PlayingAudioData>;
+        using PlayingVoiceContainer = std::unordered_map<AudioVoiceId, AudioResourceRequest>;
 
     private:
         MCP_DEFINE_SYSTEM(AudioManager)
 
         static constexpr const char* kMasterVolumeName = "Master";
         AudioGroupContainer m_audioGroups;
-        ActiveChannelContainer m_activeChannels;
+        PlayingVoiceContainer m_playingVoices;  // Voices that the audio thread hasn't reported as finished.
+        AudioThread m_audioThread;
+        AudioVoiceStats m_voiceStats;           // Last stats reported by the audio thread.
+        AudioVoiceId m_nextVoiceId = kInvalidVoiceId + 1;
         bool m_isMuted = false;
+        bool m_hasPendingCommands = false;      // Whether the audio thread needs to be woken up this frame.
 
         // Private Ctor
         AudioManager(AudioGroupContainer&& audioGroups);
@@ -43,16 +49,25 @@ namespace mcp
         AudioGroup* GetGroup(const AudioGroup::Id id);
         AudioGroup* GetGroup(const char* pAudioGroupName);
         AudioGroup::Id GetGroupId(const char* pAudioGroupName);
-        AudioHardwareChannel PlayAudio(const AudioSourceComponent* pSource, const AudioResource& resource, const AudioGroup::Id groupId, const float volume);
+        AudioVoiceId PlayAudio(const AudioSourceComponent* pSource, const AudioResource& resource, const AudioGroup::Id groupId, const float volume);
+        void StopVoice(const AudioVoiceId id);
+        void SetVoiceVolume(const AudioVoiceId id, const float volume);
+        [[nodiscard]] bool IsVoicePlaying(const AudioVoiceId id) const;
+        [[nodiscard]] AudioVoiceStats GetVoiceStats() const;
 
-        // Internal:
-        void Internal_OnChannelFinished(const AudioHardwareChannel channel);
+        void Update(const float deltaTimeMs);
 
         static AudioManager* Get();
         static AudioManager* AddFromData(const XMLElement);
 
     private:
         static void CreateChildAudioGroupFromData(AudioGroupContainer& container, AudioGroup* pParent, const XMLElement groupElement);
+        static void LoadDeviceSettings(const XMLElement audioElement);
+
+        void SendCommand(const AudioCommand& command);
+        void SendGroupStates();
+        void ProcessEvents();
+        void ReleaseVoice(const AudioVoiceId id);
 
         virtual bool Init() override;
         virtual void Close() override;
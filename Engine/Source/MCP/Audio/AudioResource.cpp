@@ -2,12 +2,47 @@
 
 #include "AudioResource.h"
 
+#include "MCP/Core/Resource/PreloadManifest.h"
 #include "MCP/Core/Resource/ResourceManager.h"
 
 namespace mcp
 {
+    // Music is streamed from its package entry while it plays, and clips are decoded straight from theirs.
+    template<> struct StreamsFromPackage<AudioResourceData> : std::true_type {};
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The load holds a reference until it is released with ResourceManager::ReleaseLoad().
+    //
+    ///		@brief : Start loading an audio resource in the background, without keeping a handle to it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceLoadHandle AudioResource::Preload(const AudioResourceRequest& request)
+    {
+        return ResourceManager::Get()->LoadAsync<AudioResourceData>(request, LoadPriority::kBackground);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Used by things that need a resource to outlive the AudioResource that loaded it, like a playing voice. The resource
+    //      must already be loaded.
+    //
+    ///		@brief : Add a reference to a loaded audio resource. Release it with RemoveReference().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioResource::AddReference(const AudioResourceRequest& request)
+    {
+        ResourceManager::Get()->LoadFromDisk<AudioResourceData>(request);
+    }
+
+    void AudioResource::RemoveReference(const AudioResourceRequest& request)
+    {
+        ResourceManager::Get()->FreeResource<AudioResourceData>(request);
+    }
+
     void* AudioResource::LoadResourceType()
     {
+        // Audio resources are requested with the path as it was written in the scene data.
+        PreloadManifest::Record(PreloadAssetType::kAudioResource, m_request.path.GetCStr()
+            , m_request.packagePath.IsValid() ? m_request.packagePath.GetCStr() : nullptr, m_request.isMusicResource ? 1 : 0);
         return ResourceManager::Get()->LoadFromDisk<AudioResourceData>(m_request);
     }
 
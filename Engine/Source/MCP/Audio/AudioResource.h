@@ -2,6 +2,7 @@
 // AudioResource.h
 
 #include "MCP/Core/Resource/Resource.h"
+#include "MCP/Core/Resource/ResourceLoadHandle.h"
 #include "MCP/Core/Config.h"
 
 namespace mcp
@@ -12,7 +13,7 @@ namespace mcp
 
         uint64_t operator()(const DiskResourceRequest& request) const
         {
-            return std::hash<const void*>{}(request.path.GetConstPtr());
+            return request.path.GetHash();
         }
 
         bool operator==(const DiskResourceRequest& right) const
@@ -35,6 +36,10 @@ namespace mcp
         [[nodiscard]] virtual void* Get() const override;
         [[nodiscard]] bool IsMusicResource() const;
 
+        static ResourceLoadHandle Preload(const AudioResourceRequest& request);
+        static void AddReference(const AudioResourceRequest& request);
+        static void RemoveReference(const AudioResourceRequest& request);
+
     protected:
         virtual void Free() override;
         virtual void* LoadResourceType() override;
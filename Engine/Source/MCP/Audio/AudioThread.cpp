@@ -0,0 +1,331 @@
+// AudioThread.cpp
+
+#include "AudioThread.h"
+
+#include <algorithm>
+#include <BleachNew.h>
+#include <chrono>
+#include "MCP/Debug/Log.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+#if MCP_AUDIO_PLATFORM == MCP_AUDIO_PLATFORM_SDL
+// Disable SDL Warnings.
+#pragma warning(push, 0)
+#include "Platform/SDL2/SDLAudio.h"
+#pragma warning(pop)
+using AudioPlatform = SDLAudioManager;
+#endif
+
+namespace mcp
+{
+    AudioThread::~AudioThread()
+    {
+        Stop();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Call this before Start(). Missing values keep their defaults. Queue capacities are rounded up to a power of 2.
+    //
+    ///		@brief : Load the thread settings from the 'AudioThread' element, and the voice settings, from the Audio element.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::LoadSettings(const XMLElement audioElement)
+    {
+        m_voiceManager.LoadSettings(audioElement);
+
+        const auto threadElement = audioElement.GetChildElement("AudioThread");
+        if (!threadElement.IsValid())
+            return;
+
+        const auto roundUpToPowerOf2 = [](const int value) -> size_t
+        {
+            size_t result = 2;
+            while (result < static_cast<size_t>(std::max(value, 2)))
+                result <<= 1;
+
+            return result;
+        };
+
+        m_updateIntervalMs = std::max(threadElement.GetAttributeValue<float>("updateIntervalMs", kDefaultUpdateIntervalMs), 1.f);
+        m_commandCapacity = roundUpToPowerOf2(threadElement.GetAttributeValue<int>("commandCapacity", static_cast<int>(kDefaultQueueCapacity)));
+        m_eventCapacity = roundUpToPowerOf2(threadElement.GetAttributeValue<int>("eventCapacity", static_cast<int>(kDefaultQueueCapacity)));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The audio platform must already be initialized. The voices' channels are allocated here, before the thread starts,
+    //      so a failure can be reported to the caller.
+    //
+    ///		@brief : Start the audio thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioThread::Start()
+    {
+        if (m_isRunning)
+            return true;
+
+        if (!m_voiceManager.Init())
+            return false;
+
+        m_pCommands = BLEACH_NEW(SpscQueue<AudioCommand>(m_commandCapacity));
+        m_pEvents = BLEACH_NEW(SpscQueue<AudioEvent>(m_eventCapacity));
+
+        m_isRunning = true;
+        m_thread = std::thread(&AudioThread::Run, this);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Any commands still in the queue are dropped, and no more events are sent. The caller is responsible for anything
+    //      that it was holding on to for voices that were still playing.
+    //
+    ///		@brief : Stop the audio thread, and every voice and the music that it was playing.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::Stop()
+    {
+        if (!m_thread.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_wakeMutex);
+            m_isRunning = false;
+        }
+
+        m_wakeCondition.notify_one();
+        m_thread.join();
+
+        // The thread is gone, so we own the audio platform again.
+        m_voiceManager.Close();
+        StopMusic();
+        m_voiceManager.GetFinishedVoices().clear();
+        m_unsentEvents.clear();
+
+        BLEACH_DELETE(m_pCommands);
+        BLEACH_DELETE(m_pEvents);
+        m_pCommands = nullptr;
+        m_pEvents = nullptr;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Main thread only. The audio thread doesn't see the command until its next update, or until Wake() is called.
+    //
+    ///		@brief : Send a command to the audio thread.
+    ///		@returns : False if the thread isn't running, or the command queue is full.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioThread::PushCommand(const AudioCommand& command)
+    {
+        if (!m_pCommands)
+            return false;
+
+        return m_pCommands->TryPush(command);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Main thread only. Get the next event from the audio thread.
+    ///		@returns : False if there are no events waiting.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioThread::PopEvent(AudioEvent& eventOut)
+    {
+        if (!m_pEvents)
+            return false;
+
+        return m_pEvents->TryPop(eventOut);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Wake the audio thread so that it handles the commands that were pushed, without waiting for its next update.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::Wake()
+    {
+        {
+            std::lock_guard lock(m_wakeMutex);
+            m_wakeRequested = true;
+        }
+
+        m_wakeCondition.notify_one();
+    }
+
+    void AudioThread::Run()
+    {
+        const auto updateInterval = std::chrono::duration<float, std::milli>(m_updateIntervalMs);
+
+        HighPrecisionTimer timer;
+        timer.Start();
+        double lastUpdateTime = 0.0;
+
+        while (m_isRunning)
+        {
+            AudioCommand command;
+            while (m_pCommands->TryPop(command))
+            {
+                ProcessCommand(command);
+            }
+
+            const double now = timer.GetTimer();
+            m_voiceManager.Update(static_cast<float>(now - lastUpdateTime));
+            lastUpdateTime = now;
+
+            UpdateMusic();
+            SendEvents();
+
+            std::unique_lock lock(m_wakeMutex);
+            m_wakeCondition.wait_for(lock, updateInterval, [this]() -> bool { return m_wakeRequested || !m_isRunning; });
+            m_wakeRequested = false;
+        }
+    }
+
+    void AudioThread::ProcessCommand(const AudioCommand& command)
+    {
+        switch (command.type)
+        {
+            case AudioCommand::Type::kPlayClip:
+                m_voiceManager.Play(command.voiceId, command.pResource, command.groupId, command.volume, command.priority, command.isLooping);
+                break;
+
+            case AudioCommand::Type::kPlayMusic:
+                PlayMusic(command);
+                break;
+
+            case AudioCommand::Type::kStopVoice:
+                if (command.voiceId == m_music.voiceId)
+                    StopMusic();
+                else
+                    m_voiceManager.Stop(command.voiceId);
+                break;
+
+            case AudioCommand::Type::kSetVoiceVolume:
+                if (command.voiceId == m_music.voiceId)
+                    m_music.volume = std::clamp(command.volume, 0.f, 1.f);
+                else
+                    m_voiceManager.SetVolume(command.voiceId, command.volume);
+                break;
+
+            case AudioCommand::Type::kSetGroupState:
+                m_voiceManager.SetGroupState(command.groupId, command.groupState);
+                break;
+
+            case AudioCommand::Type::kMute:
+                m_voiceManager.SetMuted(true);
+                break;
+
+            case AudioCommand::Type::kUnMute:
+                m_voiceManager.SetMuted(false);
+                break;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      There is only one music channel, so new music replaces whatever music was playing.
+    //
+    ///		@brief : Start playing a music track.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::PlayMusic(const AudioCommand& command)
+    {
+        StopMusic();
+
+        const auto channel = AudioPlatform::PlayMusic(command.pResource, 0.f, command.isLooping);
+        if (channel == AudioGroup::kNoChannel)
+        {
+            MCP_ERROR("Audio", "Failed to play music!");
+            SendEvent({ AudioEvent::Type::kVoiceFinished, command.voiceId, {} });
+            return;
+        }
+
+        m_music.voiceId = command.voiceId;
+        m_music.groupId = command.groupId;
+        m_music.channel = channel;
+        m_music.volume = std::clamp(command.volume, 0.f, 1.f);
+        m_music.appliedVolume = -1.f;
+        m_music.isPaused = false;
+
+        UpdateMusic();
+    }
+
+    void AudioThread::StopMusic()
+    {
+        if (m_music.voiceId == kInvalidVoiceId)
+            return;
+
+        AudioPlatform::StopMusic();
+
+        // Once the thread has stopped, there is no one to send the event to.
+        if (m_isRunning)
+            SendEvent({ AudioEvent::Type::kVoiceFinished, m_music.voiceId, {} });
+
+        m_music = MusicState{};
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Apply the music's group to the music channel, and report the music once it finishes.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::UpdateMusic()
+    {
+        if (m_music.voiceId == kInvalidVoiceId)
+            return;
+
+        if (AudioPlatform::ConsumeMusicFinished())
+        {
+            SendEvent({ AudioEvent::Type::kVoiceFinished, m_music.voiceId, {} });
+            m_music = MusicState{};
+            return;
+        }
+
+        const auto& group = m_voiceManager.GetGroupState(m_music.groupId);
+
+        if (group.isPaused != m_music.isPaused)
+        {
+            if (group.isPaused)
+                AudioPlatform::PauseChannel(m_music.channel);
+            else
+                AudioPlatform::ResumeChannel(m_music.channel);
+
+            m_music.isPaused = group.isPaused;
+        }
+
+        const float volume = (m_voiceManager.IsMuted() || group.isMuted) ? 0.f : m_music.volume * group.volume;
+        if (volume != m_music.appliedVolume)
+        {
+            AudioPlatform::UnMuteChannel(m_music.channel, volume);
+            m_music.appliedVolume = volume;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Send the voices that finished since the last update, and the stats if they changed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioThread::SendEvents()
+    {
+        auto& finishedVoices = m_voiceManager.GetFinishedVoices();
+        for (const auto id : finishedVoices)
+        {
+            SendEvent({ AudioEvent::Type::kVoiceFinished, id, {} });
+        }
+
+        finishedVoices.clear();
+
+        const auto stats = m_voiceManager.GetStats();
+        if (stats != m_lastSentStats)
+        {
+            SendEvent({ AudioEvent::Type::kStats, kInvalidVoiceId, stats });
+            m_lastSentStats = stats;
+        }
+
+        // Retry anything that didn't fit last time, in order.
+        size_t sentCount = 0;
+        while (sentCount < m_unsentEvents.size() && m_pEvents->TryPush(m_unsentEvents[sentCount]))
+        {
+            ++sentCount;
+        }
+
+        m_unsentEvents.erase(m_unsentEvents.begin(), m_unsentEvents.begin() + static_cast<std::ptrdiff_t>(sentCount));
+    }
+
+    void AudioThread::SendEvent(const AudioEvent& event)
+    {
+        // Events have to stay in order, so once one is waiting, everything after it waits too.
+        if (!m_unsentEvents.empty() || !m_pEvents->TryPush(event))
+            m_unsentEvents.emplace_back(event);
+    }
+}
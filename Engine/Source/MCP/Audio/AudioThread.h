@@ -0,0 +1,130 @@
+#pragma once
+// AudioThread.h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "AudioVoiceManager.h"
+#include "Utility/Thread/SpscQueue.h"
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : A request from the main thread to the audio thread. Only the fields that the type uses are set.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct AudioCommand
+    {
+        enum class Type : uint8_t
+        {
+            kPlayClip,          // voiceId, groupId, pResource, volume, priority, isLooping
+            kPlayMusic,         // voiceId, groupId, pResource, volume, isLooping
+            kStopVoice,         // voiceId
+            kSetVoiceVolume,    // voiceId, volume
+            kSetGroupState,     // groupId, groupState
+            kMute,
+            kUnMute,
+        };
+
+        Type type = Type::kStopVoice;
+        AudioVoiceId voiceId = kInvalidVoiceId;
+        AudioGroup::Id groupId = AudioGroup::kInvalidId;
+        void* pResource = nullptr;
+        float volume = 1.f;
+        int priority = AudioVoiceManager::kDefaultPriority;
+        bool isLooping = false;
+        AudioGroupState groupState;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : A status update from the audio thread to the main thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct AudioEvent
+    {
+        enum class Type : uint8_t
+        {
+            kVoiceFinished,     // voiceId. The voice's resource is no longer used by the audio thread.
+            kStats,             // stats. Only sent when they change.
+        };
+
+        Type type = Type::kVoiceFinished;
+        AudioVoiceId voiceId = kInvalidVoiceId;
+        AudioVoiceStats stats;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The audio thread owns the AudioVoiceManager and every call into the audio platform after Start(). The main thread
+    //      talks to it through two lock-free queues: commands go in with PushCommand(), and events come back out with
+    //      PopEvent(). Each queue has exactly one producer and one consumer, so an audio call on the main thread costs one push.
+    //
+    //      The thread wakes every update interval to move its voices forward, and when the main thread calls Wake() after
+    //      pushing commands. If the event queue is full, events are held on the audio thread and sent on a later update.
+    //
+    //      Ex: <AudioThread updateIntervalMs="5" commandCapacity="1024" eventCapacity="1024"/>, inside the <Audio> element of
+    //      the project settings.
+    //
+    ///		@brief : Runs the mixer and the voices on their own thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class AudioThread
+    {
+        static constexpr size_t kDefaultQueueCapacity = 1024;
+        static constexpr float kDefaultUpdateIntervalMs = 5.f;
+
+        struct MusicState
+        {
+            AudioVoiceId voiceId = kInvalidVoiceId;
+            AudioGroup::Id groupId = AudioGroup::kInvalidId;
+            AudioHardwareChannel channel = AudioGroup::kNoChannel;
+            float volume = 1.f;
+            float appliedVolume = -1.f;
+            bool isPaused = false;
+        };
+
+        SpscQueue<AudioCommand>* m_pCommands = nullptr;    // Main thread -> Audio thread.
+        SpscQueue<AudioEvent>* m_pEvents = nullptr;        // Audio thread -> Main thread.
+        AudioVoiceManager m_voiceManager;
+        MusicState m_music;
+        std::vector<AudioEvent> m_unsentEvents;             // Events that didn't fit in the event queue.
+        AudioVoiceStats m_lastSentStats;
+        std::thread m_thread;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic_bool m_isRunning = false;
+        bool m_wakeRequested = false;                       // Guarded by m_wakeMutex.
+        size_t m_commandCapacity = kDefaultQueueCapacity;
+        size_t m_eventCapacity = kDefaultQueueCapacity;
+        float m_updateIntervalMs = kDefaultUpdateIntervalMs;
+
+    public:
+        AudioThread() = default;
+        ~AudioThread();
+
+        AudioThread(const AudioThread&) = delete;
+        AudioThread(AudioThread&&) noexcept = delete;
+        AudioThread& operator=(const AudioThread&) = delete;
+        AudioThread& operator=(AudioThread&&) noexcept = delete;
+
+        void LoadSettings(const XMLElement audioElement);
+        bool Start();
+        void Stop();
+
+        // Main thread:
+        bool PushCommand(const AudioCommand& command);
+        bool PopEvent(AudioEvent& eventOut);
+        void Wake();
+
+        [[nodiscard]] bool IsRunning() const { return m_isRunning; }
+
+    private:
+        void Run();
+        void ProcessCommand(const AudioCommand& command);
+        void PlayMusic(const AudioCommand& command);
+        void StopMusic();
+        void UpdateMusic();
+        void SendEvents();
+        void SendEvent(const AudioEvent& event);
+    };
+}
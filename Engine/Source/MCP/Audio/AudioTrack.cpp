@@ -2,6 +2,7 @@
 
 #include "AudioTrack.h"
 
+#include "MCP/Core/Resource/PreloadManifest.h"
 #include "MCP/Core/Resource/ResourceManager.h"
 
 using KeyType = const char*;
@@ -12,6 +13,9 @@ struct _Mix_Music;
 namespace mcp
 {
     using AudioTrackType = _Mix_Music;
+
+    // Music is streamed from its package entry while it plays.
+    template<> struct StreamsFromPackage<AudioTrackType> : std::true_type {};
 }
 #else
 #error "We don't have a resource implementation for Texture loading for current API!'"
@@ -19,8 +23,20 @@ namespace mcp
 
 namespace mcp
 {
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The load holds a reference until it is released with ResourceManager::ReleaseLoad().
+    //
+    ///		@brief : Start loading an audio track in the background, without keeping a handle to it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceLoadHandle AudioTrack::Preload(const DiskResourceRequest& request)
+    {
+        return ResourceManager::Get()->LoadAsync<AudioTrackType>(request, LoadPriority::kBackground);
+    }
+
     void* AudioTrack::LoadResourceType()
     {
+        PreloadManifest::Record(PreloadAssetType::kAudioTrack, m_request);
         return ResourceManager::Get()->LoadFromDisk<AudioTrackType>(m_request);
     }
 
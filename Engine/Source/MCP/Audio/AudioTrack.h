@@ -2,6 +2,7 @@
 // AudioTrack.h
 
 #include "MCP/Core/Resource/Resource.h"
+#include "MCP/Core/Resource/ResourceLoadHandle.h"
 
 namespace mcp
 {
@@ -10,6 +11,8 @@ namespace mcp
     public:
         MCP_DEFINE_RESOURCE_DESTRUCTOR(AudioTrack)
 
+        static ResourceLoadHandle Preload(const DiskResourceRequest& request);
+
     protected:
         virtual void* LoadResourceType() override;
         virtual void Free() override;
@@ -0,0 +1,411 @@
+// AudioVoiceManager.cpp
+
+#include "AudioVoiceManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include "MCP/Debug/Log.h"
+
+#if MCP_AUDIO_PLATFORM == MCP_AUDIO_PLATFORM_SDL
+// Disable SDL Warnings.
+#pragma warning(push, 0)
+#include "Platform/SDL2/SDLAudio.h"
+#pragma warning(pop)
+using AudioPlatform = SDLAudioManager;
+#endif
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Call this before Init(). Missing values keep their defaults.
+    //
+    ///		@brief : Load the voice settings from the 'Voices' element in the Audio element of the project settings.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioVoiceManager::LoadSettings(const XMLElement audioElement)
+    {
+        const auto voicesElement = audioElement.GetChildElement("Voices");
+        if (!voicesElement.IsValid())
+            return;
+
+        m_maxRealVoices = std::max(voicesElement.GetAttributeValue<int>("maxRealVoices", kDefaultMaxRealVoices), 1);
+        m_minAudibleVolume = std::clamp(voicesElement.GetAttributeValue<float>("minAudibleVolume", kDefaultMinAudibleVolume), 0.f, 1.f);
+    }
+
+    bool AudioVoiceManager::Init()
+    {
+        const int channelCount = AudioPlatform::AllocateChannels(m_maxRealVoices);
+        if (channelCount <= 0)
+        {
+            MCP_ERROR("Audio", "Failed to allocate any channels for voices!");
+            return false;
+        }
+
+        if (channelCount != m_maxRealVoices)
+            MCP_WARN("Audio", "Requested ", m_maxRealVoices, " channels for voices, but only got ", channelCount);
+
+        // Hand out the lowest channels first.
+        m_freeChannels.clear();
+        for (int channel = channelCount - 1; channel >= 0; --channel)
+        {
+            m_freeChannels.emplace_back(channel);
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The stopped voices are added to the finished list, like any other voice that ends.
+    //
+    ///		@brief : Stop every voice.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioVoiceManager::Close()
+    {
+        while (!m_voices.empty())
+        {
+            RemoveVoice(m_voices.size() - 1);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Called once per frame. Virtual voices are moved forward in time, voices that have finished are removed, and then
+    //      the most important audible voices are given the hardware channels.
+    //
+    ///		@brief : Update every voice.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioVoiceManager::Update(const float deltaTimeMs)
+    {
+        const float deltaTime = deltaTimeMs / 1000.f;
+
+        for (size_t i = 0; i < m_voices.size();)
+        {
+            auto& voice = m_voices[i];
+
+            if (voice.IsReal() && AudioPlatform::ConsumeChannelFinished(voice.channel))
+            {
+                // If we resumed partway through a looping clip, we have reached the end of it, so start the loop proper.
+                if (voice.isPlayingTail && voice.isLooping)
+                {
+                    voice.isPlayingTail = false;
+                    voice.position = 0.f;
+
+                    if (AudioPlatform::PlayClipOnChannel(voice.pClip, voice.channel, voice.audibleVolume, 0.f, true))
+                    {
+                        ++i;
+                        continue;
+                    }
+                }
+
+                RemoveVoice(i);
+                continue;
+            }
+
+            if (!voice.pGroup->isPaused)
+            {
+                voice.position += deltaTime;
+
+                if (voice.position >= voice.length)
+                {
+                    if (voice.isLooping)
+                    {
+                        voice.position = voice.length > 0.f ? std::fmod(voice.position, voice.length) : 0.f;
+                    }
+
+                    // Real voices are finished when their channel says so. Virtual voices have nothing else to wait on.
+                    else if (!voice.IsReal())
+                    {
+                        RemoveVoice(i);
+                        continue;
+                    }
+
+                    else
+                    {
+                        voice.position = voice.length;
+                    }
+                }
+            }
+
+            UpdateAudibleVolume(voice);
+
+            if (voice.IsReal())
+            {
+                // Cull voices that can't be heard anymore.
+                if (voice.audibleVolume < m_minAudibleVolume)
+                {
+                    m_freeChannels.emplace_back(MakeVirtual(voice));
+                }
+
+                else if (voice.audibleVolume != voice.appliedVolume)
+                {
+                    AudioPlatform::SetChannelVolume(voice.channel, voice.audibleVolume);
+                    voice.appliedVolume = voice.audibleVolume;
+                }
+            }
+
+            ++i;
+        }
+
+        // Give the channels to the most important virtual voices that can be heard.
+        std::vector<Voice*> candidates;
+        for (auto& voice : m_voices)
+        {
+            if (!voice.IsReal() && voice.audibleVolume >= m_minAudibleVolume && !voice.pGroup->isPaused)
+                candidates.emplace_back(&voice);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Voice* pLeft, const Voice* pRight) { return IsMoreImportant(*pLeft, *pRight); });
+
+        for (auto* pVoice : candidates)
+        {
+            // The candidates are sorted, so once one can't get a channel, none of the rest can either.
+            if (!TryMakeReal(*pVoice))
+                break;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If there isn't a free channel, the voice takes the channel of a less important voice, or starts out virtual.
+    //
+    ///		@brief : Play a clip. If the clip fails to play, or its group was full, the voice is finished right away.
+    ///		@param id : Id for the new voice, given out by the main thread.
+    ///		@param pClip : The clip to play. It must stay loaded until the voice has finished.
+    ///		@param groupId : The group that the voice plays in.
+    ///		@param volume : Volume of the voice, from [0, 1]. The group's volume is applied on top of this.
+    ///		@param priority : Higher priority voices take channels from lower priority voices.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioVoiceManager::Play(const AudioVoiceId id, void* pClip, const AudioGroup::Id groupId, const float volume, const int priority, const bool isLooping)
+    {
+        auto* pGroup = &m_groups[groupId];
+
+        Voice voice;
+        voice.id = id;
+        voice.pClip = pClip;
+        voice.pGroup = pGroup;
+        voice.priority = priority;
+        voice.volume = std::clamp(volume, 0.f, 1.f);
+        voice.length = AudioPlatform::GetClipLength(voice.pClip);
+        voice.isLooping = isLooping;
+        UpdateAudibleVolume(voice);
+
+        if (voice.length <= 0.f)
+        {
+            m_finishedVoices.emplace_back(id);
+            return;
+        }
+
+        // Make room in the group, if it is full.
+        if (pGroup->maxVoices > 0 && GetVoiceCount(pGroup) >= pGroup->maxVoices)
+        {
+            auto* pLeastImportant = FindLeastImportantVoice(pGroup, false);
+            if (!pLeastImportant || !IsMoreImportant(voice, *pLeastImportant))
+            {
+                ++m_stats.rejectedVoiceCount;
+                m_finishedVoices.emplace_back(id);
+                return;
+            }
+
+            ++m_stats.stolenVoiceCount;
+            RemoveVoice(static_cast<size_t>(pLeastImportant - m_voices.data()));
+        }
+
+        auto& addedVoice = m_voices.emplace_back(voice);
+        if (addedVoice.audibleVolume >= m_minAudibleVolume && !pGroup->isPaused)
+            TryMakeReal(addedVoice);
+    }
+
+    void AudioVoiceManager::Stop(const AudioVoiceId id)
+    {
+        auto* pVoice = FindVoice(id);
+        if (!pVoice)
+            return;
+
+        RemoveVoice(static_cast<size_t>(pVoice - m_voices.data()));
+    }
+
+    void AudioVoiceManager::SetVolume(const AudioVoiceId id, const float volume)
+    {
+        auto* pVoice = FindVoice(id);
+        if (!pVoice)
+            return;
+
+        // The channel's volume is updated with the next Update().
+        pVoice->volume = std::clamp(volume, 0.f, 1.f);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Volume and mute changes are picked up by the next Update(). Pausing has to happen right away, since paused voices
+    //      stop moving forward in time.
+    //
+    ///		@brief : Set the final state of a group.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AudioVoiceManager::SetGroupState(const AudioGroup::Id groupId, const AudioGroupState& state)
+    {
+        auto& group = m_groups[groupId];
+
+        if (group.isPaused != state.isPaused)
+        {
+            for (const auto& voice : m_voices)
+            {
+                if (voice.pGroup != &group || !voice.IsReal())
+                    continue;
+
+                if (state.isPaused)
+                    AudioPlatform::PauseChannel(voice.channel);
+                else
+                    AudioPlatform::ResumeChannel(voice.channel);
+            }
+        }
+
+        group = state;
+    }
+
+    const AudioGroupState& AudioVoiceManager::GetGroupState(const AudioGroup::Id groupId)
+    {
+        return m_groups[groupId];
+    }
+
+    AudioVoiceStats AudioVoiceManager::GetStats() const
+    {
+        AudioVoiceStats stats = m_stats;
+
+        for (const auto& voice : m_voices)
+        {
+            if (voice.IsReal())
+                ++stats.realVoiceCount;
+            else
+                ++stats.virtualVoiceCount;
+        }
+
+        return stats;
+    }
+
+    AudioVoiceManager::Voice* AudioVoiceManager::FindVoice(const AudioVoiceId id)
+    {
+        for (auto& voice : m_voices)
+        {
+            if (voice.id == id)
+                return &voice;
+        }
+
+        return nullptr;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Find the least important voice.
+    ///		@param pGroup : If not null, only voices in this group are considered.
+    ///		@param realOnly : If true, only real voices are considered.
+    ///		@returns : nullptr if there are no voices to consider.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    AudioVoiceManager::Voice* AudioVoiceManager::FindLeastImportantVoice(const AudioGroupState* pGroup, const bool realOnly)
+    {
+        Voice* pLeastImportant = nullptr;
+
+        for (auto& voice : m_voices)
+        {
+            if ((pGroup && voice.pGroup != pGroup) || (realOnly && !voice.IsReal()))
+                continue;
+
+            if (!pLeastImportant || IsMoreImportant(*pLeastImportant, voice))
+                pLeastImportant = &voice;
+        }
+
+        return pLeastImportant;
+    }
+
+    void AudioVoiceManager::UpdateAudibleVolume(Voice& voice) const
+    {
+        voice.audibleVolume = (m_isMuted || voice.pGroup->isMuted) ? 0.f : voice.volume * voice.pGroup->volume;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The voice must be virtual. If there are no free channels, the least important real voice gives up its channel, as
+    //      long as it is less important than this voice.
+    //
+    ///		@brief : Try to give a voice a hardware channel.
+    ///		@returns : False if the voice is still virtual.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioVoiceManager::TryMakeReal(Voice& voice)
+    {
+        if (!m_freeChannels.empty())
+        {
+            const AudioHardwareChannel channel = m_freeChannels.back();
+            m_freeChannels.pop_back();
+
+            if (MakeReal(voice, channel))
+                return true;
+
+            m_freeChannels.emplace_back(channel);
+            return false;
+        }
+
+        auto* pLeastImportant = FindLeastImportantVoice(nullptr, true);
+        if (!pLeastImportant || !IsMoreImportant(voice, *pLeastImportant))
+            return false;
+
+        const AudioHardwareChannel channel = MakeVirtual(*pLeastImportant);
+        if (MakeReal(voice, channel))
+            return true;
+
+        m_freeChannels.emplace_back(channel);
+        return false;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Start playing a virtual voice on a free channel, from where it would be in its clip.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AudioVoiceManager::MakeReal(Voice& voice, const AudioHardwareChannel channel)
+    {
+        if (!AudioPlatform::PlayClipOnChannel(voice.pClip, channel, voice.audibleVolume, voice.position, voice.isLooping))
+            return false;
+
+        voice.channel = channel;
+        voice.appliedVolume = voice.audibleVolume;
+        voice.isPlayingTail = voice.position > 0.f;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Stop playing a real voice, and keep tracking it virtually.
+    ///		@returns : The channel that the voice was using, which the caller now owns.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    AudioHardwareChannel AudioVoiceManager::MakeVirtual(Voice& voice)
+    {
+        const AudioHardwareChannel channel = voice.channel;
+
+        AudioPlatform::StopChannel(channel);
+        voice.channel = AudioGroup::kNoChannel;
+        voice.isPlayingTail = false;
+        return channel;
+    }
+
+    void AudioVoiceManager::RemoveVoice(const size_t index)
+    {
+        auto& voice = m_voices[index];
+
+        if (voice.IsReal())
+            m_freeChannels.emplace_back(MakeVirtual(voice));
+
+        m_finishedVoices.emplace_back(voice.id);
+
+        std::swap(m_voices[index], m_voices.back());
+        m_voices.pop_back();
+    }
+
+    size_t AudioVoiceManager::GetVoiceCount(const AudioGroupState* pGroup) const
+    {
+        return static_cast<size_t>(std::count_if(m_voices.begin(), m_voices.end(), [pGroup](const Voice& voice) { return voice.pGroup == pGroup; }));
+    }
+
+    bool AudioVoiceManager::IsMoreImportant(const Voice& left, const Voice& right)
+    {
+        if (left.priority != right.priority)
+            return left.priority > right.priority;
+
+        return left.audibleVolume > right.audibleVolume;
+    }
+}
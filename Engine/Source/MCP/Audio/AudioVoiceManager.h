@@ -0,0 +1,131 @@
+#pragma once
+// AudioVoiceManager.h
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "AudioGroup.h"
+#include "MCP/Core/Resource/Parsers/XMLParser.h"
+
+namespace mcp
+{
+    // Handle to a playing clip. Ids are never reused, so a stale id is simply not found.
+    using AudioVoiceId = uint32_t;
+    static constexpr AudioVoiceId kInvalidVoiceId = 0;
+
+    struct AudioVoiceStats
+    {
+        uint32_t realVoiceCount = 0;        // Voices that are playing on a hardware channel.
+        uint32_t virtualVoiceCount = 0;     // Voices that are only tracking their position.
+        uint32_t stolenVoiceCount = 0;      // Total voices that were stopped to make room in their group.
+        uint32_t rejectedVoiceCount = 0;    // Total play requests that were dropped because their group was full.
+
+        bool operator==(const AudioVoiceStats& right) const
+        {
+            return realVoiceCount == right.realVoiceCount && virtualVoiceCount == right.virtualVoiceCount
+                && stolenVoiceCount == right.stolenVoiceCount && rejectedVoiceCount == right.rejectedVoiceCount;
+        }
+
+        bool operator!=(const AudioVoiceStats& right) const { return !(*this == right); }
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : The final state of an AudioGroup, with its parents applied, as it is seen by the audio thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct AudioGroupState
+    {
+        float volume = 1.f;
+        unsigned maxVoices = 0;
+        bool isMuted = false;
+        bool isPaused = false;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every clip that is played gets a voice, but only the most important audible voices get one of the hardware channels.
+    //      The rest are virtual: they keep track of where they would be in the clip, and start playing from there once a
+    //      channel is free and they are important enough to have it. A voice is more important than another if it has a higher
+    //      priority, or the same priority and a louder volume. Voices that are quieter than the minimum audible volume (or that
+    //      are in a muted group) are always virtual.
+    //
+    //      Each AudioGroup can also limit how many voices it has at once, real or virtual. When a group is full, a new voice
+    //      replaces the least important voice in the group, or is dropped if it isn't more important than any of them.
+    //
+    //      This is owned by the AudioThread, and must only be used on the audio thread. It never sees the AudioGroups
+    //      themselves, only the AudioGroupStates that the AudioManager sends over. Voices that end (or never got to start)
+    //      are added to the finished list, which the AudioThread reports back to the main thread. Music has its own
+    //      channel and is not managed here.
+    //
+    //      Ex: <Voices maxRealVoices="32" minAudibleVolume="0.01"/>, inside the <Audio> element of the project settings.
+    //
+    ///		@brief : Shares the hardware channels between every clip that is playing.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class AudioVoiceManager
+    {
+    public:
+        static constexpr int kDefaultPriority = 128;
+
+    private:
+        struct Voice
+        {
+            void* pClip = nullptr;
+            AudioGroupState* pGroup = nullptr;
+            AudioVoiceId id = kInvalidVoiceId;
+            AudioHardwareChannel channel = AudioGroup::kNoChannel;
+            int priority = kDefaultPriority;
+            float volume = 0.f;                 // Volume of the source, before the group's volume.
+            float audibleVolume = 0.f;          // Final volume, after the group's volume and mute.
+            float appliedVolume = -1.f;         // Last volume set on the hardware channel.
+            float position = 0.f;               // Seconds into the clip.
+            float length = 0.f;                 // Length of the clip, in seconds.
+            bool isLooping = false;
+            bool isPlayingTail = false;         // We resumed partway through a looping clip, and have to restart it at the end.
+
+            [[nodiscard]] bool IsReal() const { return channel != AudioGroup::kNoChannel; }
+        };
+
+        static constexpr int kDefaultMaxRealVoices = 32;
+        static constexpr float kDefaultMinAudibleVolume = 0.01f;
+
+        std::vector<Voice> m_voices;
+        std::vector<AudioHardwareChannel> m_freeChannels;
+        std::vector<AudioVoiceId> m_finishedVoices;
+        std::unordered_map<AudioGroup::Id, AudioGroupState> m_groups;
+        AudioVoiceStats m_stats;
+        int m_maxRealVoices = kDefaultMaxRealVoices;
+        float m_minAudibleVolume = kDefaultMinAudibleVolume;
+        bool m_isMuted = false;
+
+    public:
+        void LoadSettings(const XMLElement audioElement);
+        bool Init();
+        void Close();
+        void Update(const float deltaTimeMs);
+
+        void Play(const AudioVoiceId id, void* pClip, const AudioGroup::Id groupId, const float volume, const int priority, const bool isLooping);
+        void Stop(const AudioVoiceId id);
+        void SetVolume(const AudioVoiceId id, const float volume);
+        void SetGroupState(const AudioGroup::Id groupId, const AudioGroupState& state);
+        void SetMuted(const bool isMuted) { m_isMuted = isMuted; }
+
+        [[nodiscard]] const AudioGroupState& GetGroupState(const AudioGroup::Id groupId);
+        [[nodiscard]] AudioVoiceStats GetStats() const;
+        [[nodiscard]] bool IsMuted() const { return m_isMuted; }
+
+        // Voices that have ended since the list was last cleared. The caller clears it once they have been reported.
+        std::vector<AudioVoiceId>& GetFinishedVoices() { return m_finishedVoices; }
+
+    private:
+        Voice* FindVoice(const AudioVoiceId id);
+        Voice* FindLeastImportantVoice(const AudioGroupState* pGroup, const bool realOnly);
+        void UpdateAudibleVolume(Voice& voice) const;
+        bool TryMakeReal(Voice& voice);
+        bool MakeReal(Voice& voice, const AudioHardwareChannel channel);
+        AudioHardwareChannel MakeVirtual(Voice& voice);
+        void RemoveVoice(const size_t index);
+        [[nodiscard]] size_t GetVoiceCount(const AudioGroupState* pGroup) const;
+
+        static bool IsMoreImportant(const Voice& left, const Voice& right);
+    };
+}
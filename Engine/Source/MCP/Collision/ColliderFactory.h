@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <functional>
+#include <limits>
 #include "MCP/Debug/Log.h"
 #include "MCP/Core/Resource/Parser.h"
 #include "Utility/Generic/Hash.h"
@@ -10,8 +10,9 @@ namespace mcp
     AudioSourceComponent::AudioSourceComponent(const AudioSourceConstructionData& data)
         : Component(true)
         , m_groupId(0)
-        , m_hardwareChannel(-1)
+        , m_voiceId(kInvalidVoiceId)
         , m_volume(data.volume)
+        , m_priority(data.priority)
         , m_isLooping(data.isLooping)
         , m_isMuted(data.isMuted)
         , m_playOnActive(data.playOnActive)
@@ -36,12 +37,13 @@ namespace mcp
 
     void AudioSourceComponent::Play()
     {
-        m_hardwareChannel = AudioManager::Get()->PlayAudio(this, m_resource, m_groupId, m_volume);
+        m_voiceId = AudioManager::Get()->PlayAudio(this, m_resource, m_groupId, m_volume);
     }
 
     void AudioSourceComponent::SetVolume(const float volume)
     {
         m_volume = std::clamp(volume, 0.f, 1.f);
+        AudioManager::Get()->SetVoiceVolume(m_voiceId, m_volume);
     }
 
     void AudioSourceComponent::OnActive()
@@ -61,6 +63,7 @@ namespace mcp
 
         data.pAudioGroupName = element.GetAttributeValue<const char*>("group", "Master");
         data.volume = element.GetAttributeValue<float>("volume", 1.f);
+        data.priority = element.GetAttributeValue<int>("priority", AudioVoiceManager::kDefaultPriority);
         data.isLooping = element.GetAttributeValue<bool>("isLooping", false);
         data.isMuted = element.GetAttributeValue<bool>("isMuted", false);
         data.playOnActive = element.GetAttributeValue<bool>("playOnActive", false);
@@ -4,6 +4,7 @@
 #include "Component.h"
 #include "MCP/Audio/AudioGroup.h"
 #include "MCP/Audio/AudioResource.h"
+#include "MCP/Audio/AudioVoiceManager.h"
 
 namespace mcp
 {
@@ -12,6 +13,7 @@ namespace mcp
         const char* pResourcePath = nullptr;
         const char* pAudioGroupName = nullptr;
         float volume = 1.0f;
+        int priority = AudioVoiceManager::kDefaultPriority;
         bool isLooping = false;
         bool isMuted = false;
         bool playOnActive = false;
@@ -24,8 +26,9 @@ namespace mcp
 
         AudioResource m_resource;
         AudioGroup::Id m_groupId;
-        AudioHardwareChannel m_hardwareChannel;
+        AudioVoiceId m_voiceId;
         float m_volume;
+        int m_priority;     // Higher priority sources take hardware channels from lower priority ones.
         bool m_isLooping;
         bool m_isMuted;
         bool m_playOnActive;
@@ -47,6 +50,7 @@ namespace mcp
         [[nodiscard]] bool IsLooping() const { return m_isLooping; }
         [[nodiscard]] bool IsMuted() const { return m_isMuted; }
         [[nodiscard]] float GetVolume() const { return m_volume; }
+        [[nodiscard]] int GetPriority() const { return m_priority; }
 
         static AudioSourceComponent* AddFromData(const XMLElement element);
 
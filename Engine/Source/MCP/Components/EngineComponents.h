@@ -12,6 +12,7 @@
 #include "ColliderComponent.h"
 #include "ImageComponent.h"
 #include "InputComponent.h"
+#include "ParticleEmitterComponent.h"
 #include "PrimitiveComponent.h"
 #include "Rect2DComponent.h"
 #include "ScriptComponent.h"
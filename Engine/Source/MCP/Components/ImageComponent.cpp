@@ -5,6 +5,7 @@
 #include "TransformComponent.h"
 #include "MCP/Scene/Object.h"
 #include "MCP/Scene/Scene.h"
+#include "MCP/Scene/WorldLayer.h"
 #include "MCP/Graphics/Graphics.h"
 
 namespace mcp
@@ -59,12 +60,16 @@ namespace mcp
             return;
         }
 
-        if (!m_texture.Load(DiskResourceRequest(data.pImagePath)))
+        const bool loaded = data.loadAsync ? m_texture.LoadAsync(DiskResourceRequest(data.pImagePath)) : m_texture.Load(DiskResourceRequest(data.pImagePath));
+        if (!loaded)
         {
             MCP_WARN("ImageComponent", "Failed to load texture! Path: ", data.pImagePath);
             return;
         }
 
+        m_isWaitingOnTexture = m_texture.IsPending();
+        m_cropNeedsContentSize = m_isWaitingOnTexture && m_sizedToContent;
+
         // If we are sized to our content, then we are going to set the crop to contain the whole image.
         if (m_sizedToContent)
         {
@@ -84,7 +89,7 @@ namespace mcp
 
         if (IsActive() && m_texture.IsValid())
         {
-            GetOwner()->GetWorld()->AddRenderable(this);
+            AddToWorld();
         }
 
         return true;
@@ -112,19 +117,81 @@ namespace mcp
     void ImageComponent::OnActive()
     {
         if (m_texture.IsValid())
-            GetOwner()->GetWorld()->AddRenderable(this);
+            AddToWorld();
     }
 
     void ImageComponent::OnInactive()
     {
         if (m_texture.IsValid())
-            GetOwner()->GetWorld()->RemoveRenderable(this);
+            RemoveFromWorld();
+    }
+
+    void ImageComponent::OnDestroy()
+    {
+        // Static chunks hold onto us directly, so we need to make sure that we are removed.
+        if (m_isBakedStatic)
+            RemoveFromWorld();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Images on static Objects are baked into the World's static chunks, rather than being rendered individually.
+    //		
+    ///		@brief : Register with the World for rendering.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ImageComponent::AddToWorld()
+    {
+        auto* pWorld = GetOwner()->GetWorld();
+
+        if (GetOwner()->IsStatic() && pWorld->AddStaticImage(this))
+        {
+            m_isBakedStatic = true;
+            return;
+        }
+
+        pWorld->AddRenderable(this);
+    }
+
+    void ImageComponent::RemoveFromWorld()
+    {
+        auto* pWorld = GetOwner()->GetWorld();
+
+        if (m_isBakedStatic)
+        {
+            pWorld->RemoveStaticImage(this);
+            m_isBakedStatic = false;
+            return;
+        }
+
+        pWorld->RemoveRenderable(this);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : If we are baked into a static chunk, let the World know that the chunk needs to be rebaked.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ImageComponent::OnRenderDataChanged()
+    {
+        if (m_isBakedStatic)
+            GetOwner()->GetWorld()->MarkStaticImageDirty(this);
     }
 
     void ImageComponent::Render() const
+    {
+        DrawTexture(GetRenderData());
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is also used by the WorldLayer to bake static images.
+    //		
+    ///		@brief : Get the data needed to draw this image at its current position.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    TextureRenderData ImageComponent::GetRenderData() const
     {
         MCP_CHECK_MSG(m_pTransformComponent, "Failed to Render ImageComponent! TransformComponent was nullptr!");
 
+        RefreshPendingTexture();
+
         const Vec2 scale = m_pTransformComponent->GetScale();
         const float width = scale.x * static_cast<float>(m_crop.width);
         const float height = scale.y * static_cast<float>(m_crop.height);
@@ -144,13 +211,24 @@ namespace mcp
         TextureRenderData renderData;
         renderData.pTexture = m_texture.Get();
         renderData.angle = m_renderAngle;
-        renderData.crop = m_crop;
+        // While the texture is loading, our crop doesn't apply to the placeholder, so we stretch the whole placeholder.
+        if (m_isWaitingOnTexture)
+        {
+            const auto placeholderSize = m_texture.GetTextureSize();
+            renderData.crop = RectInt{0, 0, placeholderSize.x, placeholderSize.y};
+        }
+
+        else
+        {
+            renderData.crop = m_crop;
+        }
+
         renderData.tint = m_tint;
         renderData.anglePivot = m_anglePivot;
         renderData.destinationRect = destinationRect;
         renderData.flip = m_flip;
 
-        DrawTexture(renderData);
+        return renderData;
     }
 
     void ImageComponent::SetTexture(const Texture* pTexture)
@@ -166,7 +244,7 @@ namespace mcp
             // If this is active, we need to not render the null texture.
             if (IsActive())
             {
-                GetOwner()->GetWorld()->RemoveRenderable(this);
+                RemoveFromWorld();
             }
         }
 
@@ -177,6 +255,8 @@ namespace mcp
 
             // Assign the new texture:
             m_texture = *pTexture;
+            m_isWaitingOnTexture = m_texture.IsPending();
+            m_cropNeedsContentSize = m_isWaitingOnTexture && m_sizedToContent;
 
             // If we are sized to our content, adjust our crop.
             if (m_sizedToContent)
@@ -188,11 +268,46 @@ namespace mcp
             // If we are active and our texture was previously invalid (null texture), then add us to World for rendering.
             if (IsActive() && !textureWasValid)
             {
-                GetOwner()->GetWorld()->AddRenderable(this);
+                AddToWorld();
+            }
+
+            else
+            {
+                OnRenderDataChanged();
             }
         }
     }
 
+    void ImageComponent::SetCrop(const RectInt& crop)
+    {
+        m_crop = crop;
+
+        // An explicit crop shouldn't be overwritten when our texture finishes loading.
+        m_cropNeedsContentSize = false;
+        OnRenderDataChanged();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The crop of a sized to content image can't be known until the texture has been loaded, so it is set to the
+    //      placeholder's size until then.
+    //		
+    ///		@brief : Check if our async texture has finished loading, updating our crop if we are sized to content.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ImageComponent::RefreshPendingTexture() const
+    {
+        if (!m_isWaitingOnTexture || m_texture.IsPending())
+            return;
+
+        m_isWaitingOnTexture = false;
+
+        if (m_cropNeedsContentSize)
+        {
+            const auto imageSize = m_texture.GetTextureSize();
+            m_crop = RectInt{0,0, imageSize.x, imageSize.y};
+        }
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
@@ -201,6 +316,7 @@ namespace mcp
     void ImageComponent::SetTint(const Color color)
     {
         m_tint = color;
+        OnRenderDataChanged();
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -211,6 +327,7 @@ namespace mcp
     void ImageComponent::SetAlpha(const uint8_t alpha)
     {
         m_tint.alpha = alpha;
+        OnRenderDataChanged();
     }
 
     ImageComponent* ImageComponent::AddFromData(const XMLElement element)
@@ -229,6 +346,9 @@ namespace mcp
         // Size to content:
         data.sizedToContent = element.GetAttributeValue<bool>("sizedToContent", true);
 
+        // Async loading:
+        data.loadAsync = element.GetAttributeValue<bool>("loadAsync", false);
+
         // Crop
         const XMLElement cropElement = element.GetChildElement("Crop");
         if (cropElement.IsValid())
@@ -3,6 +3,7 @@
 
 #include "Component.h"
 #include "../Graphics/Texture.h"
+#include "MCP/Graphics/Graphics.h"
 #include "MCP/Graphics/RenderData/BaseRenderData.h"
 #include "MCP/Scene/IRenderable.h"
 #include "Utility/Types/Color.h"
@@ -19,6 +20,7 @@ namespace mcp
         Color tint = Color::White();
         int zOrder = 0;
         bool sizedToContent = true;
+        bool loadAsync = false;     // If true, the image is decoded off of the main thread, and a placeholder is drawn until it is ready.
     };
 
     class ImageComponent final : public Component, public IRenderable
@@ -27,13 +29,16 @@ namespace mcp
 
         Texture m_texture;
         TransformComponent* m_pTransformComponent;
-        RectInt m_crop {};
+        mutable RectInt m_crop {};          // Mutable so a sized to content crop can be refreshed once an async texture is ready.
         Vec2 m_anglePivot;
         Vec2 m_scale;
         Color m_tint;
         double m_renderAngle;
         RenderFlip2D m_flip;
         bool m_sizedToContent;
+        mutable bool m_isWaitingOnTexture = false;  // True while our texture is still loading asynchronously.
+        bool m_cropNeedsContentSize = false;        // True if our crop should be sized to the texture once it has loaded.
+        bool m_isBakedStatic = false;               // True if we are rendered by one of the World's static chunks.
 
     public:
         ImageComponent(const RenderLayer layer, const int zOrder);
@@ -44,19 +49,27 @@ namespace mcp
         virtual void Render() const override;
 
         void SetTexture(const Texture* pTexture);
-        void SetCrop(const RectInt& crop) { m_crop = crop; }
+        void SetCrop(const RectInt& crop);
         void SetSize(const float width, const float height) { m_scale = { width, height }; }
         void SetTint(const Color color);
         void SetAlpha(const uint8_t alpha);
 
         [[nodiscard]] Color GetTint() const { return m_tint; }
         [[nodiscard]] RectInt GetCrop() const { return m_crop; }
+        [[nodiscard]] TextureRenderData GetRenderData() const;
+        [[nodiscard]] bool IsTexturePending() const { return m_texture.IsPending(); }
+        
+        void OnRenderDataChanged();
         
         static ImageComponent* AddFromData(const XMLElement element);
 
     private:
+        void RefreshPendingTexture() const;
+        void AddToWorld();
+        void RemoveFromWorld();
         virtual void OnOwnerParentSet(Object* pParent) override;
         virtual void OnActive() override;
         virtual void OnInactive() override;
+        virtual void OnDestroy() override;
     };
 }
@@ -0,0 +1,291 @@
+// ParticleEmitterComponent.cpp
+
+#include "ParticleEmitterComponent.h"
+
+#include <algorithm>
+#include <cmath>
+#include "TransformComponent.h"
+#include "MCP/Animation/AnimationCurve.h"
+#include "MCP/Scene/Object.h"
+#include "MCP/Scene/Scene.h"
+
+namespace mcp
+{
+    namespace
+    {
+        constexpr float kDegreesToRadians = 3.14159265358979f / 180.f;
+
+        ParticleCurveData GetCurveFromData(const XMLElement parent, const char* pName)
+        {
+            ParticleCurveData curve;
+
+            const XMLElement element = parent.GetChildElement(pName);
+            if (!element.IsValid())
+                return curve;
+
+            curve.start = element.GetAttributeValue<float>("start", curve.start);
+            curve.end = element.GetAttributeValue<float>("end", curve.end);
+            curve.control1.x = element.GetAttributeValue<float>("c1x", curve.control1.x);
+            curve.control1.y = element.GetAttributeValue<float>("c1y", curve.control1.y);
+            curve.control2.x = element.GetAttributeValue<float>("c2x", curve.control2.x);
+            curve.control2.y = element.GetAttributeValue<float>("c2y", curve.control2.y);
+
+            return curve;
+        }
+
+        Color GetColorFromData(const XMLElement parent, const char* pName, const Color defaultColor)
+        {
+            const XMLElement element = parent.GetChildElement(pName);
+            if (!element.IsValid())
+                return defaultColor;
+
+            Color color;
+            color.r = element.GetAttributeValue<uint8_t>("r", defaultColor.r);
+            color.g = element.GetAttributeValue<uint8_t>("g", defaultColor.g);
+            color.b = element.GetAttributeValue<uint8_t>("b", defaultColor.b);
+            color.alpha = element.GetAttributeValue<uint8_t>("alpha", defaultColor.alpha);
+
+            return color;
+        }
+
+        uint8_t LerpChannel(const uint8_t start, const uint8_t end, const float weight)
+        {
+            const float value = static_cast<float>(start) + (static_cast<float>(end) - static_cast<float>(start)) * weight;
+            return static_cast<uint8_t>(std::clamp(value, 0.f, 255.f));
+        }
+    }
+
+    ParticleEmitterComponent::ParticleEmitterComponent(const ParticleEmitterConstructionData& data)
+        : Component(data.componentData)
+        , IRenderable(RenderLayer::kWorld, data.zOrder)
+        , m_pool(data.maxParticles)
+        , m_settings(data)
+        , m_crop(data.crop)
+    {
+        // The path is only valid during construction.
+        m_settings.pImagePath = nullptr;
+
+        BakeCurves();
+
+        if (!data.pImagePath)
+            return;
+
+        if (!m_texture.Load(DiskResourceRequest(data.pImagePath)))
+        {
+            MCP_WARN("ParticleEmitterComponent", "Failed to load texture! Path: ", data.pImagePath);
+            return;
+        }
+
+        // No crop means that we want the whole texture.
+        if (m_crop.width <= 0 || m_crop.height <= 0)
+        {
+            const auto imageSize = m_texture.GetTextureSize();
+            m_crop = RectInt{0, 0, imageSize.x, imageSize.y};
+        }
+    }
+
+    ParticleEmitterComponent::~ParticleEmitterComponent()
+    {
+        if (IsActive())
+        {
+            auto* pWorld = GetOwner()->GetWorld();
+            MCP_CHECK(pWorld);
+            pWorld->RemoveUpdateable(this);
+            pWorld->RemoveRenderable(this);
+        }
+    }
+
+    bool ParticleEmitterComponent::Init()
+    {
+        m_pTransformComponent = GetOwner()->GetComponent<TransformComponent>();
+        if (!m_pTransformComponent)
+        {
+            MCP_ERROR("ParticleEmitterComponent", "Failed to initialize ParticleEmitterComponent! TransformComponent was nullptr!");
+            return false;
+        }
+
+        if (IsActive())
+            OnActive();
+
+        return true;
+    }
+
+    void ParticleEmitterComponent::OnActive()
+    {
+        auto* pWorld = GetOwner()->GetWorld();
+        MCP_CHECK(pWorld);
+        pWorld->AddUpdateable(this);
+        pWorld->AddRenderable(this);
+    }
+
+    void ParticleEmitterComponent::OnInactive()
+    {
+        auto* pWorld = GetOwner()->GetWorld();
+        MCP_CHECK(pWorld);
+        pWorld->RemoveUpdateable(this);
+        pWorld->RemoveRenderable(this);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Emission is based on a rate, so the fractional part of a frame's particles is carried over to the next update.
+    //
+    ///		@brief : Emit new particles, then simulate all of the live particles.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticleEmitterComponent::Update(const float deltaTimeMs)
+    {
+        const float deltaTimeS = deltaTimeMs / 1000.f;
+
+        if (m_settings.isEmitting && m_settings.emitRate > 0.f)
+        {
+            m_emitAccumulator += m_settings.emitRate * deltaTimeS;
+
+            const Vec2 origin = m_pTransformComponent->GetPosition();
+            while (m_emitAccumulator >= 1.f)
+            {
+                m_emitAccumulator -= 1.f;
+                EmitParticle(origin);
+            }
+        }
+
+        m_pool.Update(deltaTimeS, m_settings.gravity, m_settings.drag);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Immediately emit a number of particles, regardless of the emit rate.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticleEmitterComponent::Burst(const size_t count)
+    {
+        if (!m_pTransformComponent)
+            return;
+
+        const Vec2 origin = m_pTransformComponent->GetPosition();
+        for (size_t i = 0; i < count && !m_pool.IsFull(); ++i)
+        {
+            EmitParticle(origin);
+        }
+    }
+
+    void ParticleEmitterComponent::EmitParticle(const Vec2& origin)
+    {
+        const float angle = (m_settings.direction + m_rng.SignedNormalizedRand() * m_settings.spread) * kDegreesToRadians;
+        const float speed = m_rng.RandRange(m_settings.minSpeed, m_settings.maxSpeed);
+        const float lifetime = m_rng.RandRange(m_settings.minLifetime, m_settings.maxLifetime);
+        const float sizeScale = 1.f - m_rng.NormalizedRand() * m_settings.sizeVariance;
+
+        m_pool.Emit(origin, Vec2{std::cos(angle) * speed, std::sin(angle) * speed}, lifetime, sizeScale);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The quads are built straight from the pool's arrays, and submitted in one call.
+    //
+    ///		@brief : Draw all of the live particles.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticleEmitterComponent::Render() const
+    {
+        const size_t count = m_pool.GetCount();
+        if (count == 0)
+            return;
+
+        const float* pPosX = m_pool.GetPositionsX();
+        const float* pPosY = m_pool.GetPositionsY();
+        const float* pAges = m_pool.GetNormalizedAges();
+        const float* pSizeScales = m_pool.GetSizeScales();
+
+        m_quads.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto sample = std::min(static_cast<size_t>(pAges[i] * static_cast<float>(kCurveSamples - 1)), kCurveSamples - 1);
+            const float size = m_sizeOverLife[sample] * pSizeScales[i];
+            const float halfSize = size / 2.f;
+
+            m_quads[i].rect = RectF{pPosX[i] - halfSize, pPosY[i] - halfSize, size, size};
+            m_quads[i].color = m_colorOverLife[sample];
+        }
+
+        DrawQuads(m_texture.IsValid() ? m_texture.Get() : nullptr, m_crop, m_quads.data(), count);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The Curves are only alive for the duration of this function, as they can't be safely copied.
+    //
+    ///		@brief : Sample the size and color curves into our lookup tables.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticleEmitterComponent::BakeCurves()
+    {
+        const auto& sizeData = m_settings.sizeCurve;
+        const auto& colorData = m_settings.colorCurve;
+        const Curve<float> sizeCurve(sizeData.start, sizeData.end, sizeData.control1, sizeData.control2);
+        const Curve<float> colorCurve(colorData.start, colorData.end, colorData.control1, colorData.control2);
+
+        const Color& startColor = m_settings.startColor;
+        const Color& endColor = m_settings.endColor;
+
+        for (size_t i = 0; i < kCurveSamples; ++i)
+        {
+            const float t = static_cast<float>(i) / static_cast<float>(kCurveSamples - 1);
+            m_sizeOverLife[i] = sizeCurve.Evaluate(t, m_settings.startSize, m_settings.endSize);
+
+            const float weight = colorCurve.Evaluate(t, 0.f, 1.f);
+            m_colorOverLife[i] = Color
+            {
+                LerpChannel(startColor.r, endColor.r, weight)
+                , LerpChannel(startColor.g, endColor.g, weight)
+                , LerpChannel(startColor.b, endColor.b, weight)
+                , LerpChannel(startColor.alpha, endColor.alpha, weight)
+            };
+        }
+    }
+
+    ParticleEmitterComponent* ParticleEmitterComponent::AddFromData(const XMLElement element)
+    {
+        ParticleEmitterConstructionData data;
+
+        // Base Component data:
+        data.componentData = GetComponentConstructionData(element);
+
+        data.pImagePath = element.GetAttributeValue<const char*>("imagePath", nullptr);
+        data.zOrder = element.GetAttributeValue<int>("zOrder", data.zOrder);
+        data.maxParticles = static_cast<size_t>(element.GetAttributeValue<int>("maxParticles", static_cast<int>(data.maxParticles)));
+        data.emitRate = element.GetAttributeValue<float>("emitRate", data.emitRate);
+        data.minLifetime = element.GetAttributeValue<float>("minLifetime", data.minLifetime);
+        data.maxLifetime = element.GetAttributeValue<float>("maxLifetime", data.maxLifetime);
+        data.minSpeed = element.GetAttributeValue<float>("minSpeed", data.minSpeed);
+        data.maxSpeed = element.GetAttributeValue<float>("maxSpeed", data.maxSpeed);
+        data.direction = element.GetAttributeValue<float>("direction", data.direction);
+        data.spread = element.GetAttributeValue<float>("spread", data.spread);
+        data.startSize = element.GetAttributeValue<float>("startSize", data.startSize);
+        data.endSize = element.GetAttributeValue<float>("endSize", data.endSize);
+        data.sizeVariance = std::clamp(element.GetAttributeValue<float>("sizeVariance", data.sizeVariance), 0.f, 1.f);
+        data.drag = element.GetAttributeValue<float>("drag", data.drag);
+        data.isEmitting = element.GetAttributeValue<bool>("emitting", data.isEmitting);
+
+        // Crop
+        const XMLElement cropElement = element.GetChildElement("Crop");
+        if (cropElement.IsValid())
+        {
+            data.crop.x = cropElement.GetAttributeValue<int>("x", 0);
+            data.crop.y = cropElement.GetAttributeValue<int>("y", 0);
+            data.crop.width = cropElement.GetAttributeValue<int>("w", 0);
+            data.crop.height = cropElement.GetAttributeValue<int>("h", 0);
+        }
+
+        // Gravity
+        const XMLElement gravityElement = element.GetChildElement("Gravity");
+        if (gravityElement.IsValid())
+        {
+            data.gravity.x = gravityElement.GetAttributeValue<float>("x", 0.f);
+            data.gravity.y = gravityElement.GetAttributeValue<float>("y", 0.f);
+        }
+
+        // Over Life
+        data.startColor = GetColorFromData(element, "StartColor", data.startColor);
+        data.endColor = GetColorFromData(element, "EndColor", data.endColor);
+        data.sizeCurve = GetCurveFromData(element, "SizeCurve");
+        data.colorCurve = GetCurveFromData(element, "ColorCurve");
+
+        return BLEACH_NEW(ParticleEmitterComponent(data));
+    }
+}
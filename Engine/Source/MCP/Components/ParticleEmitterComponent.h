@@ -0,0 +1,105 @@
+#pragma once
+// ParticleEmitterComponent.h
+
+#include <array>
+#include <vector>
+#include "Component.h"
+#include "MCP/Graphics/Graphics.h"
+#include "MCP/Graphics/ParticlePool.h"
+#include "MCP/Graphics/Texture.h"
+#include "MCP/Scene/IRenderable.h"
+#include "MCP/Scene/IUpdateable.h"
+#include "Utility/Random/RNG.h"
+#include "Utility/Types/Color.h"
+
+namespace mcp
+{
+    class TransformComponent;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Control points of a Curve that maps the normalized age of a particle to a weight between a start and end value.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ParticleCurveData
+    {
+        float start = 0.f;
+        float end = 1.f;
+        Vec2 control1 = {0.5f, 0.f};
+        Vec2 control2 = {0.5f, 1.f};
+    };
+
+    struct ParticleEmitterConstructionData
+    {
+        ComponentConstructionData componentData;
+        const char* pImagePath = nullptr;       // If nullptr, particles are drawn as filled rects.
+        RectInt crop = {};
+        ParticleCurveData sizeCurve;            // Blends from startSize to endSize over the life of a particle.
+        ParticleCurveData colorCurve;           // Blends from startColor to endColor over the life of a particle.
+        Color startColor = Color::White();
+        Color endColor = {255, 255, 255, 0};
+        Vec2 gravity = {0.f, 0.f};              // Units per second squared.
+        float emitRate = 50.f;                  // Particles per second.
+        float minLifetime = 1.f;                // Seconds.
+        float maxLifetime = 1.f;
+        float minSpeed = 50.f;                  // Units per second.
+        float maxSpeed = 100.f;
+        float direction = -90.f;                // Degrees. The default is straight up.
+        float spread = 30.f;                    // Degrees on either side of the direction.
+        float startSize = 8.f;
+        float endSize = 2.f;
+        float sizeVariance = 0.f;               // [0, 1]. Random reduction of the size of each particle.
+        float drag = 0.f;                       // Fraction of the velocity lost per second.
+        size_t maxParticles = 1000;
+        int zOrder = 0;
+        bool isEmitting = true;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Particles are simulated in a ParticlePool. The size and color curves are baked into lookup tables when the emitter
+    //      is created, so evaluating them per particle is a table lookup instead of a Bezier evaluation.
+    //
+    //      All of the particles are drawn with a single DrawQuads() call each frame, using the emitter's texture if it has one.
+    //
+    ///		@brief : Emits, simulates and renders a stream of particles from the position of its owner.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class ParticleEmitterComponent final : public Component, public IRenderable, public IUpdateable
+    {
+        MCP_DEFINE_COMPONENT_ID(ParticleEmitterComponent)
+
+        static constexpr size_t kCurveSamples = 32;
+
+        ParticlePool m_pool;
+        ParticleEmitterConstructionData m_settings;
+        std::array<float, kCurveSamples> m_sizeOverLife {};
+        std::array<Color, kCurveSamples> m_colorOverLife {};
+        mutable std::vector<ColoredQuad> m_quads;   // Reused each frame to build the batch.
+        Texture m_texture;
+        RectInt m_crop;
+        Rng m_rng;
+        TransformComponent* m_pTransformComponent = nullptr;
+        float m_emitAccumulator = 0.f;              // Fractional particles carried over between updates.
+
+    public:
+        explicit ParticleEmitterComponent(const ParticleEmitterConstructionData& data);
+        virtual ~ParticleEmitterComponent() override;
+
+        virtual bool Init() override;
+        virtual void Update(const float deltaTimeMs) override;
+        virtual void Render() const override;
+
+        void Burst(const size_t count);
+        void SetEmitting(const bool isEmitting) { m_settings.isEmitting = isEmitting; }
+        void ClearParticles() { m_pool.Clear(); }
+
+        [[nodiscard]] bool IsEmitting() const { return m_settings.isEmitting; }
+        [[nodiscard]] size_t GetParticleCount() const { return m_pool.GetCount(); }
+
+        static ParticleEmitterComponent* AddFromData(const XMLElement element);
+
+    private:
+        void BakeCurves();
+        void EmitParticle(const Vec2& origin);
+        virtual void OnActive() override;
+        virtual void OnInactive() override;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "TransformComponent.h"
 
+#include "ImageComponent.h"
 #include "MCP/Scene/Object.h"
 
 namespace mcp
@@ -45,16 +46,19 @@ namespace mcp
     {
         m_position.x += deltaX;
         m_position.y += deltaY;
+        OnTransformChanged();
     }
 
     void TransformComponent::AddToPosition(const Vec2 deltaPosition)
     {
         m_position += deltaPosition;
+        OnTransformChanged();
     }
 
     void TransformComponent::SetPosition(const Vec2 position)
     {
         m_position = position;
+        OnTransformChanged();
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -73,12 +77,14 @@ namespace mcp
     void TransformComponent::SetScale(const Vec2 scale)
     {
         m_scale = scale;
+        OnTransformChanged();
     }
 
     void TransformComponent::SetScale(const float xAxis, const float yAxis)
     {
         m_scale.x = xAxis;
         m_scale.y = yAxis;
+        OnTransformChanged();
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -97,6 +103,23 @@ namespace mcp
         return m_scale;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Static Objects aren't expected to move, but if they do, their baked image needs to be updated. Child transforms of
+    //      a static Object are not notified.
+    //		
+    ///		@brief : Let the Object's image know that it has moved, if the Object is static.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TransformComponent::OnTransformChanged()
+    {
+        auto* pOwner = GetOwner();
+        if (!pOwner || !pOwner->IsStatic())
+            return;
+
+        if (auto* pImage = pOwner->GetComponent<ImageComponent>())
+            pImage->OnRenderDataChanged();
+    }
+
     void TransformComponent::OnOwnerParentSet(Object* pParent)
     {
         // If our parent is now null and we had a parent transform,
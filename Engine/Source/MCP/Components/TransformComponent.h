@@ -38,6 +38,7 @@ namespace mcp
         static TransformComponent* AddFromData(const XMLElement element);
 
     protected:
+        void OnTransformChanged();
         virtual void OnOwnerParentSet(Object* pParent) override;
     };
 }
\ No newline at end of file
@@ -31,6 +31,10 @@ namespace mcp
 
     void Application::Destroy()
     {
+        // Systems are normally closed at the end of Run(). Tools that use the engine without the main loop rely on this.
+        if (s_pInstance && !s_pInstance->m_systems.empty())
+            s_pInstance->Close();
+
         BLEACH_DELETE(s_pInstance);
         s_pInstance = nullptr;
     }
@@ -127,6 +131,9 @@ namespace mcp
             }
 
             const auto settingsRoot = projectSettingsFile.GetElement();
+            LoadFramePacingSettings(settingsRoot);
+            ResourceManager::Get()->LoadAsyncSettings(settingsRoot);
+            ResourceManager::Get()->LoadCacheSettings(settingsRoot);
 
             // Add the Engine Systems using the project settings:
             m_systems.emplace_back(LocalizationSystem::AddFromData(settingsRoot));
@@ -187,21 +194,33 @@ namespace mcp
         m_isRunning = true;
 
         // Start the timer.
-        FrameTimer timer;
+        m_frameTimer.ResetTimer();
+        m_frameTimer.ResetStats();
 
         auto* pWindow = GraphicsManager::Get()->GetWindow();
+        auto* pResourceManager = ResourceManager::Get();
 
         while (m_isRunning)
         {
-            [[maybe_unused]] const float deltaTimeMs = static_cast<float>(timer.NewFrame());
+            // NewFrame() waits out the rest of the frame if we have a target frame rate. We update with the smoothed
+            // delta time so that OS scheduling jitter doesn't make movement uneven.
+            m_frameTimer.NewFrame();
+            [[maybe_unused]] const float deltaTimeMs = static_cast<float>(m_frameTimer.GetSmoothedDeltaMs());
+
+            // Pick the world's render scale for this frame based on how long the recent frames took.
+            GraphicsManager::Get()->UpdateDynamicResolution(m_frameTimer);
 
             m_isRunning = pWindow->ProcessEvents();
 
             if (m_isRunning)
             {
+                // Finish any async loads that are ready, so they are up to date for this frame.
+                pResourceManager->ProcessAsyncUploads();
+
 #ifndef MCP_EDITOR
                 SceneManager::Get()->Update(deltaTimeMs);
 #endif
+                AudioManager::Get()->Update(deltaTimeMs);
                 SceneManager::Get()->Render();
                 GraphicsManager::Get()->Display();
             }
@@ -211,6 +230,23 @@ namespace mcp
         Close();
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Ex: <FramePacing targetFps="60" smoothing="0.1"/>. A targetFps of 0, or no element, runs uncapped.
+    //
+    ///		@brief : Set up the frame pacing of the main loop from the project settings.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void Application::LoadFramePacingSettings(const XMLElement settingsRoot)
+    {
+        const auto pacingElement = settingsRoot.GetChildElement("FramePacing");
+        if (!pacingElement.IsValid())
+            return;
+
+        m_frameTimer.SetTargetFps(pacingElement.GetAttributeValue<double>("targetFps", 0.0));
+        m_frameTimer.SetSmoothingFactor(pacingElement.GetAttributeValue<double>("smoothing", 0.0));
+        m_frameTimer.SetMissTolerance(pacingElement.GetAttributeValue<double>("missToleranceMs", 0.5));
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //
@@ -308,6 +344,21 @@ namespace mcp
 
         MCP_LOG("Application", "Closing MCPEngine...");
 
+        const auto& frameStats = m_frameTimer.GetStats();
+        if (frameStats.frameCount > 0)
+        {
+            MCP_LOG("Application", "Frames: ", frameStats.frameCount
+                , " | Avg: ", frameStats.averageFrameMs, "ms"
+                , " | Variance: ", frameStats.frameTimeVariance
+                , " | Min: ", frameStats.minFrameMs, "ms"
+                , " | Max: ", frameStats.maxFrameMs, "ms"
+                , " | Pacing Misses: ", frameStats.pacingMisses);
+        }
+
+        // Stop caching resources, so that everything the Systems release is freed while the renderer and audio device still exist.
+        if (auto* pResourceManager = GetSystem<ResourceManager>())
+            pResourceManager->SetCacheBudget(0);
+
         // Close the Systems in reverse order.
         for (auto it = m_systems.rbegin(); it != m_systems.rend(); ++it)
         {
@@ -342,12 +393,30 @@ namespace mcp
         return 0;
     }
 
+    static int DumpResourceStats(lua_State* pState)
+    {
+        const char* pFilepath = lua_tostring(pState, -1);
+        lua_pop(pState, 1);
+
+        if (!pFilepath)
+        {
+            MCP_WARN("Application", "DumpResourceStats needs a filepath!");
+            return 0;
+        }
+
+        const std::string fullPath = Application::Get()->GetContext().workingDirectory + pFilepath;
+        ResourceManager::Get()->DumpStatsToCsv(fullPath.c_str());
+
+        return 0;
+    }
+
     void Application::RegisterLuaFunctions(lua_State* pState)
     {
         static constexpr luaL_Reg kFuncs[]
         {
             {"QuitGame", QuitGame }
             ,{"SetLanguage", SetLanguage }
+            ,{"DumpResourceStats", DumpResourceStats }
             ,{nullptr, nullptr}
         };
 
@@ -7,6 +7,7 @@
 #include "MCP/Core/System.h"
 #include "MCP/Core/Event/ApplicationEvent.h"
 #include "MCP/Graphics/Graphics.h"
+#include "Utility/Time/FrameTimer.h"
 
 struct lua_State;
 
@@ -59,6 +60,7 @@ namespace mcp
 
         std::vector<System*> m_systems;
         ApplicationContext m_context;
+        FrameTimer m_frameTimer;
         bool m_isRunning;
 
     public:
@@ -84,11 +86,13 @@ namespace mcp
         SystemType* GetSystem() const;
 
         [[nodiscard]] const ApplicationContext& GetContext() const { return m_context; }
+        [[nodiscard]] const FrameTimer& GetFrameTimer() const { return m_frameTimer; }
 
         static void RegisterLuaFunctions(lua_State* pState);
 
     private:
         bool LoadGameSystems(const char* pGameSystemsPath);
+        void LoadFramePacingSettings(const XMLElement settingsRoot);
         void Close();
     };
 
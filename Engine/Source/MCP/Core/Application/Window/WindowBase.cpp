@@ -25,11 +25,12 @@ namespace mcp
     ///		@param pWindowName : Name of the window.
     ///		@param width : Initial width of the window.
     ///		@param height : Initial height of the window.
+    ///		@param isHeadless : If true, no window is opened and rendering goes to an in-memory framebuffer.
     ///		@returns : False if something went wrong in the initialization.
     //-----------------------------------------------------------------------------------------------------------------------------
-    bool WindowBase::Init(const char* pWindowName, const int width, const int height)
+    bool WindowBase::Init(const char* pWindowName, const int width, const int height, const bool isHeadless)
     {
-        return GetWindow<WindowType>().Init(pWindowName, width, height);
+        return GetWindow<WindowType>().Init(pWindowName, width, height, isHeadless);
     }
 
     const RectInt& WindowBase::GetDimensions()
@@ -21,7 +21,7 @@ namespace mcp
             Close();
         }
 
-        bool Init(const char* pWindowName, const int width, const int height);
+        bool Init(const char* pWindowName, const int width, const int height, const bool isHeadless = false);
         bool ProcessEvents();
         void PostApplicationEvent(ApplicationEvent& event);
         void Close();
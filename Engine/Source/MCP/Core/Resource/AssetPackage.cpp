@@ -2,16 +2,90 @@
 
 #include "AssetPackage.h"
 
+#include <algorithm>
+#include <atomic>
 #include <BleachNew.h>
-#include <cassert>
-#include <fstream>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 #define ZLIB_WINAPI
 #include <zlib.h>
 #include "MCP/Debug/Log.h"
+#include "MCP/Core/Resource/LzCodec.h"
 #include "MCP/Core/Resource/Zip.h"
+#include "Utility/Generic/Hash.h"
+#include "Utility/Time/HighPrecisionTimer.h"
 
 namespace mcp
 {
+    namespace
+    {
+        // The end of central directory record can be followed by a comment of up to 64K.
+        constexpr size_t kMaxZipCommentLength = 0xFFFF;
+
+        template<typename Type>
+        Type ReadStruct(const uint8_t* pData)
+        {
+            Type value;
+            std::memcpy(&value, pData, sizeof(Type));
+            return value;
+        }
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      The stream must have been initialized with inflateInit2(-MAX_WBITS), as zip entries are raw deflate streams with no
+        //      zlib header. It is reset here, so one stream can be reused for any number of entries.
+        //
+        ///		@brief : Inflate a whole entry in one call.
+        ///		@returns : The zlib status. Z_STREAM_END on success.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        int InflateEntryData(z_stream& zStream, const uint8_t* pCompressedData, const uint32_t compressedSize, char* pOutput, const uint32_t uncompressedSize)
+        {
+            int zStatus = inflateReset(&zStream);
+            if (zStatus != Z_OK)
+                return zStatus;
+
+            zStream.next_in = const_cast<Bytef*>(pCompressedData);
+            zStream.avail_in = compressedSize;
+            zStream.next_out = reinterpret_cast<Bytef*>(pOutput);
+            zStream.avail_out = uncompressedSize;
+
+            zStatus = inflate(&zStream, Z_FINISH);
+            if (zStatus == Z_STREAM_END && zStream.total_out != uncompressedSize)
+                return Z_DATA_ERROR;
+
+            return zStatus;
+        }
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      The decoded data is checked against the entry's checksum, which catches corrupt packages that still decode.
+        //
+        ///		@brief : Decode a compressed entry into pOutput, which must be 'size' bytes.
+        ///		@param zStream : Stream to use for zlib entries. See InflateEntryData(). Unused for other codecs.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        bool DecodeEntryData(z_stream& zStream, const PackageCodec codec, const uint8_t* pStoredData, const uint32_t storedSize, char* pOutput, const uint32_t size, const uint32_t checksum)
+        {
+            bool succeeded = false;
+
+            switch (codec)
+            {
+                case PackageCodec::kZlib:
+                    succeeded = InflateEntryData(zStream, pStoredData, storedSize, pOutput, size) == Z_STREAM_END;
+                    break;
+
+                case PackageCodec::kLz:
+                    succeeded = LzDecompress(pStoredData, storedSize, reinterpret_cast<uint8_t*>(pOutput), size);
+                    break;
+
+                default: break;
+            }
+
+            return succeeded && crc32(0L, reinterpret_cast<const Bytef*>(pOutput), size) == checksum;
+        }
+    }
+
     AssetPackage::~AssetPackage()
     {
         // Free the stored data in this package from memory.
@@ -20,175 +94,671 @@ namespace mcp
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      Only the table of contents is read here. The data of each asset is decoded when it is first requested.
     //
-    ///		@brief : LoadPackage a package's assets into memory. This will put all of the uncompressed data into memory!
-    ///		@param pZipFileName : name of the zip file.
+    ///		@brief : Open a package, so that its assets can be requested. The format is detected from the file's contents.
+    ///		@param pPackageFileName : Path to the .zip or native package file.
     ///		@returns : True on success, false on failure.
     //-----------------------------------------------------------------------------------------------------------------------------
-    bool AssetPackage::LoadPackage(const char* pZipFileName)
+    bool AssetPackage::LoadPackage(const char* pPackageFileName)
     {
-        std::fstream stream;
-        stream.open(pZipFileName, std::ios::in | std::ios::binary);
-        if (!stream.is_open())
+        FreePackageData();
+
+        if (!m_file.Open(pPackageFileName))
         {
-            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Failed to open file: ", pZipFileName);
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Failed to open file: ", pPackageFileName);
             return false;
         }
 
-        ZipHeader zipHeader; // This will zero everything out.
+        const bool isNative = m_file.GetSize() >= sizeof(uint32_t) && ReadStruct<uint32_t>(m_file.GetData()) == kPackageSignature;
+        m_format = isNative ? Format::kNative : Format::kZip;
 
-        // Go to the end of the zip file, then move back by the size of the zip header.
-        constexpr std::streamoff kZipHeaderOffset = -static_cast<std::streamoff>(sizeof(zipHeader));
-        stream.seekg(kZipHeaderOffset, std::ios::end);
+        const bool succeeded = isNative ? ReadTableOfContents(pPackageFileName) : ReadCentralDirectory(pPackageFileName);
+        if (!succeeded)
+        {
+            FreePackageData();
+            return false;
+        }
 
-        // Populate the zipHeader information by reading directly into the zipHeader
-        stream.read(reinterpret_cast<char*>(&zipHeader), sizeof(zipHeader));
+        MCP_LOG("AssetPackage", "Opened package: ", pPackageFileName, " | Entries: ", m_entries.size(), " | Size: ", m_file.GetSize(), " bytes");
+        return true;
+    }
 
-        // Make sure that we have the correct zip signature.
-        if (zipHeader.signature != kZipSignature)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Entries are independent, so they are split between a pool of threads that each keep their own zlib stream. The
+    //      output buffers are allocated up front, and each entry is decoded straight into its own buffer, so the workers
+    //      never touch the entry list or allocate. The results are only published into the entries after every worker has
+    //      been joined.
+    //
+    //      The biggest entries are handed out first, so that one large entry isn't left for last while the other workers are
+    //      idle. The calling thread works as well.
+    //
+    ///		@brief : Decode every entry in the package on multiple threads, and keep them in memory until the package is unloaded.
+    ///		@param workerCount : Number of threads to decode with, including the calling thread. 0 means one per hardware thread.
+    ///		@returns : False if any entry failed to decode. The entries that succeeded are still kept.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AssetPackage::MakeResident(unsigned workerCount)
+    {
+        if (!m_file.IsOpen())
         {
-            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Package file was not a .zip!");
-            stream.close();
+            MCP_ERROR("AssetPackage", "Failed to make package resident! The package has not been loaded.");
             return false;
         }
 
-        std::streamoff dirOffset = zipHeader.dirOffset;
+        struct DecodeJob
+        {
+            Entry* pEntry = nullptr;
+            const uint8_t* pStoredData = nullptr;
+            char* pOutput = nullptr;
+            bool succeeded = false;
+        };
 
-        // Start reading from the spot of the file headers.
-        stream.seekg(dirOffset, std::ios::beg);
+        HighPrecisionTimer timer;
+        timer.Start();
 
-        // LoadPackage in the directory data in a buffer.
-        char* pDirData = BLEACH_NEW_ARRAY(char, zipHeader.dirSize);
-        memset(pDirData, 0, zipHeader.dirSize);
-        stream.read(pDirData, zipHeader.dirSize);
+        std::vector<DecodeJob> jobs;
+        jobs.reserve(m_entries.size());
+        size_t totalBytes = 0;
+        bool succeeded = true;
 
-        // Test the first file:
-        FileHeader* pFileHeader = reinterpret_cast<FileHeader*>(pDirData);
-        if (pFileHeader->signature != kFileSignature)
+        for (auto& entry : m_entries)
         {
-            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Failed to get FileHeader!");
-            stream.close();
-            BLEACH_DELETE_ARRAY(pDirData);
+            if (entry.data.pData)
+                continue;
+
+            const uint8_t* pEntryData = FindEntryData(entry);
+            if (!pEntryData)
+            {
+                succeeded = false;
+                continue;
+            }
+
+            // Stored data is used straight from the mapped file.
+            if (entry.codec == PackageCodec::kStore)
+            {
+                entry.data.pData = reinterpret_cast<char*>(const_cast<uint8_t*>(pEntryData));
+                entry.data.size = static_cast<int>(entry.size);
+                continue;
+            }
+
+            // Allocate at least 1 byte, so that empty files still have valid data.
+            char* pOutput = BLEACH_NEW_ARRAY(char, entry.size > 0 ? entry.size : 1);
+            jobs.push_back({ &entry, pEntryData, pOutput, false });
+            totalBytes += entry.size;
+        }
+
+        std::sort(jobs.begin(), jobs.end(), [](const DecodeJob& left, const DecodeJob& right)
+        {
+            return left.pEntry->size > right.pEntry->size;
+        });
+
+        if (workerCount == 0)
+            workerCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+        workerCount = static_cast<unsigned>(std::min<size_t>(workerCount, std::max<size_t>(jobs.size(), 1)));
+
+        std::atomic<size_t> nextJob = 0;
+        auto decodeJobs = [&jobs, &nextJob]()
+        {
+            z_stream zStream{};
+            zStream.zalloc = static_cast<alloc_func>(nullptr);
+            zStream.zfree = static_cast<free_func>(nullptr);
+
+            const bool hasStream = inflateInit2(&zStream, -MAX_WBITS) == Z_OK;
+
+            for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+            {
+                auto& job = jobs[i];
+                const Entry& entry = *job.pEntry;
+
+                if (hasStream || entry.codec != PackageCodec::kZlib)
+                    job.succeeded = DecodeEntryData(zStream, entry.codec, job.pStoredData, entry.storedSize, job.pOutput, entry.size, entry.checksum);
+            }
+
+            if (hasStream)
+                inflateEnd(&zStream);
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount - 1);
+        for (unsigned i = 1; i < workerCount; ++i)
+            workers.emplace_back(decodeJobs);
+
+        decodeJobs();
+
+        for (auto& worker : workers)
+            worker.join();
+
+        // Publish the results.
+        for (auto& job : jobs)
+        {
+            Entry& entry = *job.pEntry;
+
+            if (!job.succeeded)
+            {
+                MCP_ERROR("AssetPackage", "Failed to decode asset! Path hash: ", entry.pathHash);
+                BLEACH_DELETE_ARRAY(job.pOutput);
+                succeeded = false;
+                continue;
+            }
+
+            entry.pDecodedData = job.pOutput;
+            entry.data.pData = job.pOutput;
+            entry.data.size = static_cast<int>(entry.size);
+            m_cachedBytes += entry.size;
+        }
+
+        m_isResident = true;
+
+        MCP_LOG("AssetPackage", "Decoded ", jobs.size(), " entries (", totalBytes, " bytes) on ", workerCount, " threads in ", timer.GetTimer(), "ms");
+        return succeeded;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The RawData is only valid until the next request to this package, as requests can evict other entries from the cache.
+    //
+    ///		@brief : Returns the raw data in memory that matches the file name. If the filename does not exist, then
+    ///            it returns nullptr.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    RawData* AssetPackage::GetRawData(const char* pFileName)
+    {
+        return GetRawData(HashPath(pFileName));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns the raw data of the entry whose name hashes to pathHash, decoding it if necessary.
+    ///		@param pathHash : Hash of the entry's name. See HashPath().
+    ///		@param pDecodeMsOut : Optional. Set to the time spent decoding the entry, which is 0 if it was stored or already decoded.
+    ///		@returns : nullptr if there is no entry, or it failed to decode.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    RawData* AssetPackage::GetRawData(const uint64_t pathHash, double* pDecodeMsOut)
+    {
+        if (pDecodeMsOut)
+            *pDecodeMsOut = 0.0;
+
+        Entry* pEntry = FindEntry(pathHash);
+        if (!pEntry)
+        {
+            MCP_ERROR("AssetPackage", "Failed to find asset in package! Path hash: ", pathHash);
+            return nullptr; // Returns an invalid piece of data.
+        }
+
+        auto& entry = *pEntry;
+        entry.lastRequest = ++m_requestCount;
+
+        if (entry.data.pData)
+            return &entry.data;
+
+        const uint8_t* pEntryData = FindEntryData(entry);
+        if (!pEntryData)
+            return nullptr;
+
+        // Stored data is used straight from the mapped file.
+        if (entry.codec == PackageCodec::kStore)
+        {
+            entry.data.pData = reinterpret_cast<char*>(const_cast<uint8_t*>(pEntryData));
+            entry.data.size = static_cast<int>(entry.size);
+            return &entry.data;
+        }
+
+        HighPrecisionTimer timer;
+        timer.Start();
+
+        if (!Decode(entry, pEntryData))
+            return nullptr;
+
+        if (pDecodeMsOut)
+            *pDecodeMsOut = timer.GetTimer();
+
+        EvictToBudget(&entry);
+        return &entry.data;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      See PackageStream for how each codec is read. Free the stream with BLEACH_DELETE once you are done with it, and
+    //      before the package is unloaded.
+    //
+    ///		@brief : Open a stream that reads an entry's data without decoding all of it into the cache. Nothing is decoded here.
+    ///		@param pathHash : Hash of the entry's name. See HashPath().
+    ///		@returns : nullptr if there is no entry, or zlib failed to start.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    PackageStream* AssetPackage::OpenStream(const uint64_t pathHash)
+    {
+        Entry* pEntry = FindEntry(pathHash);
+        if (!pEntry)
+        {
+            MCP_ERROR("AssetPackage", "Failed to find asset in package! Path hash: ", pathHash);
+            return nullptr;
+        }
+
+        auto& entry = *pEntry;
+
+        // Resident entries are never freed, so the stream can read them in place.
+        if (m_isResident && entry.data.pData)
+            return BLEACH_NEW(PackageStream(m_openStreamCount, reinterpret_cast<const uint8_t*>(entry.data.pData), entry.size));
+
+        const uint8_t* pEntryData = FindEntryData(entry);
+        if (!pEntryData)
+            return nullptr;
+
+        if (entry.codec == PackageCodec::kStore)
+            return BLEACH_NEW(PackageStream(m_openStreamCount, pEntryData, entry.size));
+
+        if (entry.codec == PackageCodec::kZlib)
+        {
+            auto* pStream = BLEACH_NEW(PackageStream(m_openStreamCount, pEntryData, entry.size));
+            if (!pStream->BeginInflate(entry.storedSize, entry.checksum))
+            {
+                MCP_ERROR("AssetPackage", "Failed to begin inflating asset! Path hash: ", pathHash);
+                BLEACH_DELETE(pStream);
+                return nullptr;
+            }
+
+            return pStream;
+        }
+
+        // LZ entries have to be decoded whole. The cached copy may be evicted, so the stream gets its own.
+        if (entry.pDecodedData)
+        {
+            char* pDecodedData = BLEACH_NEW_ARRAY(char, entry.size > 0 ? entry.size : 1);
+            std::memcpy(pDecodedData, entry.pDecodedData, entry.size);
+
+            auto* pStream = BLEACH_NEW(PackageStream(m_openStreamCount, reinterpret_cast<const uint8_t*>(pDecodedData), entry.size));
+            pStream->m_pOwnedData = pDecodedData;
+            return pStream;
+        }
+
+        // Otherwise, the stream decodes it on its first use, which is on the worker for async loads.
+        auto* pStream = BLEACH_NEW(PackageStream(m_openStreamCount, pEntryData, entry.size));
+        pStream->BeginLzDecode(entry.storedSize, entry.checksum);
+        return pStream;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Free the decoded data of every entry. Does nothing if the package is resident.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AssetPackage::ClearCache()
+    {
+        if (m_isResident)
+            return;
+
+        for (auto& entry : m_entries)
+        {
+            FreeEntry(entry);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Set the number of bytes of decoded data that are kept cached. Entries are evicted immediately if we are over.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AssetPackage::SetCacheBudget(const size_t bytes)
+    {
+        m_cacheBudget = bytes;
+        EvictToBudget(nullptr);
+    }
+
+    bool AssetPackage::Contains(const uint64_t pathHash) const
+    {
+        const auto result = std::lower_bound(m_entries.begin(), m_entries.end(), pathHash, [](const Entry& entry, const uint64_t hash)
+        {
+            return entry.pathHash < hash;
+        });
+
+        return result != m_entries.end() && result->pathHash == pathHash;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Names are matched exactly, including the direction of the slashes.
+    //
+    ///		@brief : Get the hash that entries are stored by. Hash a path once and keep it, to avoid hashing it on every request.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    uint64_t AssetPackage::HashPath(const char* pFileName)
+    {
+        return HashString64(pFileName);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Zip64 archives are not supported.
+    //
+    ///		@brief : Find the end of central directory record, and add an Entry for each file in the central directory.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AssetPackage::ReadCentralDirectory(const char* pZipFileName)
+    {
+        const uint8_t* pFileData = m_file.GetData();
+        const size_t fileSize = m_file.GetSize();
+
+        if (fileSize < sizeof(ZipHeader))
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Package file was not a .zip: ", pZipFileName);
             return false;
         }
 
-        // For each file, we are going to get the name, decompress the data and store both in our assets map.
-        for (int i = 0; i < zipHeader.numberOfFiles; ++i)
+        // Search backwards for the zip header, in case the zip has a comment.
+        const size_t lastHeaderOffset = fileSize - sizeof(ZipHeader);
+        const size_t firstHeaderOffset = lastHeaderOffset > kMaxZipCommentLength ? lastHeaderOffset - kMaxZipCommentLength : 0;
+
+        ZipHeader zipHeader;
+        bool foundHeader = false;
+        for (size_t offset = lastHeaderOffset + 1; offset-- > firstHeaderOffset;)
         {
-            // Each file header is a different size, because of the name of the file at the end.
-            // We need to move over 1 FileHeader size over, then we need to move over the 
-            // nameLength times the byte size.
-            char* pNamePtr = reinterpret_cast<char*>(pFileHeader + 1);
+            if (ReadStruct<uint32_t>(pFileData + offset) == kZipSignature)
+            {
+                zipHeader = ReadStruct<ZipHeader>(pFileData + offset);
+                foundHeader = true;
+                break;
+            }
+        }
 
-            // Construct the Name.
-            char* pName = BLEACH_NEW_ARRAY(char, pFileHeader->nameLength + 1);
-            memcpy(pName, pNamePtr, pFileHeader->nameLength);
-            pName[pFileHeader->nameLength] = '\0';
+        if (!foundHeader)
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Package file was not a .zip: ", pZipFileName);
+            return false;
+        }
 
-            // Getting the data header
-            DataHeader dataHeader;
-            stream.seekg(pFileHeader->dataOffset, std::ios::beg);
-            stream.read(reinterpret_cast<char*>(&dataHeader), sizeof(dataHeader));
+        if (static_cast<size_t>(zipHeader.dirOffset) + zipHeader.dirSize > fileSize)
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The central directory is out of bounds: ", pZipFileName);
+            return false;
+        }
+
+        const uint8_t* pDir = pFileData + zipHeader.dirOffset;
+        const uint8_t* pDirEnd = pDir + zipHeader.dirSize;
+        m_entries.reserve(zipHeader.numberOfFiles);
 
-            // If we failed to get a data header signature, then something went horribly wrong and we need to quit.
-            if (dataHeader.signature != kDataSignature)
+        for (int i = 0; i < zipHeader.numberOfFiles; ++i)
+        {
+            if (pDir + sizeof(FileHeader) > pDirEnd)
             {
-                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Failed to get DataHeader of file: ", pName);
-                FreePackageData();
-                BLEACH_DELETE_ARRAY(pName);
-                stream.close();
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The central directory is truncated: ", pZipFileName);
                 return false;
             }
 
-            // Find the spot where the compressed data lives in the zip file and read it into a buffer.
-            stream.seekg(dataHeader.nameLength, std::ios::cur);
-            char* pData = BLEACH_NEW_ARRAY(char, dataHeader.compressedSize);
-            stream.read(pData, dataHeader.compressedSize);
+            const auto fileHeader = ReadStruct<FileHeader>(pDir);
+            if (fileHeader.signature != kFileSignature)
+            {
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Failed to get FileHeader!");
+                return false;
+            }
 
-            // If we are looking at compressed data, decompress it.
-            if (dataHeader.compression == Z_DEFLATED)
+            const char* pName = reinterpret_cast<const char*>(pDir + sizeof(FileHeader));
+            const size_t headerSize = sizeof(FileHeader) + fileHeader.nameLength + fileHeader.extraLength + fileHeader.commentLength;
+            if (pDir + headerSize > pDirEnd)
             {
-                // Create a buffer equal to the uncompressed size.
-                char* pUncompressedData = BLEACH_NEW_ARRAY(char, dataHeader.uncompressedSize);
-
-                // Set up a zStream
-                z_stream zStream;
-                zStream.next_in = reinterpret_cast<Bytef*>(pData);
-                zStream.avail_in = dataHeader.compressedSize;
-                zStream.next_out = reinterpret_cast<Bytef*>(pUncompressedData);
-                zStream.avail_out = dataHeader.uncompressedSize;
-                zStream.zalloc = static_cast<alloc_func>(nullptr); // Use the default allocator.
-                zStream.zfree = static_cast<free_func>(nullptr);   // Use the default deallocator.
-
-                // Perform the inflation.
-                int zStatus = inflateInit2(&zStream, -MAX_WBITS);
-                if (zStatus == Z_OK)
-                {
-                    zStatus = inflate(&zStream, Z_FINISH);
-                    inflateEnd(&zStream);
-
-                    if (zStatus == Z_STREAM_END)
-                    {
-                        zStatus = Z_OK;
-                    }
-
-                    // You have to end the inflation again. Don't know why.
-                    inflateEnd(&zStream);
-                }
-
-                // Free the compressed data from memory.
-                BLEACH_DELETE_ARRAY(pData);
-
-                // Set the Uncompressed data as our pData.
-                pData = pUncompressedData;
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The central directory is truncated: ", pZipFileName);
+                return false;
             }
 
-            // Add the name and pData to our map:
-            m_packageAssets.emplace(std::make_pair(pName, RawData{ pData , static_cast<int>(dataHeader.uncompressedSize)}));
+            pDir += headerSize;
 
-            // TODO: we don't need this extra allocation. Make the string above.
-            // Delete the allocated array.
-            BLEACH_DELETE_ARRAY(pName);
+            // Skip directories.
+            if (fileHeader.nameLength > 0 && pName[fileHeader.nameLength - 1] == '/')
+                continue;
 
-            // Update the position of our file header.
-            pFileHeader = reinterpret_cast<FileHeader*>(pNamePtr + pFileHeader->nameLength);
+            if (fileHeader.compression != 0 && fileHeader.compression != Z_DEFLATED)
+            {
+                MCP_WARN("AssetPackage", "Skipping asset '", std::string(pName, fileHeader.nameLength), "'. Unsupported compression method: ", fileHeader.compression);
+                continue;
+            }
+
+            Entry entry;
+            entry.pathHash = HashString64(pName, fileHeader.nameLength);
+            entry.offset = fileHeader.dataOffset;
+            entry.storedSize = fileHeader.compressedSize;
+            entry.size = fileHeader.uncompressedSize;
+            entry.checksum = fileHeader.crcCode;
+            entry.codec = fileHeader.compression == 0 ? PackageCodec::kStore : PackageCodec::kZlib;
+            m_entries.push_back(entry);
         }
 
-        stream.close();
-        BLEACH_DELETE_ARRAY(pDirData);
+        // Stable, so that the first of any entries with the same hash is the one that is kept.
+        std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& left, const Entry& right)
+        {
+            return left.pathHash < right.pathHash;
+        });
+
+        const auto duplicates = std::unique(m_entries.begin(), m_entries.end(), [](const Entry& left, const Entry& right)
+        {
+            return left.pathHash == right.pathHash;
+        });
+
+        if (duplicates != m_entries.end())
+        {
+            MCP_WARN("AssetPackage", "Skipping ", std::distance(duplicates, m_entries.end()), " assets in '", pZipFileName, "'. Other entries have the same name or path hash.");
+            m_entries.erase(duplicates, m_entries.end());
+        }
 
         return true;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      The table of contents is checked against its checksum, and every entry is bounds checked here, so that requests
+    //      don't have to.
     //
-    ///		@brief : Returns the raw data in memory that matches the file name. If the filename does not exist, then
-    ///            it returns nullptr.
+    ///		@brief : Read the header and table of contents of a native package.
     //-----------------------------------------------------------------------------------------------------------------------------
-    RawData* AssetPackage::GetRawData(const char* pFileName)
+    bool AssetPackage::ReadTableOfContents(const char* pPackageFileName)
     {
-        const auto result = m_packageAssets.find(pFileName);
-        if (result == m_packageAssets.end())
+        const uint8_t* pFileData = m_file.GetData();
+        const size_t fileSize = m_file.GetSize();
+
+        if (fileSize < sizeof(PackageHeader))
         {
-            MCP_ERROR("AssetPackage", "Failed to find asset in package! Filename: ", pFileName);
-            return nullptr; // Returns an invalid piece of data.
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The package header is truncated: ", pPackageFileName);
+            return false;
+        }
+
+        const auto header = ReadStruct<PackageHeader>(pFileData);
+        if (header.version != kPackageVersion)
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Unsupported package version: ", header.version, ". Expected: ", kPackageVersion);
+            return false;
+        }
+
+        const size_t tocSize = static_cast<size_t>(header.entryCount) * sizeof(PackageTocEntry);
+        if (header.tocOffset > fileSize || tocSize > fileSize - header.tocOffset)
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The table of contents is out of bounds: ", pPackageFileName);
+            return false;
+        }
+
+        const uint8_t* pToc = pFileData + header.tocOffset;
+        if (crc32(0L, pToc, static_cast<uInt>(tocSize)) != header.tocChecksum)
+        {
+            MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The table of contents is corrupt: ", pPackageFileName);
+            return false;
+        }
+
+        m_entries.resize(header.entryCount);
+
+        for (uint32_t i = 0; i < header.entryCount; ++i)
+        {
+            const auto tocEntry = ReadStruct<PackageTocEntry>(pToc + i * sizeof(PackageTocEntry));
+
+            if (tocEntry.offset > fileSize || tocEntry.storedSize > fileSize - tocEntry.offset)
+            {
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! An entry's data is out of bounds: ", pPackageFileName);
+                return false;
+            }
+
+            if (tocEntry.codec >= static_cast<uint8_t>(PackageCodec::kCount))
+            {
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! Unknown codec: ", static_cast<int>(tocEntry.codec));
+                return false;
+            }
+
+            if (i > 0 && tocEntry.pathHash <= m_entries[i - 1].pathHash)
+            {
+                MCP_ERROR("AssetPackage", "Failed to load AssetPackage! The table of contents is not sorted: ", pPackageFileName);
+                return false;
+            }
+
+            Entry& entry = m_entries[i];
+            entry.pathHash = tocEntry.pathHash;
+            entry.offset = tocEntry.offset;
+            entry.storedSize = tocEntry.storedSize;
+            entry.size = tocEntry.size;
+            entry.checksum = tocEntry.checksum;
+            entry.codec = static_cast<PackageCodec>(tocEntry.codec);
         }
 
-        return &result->second;
+        return true;
+    }
+
+    AssetPackage::Entry* AssetPackage::FindEntry(const uint64_t pathHash)
+    {
+        const auto result = std::lower_bound(m_entries.begin(), m_entries.end(), pathHash, [](const Entry& entry, const uint64_t hash)
+        {
+            return entry.pathHash < hash;
+        });
+
+        if (result == m_entries.end() || result->pathHash != pathHash)
+            return nullptr;
+
+        return &(*result);
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      For zips, the sizes in the local header can be 0 if the zip was streamed, so we only use it to find the start of the
+    //      data. Native entries were already bounds checked when the package was loaded.
     //
-    ///		@brief : Frees the data and the dynamically allocated names from memory.
+    ///		@brief : Get a pointer to the entry's (possibly compressed) data in the mapped file.
     //-----------------------------------------------------------------------------------------------------------------------------
-    void AssetPackage::FreePackageData()
+    const uint8_t* AssetPackage::FindEntryData(const Entry& entry) const
+    {
+        const uint8_t* pFileData = m_file.GetData();
+        const size_t fileSize = m_file.GetSize();
+
+        if (m_format == Format::kNative)
+            return pFileData + entry.offset;
+
+        if (entry.offset + sizeof(DataHeader) > fileSize)
+        {
+            MCP_ERROR("AssetPackage", "Failed to read asset! Local header is out of bounds.");
+            return nullptr;
+        }
+
+        const auto dataHeader = ReadStruct<DataHeader>(pFileData + entry.offset);
+        if (dataHeader.signature != kDataSignature)
+        {
+            MCP_ERROR("AssetPackage", "Failed to read asset! Failed to get DataHeader.");
+            return nullptr;
+        }
+
+        const size_t dataOffset = entry.offset + sizeof(DataHeader) + dataHeader.nameLength + dataHeader.extraLength;
+        if (dataOffset + entry.storedSize > fileSize)
+        {
+            MCP_ERROR("AssetPackage", "Failed to read asset! Data is out of bounds.");
+            return nullptr;
+        }
+
+        return pFileData + dataOffset;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Decode an entry's data into a new buffer that is owned by the entry.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AssetPackage::Decode(Entry& entry, const uint8_t* pStoredData)
+    {
+        // Allocate at least 1 byte, so that empty files still have valid data.
+        char* pDecodedData = BLEACH_NEW_ARRAY(char, entry.size > 0 ? entry.size : 1);
+
+        z_stream zStream{};
+        zStream.zalloc = static_cast<alloc_func>(nullptr); // Use the default allocator.
+        zStream.zfree = static_cast<free_func>(nullptr);   // Use the default deallocator.
+
+        // Only zlib entries need the stream.
+        const bool needsStream = entry.codec == PackageCodec::kZlib;
+        const bool hasStream = needsStream && inflateInit2(&zStream, -MAX_WBITS) == Z_OK;
+
+        const bool succeeded = (hasStream || !needsStream)
+            && DecodeEntryData(zStream, entry.codec, pStoredData, entry.storedSize, pDecodedData, entry.size, entry.checksum);
+
+        if (hasStream)
+            inflateEnd(&zStream);
+
+        if (!succeeded)
+        {
+            MCP_ERROR("AssetPackage", "Failed to decode asset! Path hash: ", entry.pathHash);
+            BLEACH_DELETE_ARRAY(pDecodedData);
+            return false;
+        }
+
+        entry.pDecodedData = pDecodedData;
+        entry.data.pData = pDecodedData;
+        entry.data.size = static_cast<int>(entry.size);
+        m_cachedBytes += entry.size;
+
+        return true;
+    }
+
+    void AssetPackage::FreeEntry(Entry& entry)
     {
-        for (auto [pName, data] : m_packageAssets)
+        if (entry.pDecodedData)
         {
-            // Delete the uncompressed data from memory.
-            BLEACH_DELETE_ARRAY(data.pData);
+            m_cachedBytes -= entry.size;
+            BLEACH_DELETE_ARRAY(entry.pDecodedData);
+            entry.pDecodedData = nullptr;
         }
+
+        entry.data = RawData{};
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Eviction is rare compared to requests, so we just search for the oldest entry each time instead of maintaining
+    //      a separate list.
+    //
+    ///		@brief : Free the least recently requested decoded entries until the cache is within its budget.
+    ///		@param pKeep : Entry that must not be freed, because it is being returned. Can be nullptr.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AssetPackage::EvictToBudget(const Entry* pKeep)
+    {
+        if (m_isResident)
+            return;
+
+        while (m_cachedBytes > m_cacheBudget)
+        {
+            Entry* pOldest = nullptr;
+            for (auto& entry : m_entries)
+            {
+                if (&entry == pKeep || !entry.pDecodedData)
+                    continue;
+
+                if (!pOldest || entry.lastRequest < pOldest->lastRequest)
+                    pOldest = &entry;
+            }
+
+            // Only the entry we are keeping is left.
+            if (!pOldest)
+                return;
+
+            FreeEntry(*pOldest);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Frees the decoded data and unmaps the package file.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AssetPackage::FreePackageData()
+    {
+        if (m_openStreamCount > 0)
+            MCP_ERROR("AssetPackage", "Unloading a package that still has ", m_openStreamCount.load(), " open streams! They will read freed memory.");
+
+        m_isResident = false;
+
+        for (auto& entry : m_entries)
+            FreeEntry(entry);
+
+        m_entries.clear();
+        m_file.Close();
     }
-}
\ No newline at end of file
+}
@@ -1,13 +1,15 @@
 #pragma once
 // AssetPackage.h
 
-#include <string>  // I don't want this include here, may need to change the structure.
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "MappedFile.h"
+#include "PackageFormat.h"
+#include "PackageStream.h"
 
 namespace mcp
 {
-    struct DataHeader;
-
     struct RawData
     {
         char* pData = nullptr;
@@ -16,14 +18,59 @@ namespace mcp
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
-    //		
-    ///		@brief : On disk, an AssetPackage is a .zip file. This class unzips the raw data and creates mappings to that data for
-    ///         to each resource.
+    //      Opening a package maps the file and reads its table of contents, nothing else. Each entry is found by the 64-bit hash
+    //      of its name (see HashPath()), and is only decoded the first time it is requested.
+    //
+    //      Stored (uncompressed) entries point straight into the mapped file and cost no extra memory. Decoded entries are
+    //      cached, and once the cache is over its budget, the least recently requested entries are freed. The RawData returned
+    //      by GetRawData() stays valid until the next request to this package, so use or copy it right away. Resources that
+    //      keep reading their data after they are loaded (fonts, streamed music) should read it through a stream instead
+    //      (see OpenStream()), which doesn't use the cache at all.
+    //
+    //      A package can also be made resident with MakeResident(), which decodes every entry up front on multiple threads and
+    //      keeps them until the package is unloaded. Use this when a package's assets will all be needed anyway.
+    //
+    //      The data of stored entries is read-only memory, even though RawData holds a char*. Never write to it.
+    //
+    ///		@brief : On disk, an AssetPackage is either a .zip file, or the engine's own package format (see PackageFormat.h).
+    ///         This class maps the file into memory and decodes each asset's data on demand.
     //-----------------------------------------------------------------------------------------------------------------------------
     class AssetPackage
     {
-        using Assets = std::unordered_map<std::string, RawData>;
-        Assets m_packageAssets;
+        enum class Format
+        {
+            kZip,
+            kNative,
+        };
+
+        struct Entry
+        {
+            uint64_t pathHash = 0;
+            uint64_t offset = 0;            // Zip: Offset of the local header. Native: Offset of the data.
+            uint32_t storedSize = 0;        // Size of the data in the file.
+            uint32_t size = 0;              // Size of the decoded data.
+            uint32_t checksum = 0;          // crc32 of the decoded data.
+            PackageCodec codec = PackageCodec::kStore;
+            RawData data;                   // Set once the entry has been requested.
+            char* pDecodedData = nullptr;   // Owned copy of the data, if the entry was compressed.
+            uint64_t lastRequest = 0;
+        };
+
+        // Sorted by pathHash.
+        using Entries = std::vector<Entry>;
+
+    public:
+        static constexpr size_t kDefaultCacheBudget = 64 * 1024 * 1024;
+
+    private:
+        MappedFile m_file;
+        Entries m_entries;
+        Format m_format = Format::kZip;
+        size_t m_cacheBudget = kDefaultCacheBudget;
+        size_t m_cachedBytes = 0;
+        uint64_t m_requestCount = 0;
+        bool m_isResident = false;          // Resident packages have every entry decoded, and never evict.
+        std::atomic<uint32_t> m_openStreamCount = 0; // Streams can be freed on any thread.
 
     public:
         AssetPackage() = default;
@@ -34,10 +81,31 @@ namespace mcp
         AssetPackage& operator=(const AssetPackage&) = delete;
         AssetPackage& operator=(AssetPackage&&) = delete;
 
-        bool LoadPackage(const char* pZipFileName);
+        bool LoadPackage(const char* pPackageFileName);
+        bool MakeResident(unsigned workerCount = 0);
         RawData* GetRawData(const char* pFileName);
+        RawData* GetRawData(const uint64_t pathHash, double* pDecodeMsOut = nullptr);
+        PackageStream* OpenStream(const uint64_t pathHash);
+        void ClearCache();
+        void SetCacheBudget(const size_t bytes);
+
+        [[nodiscard]] bool Contains(const uint64_t pathHash) const;
+        [[nodiscard]] size_t GetEntryCount() const { return m_entries.size(); }
+        [[nodiscard]] size_t GetCachedBytes() const { return m_cachedBytes; }
+        [[nodiscard]] size_t GetMappedSize() const { return m_file.GetSize(); }
+        [[nodiscard]] bool IsResident() const { return m_isResident; }
+        [[nodiscard]] uint32_t GetOpenStreamCount() const { return m_openStreamCount; }
+
+        static uint64_t HashPath(const char* pFileName);
 
     private:
+        bool ReadCentralDirectory(const char* pZipFileName);
+        bool ReadTableOfContents(const char* pPackageFileName);
+        [[nodiscard]] Entry* FindEntry(const uint64_t pathHash);
+        [[nodiscard]] const uint8_t* FindEntryData(const Entry& entry) const;
+        bool Decode(Entry& entry, const uint8_t* pStoredData);
+        void FreeEntry(Entry& entry);
+        void EvictToBudget(const Entry* pKeep);
         void FreePackageData();
     };
-}
\ No newline at end of file
+}
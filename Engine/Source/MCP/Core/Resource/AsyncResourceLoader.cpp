@@ -0,0 +1,342 @@
+// AsyncResourceLoader.cpp
+
+#include "AsyncResourceLoader.h"
+
+#include <algorithm>
+#include "MCP/Debug/Log.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+namespace mcp
+{
+    AsyncResourceLoader::~AsyncResourceLoader()
+    {
+        Close();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The workers are started on the first submit, so that we don't spin up threads for projects that never load
+    //      anything asynchronously.
+    //
+    ///		@brief : Queue a job to be decoded on a worker thread and then uploaded on the main thread.
+    ///		@param decode : Thread-safe function that returns the decoded data, or nullptr on failure.
+    ///		@param upload : Main thread function that receives the decoded data. This is called even if the decode failed.
+    ///		@param discard : Main thread function that frees the decoded data if the job is canceled.
+    ///		@param priority : Blocking jobs go to the front of the queue. Background jobs wait behind every other job.
+    ///		@returns : Handle to the job, or nullptr if the loader has been closed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    AsyncJobHandle AsyncResourceLoader::Submit(DecodeFunc&& decode, UploadFunc&& upload, DiscardFunc&& discard, const LoadPriority priority)
+    {
+        auto handle = std::make_shared<AsyncJobState>();
+
+        {
+            std::lock_guard lock(m_decodeMutex);
+            if (m_isTerminated)
+            {
+                MCP_ERROR("AsyncResourceLoader", "Failed to submit job! The loader has been closed.");
+                return nullptr;
+            }
+
+            if (m_workers.empty())
+                StartWorkers();
+
+            Job job{handle, std::move(decode), std::move(upload), std::move(discard)};
+
+            switch (priority)
+            {
+                case LoadPriority::kBlocking: m_decodeQueue.push_front(std::move(job)); break;
+                case LoadPriority::kHigh: m_decodeQueue.push_back(std::move(job)); break;
+                case LoadPriority::kBackground:
+                {
+                    job.isBackground = true;
+                    m_backgroundDecodeQueue.push_back(std::move(job));
+                    break;
+                }
+            }
+
+            ++m_jobsInFlight;
+        }
+
+        m_wakeCondition.notify_one();
+        return handle;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This should be called once a frame, before anything is rendered. Background jobs are only uploaded once every
+    //      other decoded job has been, so they only ever use the time that is left over.
+    //
+    ///		@brief : Run the upload stage of the decoded jobs on the main thread, until we run out of jobs or time.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AsyncResourceLoader::ProcessUploads()
+    {
+        if (m_jobsInFlight == 0)
+            return;
+
+        HighPrecisionTimer timer;
+        timer.Start();
+
+        while (true)
+        {
+            Job job;
+
+            {
+                std::lock_guard lock(m_uploadMutex);
+                auto& queue = !m_uploadQueue.empty() ? m_uploadQueue : m_backgroundUploadQueue;
+                if (queue.empty())
+                    return;
+
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            if (job.handle->isCanceled)
+            {
+                DiscardJob(job);
+            }
+
+            else
+            {
+                job.upload(job.pDecodedData);
+                --m_jobsInFlight;
+            }
+
+            // We always complete at least one job, so that a low budget can't stall loading completely.
+            if (m_uploadBudgetMs > 0.0 && timer.GetTimer() >= m_uploadBudgetMs)
+                return;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Main thread only. For when something can't wait for the job's turn, like a blocking load of a resource that is
+    //      already loading in the background. If the job hasn't been started, it is decoded on the main thread. If a worker is
+    //      decoding it, we wait for the worker to finish. The upload ignores the frame's budget.
+    //
+    ///		@brief : Decode and upload a job right now.
+    ///		@returns : False if the job was canceled, or the loader has been closed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AsyncResourceLoader::Complete(const AsyncJobHandle& handle)
+    {
+        if (!handle)
+            return false;
+
+        Job job;
+        bool isWaitingOnWorker = false;
+
+        {
+            std::lock_guard lock(m_decodeMutex);
+            if (m_isTerminated)
+                return false;
+
+            isWaitingOnWorker = !TakeJob(m_decodeQueue, handle, job) && !TakeJob(m_backgroundDecodeQueue, handle, job);
+        }
+
+        if (isWaitingOnWorker)
+        {
+            std::unique_lock lock(m_uploadMutex);
+            m_decodedCondition.wait(lock, [this, &handle, &job]() -> bool
+            {
+                return TakeJob(m_uploadQueue, handle, job) || TakeJob(m_backgroundUploadQueue, handle, job);
+            });
+        }
+
+        else if (!job.handle->isCanceled)
+        {
+            job.pDecodedData = job.decode();
+        }
+
+        if (job.handle->isCanceled)
+        {
+            DiscardJob(job);
+            return false;
+        }
+
+        job.upload(job.pDecodedData);
+        --m_jobsInFlight;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Any job that hasn't been uploaded is discarded. Nothing can be submitted after the loader is closed.
+    //
+    ///		@brief : Stop and join the worker threads.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AsyncResourceLoader::Close()
+    {
+        {
+            std::lock_guard lock(m_decodeMutex);
+            m_isTerminated = true;
+        }
+
+        m_wakeCondition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+
+        m_workers.clear();
+
+        // Jobs that were never decoded have nothing to free.
+        m_jobsInFlight -= m_decodeQueue.size() + m_backgroundDecodeQueue.size();
+        m_decodeQueue.clear();
+        m_backgroundDecodeQueue.clear();
+
+        for (auto* pQueue : {&m_uploadQueue, &m_backgroundUploadQueue})
+        {
+            for (auto& job : *pQueue)
+            {
+                DiscardJob(job);
+            }
+
+            pQueue->clear();
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This only has an effect before the workers are started.
+    //
+    ///		@brief : Set the number of worker threads. 0 will use one less than the number of hardware threads, up to 4.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AsyncResourceLoader::SetWorkerCount(const size_t workerCount)
+    {
+        if (!m_workers.empty())
+        {
+            MCP_WARN("AsyncResourceLoader", "Tried to set the worker count after the workers were started!");
+            return;
+        }
+
+        m_workerCount = workerCount;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The job will be skipped if it hasn't been decoded yet, otherwise the decoded data is discarded on the main thread.
+    //
+    ///		@brief : Cancel a job. The job's upload function will not be called after this.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AsyncResourceLoader::Cancel(const AsyncJobHandle& handle)
+    {
+        if (handle)
+            handle->isCanceled = true;
+    }
+
+    void AsyncResourceLoader::StartWorkers()
+    {
+        size_t workerCount = m_workerCount;
+        if (workerCount == 0)
+        {
+            const size_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = std::clamp<size_t>(hardwareThreads > 1 ? hardwareThreads - 1 : 1, 1, kMaxDefaultWorkers);
+        }
+
+        // Leave one worker free for high priority jobs, so a big batch of background loads can't hold them up.
+        m_maxBackgroundDecodes = workerCount > 1 ? workerCount - 1 : 1;
+
+        m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this]() -> void { ProcessDecodeJobs(); });
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Workers always take a high priority job first. With a single worker, background jobs can still block a high
+    //      priority job for as long as one decode takes.
+    //
+    ///		@brief : Main loop of each worker thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void AsyncResourceLoader::ProcessDecodeJobs()
+    {
+        while (true)
+        {
+            Job job;
+
+            {
+                std::unique_lock lock(m_decodeMutex);
+                m_wakeCondition.wait(lock, [this]() -> bool { return m_isTerminated || HasDecodeJob(); });
+
+                if (m_isTerminated)
+                    return;
+
+                auto& queue = !m_decodeQueue.empty() ? m_decodeQueue : m_backgroundDecodeQueue;
+                job = std::move(queue.front());
+                queue.pop_front();
+
+                if (job.isBackground)
+                    ++m_backgroundDecodes;
+            }
+
+            // Skip the decode if nobody wants the result anymore. The job still goes through the upload
+            // queue so that it is accounted for on the main thread.
+            if (!job.handle->isCanceled)
+                job.pDecodedData = job.decode();
+
+            if (job.isBackground)
+            {
+                {
+                    std::lock_guard lock(m_decodeMutex);
+                    --m_backgroundDecodes;
+                }
+
+                // Another background job may have been waiting on us to finish.
+                m_wakeCondition.notify_one();
+            }
+
+            {
+                std::lock_guard lock(m_uploadMutex);
+                auto& queue = job.isBackground ? m_backgroundUploadQueue : m_uploadQueue;
+                queue.push_back(std::move(job));
+            }
+
+            // The main thread may be waiting on this job in Complete().
+            m_decodedCondition.notify_all();
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Must be called with m_decodeMutex locked.
+    //
+    ///		@brief : Returns true if there is a job that a worker is allowed to start.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AsyncResourceLoader::HasDecodeJob() const
+    {
+        if (!m_decodeQueue.empty())
+            return true;
+
+        return !m_backgroundDecodeQueue.empty() && m_backgroundDecodes < m_maxBackgroundDecodes;
+    }
+
+    void AsyncResourceLoader::DiscardJob(Job& job)
+    {
+        if (job.pDecodedData)
+            job.discard(job.pDecodedData);
+
+        job.pDecodedData = nullptr;
+        --m_jobsInFlight;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The queue's mutex must be locked.
+    //
+    ///		@brief : Move the job with the handle out of the queue.
+    ///		@returns : False if the job isn't in the queue.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool AsyncResourceLoader::TakeJob(std::deque<Job>& queue, const AsyncJobHandle& handle, Job& jobOut)
+    {
+        const auto result = std::find_if(queue.begin(), queue.end(), [&handle](const Job& job) -> bool { return job.handle == handle; });
+        if (result == queue.end())
+            return false;
+
+        jobOut = std::move(*result);
+        queue.erase(result);
+        return true;
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+// AsyncResourceLoader.h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      - Blocking: Needed before the next frame is drawn. Blocking requests made through the ResourceManager are loaded on
+    //        the main thread; jobs submitted with this priority skip to the front of the queue.
+    //      - High: Needed soon, ex: something that just came on screen. These are decoded and uploaded first.
+    //      - Background: Streaming ahead of time, ex: the next area. These never take every worker, and are only uploaded
+    //        while there is time left in the frame's budget.
+    //
+    ///		@brief : How urgently a resource is needed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    enum class LoadPriority : uint8_t
+    {
+        kBlocking,
+        kHigh,
+        kBackground,
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Specialize this as true_type for resources that define LoadFromDiskAsyncImpl() and LoadFromRawDataAsyncImpl() (or
+    //      LoadFromStreamAsyncImpl(), if they stream from packages).
+    //      Any other resource type requested asynchronously is loaded on the main thread when its request is processed.
+    //
+    ///		@brief : Whether a ResourceType can be decoded on the AsyncResourceLoader's workers.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType>
+    struct SupportsAsyncLoad : std::false_type {};
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is shared between the loader and whoever requested the job. Canceling only sets a flag, so it is safe to do
+    //      at any point, even after the loader has been closed.
+    //
+    ///		@brief : Shared state of a single async load job.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct AsyncJobState
+    {
+        std::atomic_bool isCanceled = false;
+    };
+
+    using AsyncJobHandle = std::shared_ptr<AsyncJobState>;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      A job is split into two stages:
+    //          - Decode: Runs on one of the worker threads. This must be thread-safe; it should only turn raw bytes into
+    //            some intermediate data (ex: an SDL_Surface), and must not touch the renderer or any engine state.
+    //          - Upload: Runs on the main thread in ProcessUploads(), which is called once a frame. The uploads are limited
+    //            by a time budget so that a big batch of loads doesn't cause a spike. At least one upload is done each frame
+    //            so that we always make progress.
+    //      If a job is canceled, or the loader is closed, the Discard function is called with the decoded data instead of the
+    //      Upload function.
+    //
+    //      High and Background jobs are kept in separate queues for both stages, so background streaming can never delay
+    //      a load that is needed now.
+    //
+    ///		@brief : Pool of worker threads that decode resources off of the main thread, with a budgeted main-thread upload stage.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class AsyncResourceLoader
+    {
+    public:
+        using DecodeFunc = std::function<void*()>;
+        using UploadFunc = std::function<void(void* pDecodedData)>;
+        using DiscardFunc = std::function<void(void* pDecodedData)>;
+
+    private:
+        static constexpr size_t kMaxDefaultWorkers = 4;
+
+        struct Job
+        {
+            AsyncJobHandle handle;
+            DecodeFunc decode;
+            UploadFunc upload;
+            DiscardFunc discard;
+            void* pDecodedData = nullptr;
+            bool isBackground = false;
+        };
+
+        std::vector<std::thread> m_workers;
+        std::deque<Job> m_decodeQueue;              // Jobs waiting for a worker. Guarded by m_decodeMutex.
+        std::deque<Job> m_backgroundDecodeQueue;    // Background jobs waiting for a worker. Guarded by m_decodeMutex.
+        std::deque<Job> m_uploadQueue;              // Decoded jobs waiting for the main thread. Guarded by m_uploadMutex.
+        std::deque<Job> m_backgroundUploadQueue;    // Decoded background jobs waiting for the main thread. Guarded by m_uploadMutex.
+        std::mutex m_decodeMutex;
+        std::mutex m_uploadMutex;
+        std::condition_variable m_wakeCondition;    // Wakes the workers when there is a job, or when we are terminating.
+        std::condition_variable m_decodedCondition; // Wakes the main thread in Complete() when a worker finishes a decode.
+        std::atomic<size_t> m_jobsInFlight = 0;     // Number of jobs that have been submitted, but not uploaded or discarded.
+        size_t m_workerCount = 0;                   // Number of workers to start. 0 means pick based on the hardware.
+        size_t m_maxBackgroundDecodes = 1;          // Workers that can be decoding background jobs at once. Set when the workers start.
+        size_t m_backgroundDecodes = 0;             // Workers currently decoding background jobs. Guarded by m_decodeMutex.
+        double m_uploadBudgetMs = 2.0;              // Time allowed for uploads each frame. 0 means no limit.
+        bool m_isTerminated = false;                // Guarded by m_decodeMutex.
+
+    public:
+        AsyncResourceLoader() = default;
+        ~AsyncResourceLoader();
+
+        AsyncResourceLoader(const AsyncResourceLoader&) = delete;
+        AsyncResourceLoader(AsyncResourceLoader&&) noexcept = delete;
+        AsyncResourceLoader& operator=(const AsyncResourceLoader&) = delete;
+        AsyncResourceLoader& operator=(AsyncResourceLoader&&) noexcept = delete;
+
+        AsyncJobHandle Submit(DecodeFunc&& decode, UploadFunc&& upload, DiscardFunc&& discard, const LoadPriority priority = LoadPriority::kHigh);
+        void ProcessUploads();
+        bool Complete(const AsyncJobHandle& handle);
+        void Close();
+
+        void SetWorkerCount(const size_t workerCount);
+        void SetUploadBudget(const double budgetMs) { m_uploadBudgetMs = budgetMs; }
+
+        [[nodiscard]] size_t GetJobsInFlight() const { return m_jobsInFlight; }
+        [[nodiscard]] double GetUploadBudget() const { return m_uploadBudgetMs; }
+
+        static void Cancel(const AsyncJobHandle& handle);
+
+    private:
+        void StartWorkers();
+        void ProcessDecodeJobs();
+        bool HasDecodeJob() const;
+        void DiscardJob(Job& job);
+        static bool TakeJob(std::deque<Job>& queue, const AsyncJobHandle& handle, Job& jobOut);
+    };
+}
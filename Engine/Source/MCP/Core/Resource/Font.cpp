@@ -2,6 +2,7 @@
 
 #include "Font.h"
 
+#include "MCP/Core/Resource/PreloadManifest.h"
 #include "MCP/Core/Resource/ResourceManager.h"
 
 #if MCP_RENDERER_API == MCP_RENDERER_API_SDL
@@ -10,6 +11,9 @@
 namespace mcp
 {
     using FontAssetType = FontData;
+
+    // TTF fonts read from their data whenever a glyph is rendered, so they keep a stream over it.
+    template<> struct StreamsFromPackage<FontAssetType> : std::true_type {};
 }
 #else
 #error "We don't have a resource implementation for Texture loading for current API!'"
@@ -69,8 +73,21 @@ namespace mcp
         return GetCursorDistance(static_cast<_TTF_Font*>(pFontData->pFontResource), glyph);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Fonts are rendered on the main thread, so this is time-sliced with the other background loads rather than decoded
+    //      on a worker. The load holds a reference until it is released with ResourceManager::ReleaseLoad().
+    //
+    ///		@brief : Start loading a font in the background, without keeping a handle to it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceLoadHandle Font::Preload(const FontResourceRequest& request)
+    {
+        return ResourceManager::Get()->LoadAsync<FontAssetType>(request, LoadPriority::kBackground);
+    }
+
     void* Font::LoadResourceType()
     {
+        PreloadManifest::Record(PreloadAssetType::kFont, m_request, m_request.fontSize);
         return ResourceManager::Get()->LoadFromDisk<FontAssetType>(m_request);
     }
 
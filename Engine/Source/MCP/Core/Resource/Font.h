@@ -49,6 +49,8 @@ namespace mcp
         [[nodiscard]] int GetNextCharDistance(const uint32_t lastGlyph, const uint32_t nextGlyph) const;
         [[nodiscard]] int GetCursorDistanceAfterGlyph(const uint32_t glyph) const;
 
+        static ResourceLoadHandle Preload(const FontResourceRequest& request);
+
     private:
         virtual void* LoadResourceType() override;
     };
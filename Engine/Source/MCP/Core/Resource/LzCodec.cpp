@@ -0,0 +1,251 @@
+// LzCodec.cpp
+
+#include "LzCodec.h"
+
+#include <cstring>
+#include <vector>
+
+namespace mcp
+{
+    namespace
+    {
+        constexpr size_t kMinMatch = 4;
+        constexpr size_t kMaxOffset = 0xFFFF;
+        constexpr size_t kLastLiterals = 5;         // The last bytes are always literals,
+        constexpr size_t kMatchSafeDistance = 12;   // and no match starts this close to the end, so the decoder never over-reads.
+        constexpr unsigned kHashBits = 14;
+        constexpr unsigned kSkipTrigger = 6;        // Skip ahead faster the longer we go without finding a match.
+
+        uint32_t Read32(const uint8_t* pData)
+        {
+            uint32_t value;
+            std::memcpy(&value, pData, sizeof(value));
+            return value;
+        }
+
+        uint32_t HashSequence(const uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - kHashBits);
+        }
+
+        // Write the extra bytes of a length that didn't fit in the token.
+        uint8_t* WriteLength(uint8_t* pDest, size_t length)
+        {
+            while (length >= 255)
+            {
+                *pDest++ = 255;
+                length -= 255;
+            }
+
+            *pDest++ = static_cast<uint8_t>(length);
+            return pDest;
+        }
+
+        bool ReadLength(const uint8_t*& pSource, const uint8_t* pSourceEnd, size_t& length)
+        {
+            uint8_t value;
+            do
+            {
+                if (pSource >= pSourceEnd)
+                    return false;
+
+                value = *pSource++;
+                length += value;
+            } while (value == 255);
+
+            return true;
+        }
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ///		@brief : Write a sequence of literals, followed by a match if matchLength > 0.
+        ///		@returns : The new end of the output, or nullptr if it would not fit.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        uint8_t* WriteSequence(uint8_t* pDest, const uint8_t* pDestEnd, const uint8_t* pLiterals, const size_t literalCount, const size_t offset, const size_t matchLength)
+        {
+            // Token, literals, their extra length bytes, the offset and the match length's extra bytes.
+            const size_t worstCase = 1 + literalCount + literalCount / 255 + 1 + 2 + matchLength / 255 + 1;
+            if (static_cast<size_t>(pDestEnd - pDest) < worstCase)
+                return nullptr;
+
+            uint8_t* pToken = pDest++;
+            uint8_t token = 0;
+
+            if (literalCount >= 15)
+            {
+                token = 15 << 4;
+                pDest = WriteLength(pDest, literalCount - 15);
+            }
+
+            else
+            {
+                token = static_cast<uint8_t>(literalCount << 4);
+            }
+
+            if (literalCount > 0)
+            {
+                std::memcpy(pDest, pLiterals, literalCount);
+                pDest += literalCount;
+            }
+
+            if (matchLength > 0)
+            {
+                *pDest++ = static_cast<uint8_t>(offset & 0xFF);
+                *pDest++ = static_cast<uint8_t>(offset >> 8);
+
+                const size_t lengthCode = matchLength - kMinMatch;
+                if (lengthCode >= 15)
+                {
+                    token |= 15;
+                    pDest = WriteLength(pDest, lengthCode - 15);
+                }
+
+                else
+                {
+                    token |= static_cast<uint8_t>(lengthCode);
+                }
+            }
+
+            *pToken = token;
+            return pDest;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : The most bytes that LzCompress() can write for a source of this size.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t LzCompressBound(const size_t sourceSize)
+    {
+        return sourceSize + sourceSize / 255 + 16;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Matches are found with a single-entry hash table of the last position each 4-byte sequence was seen at. This is
+    //      greedy and doesn't look for the longest match, which keeps compression fast.
+    //
+    ///		@brief : Compress the source data.
+    ///		@param destCapacity : Size of pDest. Use LzCompressBound() to make sure the data always fits.
+    ///		@returns : Size of the compressed data, or 0 if it didn't fit in pDest.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t LzCompress(const uint8_t* pSource, const size_t sourceSize, uint8_t* pDest, const size_t destCapacity)
+    {
+        uint8_t* pOut = pDest;
+        const uint8_t* pDestEnd = pDest + destCapacity;
+        size_t anchor = 0;
+
+        if (sourceSize > kMatchSafeDistance)
+        {
+            std::vector<uint32_t> table(static_cast<size_t>(1) << kHashBits, 0);
+            const size_t matchStartLimit = sourceSize - kMatchSafeDistance;
+            const size_t matchEndLimit = sourceSize - kLastLiterals;
+
+            size_t position = 0;
+            size_t searchCount = 1 << kSkipTrigger;
+
+            while (position < matchStartLimit)
+            {
+                const uint32_t sequence = Read32(pSource + position);
+                const uint32_t hash = HashSequence(sequence);
+                const size_t candidate = table[hash];
+                table[hash] = static_cast<uint32_t>(position);
+
+                if (candidate >= position || position - candidate > kMaxOffset || Read32(pSource + candidate) != sequence)
+                {
+                    position += searchCount++ >> kSkipTrigger;
+                    continue;
+                }
+
+                size_t matchLength = kMinMatch;
+                while (position + matchLength < matchEndLimit && pSource[candidate + matchLength] == pSource[position + matchLength])
+                    ++matchLength;
+
+                pOut = WriteSequence(pOut, pDestEnd, pSource + anchor, position - anchor, position - candidate, matchLength);
+                if (!pOut)
+                    return 0;
+
+                position += matchLength;
+                anchor = position;
+                searchCount = 1 << kSkipTrigger;
+            }
+        }
+
+        pOut = WriteSequence(pOut, pDestEnd, pSource + anchor, sourceSize - anchor, 0, 0);
+        if (!pOut)
+            return 0;
+
+        return static_cast<size_t>(pOut - pDest);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every length and offset is checked against the buffers, so bad data fails instead of reading or writing out of bounds.
+    //
+    ///		@brief : Decompress data written by LzCompress().
+    ///		@param destSize : The exact size of the decompressed data.
+    ///		@returns : False if the data is corrupt or doesn't decompress to exactly destSize bytes.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool LzDecompress(const uint8_t* pSource, const size_t sourceSize, uint8_t* pDest, const size_t destSize)
+    {
+        const uint8_t* pIn = pSource;
+        const uint8_t* pInEnd = pSource + sourceSize;
+        uint8_t* pOut = pDest;
+        const uint8_t* pOutEnd = pDest + destSize;
+
+        while (pIn < pInEnd)
+        {
+            const uint8_t token = *pIn++;
+
+            size_t literalCount = token >> 4;
+            if (literalCount == 15 && !ReadLength(pIn, pInEnd, literalCount))
+                return false;
+
+            if (literalCount > static_cast<size_t>(pInEnd - pIn) || literalCount > static_cast<size_t>(pOutEnd - pOut))
+                return false;
+
+            if (literalCount > 0)
+            {
+                std::memcpy(pOut, pIn, literalCount);
+                pIn += literalCount;
+                pOut += literalCount;
+            }
+
+            // The last sequence has no match.
+            if (pIn == pInEnd)
+                break;
+
+            if (pInEnd - pIn < 2)
+                return false;
+
+            const size_t offset = static_cast<size_t>(pIn[0]) | (static_cast<size_t>(pIn[1]) << 8);
+            pIn += 2;
+
+            if (offset == 0 || offset > static_cast<size_t>(pOut - pDest))
+                return false;
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(pIn, pInEnd, matchLength))
+                return false;
+
+            matchLength += kMinMatch;
+            if (matchLength > static_cast<size_t>(pOutEnd - pOut))
+                return false;
+
+            const uint8_t* pMatch = pOut - offset;
+
+            // Overlapping matches repeat the bytes that were just written, so they have to be copied in order.
+            if (offset >= matchLength)
+            {
+                std::memcpy(pOut, pMatch, matchLength);
+                pOut += matchLength;
+            }
+
+            else
+            {
+                for (size_t i = 0; i < matchLength; ++i)
+                    *pOut++ = *pMatch++;
+            }
+        }
+
+        return pOut == pOutEnd;
+    }
+}
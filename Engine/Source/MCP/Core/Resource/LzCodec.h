@@ -0,0 +1,27 @@
+#pragma once
+// LzCodec.h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      A small LZ77 codec in the style of LZ4's block format. It compresses less than zlib, but decompresses several times
+    //      faster, which makes it a good fit for assets that are loaded often and don't shrink much further with zlib anyway.
+    //
+    //      The compressed data is a list of sequences. Each sequence is:
+    //          - A token byte. The high 4 bits are the literal count, the low 4 bits are the match length - 4.
+    //            A value of 15 means more length bytes follow (each adds 0-255, and a byte of 255 means another follows).
+    //          - The literal bytes.
+    //          - A 2-byte little-endian offset back into the output, and any extra match length bytes.
+    //      The last sequence only has literals.
+    //
+    //      The sizes are not stored in the data, so the decompressed size must be known up front (packages store it per entry).
+    //-----------------------------------------------------------------------------------------------------------------------------
+
+    size_t LzCompressBound(const size_t sourceSize);
+    size_t LzCompress(const uint8_t* pSource, const size_t sourceSize, uint8_t* pDest, const size_t destCapacity);
+    bool LzDecompress(const uint8_t* pSource, const size_t sourceSize, uint8_t* pDest, const size_t destSize);
+}
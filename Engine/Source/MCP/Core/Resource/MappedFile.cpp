@@ -0,0 +1,151 @@
+// MappedFile.cpp
+
+#include "MappedFile.h"
+
+#include <utility>
+#include "MCP/Debug/Log.h"
+
+#if _WIN32
+#pragma warning (push)
+#pragma warning (disable : 5105)
+#include <Windows.h>
+#pragma warning (pop)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcp
+{
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& right) noexcept
+        : m_pData(right.m_pData)
+        , m_size(right.m_size)
+        , m_fileHandle(right.m_fileHandle)
+        , m_mappingHandle(right.m_mappingHandle)
+    {
+        right.m_pData = nullptr;
+        right.m_size = 0;
+        right.m_fileHandle = nullptr;
+        right.m_mappingHandle = nullptr;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& right) noexcept
+    {
+        if (&right != this)
+        {
+            Close();
+            std::swap(m_pData, right.m_pData);
+            std::swap(m_size, right.m_size);
+            std::swap(m_fileHandle, right.m_fileHandle);
+            std::swap(m_mappingHandle, right.m_mappingHandle);
+        }
+
+        return *this;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Map a file into memory. Any file that was already open is closed first.
+    ///		@returns : False if the file couldn't be opened or is empty.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool MappedFile::Open(const char* pFilepath)
+    {
+        Close();
+
+#if _WIN32
+        HANDLE file = CreateFileA(pFilepath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            MCP_ERROR("MappedFile", "Failed to open file: ", pFilepath);
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            MCP_ERROR("MappedFile", "Failed to map file! File is empty: ", pFilepath);
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            MCP_ERROR("MappedFile", "Failed to create file mapping for: ", pFilepath);
+            CloseHandle(file);
+            return false;
+        }
+
+        void* pView = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!pView)
+        {
+            MCP_ERROR("MappedFile", "Failed to map view of file: ", pFilepath);
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle = file;
+        m_mappingHandle = mapping;
+        m_pData = static_cast<const uint8_t*>(pView);
+        m_size = static_cast<size_t>(size.QuadPart);
+
+#else
+        const int file = open(pFilepath, O_RDONLY);
+        if (file < 0)
+        {
+            MCP_ERROR("MappedFile", "Failed to open file: ", pFilepath);
+            return false;
+        }
+
+        struct stat fileStat {};
+        if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            MCP_ERROR("MappedFile", "Failed to map file! File is empty: ", pFilepath);
+            close(file);
+            return false;
+        }
+
+        void* pView = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping keeps its own reference to the file.
+        close(file);
+
+        if (pView == MAP_FAILED)
+        {
+            MCP_ERROR("MappedFile", "Failed to map file: ", pFilepath);
+            return false;
+        }
+
+        m_pData = static_cast<const uint8_t*>(pView);
+        m_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (!m_pData)
+            return;
+
+#if _WIN32
+        UnmapViewOfFile(m_pData);
+        CloseHandle(m_mappingHandle);
+        CloseHandle(m_fileHandle);
+#else
+        munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+
+        m_pData = nullptr;
+        m_size = 0;
+        m_fileHandle = nullptr;
+        m_mappingHandle = nullptr;
+    }
+}
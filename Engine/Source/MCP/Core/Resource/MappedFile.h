@@ -0,0 +1,39 @@
+#pragma once
+// MappedFile.h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The OS only reads the pages that are actually touched, and can drop them again under memory pressure, so opening a
+    //      large file costs almost nothing until its data is used.
+    //
+    ///		@brief : A read-only view of an entire file in memory.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class MappedFile
+    {
+        const uint8_t* m_pData = nullptr;
+        size_t m_size = 0;
+        void* m_fileHandle = nullptr;       // Windows only.
+        void* m_mappingHandle = nullptr;    // Windows only.
+
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& right) noexcept;
+        MappedFile& operator=(MappedFile&& right) noexcept;
+
+        bool Open(const char* pFilepath);
+        void Close();
+
+        [[nodiscard]] const uint8_t* GetData() const { return m_pData; }
+        [[nodiscard]] size_t GetSize() const { return m_size; }
+        [[nodiscard]] bool IsOpen() const { return m_pData != nullptr; }
+    };
+}
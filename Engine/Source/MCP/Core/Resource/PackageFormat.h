@@ -0,0 +1,65 @@
+#pragma once
+// PackageFormat.h
+
+#include <cstdint>
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      The engine's own package format, written by the AssetPacker tool. The layout is:
+//          - PackageHeader
+//          - The table of contents: one PackageTocEntry per asset, sorted by pathHash so an entry can be found with a binary search.
+//          - The data of each entry, starting on a kPackageAlignment boundary.
+//
+//      Because each entry starts on a page boundary, a stored entry can be used straight from a memory mapped file with no
+//      copy, and its pages are never shared with another entry.
+//
+//      Entries are found by the 64-bit FNV-1a hash of their path (HashString64()); the paths themselves are not stored.
+//      Assets with identical contents are only stored once, so several entries can have the same offset.
+//
+//      All values are little-endian.
+//-----------------------------------------------------------------------------------------------------------------------------
+
+namespace mcp
+{
+    static constexpr uint32_t kPackageSignature = 0x4B50434D; // "MCPK"
+    static constexpr uint16_t kPackageVersion = 1;
+    static constexpr uint32_t kPackageAlignment = 4096;
+
+    enum class PackageCodec : uint8_t
+    {
+        kStore = 0,     // Uncompressed.
+        kZlib = 1,      // Raw deflate stream, with no zlib header, just like a zip entry.
+        kLz = 2,        // See LzCodec.h.
+        kCount,
+    };
+
+#pragma pack(1)
+    struct PackageHeader
+    {
+        uint32_t signature          = 0; // kPackageSignature.
+        uint16_t version            = 0; // kPackageVersion.
+        uint16_t reserved           = 0;
+        uint32_t entryCount         = 0; // Number of PackageTocEntry in the table of contents.
+        uint32_t alignment          = 0; // Alignment of each entry's data. kPackageAlignment.
+        uint64_t tocOffset          = 0; // Where the table of contents starts.
+        uint32_t tocChecksum        = 0; // crc32 of the table of contents.
+        uint32_t reserved2          = 0;
+    };
+#pragma pack()
+
+#pragma pack(1)
+    struct PackageTocEntry
+    {
+        uint64_t pathHash           = 0; // HashString64() of the asset's path.
+        uint64_t offset             = 0; // Where the data starts.
+        uint32_t storedSize         = 0; // Size of the data in the package.
+        uint32_t size               = 0; // Size of the data once it is decoded.
+        uint32_t checksum           = 0; // crc32 of the decoded data.
+        uint8_t codec               = 0; // PackageCodec.
+        uint8_t reserved[3]         = {};
+    };
+#pragma pack()
+
+    static_assert(sizeof(PackageHeader) == 32, "PackageHeader must match the file format!");
+    static_assert(sizeof(PackageTocEntry) == 32, "PackageTocEntry must match the file format!");
+}
@@ -2,6 +2,7 @@
 
 #include "PackageManager.h"
 
+#include <algorithm>
 #include <BleachNew.h>
 #include "AssetPackage.h"
 #include "MCP/Debug/Log.h"
@@ -30,12 +31,25 @@ namespace mcp
         }
     }
 
-    bool PackageManager::LoadPackage(const char* pZipFileName)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Open a package so that its assets can be requested.
+    ///		@param pZipFileName : Path to the package.
+    ///		@param makeResident : If true, every entry is decoded now on multiple threads and kept until the package is unloaded.
+    ///             Otherwise, entries are decoded when they are requested.
+    ///		@returns : True if the package is loaded.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool PackageManager::LoadPackage(const char* pZipFileName, const bool makeResident)
     {
         // If we already have that package loaded into memory, don't load it.
         if (const auto result = m_packages.find(pZipFileName); result != m_packages.end())
         {
             MCP_WARN("PackageManager", "Tried to reload a package with name: ", pZipFileName);
+
+            if (makeResident && !result->second->IsResident())
+                result->second->MakeResident();
+
             return true;
         }
 
@@ -44,10 +58,18 @@ namespace mcp
         if (!pPackage->LoadPackage(pZipFileName))
         {
             MCP_WARN("PackageManager", "Failed to load package: ", pZipFileName);
+            BLEACH_DELETE(pPackage);
             return false;
         }
-        
-        m_packages.emplace(pZipFileName, pPackage);
+
+        pPackage->SetCacheBudget(m_cacheBudget);
+
+        // A failed entry is reported by the package, and will fail again if it is requested. The rest are still usable.
+        if (makeResident)
+            pPackage->MakeResident();
+
+        const auto result = m_packages.emplace(pZipFileName, pPackage).first;
+        m_loadOrder.emplace_back(result->first);
         return true;
     }
 
@@ -60,6 +82,7 @@ namespace mcp
             return;
         }
 
+        m_loadOrder.erase(std::find(m_loadOrder.begin(), m_loadOrder.end(), result->first));
         BLEACH_DELETE(result->second);
         m_packages.erase(result);
     }
@@ -75,30 +98,107 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     RawData* PackageManager::GetRawData(const char* pPackagePath, const char* pFileName)
     {
-        auto result = m_packages.find(pPackagePath);
+        auto* pRawData = GetRawData(StringId(pPackagePath), AssetPackage::HashPath(pFileName));
+        if (!pRawData)
+        {
+            MCP_ERROR("AssetPackage", "Failed to find asset with name: ", pFileName, ", in package named: ", pPackagePath);
+            return nullptr;
+        }
+
+        return pRawData;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Prefer this version when you have the hash already (ex: DiskResourceRequest::pathHash), so no string work is done.
+    //      The data is only valid until the next request to the same package.
+    //
+    ///		@brief : Get the raw data of an asset from the package specified, by the hash of its path. If the package isn't loaded,
+    ///             we will load it here.
+    ///		@param pDecodeMsOut : Optional. Set to the time spent decompressing the asset. See AssetPackage::GetRawData().
+    ///		@returns : Ptr to the raw data on success, otherwise nullptr.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    RawData* PackageManager::GetRawData(const StringId packagePath, const uint64_t pathHash, double* pDecodeMsOut)
+    {
+        AssetPackage* pPackage = GetOrLoadPackage(packagePath);
+        if (!pPackage)
+            return nullptr;
+
+        return pPackage->GetRawData(pathHash, pDecodeMsOut);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The package must stay loaded until the stream is freed. See AssetPackage::OpenStream().
+    //
+    ///		@brief : Open a stream over an asset in the package specified. If the package isn't loaded, we will load it here.
+    ///		@returns : The stream, which must be freed with BLEACH_DELETE, or nullptr on failure.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    PackageStream* PackageManager::OpenStream(const StringId packagePath, const uint64_t pathHash)
+    {
+        AssetPackage* pPackage = GetOrLoadPackage(packagePath);
+        if (!pPackage)
+            return nullptr;
+
+        return pPackage->OpenStream(pathHash);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      For assets that aren't requested from a specific package, like Lua modules. Packages that were loaded later are
+    //      searched first, so a patch package can replace assets in the packages loaded before it. Only loaded packages are
+    //      searched. The data is only valid until the next request to the same package.
+    //
+    ///		@brief : Find an asset in any loaded package, by the hash of its path.
+    ///		@param pPackagePathOut : Optional. Set to the package that the asset was found in.
+    ///		@returns : Ptr to the raw data, or nullptr if no loaded package has the asset, or it failed to decode.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    RawData* PackageManager::FindRawData(const uint64_t pathHash, StringId* pPackagePathOut)
+    {
+        for (auto it = m_loadOrder.rbegin(); it != m_loadOrder.rend(); ++it)
+        {
+            auto* pPackage = m_packages.find(*it)->second;
+            if (!pPackage->Contains(pathHash))
+                continue;
+
+            if (pPackagePathOut)
+                *pPackagePathOut = *it;
+
+            return pPackage->GetRawData(pathHash);
+        }
+
+        return nullptr;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Set the number of bytes of decoded data that each package keeps cached.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void PackageManager::SetCacheBudget(const size_t bytes)
+    {
+        m_cacheBudget = bytes;
+
+        for (auto& [name, pPackage] : m_packages)
+        {
+            pPackage->SetCacheBudget(bytes);
+        }
+    }
+
+    AssetPackage* PackageManager::GetOrLoadPackage(const StringId packagePath)
+    {
+        auto result = m_packages.find(packagePath);
         if (result == m_packages.end())
         {
-            MCP_WARN("PackageManager", "Trying to get data from unloaded package. Loading now...\nPackage name: ", pPackagePath);
+            MCP_WARN("PackageManager", "Trying to get data from unloaded package. Loading now...\nPackage name: ", packagePath.GetCStr());
 
-            if (!LoadPackage(pPackagePath))
+            if (!LoadPackage(packagePath.GetCStr()))
             {
                 // Load package will take care of the error msg.
                 return nullptr;
             }
 
-            result = m_packages.find(pPackagePath);
+            result = m_packages.find(packagePath);
         }
 
-        AssetPackage* pPackage = result->second;
-
-        auto* pRawData = pPackage->GetRawData(pFileName);
-        if (!pRawData)
-        {
-            MCP_ERROR("AssetPackage", "Failed to find asset with name: ", pFileName, ", in package named: ", pPackagePath);
-            return nullptr;
-        }
-
-        return pRawData;
+        return result->second;
     }
-
 }
@@ -2,6 +2,7 @@
 // PackageManager.h
 
 #include <unordered_map>
+#include <vector>
 #include "AssetPackage.h"
 #include "Utility/String/StringId.h"
 
@@ -14,6 +15,8 @@ namespace mcp
 
         static inline PackageManager* s_pInstance = nullptr;
         PackageMap m_packages;
+        std::vector<StringId> m_loadOrder;      // Loaded packages, oldest first. Searched newest first by FindRawData().
+        size_t m_cacheBudget = AssetPackage::kDefaultCacheBudget;
 
     public:
         PackageManager(const PackageManager&) = delete;
@@ -29,8 +32,15 @@ namespace mcp
         static PackageManager* Get() { return s_pInstance; }
         static void Destroy();
 
-        bool LoadPackage(const char* pZipFileName);
+        bool LoadPackage(const char* pZipFileName, const bool makeResident = false);
         void UnloadPackage(const char* pZipFileName);
         RawData* GetRawData(const char* pPackagePath, const char* pFileName);
+        RawData* GetRawData(const StringId packagePath, const uint64_t pathHash, double* pDecodeMsOut = nullptr);
+        PackageStream* OpenStream(const StringId packagePath, const uint64_t pathHash);
+        RawData* FindRawData(const uint64_t pathHash, StringId* pPackagePathOut = nullptr);
+        void SetCacheBudget(const size_t bytes);
+
+    private:
+        AssetPackage* GetOrLoadPackage(const StringId packagePath);
     };
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+// PackageStream.cpp
+
+#include "PackageStream.h"
+
+#include <algorithm>
+#include <BleachNew.h>
+#include <cstring>
+#define ZLIB_WINAPI
+#include <zlib.h>
+#include "MCP/Debug/Log.h"
+#include "MCP/Core/Resource/LzCodec.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+namespace mcp
+{
+    struct PackageStream::InflateState
+    {
+        static constexpr size_t kSkipBufferSize = 16 * 1024;
+
+        z_stream zStream{};
+        uint32_t crc = 0;                       // crc32 of everything inflated since the last restart.
+        bool isFinished = false;
+        uint8_t skipBuffer[kSkipBufferSize];    // Bytes that are skipped over when seeking are inflated into here.
+    };
+
+    PackageStream::PackageStream(std::atomic<uint32_t>& openStreamCount, const uint8_t* pData, const uint32_t size)
+        : m_openStreamCount(openStreamCount)
+        , m_pData(pData)
+        , m_size(size)
+    {
+        ++m_openStreamCount;
+    }
+
+    PackageStream::~PackageStream()
+    {
+        if (m_pInflate)
+        {
+            inflateEnd(&m_pInflate->zStream);
+            BLEACH_DELETE(m_pInflate);
+        }
+
+        if (m_pOwnedData)
+            BLEACH_DELETE_ARRAY(m_pOwnedData);
+
+        --m_openStreamCount;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Read up to 'size' bytes into pDest.
+    ///		@returns : Number of bytes read. Less than size at the end of the entry, or if compressed data is corrupt.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t PackageStream::Read(void* pDest, const size_t size)
+    {
+        if (!DecodeWhole())
+            return 0;
+
+        const size_t toRead = static_cast<size_t>(std::min<uint64_t>(size, m_size - m_position));
+        if (toRead == 0)
+            return 0;
+
+        if (m_pInflate)
+            return Inflate(static_cast<uint8_t*>(pDest), toRead);
+
+        std::memcpy(pDest, m_pData + m_position, toRead);
+        m_position += toRead;
+        return toRead;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Like SDL's memory streams, seeking past the end stops at the end.
+    //
+    ///		@brief : Move the read position.
+    ///		@returns : The new position, or -1 on failure.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    int64_t PackageStream::Seek(const int64_t offset, const SeekOrigin origin)
+    {
+        if (!DecodeWhole())
+            return -1;
+
+        int64_t base = 0;
+        switch (origin)
+        {
+            case SeekOrigin::kBegin: base = 0; break;
+            case SeekOrigin::kCurrent: base = static_cast<int64_t>(m_position); break;
+            case SeekOrigin::kEnd: base = static_cast<int64_t>(m_size); break;
+        }
+
+        const int64_t target = base + offset;
+        if (target < 0)
+            return -1;
+
+        const uint64_t newPosition = std::min<uint64_t>(static_cast<uint64_t>(target), m_size);
+
+        if (!m_pInflate)
+        {
+            m_position = newPosition;
+            return static_cast<int64_t>(m_position);
+        }
+
+        // Inflating can only go forward.
+        if (newPosition < m_position && !RestartInflate())
+            return -1;
+
+        while (m_position < newPosition)
+        {
+            const size_t toSkip = static_cast<size_t>(std::min<uint64_t>(newPosition - m_position, InflateState::kSkipBufferSize));
+            if (Inflate(m_pInflate->skipBuffer, toSkip) == 0)
+                return -1;
+        }
+
+        return static_cast<int64_t>(m_position);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Streams that are inflating don't have their data in memory. An LZ entry is decoded here if it hasn't been yet.
+    //
+    ///		@brief : Get all of the entry's decoded data, if it is in memory. Otherwise, returns nullptr and it must be Read().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    const char* PackageStream::GetData()
+    {
+        if (m_pInflate || !DecodeWhole())
+            return nullptr;
+
+        return reinterpret_cast<const char*>(m_pData);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The first read, seek or GetData() call does this anyway. The time it took is kept in GetDecodeMs().
+    //
+    ///		@brief : Decode an LZ entry whole, if it hasn't been yet. Does nothing for any other entry.
+    ///		@returns : False if the entry failed to decode. The stream can't be read after that.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool PackageStream::DecodeWhole()
+    {
+        if (!m_isLzPending)
+            return !m_hasFailed;
+
+        m_isLzPending = false;
+
+        HighPrecisionTimer timer;
+        timer.Start();
+
+        m_pOwnedData = BLEACH_NEW_ARRAY(char, m_size > 0 ? m_size : 1);
+        auto* pOutput = reinterpret_cast<uint8_t*>(m_pOwnedData);
+
+        if (!LzDecompress(m_pData, m_storedSize, pOutput, m_size) || crc32(0L, pOutput, m_size) != m_checksum)
+        {
+            MCP_ERROR("PackageStream", "Failed to decode package entry! The package is corrupt.");
+            m_hasFailed = true;
+            m_size = 0;
+        }
+
+        m_pData = pOutput;
+        m_decodeMs = timer.GetTimer();
+        return !m_hasFailed;
+    }
+
+    void PackageStream::BeginLzDecode(const uint32_t storedSize, const uint32_t checksum)
+    {
+        m_storedSize = storedSize;
+        m_checksum = checksum;
+        m_isLzPending = true;
+    }
+
+    bool PackageStream::BeginInflate(const uint32_t storedSize, const uint32_t checksum)
+    {
+        m_storedSize = storedSize;
+        m_checksum = checksum;
+        m_pInflate = BLEACH_NEW(InflateState);
+
+        // Package entries are raw deflate streams, with no zlib header.
+        if (inflateInit2(&m_pInflate->zStream, -MAX_WBITS) != Z_OK)
+        {
+            BLEACH_DELETE(m_pInflate);
+            m_pInflate = nullptr;
+            return false;
+        }
+
+        return RestartInflate();
+    }
+
+    bool PackageStream::RestartInflate()
+    {
+        auto& zStream = m_pInflate->zStream;
+        if (inflateReset(&zStream) != Z_OK)
+            return false;
+
+        zStream.next_in = const_cast<Bytef*>(m_pData);
+        zStream.avail_in = m_storedSize;
+        m_pInflate->crc = static_cast<uint32_t>(crc32(0L, Z_NULL, 0));
+        m_pInflate->isFinished = false;
+        m_position = 0;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Everything is inflated front to back from the last restart, so once the whole entry has been inflated, we can check
+    //      it against the entry's checksum.
+    //
+    ///		@brief : Inflate the next 'size' bytes into pDest.
+    ///		@returns : Number of bytes inflated.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t PackageStream::Inflate(uint8_t* pDest, const size_t size)
+    {
+        auto& state = *m_pInflate;
+        auto& zStream = state.zStream;
+
+        zStream.next_out = pDest;
+        zStream.avail_out = static_cast<uInt>(size);
+
+        while (zStream.avail_out > 0 && !state.isFinished)
+        {
+            const int zStatus = inflate(&zStream, Z_NO_FLUSH);
+            if (zStatus == Z_STREAM_END)
+            {
+                state.isFinished = true;
+                break;
+            }
+
+            if (zStatus != Z_OK)
+            {
+                MCP_ERROR("PackageStream", "Failed to inflate package entry! zlib status: ", zStatus);
+                break;
+            }
+        }
+
+        const size_t inflated = size - zStream.avail_out;
+        state.crc = static_cast<uint32_t>(crc32(state.crc, pDest, static_cast<uInt>(inflated)));
+        m_position += inflated;
+
+        if (inflated > 0 && m_position == m_size && state.crc != m_checksum)
+            MCP_ERROR("PackageStream", "Streamed package entry does not match its checksum! The package is corrupt.");
+
+        return inflated;
+    }
+}
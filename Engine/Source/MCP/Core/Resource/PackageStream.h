@@ -0,0 +1,79 @@
+#pragma once
+// PackageStream.h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Streams are opened with AssetPackage::OpenStream(), and never touch the package's cache, so the whole entry never has
+    //      to be held in memory:
+    //          - Stored entries, and entries of resident packages, are read straight from the package's memory.
+    //          - zlib entries are inflated as they are read, so a stream only costs its zlib state. Seeking backwards restarts
+    //            the inflate from the start of the entry, so compressed entries should only be streamed front to back. Music
+    //            is already compressed, and is stored by the AssetPacker anyway.
+    //          - LZ entries can't be decoded in pieces, so they are decoded whole into a buffer owned by the stream, the first
+    //            time that the stream is used. Opening the stream is cheap, so the decode happens on whichever thread reads it,
+    //            like the worker of an async load. Call DecodeWhole() to decode it somewhere else.
+    //
+    //      A stream only reads memory that doesn't change while the package is loaded, so it can be read and freed on any
+    //      thread (one thread at a time), like the audio thread that streams music. The package must stay loaded until every
+    //      stream opened from it has been freed.
+    //
+    ///		@brief : Reads the data of a single package entry, decoding it on the fly if it is compressed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class PackageStream
+    {
+        friend class AssetPackage;
+        struct InflateState;
+
+    public:
+        enum class SeekOrigin
+        {
+            kBegin,
+            kCurrent,
+            kEnd,
+        };
+
+    private:
+        std::atomic<uint32_t>& m_openStreamCount;  // Owned by the package.
+        const uint8_t* m_pData = nullptr;           // The decoded data, or the compressed data if we are inflating or the LZ
+                                                    // decode is pending.
+        char* m_pOwnedData = nullptr;               // Decoded copy of an LZ entry.
+        double m_decodeMs = 0.0;                    // Time spent decoding an LZ entry whole.
+        InflateState* m_pInflate = nullptr;         // Only used for zlib entries.
+        uint64_t m_position = 0;
+        uint32_t m_storedSize = 0;
+        uint32_t m_size = 0;
+        uint32_t m_checksum = 0;
+        bool m_isLzPending = false;
+        bool m_hasFailed = false;
+
+    public:
+        ~PackageStream();
+
+        PackageStream(const PackageStream&) = delete;
+        PackageStream(PackageStream&&) = delete;
+        PackageStream& operator=(const PackageStream&) = delete;
+        PackageStream& operator=(PackageStream&&) = delete;
+
+        size_t Read(void* pDest, const size_t size);
+        int64_t Seek(const int64_t offset, const SeekOrigin origin);
+        bool DecodeWhole();
+
+        [[nodiscard]] const char* GetData();
+        [[nodiscard]] double GetDecodeMs() const { return m_decodeMs; }
+        [[nodiscard]] uint64_t GetSize() const { return m_size; }
+        [[nodiscard]] uint64_t GetPosition() const { return m_position; }
+
+    private:
+        PackageStream(std::atomic<uint32_t>& openStreamCount, const uint8_t* pData, const uint32_t size);
+        void BeginLzDecode(const uint32_t storedSize, const uint32_t checksum);
+        bool BeginInflate(const uint32_t storedSize, const uint32_t checksum);
+        bool RestartInflate();
+        size_t Inflate(uint8_t* pDest, const size_t size);
+    };
+}
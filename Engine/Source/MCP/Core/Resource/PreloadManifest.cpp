@@ -0,0 +1,201 @@
+// PreloadManifest.cpp
+
+#include "PreloadManifest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "Resource.h"
+#include "MCP/Core/Application/Application.h"
+#include "MCP/Debug/Log.h"
+
+namespace mcp
+{
+    static constexpr const char* kTypeNames[static_cast<size_t>(PreloadAssetType::kCount)]
+    {
+        "texture",
+        "font",
+        "clip",
+        "track",
+        "audio",
+        "script",
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Lines that can't be read are skipped with a warning, so that one bad line doesn't lose the rest of the manifest.
+    //
+    ///		@brief : Load the manifest from disk, replacing any entries we had.
+    ///		@param pFilepath : Full path to the manifest.
+    ///		@returns : False if the file could not be opened.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool PreloadManifest::Load(const char* pFilepath)
+    {
+        std::ifstream file(pFilepath);
+        if (!file.is_open())
+            return false;
+
+        m_entries.clear();
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream stream(line);
+            std::string typeName;
+            Entry entry;
+
+            if (!(stream >> typeName >> entry.param))
+            {
+                MCP_WARN("PreloadManifest", "Skipping invalid line in manifest: ", pFilepath, ". Line: ", line);
+                continue;
+            }
+
+            const auto* pTypeName = std::find_if(std::begin(kTypeNames), std::end(kTypeNames), [&typeName](const char* pName) -> bool { return typeName == pName; });
+            if (pTypeName == std::end(kTypeNames))
+            {
+                MCP_WARN("PreloadManifest", "Skipping unknown asset type '", typeName, "' in manifest: ", pFilepath);
+                continue;
+            }
+
+            entry.type = static_cast<PreloadAssetType>(pTypeName - std::begin(kTypeNames));
+
+            // The path is the rest of the line, so that it can contain spaces. '|' can't be in a path, so it marks the package.
+            stream >> std::ws;
+            std::getline(stream, entry.path);
+
+            if (const auto separator = entry.path.rfind('|'); separator != std::string::npos)
+            {
+                entry.packagePath = entry.path.substr(separator + 1);
+                entry.path.erase(separator);
+            }
+
+            if (entry.path.empty())
+            {
+                MCP_WARN("PreloadManifest", "Skipping entry with no path in manifest: ", pFilepath);
+                continue;
+            }
+
+            Add(entry);
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Write the manifest to disk.
+    ///		@param pFilepath : Full path to the manifest.
+    ///		@returns : False if the file could not be written.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool PreloadManifest::Save(const char* pFilepath) const
+    {
+        std::ofstream file(pFilepath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            MCP_WARN("PreloadManifest", "Failed to save preload manifest: ", pFilepath);
+            return false;
+        }
+
+        file << "# Generated by MCPEngine when the scene is loaded. Each line is: <type> <param> <path>|<package>\n";
+
+        for (const auto& entry : m_entries)
+        {
+            file << GetTypeName(entry.type) << ' ' << entry.param << ' ' << entry.path;
+
+            if (!entry.packagePath.empty())
+                file << '|' << entry.packagePath;
+
+            file << '\n';
+        }
+
+        return file.good();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Add an entry if we don't already have it.
+    ///		@returns : True if the entry was added.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool PreloadManifest::Add(const Entry& entry)
+    {
+        if (Contains(entry))
+            return false;
+
+        m_entries.push_back(entry);
+        return true;
+    }
+
+    bool PreloadManifest::Contains(const Entry& entry) const
+    {
+        return std::find(m_entries.begin(), m_entries.end(), entry) != m_entries.end();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Only one manifest can be recorded at a time. This should only be used on the main thread.
+    //
+    ///		@brief : Start adding every asset that is requested to the manifest.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void PreloadManifest::BeginRecording(PreloadManifest* pManifest)
+    {
+        MCP_CHECK_MSG(!s_pRecording, "Tried to record two preload manifests at once!");
+        s_pRecording = pManifest;
+    }
+
+    void PreloadManifest::EndRecording()
+    {
+        s_pRecording = nullptr;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      DiskResourceRequests hold the full path, so the working directory is removed to get the path that was requested.
+    //
+    ///		@brief : Add a requested asset to the manifest that is being recorded, if there is one.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void PreloadManifest::Record(const PreloadAssetType type, const DiskResourceRequest& request, const int param)
+    {
+        if (!s_pRecording || !request.path.IsValid())
+            return;
+
+        const char* pPath = request.path.GetCStr();
+        const std::string& workingDirectory = Application::Get()->GetContext().workingDirectory;
+
+        if (!workingDirectory.empty() && std::strncmp(pPath, workingDirectory.c_str(), workingDirectory.size()) == 0)
+            pPath += workingDirectory.size();
+
+        Record(type, pPath, request.packagePath.IsValid() ? request.packagePath.GetCStr() : nullptr, param);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Add a requested asset to the manifest that is being recorded, if there is one.
+    ///		@param pPath : Path of the asset, exactly as it will be requested again.
+    ///		@param pPackagePath : Package that the asset was requested from, or nullptr if it is a loose file.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void PreloadManifest::Record(const PreloadAssetType type, const char* pPath, const char* pPackagePath, const int param)
+    {
+        if (!s_pRecording || !pPath)
+            return;
+
+        s_pRecording->Add(Entry{type, param, pPath, pPackagePath ? pPackagePath : ""});
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the full path of the manifest that belongs to a scene.
+    ///		@param sceneDataPath : Path to the scene data, relative to the working directory.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    std::string PreloadManifest::GetManifestPath(const std::string& sceneDataPath)
+    {
+        return Application::Get()->GetContext().workingDirectory + sceneDataPath + kManifestExtension;
+    }
+
+    const char* PreloadManifest::GetTypeName(const PreloadAssetType type)
+    {
+        if (type >= PreloadAssetType::kCount)
+            return "unknown";
+
+        return kTypeNames[static_cast<size_t>(type)];
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+// PreloadManifest.h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mcp
+{
+    struct DiskResourceRequest;
+
+    enum class PreloadAssetType : uint8_t
+    {
+        kTexture,
+        kFont,          // param is the font size.
+        kAudioClip,
+        kAudioTrack,
+        kAudioResource, // param is 1 for music.
+        kScript,
+        kCount,
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Manifests are generated by recording every request that is made while a scene is being loaded, and are saved next
+    //      to the scene data so that later runs can preload the scene before it is entered. The file is plain text, with one
+    //      asset per line:
+    //          <type> <param> <path>|<package>
+    //
+    //      Paths are stored relative to the working directory, so they can be requested the same way the scene requests them.
+    //      The package is left off for assets that were loaded from a loose file.
+    //
+    ///		@brief : List of the assets that a scene requests when it is loaded.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class PreloadManifest
+    {
+    public:
+        struct Entry
+        {
+            PreloadAssetType type = PreloadAssetType::kTexture;
+            int param = 0;
+            std::string path;
+            std::string packagePath;    // Empty if the asset isn't in a package.
+
+            // For building a DiskResourceRequest.
+            [[nodiscard]] const char* GetPackagePath() const { return packagePath.empty() ? nullptr : packagePath.c_str(); }
+
+            bool operator==(const Entry& right) const { return type == right.type && param == right.param && path == right.path && packagePath == right.packagePath; }
+            bool operator!=(const Entry& right) const { return !(*this == right); }
+        };
+
+    private:
+        static constexpr const char* kManifestExtension = ".preload";
+        static inline PreloadManifest* s_pRecording = nullptr;
+
+        std::vector<Entry> m_entries;
+
+    public:
+        bool Load(const char* pFilepath);
+        bool Save(const char* pFilepath) const;
+        bool Add(const Entry& entry);
+        void Clear() { m_entries.clear(); }
+
+        [[nodiscard]] bool Contains(const Entry& entry) const;
+        [[nodiscard]] bool IsEmpty() const { return m_entries.empty(); }
+        [[nodiscard]] const std::vector<Entry>& GetEntries() const { return m_entries; }
+
+        static void BeginRecording(PreloadManifest* pManifest);
+        static void EndRecording();
+        static void Record(const PreloadAssetType type, const DiskResourceRequest& request, const int param = 0);
+        static void Record(const PreloadAssetType type, const char* pPath, const char* pPackagePath, const int param = 0);
+        [[nodiscard]] static std::string GetManifestPath(const std::string& sceneDataPath);
+        [[nodiscard]] static const char* GetTypeName(const PreloadAssetType type);
+    };
+}
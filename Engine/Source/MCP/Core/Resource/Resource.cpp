@@ -8,6 +8,7 @@ namespace mcp
     DiskResourceRequest::DiskResourceRequest(const char* path, const char* packagePath, const bool isPersistent)
         : path(Application::Get()->GetContext().workingDirectory + path)
         , packagePath(packagePath)
+        , pathHash(HashString64(path))
         , isPersistent(isPersistent)
     {
         //
@@ -25,6 +25,7 @@ namespace mcp
     {
         StringId path {};
         StringId packagePath {};
+        uint64_t pathHash = 0;          // Hash of the path as it was requested, used to find the asset in its package.
         bool isPersistent = false;
 
         DiskResourceRequest() = default;
@@ -36,7 +37,7 @@ namespace mcp
         //-----------------------------------------------------------------------------------------------------------------------------
         uint64_t operator()(const DiskResourceRequest& request) const
         {
-            return std::hash<const void*>{}(request.path.GetConstPtr());
+            return request.path.GetHash();
         }
 
         bool operator==(const DiskResourceRequest& right) const
@@ -69,7 +70,7 @@ namespace mcp
         [[nodiscard]] bool Load(const ResourceRequestType& request);
         [[nodiscard]] virtual void* Get() const { return m_pResource; }
         [[nodiscard]] virtual bool IsValid() const { return m_pResource; }
-        [[nodiscard]] ResourceRequestType GetRequest();
+        [[nodiscard]] ResourceRequestType GetRequest() const;
 
     protected:
         virtual void* LoadResourceType() = 0;
@@ -101,7 +102,7 @@ namespace mcp
     ///         a default constructed ResourceRequestType.
     //-----------------------------------------------------------------------------------------------------------------------------
     template <typename ResourceRequestType>
-    ResourceRequestType Resource<ResourceRequestType>::GetRequest()
+    ResourceRequestType Resource<ResourceRequestType>::GetRequest() const
     {
         if (!IsValid())
             return ResourceRequestType{};
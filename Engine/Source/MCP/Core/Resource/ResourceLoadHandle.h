@@ -0,0 +1,40 @@
+#pragma once
+// ResourceLoadHandle.h
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace mcp
+{
+    enum class ResourceLoadStatus : uint8_t
+    {
+        kPending,   // Waiting in the request queue, or being decoded/uploaded.
+        kReady,     // The resource is loaded. The load holds a reference that must be released with FreeResource() or ReleaseLoad().
+        kFailed,    // The resource could not be loaded. There is nothing to free.
+        kCanceled,  // The load was canceled before it completed. There is nothing to free.
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is shared between the ResourceManager and whoever requested the load, so it is safe to check the status or
+    //      cancel from any thread. The status and resource are only written on the main thread, and the resource is set
+    //      before the status becomes kReady.
+    //
+    ///		@brief : Shared state of a single ResourceManager::LoadAsync() request.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ResourceLoadState
+    {
+        std::atomic<ResourceLoadStatus> status = ResourceLoadStatus::kPending;
+        std::atomic_bool isCanceled = false;
+        void* pResource = nullptr;  // Valid once the status is kReady.
+        std::function<void()> release; // Frees the load's reference. Set with the resource. Only used on the main thread.
+
+        [[nodiscard]] bool IsDone() const { return status != ResourceLoadStatus::kPending; }
+        [[nodiscard]] bool IsReady() const { return status == ResourceLoadStatus::kReady; }
+        [[nodiscard]] bool HasFailed() const { return status == ResourceLoadStatus::kFailed; }
+    };
+
+    using ResourceLoadHandle = std::shared_ptr<ResourceLoadState>;
+}
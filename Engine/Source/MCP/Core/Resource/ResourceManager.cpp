@@ -1,7 +1,11 @@
 // ResourceManager.cpp
 
 #include "ResourceManager.h"
+
+#include <algorithm>
+#include <fstream>
 #include "MCP/Core/Application/Application.h"
+#include "Utility/Time/HighPrecisionTimer.h"
 
 namespace mcp
 {
@@ -21,7 +25,392 @@ namespace mcp
 
     void ResourceManager::Close()
     {
+        m_asyncLoader.Close();
+
+        // Nothing will complete these anymore.
+        {
+            std::lock_guard lock(m_queueMutex);
+            for (auto& load : m_queuedLoads)
+            {
+                FinishLoad(load.handle, nullptr, ResourceLoadStatus::kCanceled);
+            }
+
+            m_queuedLoads.clear();
+        }
+
+        // Their uploads will never run, so release the references that they took.
+        for (auto& load : m_inFlightLoads)
+        {
+            if (load.handle->IsDone())
+                continue;
+
+            FinishLoad(load.handle, nullptr, ResourceLoadStatus::kCanceled);
+            load.release();
+        }
+
+        m_inFlightLoads.clear();
+
+        const auto cacheStats = GetTotalCacheStats();
+        MCP_LOG("ResourceManager", "Resource cache | Hits: ", cacheStats.hits, " | Misses: ", cacheStats.misses, " | Evictions: ", cacheStats.evictions);
+
+        m_containers.clear();
+        m_slowestLoads.clear();
         PackageManager::Destroy();
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Ex: <AsyncLoading workers="2" uploadBudgetMs="2"/>. A worker count of 0 picks a count based on the hardware, and
+    //      an upload budget of 0 uploads everything that is ready each frame.
+    //
+    ///		@brief : Set up the async loader from the project settings.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::LoadAsyncSettings(const XMLElement settingsRoot)
+    {
+        const auto asyncElement = settingsRoot.GetChildElement("AsyncLoading");
+        if (!asyncElement.IsValid())
+            return;
+
+        m_asyncLoader.SetWorkerCount(asyncElement.GetAttributeValue<unsigned>("workers", 0));
+        m_asyncLoader.SetUploadBudget(asyncElement.GetAttributeValue<double>("uploadBudgetMs", m_asyncLoader.GetUploadBudget()));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Ex: <ResourceCache budgetMB="16"/>. This is the budget of each resource type; a budget of 0 frees resources as soon
+    //      as they are no longer referenced.
+    //
+    ///		@brief : Set up the resource caches from the project settings.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::LoadCacheSettings(const XMLElement settingsRoot)
+    {
+        const auto cacheElement = settingsRoot.GetChildElement("ResourceCache");
+        if (!cacheElement.IsValid())
+            return;
+
+        const double budgetMB = cacheElement.GetAttributeValue<double>("budgetMB", static_cast<double>(m_defaultCacheBudget) / (1024.0 * 1024.0));
+        SetCacheBudget(static_cast<size_t>(budgetMB * 1024.0 * 1024.0));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This replaces any budgets that were set for a single type.
+    //
+    ///		@brief : Set the max bytes of unreferenced resources to keep in memory, for each resource type. 0 disables the cache.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::SetCacheBudget(const size_t bytes)
+    {
+        m_defaultCacheBudget = bytes;
+
+        for (auto* pContainer : m_containers)
+        {
+            pContainer->SetCacheBudget(bytes);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Ex: after leaving an area that won't be coming back, or when the platform is low on memory.
+    //
+    ///		@brief : Free every cached resource that is no longer referenced. The budgets are unchanged.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::TrimCaches()
+    {
+        for (auto* pContainer : m_containers)
+        {
+            pContainer->TrimCache();
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the cache counters of every resource type, added together.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceCacheStats ResourceManager::GetTotalCacheStats() const
+    {
+        ResourceCacheStats total;
+
+        for (const auto* pContainer : m_containers)
+        {
+            const auto& stats = pContainer->GetCacheStats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.evictions += stats.evictions;
+            total.cachedBytes += stats.cachedBytes;
+            total.cachedCount += stats.cachedCount;
+        }
+
+        return total;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Called by the Application once a frame, before the Scene is updated and rendered.
+    //
+    ///		@brief : Start any queued LoadAsync() requests, and complete any async loads that have finished decoding, within the
+    ///         upload budget.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::ProcessAsyncUploads()
+    {
+        UpdateInFlightLoads();
+        StartQueuedLoads();
+        m_asyncLoader.ProcessUploads();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The load is canceled on the main thread the next time the requests are processed. If it has already completed, this
+    //      does nothing, and the resource must still be freed.
+    //
+    ///		@brief : Cancel a LoadAsync() request. Safe to call from any thread.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::CancelLoad(const ResourceLoadHandle& handle)
+    {
+        if (handle)
+            handle->isCanceled = true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the memory and load time totals of every resource type that has been loaded.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    std::vector<ResourceTypeSummary> ResourceManager::GetSummaries() const
+    {
+        std::vector<ResourceTypeSummary> summaries;
+        summaries.reserve(m_containers.size());
+
+        for (const auto* pContainer : m_containers)
+        {
+            summaries.push_back(pContainer->GetSummary());
+        }
+
+        return summaries;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Each row is a resource that is in memory, including cached ones. Times are in milliseconds. Sizes are in bytes,
+    //      and the GPU size is an estimate.
+    //
+    ///		@brief : Write the memory, load times and reference counts of every resource to a CSV file.
+    ///		@param pFilepath : Full path of the file to write.
+    ///		@returns : False if the file could not be written.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool ResourceManager::DumpStatsToCsv(const char* pFilepath) const
+    {
+        std::ofstream file(pFilepath, std::ios::trunc);
+        if (!file.is_open())
+        {
+            MCP_ERROR("ResourceManager", "Failed to open resource stats file: ", pFilepath);
+            return false;
+        }
+
+        file << "type,path,source,cpuBytes,gpuBytes,sourceBytes,readMs,decompressMs,decodeMs,totalMs,async,loading,cached,refCount,peakRefCount,acquires,releases\n";
+
+        for (const auto* pContainer : m_containers)
+        {
+            pContainer->WriteCsvRows(file);
+        }
+
+        if (!file.good())
+        {
+            MCP_ERROR("ResourceManager", "Failed to write resource stats file: ", pFilepath);
+            return false;
+        }
+
+        MCP_LOG("ResourceManager", "Wrote resource stats to: ", pFilepath);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Only the slowest loads are kept, so this stays cheap no matter how many resources are loaded between logs.
+    //
+    ///		@brief : Called by the containers each time a resource finishes loading.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::RecordLoad(const char* pTypeName, const StringId& path, const ResourceLoadStats& stats)
+    {
+        const double totalMs = stats.GetTotalMs();
+        if (m_slowestLoads.size() >= m_slowLoadLogCount && (m_slowestLoads.empty() || m_slowestLoads.back().stats.GetTotalMs() >= totalMs))
+            return;
+
+        const auto position = std::find_if(m_slowestLoads.begin(), m_slowestLoads.end(), [totalMs](const SlowLoad& load) -> bool
+        {
+            return load.stats.GetTotalMs() < totalMs;
+        });
+
+        m_slowestLoads.insert(position, SlowLoad{pTypeName, path, stats});
+
+        if (m_slowestLoads.size() > m_slowLoadLogCount)
+            m_slowestLoads.pop_back();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Ex: after each scene transition, to see which assets made it slow.
+    //
+    ///		@brief : Log the slowest loads since this was last called, and start over.
+    ///		@param pLabel : What the loads were for. Only used for the log.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::LogSlowestLoads(const char* pLabel)
+    {
+        if (m_slowestLoads.empty())
+            return;
+
+        MCP_LOG("ResourceManager", "Slowest loads for '", pLabel, "':");
+
+        for (const auto& load : m_slowestLoads)
+        {
+            const auto& stats = load.stats;
+            MCP_LOG("ResourceManager", "    ", stats.GetTotalMs(), "ms | ", load.pTypeName, " '", load.path.GetCStr(), "' | Read: ", stats.readMs,
+                "ms, Decompress: ", stats.decompressMs, "ms, Decode: ", stats.decodeMs, "ms", stats.isAsync ? " (async)" : "");
+        }
+
+        m_slowestLoads.clear();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Set how many of the slowest loads are kept for LogSlowestLoads(). 0 stops recording them.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::SetSlowLoadLogCount(const size_t count)
+    {
+        m_slowLoadLogCount = count;
+
+        if (m_slowestLoads.size() > m_slowLoadLogCount)
+            m_slowestLoads.resize(m_slowLoadLogCount);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is useful when whoever made the request doesn't know the resource's type, like a list of preloaded assets.
+    //      Must be called on the main thread.
+    //
+    ///		@brief : Release the reference that a LoadAsync() request holds, or cancel it if it hasn't completed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::ReleaseLoad(const ResourceLoadHandle& handle)
+    {
+        if (!handle)
+            return;
+
+        if (!handle->IsDone())
+        {
+            CancelLoad(handle);
+            return;
+        }
+
+        // Only a ready load has a release function, and we only want to call it once.
+        if (handle->release)
+        {
+            auto release = std::move(handle->release);
+            handle->release = nullptr;
+            handle->pResource = nullptr;
+            release();
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns the number of LoadAsync() requests that are waiting to be started.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t ResourceManager::GetQueuedLoadCount()
+    {
+        std::lock_guard lock(m_queueMutex);
+        return m_queuedLoads.size();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Starting a load can mean reading and inflating a package entry on the main thread, so background requests are only
+    //      started while there is time left in the upload budget. Blocking and high priority requests are always started.
+    //
+    ///		@brief : Hand the queued LoadAsync() requests to the resource containers, most urgent first.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::StartQueuedLoads()
+    {
+        std::vector<QueuedLoad> loads;
+
+        {
+            std::lock_guard lock(m_queueMutex);
+            if (m_queuedLoads.empty())
+                return;
+
+            loads.swap(m_queuedLoads);
+        }
+
+        // Keep the order that they were requested in, within each priority.
+        std::stable_sort(loads.begin(), loads.end(), [](const QueuedLoad& left, const QueuedLoad& right) -> bool
+        {
+            return left.priority < right.priority;
+        });
+
+        const double budgetMs = m_asyncLoader.GetUploadBudget();
+        HighPrecisionTimer timer;
+        timer.Start();
+
+        size_t index = 0;
+        size_t backgroundStarted = 0;
+
+        for (; index < loads.size(); ++index)
+        {
+            auto& load = loads[index];
+
+            if (load.handle->isCanceled)
+            {
+                FinishLoad(load.handle, nullptr, ResourceLoadStatus::kCanceled);
+                continue;
+            }
+
+            if (load.priority == LoadPriority::kBackground)
+            {
+                // We always start at least one, so that background loads can't be starved completely.
+                if (backgroundStarted > 0 && budgetMs > 0.0 && timer.GetTimer() >= budgetMs)
+                    break;
+
+                ++backgroundStarted;
+            }
+
+            load.start();
+        }
+
+        // Put the rest back in front of anything that was requested while we were working.
+        if (index < loads.size())
+        {
+            std::lock_guard lock(m_queueMutex);
+            m_queuedLoads.insert(m_queuedLoads.begin(), std::make_move_iterator(loads.begin() + index), std::make_move_iterator(loads.end()));
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Releasing the reference of a canceled load will cancel its decode job too, if nothing else is using the resource.
+    //
+    ///		@brief : Cancel the started loads that were requested to be canceled, and forget about any that have completed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::UpdateInFlightLoads()
+    {
+        for (size_t i = 0; i < m_inFlightLoads.size(); ++i)
+        {
+            auto& load = m_inFlightLoads[i];
+            if (load.handle->IsDone() || !load.handle->isCanceled)
+                continue;
+
+            // Mark it as done first, so the load's callback ignores it if it still completes.
+            FinishLoad(load.handle, nullptr, ResourceLoadStatus::kCanceled);
+            load.release();
+        }
+
+        const auto completed = std::remove_if(m_inFlightLoads.begin(), m_inFlightLoads.end(), [](const InFlightLoad& load) -> bool
+        {
+            return load.handle->IsDone();
+        });
+
+        m_inFlightLoads.erase(completed, m_inFlightLoads.end());
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Set the result of a load. The resource is set first, so another thread that sees kReady can read it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ResourceManager::FinishLoad(const ResourceLoadHandle& handle, void* pResource, const ResourceLoadStatus status)
+    {
+        handle->pResource = pResource;
+        handle->status = status;
+    }
+
 }
@@ -11,16 +11,88 @@
 //
 //-----------------------------------------------------------------------------------------------------------------------------
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
+#include "AsyncResourceLoader.h"
 #include "PackageManager.h"
 #include "Resource.h"
+#include "ResourceLoadHandle.h"
 #include "MCP/Core/System.h"
 #include "MCP/Debug/Log.h"
+#include "Utility/Time/HighPrecisionTimer.h"
 
 namespace mcp
 {
     struct DataHeader;
 
+    enum class ResourceSource : uint8_t
+    {
+        kDisk,
+        kPackage,
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      GPU memory is an estimate, since the renderer doesn't tell us what it actually allocated.
+    //
+    ///		@brief : Memory used by a resource, split by where it lives.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ResourceMemoryUsage
+    {
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+
+        [[nodiscard]] size_t GetTotal() const { return cpuBytes + gpuBytes; }
+
+        ResourceMemoryUsage& operator+=(const ResourceMemoryUsage& right)
+        {
+            cpuBytes += right.cpuBytes;
+            gpuBytes += right.gpuBytes;
+            return *this;
+        }
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Read is the time spent getting the source data, and decompress is the time spent inflating a package entry. Loaders
+    //      that read from disk themselves (everything that isn't in a package) report their read in the decode time.
+    //      For async loads, the decode time is from submitting the job to uploading it, including any time spent waiting
+    //      for a worker.
+    //
+    ///		@brief : How a resource was loaded, and how long each stage took.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ResourceLoadStats
+    {
+        ResourceSource source = ResourceSource::kDisk;
+        size_t sourceBytes = 0;     // Size of the data the resource was decoded from. 0 if it was read by the loader.
+        double readMs = 0.0;
+        double decompressMs = 0.0;
+        double decodeMs = 0.0;
+        bool isAsync = false;
+
+        [[nodiscard]] double GetTotalMs() const { return readMs + decompressMs + decodeMs; }
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Totals of every resource of a single type that is in memory, including the cached ones.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ResourceTypeSummary
+    {
+        const char* pTypeName = nullptr;
+        size_t count = 0;
+        size_t cachedCount = 0;
+        size_t packageCount = 0;        // Resources loaded from a package. The rest were loaded from disk.
+        ResourceMemoryUsage memory;
+        size_t sourceBytes = 0;
+        double totalLoadMs = 0.0;
+        double slowestLoadMs = 0.0;
+    };
+
     template<typename ResourceType>
     struct ResourcePtr
     {
@@ -44,31 +116,113 @@ namespace mcp
         uint32_t refCount;          // How many references to this resource are in the program.
         bool isPersistent;          // Persistent means the resource will stay in memory even when the refCount goes to zero.
                                     // Can be useful if the refCount can routinely go to zero.
+        bool isLoading = false;     // True while an async load is being decoded. Until then, pResource is a placeholder.
+        bool hasFailed = false;     // True if the async load failed. pResource stays a placeholder until it is freed.
+        bool isCached = false;      // True if the refCount went to zero, and the resource is being kept in the cache.
+        size_t memorySize = 0;      // Size of the resource when it was cached.
+        uint64_t lastReleased = 0;  // When the refCount last went to zero. The oldest cached resource is evicted first.
+        std::vector<std::function<void(ResourceType*)>> loadWaiters; // Called when the async load completes.
+        ResourceLoadStats loadStats;    // How the resource was loaded.
+        uint32_t peakRefCount = 1;      // Highest the refCount has been.
+        uint32_t acquireCount = 1;      // Total references that have been added, including the first.
+        uint32_t releaseCount = 0;      // Total references that have been removed.
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      A hit is a request for a cached resource, which is revived without loading it again. A miss is a request that had
+    //      to load the resource. Requests for resources that were still referenced are neither.
+    //
+    ///		@brief : Counters for a ResourceContainer's cache of unreferenced resources.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ResourceCacheStats
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t cachedBytes = 0;     // Memory used by the resources that are in the cache.
+        size_t cachedCount = 0;     // Number of resources in the cache.
     };
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      This lets the ResourceManager configure and trim the cache of every container, without knowing their types.
     //
-    ///		@brief : This is the implementation details of the ResourceManager. Defining the functions LoadFromDiskImpl() and
-    ///         FreeResourceImpl() is required to successfully load and unload assets of a certain type.
+    ///		@brief : Type-independent interface of a ResourceContainer.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class ResourceContainerBase
+    {
+    public:
+        virtual ~ResourceContainerBase() = default;
+
+        virtual void SetCacheBudget(const size_t bytes) = 0;
+        virtual void TrimCache() = 0;
+        [[nodiscard]] virtual size_t GetCacheBudget() const = 0;
+        [[nodiscard]] virtual const ResourceCacheStats& GetCacheStats() const = 0;
+        [[nodiscard]] virtual ResourceTypeSummary GetSummary() const = 0;
+        virtual void WriteCsvRows(std::ostream& out) const = 0;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Specialize this as true_type for resources that can be loaded from a PackageStream. Their package entries are then
+    //      read through LoadFromStreamImpl() (and LoadFromStreamAsyncImpl()), instead of being decoded into the package's cache
+    //      and handed over as raw data. Resources that keep reading their data after they are loaded, like fonts and streamed
+    //      music, keep the stream until they are freed.
+    //
+    ///		@brief : Whether a ResourceType loads package entries through a PackageStream.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType>
+    struct StreamsFromPackage : std::false_type {};
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      When a resource's refCount goes to zero, it is moved into the cache instead of being freed, so that it can be revived
+    //      without loading it again. The cache is limited by a memory budget, and the least recently released resources are
+    //      freed first when it goes over. Resources that report a memory size of 0 are never cached.
+    //
+    ///		@brief : This is the implementation details of the ResourceManager. Defining the functions LoadFromDiskImpl(),
+    ///         FreeResourceImpl(), GetMemoryUsageImpl() and GetTypeNameImpl() is required to successfully load and unload assets
+    ///         of a certain type.
     ///		@tparam ResourceType :
     ///     @tparam RequestType : Type that we use to determine if the Resource exists in our container or not. This contains data
     ///             that is required to find the correct resource in memory. Could just be a filepath, or something more.
     //-----------------------------------------------------------------------------------------------------------------------------
     template<typename ResourceType, typename RequestType>
-    class ResourceContainer
+    class ResourceContainer final : public ResourceContainerBase
     {
         using ResourceMap = std::unordered_map<RequestType, ResourcePtr<ResourceType>, RequestType>;
         ResourceMap m_resources;
+        ResourceCacheStats m_cacheStats;
+        size_t m_cacheBudget = 0;       // Max bytes of unreferenced resources to keep around. 0 disables the cache.
+        uint64_t m_releaseCount = 0;    // Incremented each time a resource is cached, to order them for eviction.
 
     public:
+        using LoadCallback = std::function<void(ResourceType* pResource)>;
+        using CompleteFunc = std::function<void(const bool succeeded, const double decompressMs)>;
+
         ResourceContainer() = default;
-        ~ResourceContainer();
+        virtual ~ResourceContainer() override;
 
         ResourceType* AddFromDisk(const RequestType& request);
+        ResourceType* AddFromDiskAsync(const RequestType& request, const LoadPriority priority = LoadPriority::kHigh, LoadCallback&& onLoaded = nullptr);
         void RemoveRef(const RequestType& request);
 
+        virtual void SetCacheBudget(const size_t bytes) override;
+        virtual void TrimCache() override { EvictToBudget(0); }
+        [[nodiscard]] virtual size_t GetCacheBudget() const override { return m_cacheBudget; }
+        [[nodiscard]] virtual const ResourceCacheStats& GetCacheStats() const override { return m_cacheStats; }
+        [[nodiscard]] virtual ResourceTypeSummary GetSummary() const override;
+        virtual void WriteCsvRows(std::ostream& out) const override;
+
     private:
+        ResourceType* BeginAsyncLoad(const RequestType& request, const LoadPriority priority, LoadCallback&& onLoaded);
+        void OnAsyncLoadComplete(const RequestType& request, const bool succeeded, const double decodeMs, const double decompressMs);
+        [[nodiscard]] ResourceMemoryUsage GetMemoryUsage(const ResourcePtr<ResourceType>& resourcePtr) const;
+        void AddRef(ResourcePtr<ResourceType>& resourcePtr);
+        void EvictToBudget(const size_t budget);
+        void FreeResourcePtr(typename ResourceMap::iterator it);
+
         //-----------------------------------------------------------------------------------------------------------------------------
         //		NOTES:
         //      Interestingly enough, I can not have the function definition here, I just declare it here and then in a it is on
@@ -95,12 +249,90 @@ namespace mcp
         //-----------------------------------------------------------------------------------------------------------------------------
         ResourceType* LoadFromRawDataImpl(char* pRawData, const int dataSize, const RequestType& request);
 
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      Only required for resource types that stream from packages (see StreamsFromPackage), which use this instead of
+        //      LoadFromRawDataImpl().
+        //
+        ///		@brief : Load an asset of a certain ResourceType from a stream over its package entry.
+        ///		@param pStream : The stream. The implementation takes ownership of it, even if the load fails.
+        ///		@param request : The request data for this resource.
+        ///		@returns : Ptr to the loaded resource, or nullptr if it fails.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ResourceType* LoadFromStreamImpl(PackageStream* pStream, const RequestType& request);
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      Only required for resource types that support async loading (see SupportsAsyncLoad). The returned resource must
+        //      be usable right away, and is filled in on the main thread when the job is uploaded. The decode stage should be
+        //      submitted to the ResourceManager's AsyncResourceLoader with the given priority, and onComplete must be called
+        //      from the upload stage.
+        //
+        ///		@brief : Begin loading an asset of a certain ResourceType, decoding it on a worker thread.
+        ///		@param request : The request data for this resource.
+        ///		@param priority : Priority to submit the job with.
+        ///		@param onComplete : Called on the main thread once the upload has finished, or failed. If the worker read a
+        ///             PackageStream, pass the stream's GetDecodeMs() along, otherwise 0.
+        ///		@returns : Ptr to the (placeholder) resource, or nullptr if it fails.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ResourceType* LoadFromDiskAsyncImpl(const RequestType& request, const LoadPriority priority, CompleteFunc&& onComplete);
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      The raw data is owned by the package, so implementations must copy it before handing it to a worker thread.
+        //
+        ///		@brief : Begin loading an asset of a certain ResourceType from rawData in memory, decoding it on a worker thread.
+        ///		@param pRawData : ptr to the array of raw bytes.
+        ///		@param dataSize : size of the rawData.
+        ///		@param request : The request data for this resource.
+        ///		@param priority : Priority to submit the job with.
+        ///		@param onComplete : Called on the main thread once the upload has finished, or failed.
+        ///		@returns : Ptr to the (placeholder) resource, or nullptr if it fails.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ResourceType* LoadFromRawDataAsyncImpl(const char* pRawData, const int dataSize, const RequestType& request, const LoadPriority priority, CompleteFunc&& onComplete);
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      Only required for resource types that both support async loading and stream from packages. The stream can be
+        //      read on the worker thread, so nothing needs to be copied.
+        //
+        ///		@brief : Begin loading an asset of a certain ResourceType from a stream over its package entry, decoding it on a
+        ///             worker thread.
+        ///		@param pStream : The stream. The implementation takes ownership of it, even if the load fails.
+        ///		@returns : Ptr to the (placeholder) resource, or nullptr if it fails.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ResourceType* LoadFromStreamAsyncImpl(PackageStream* pStream, const RequestType& request, const LoadPriority priority, CompleteFunc&& onComplete);
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      Only required for resource types that support async loading. This is used when a blocking request is made for a
+        //      resource that is still loading, since the caller can't use the placeholder. The job should be finished with
+        //      AsyncResourceLoader::Complete(), which calls the upload stage (and onComplete) before returning.
+        //
+        ///		@brief : Decode and upload a resource that is loading asynchronously, right now.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        void FinishAsyncLoadImpl(ResourceType* pResource);
+
         //-----------------------------------------------------------------------------------------------------------------------------
         //		NOTES:
         //
         ///		@brief : Frees the resource from memory using a specific implementation.
         //-----------------------------------------------------------------------------------------------------------------------------
         void FreeResourceImpl(ResourceType*);
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      This doesn't need to be exact, it is used to keep the cache within its budget and for the resource stats. Return
+        //      0 for resources that shouldn't be cached, like ones whose size can't be known.
+        //
+        ///		@brief : Get an estimate of the memory that the resource is using.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ResourceMemoryUsage GetMemoryUsageImpl(const ResourceType* pResource) const;
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ///		@brief : Get the name of the ResourceType, for stats and logging.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        const char* GetTypeNameImpl() const;
         
         ResourcePtr<ResourceType>* GetResourcePtr(const RequestType& key);
     };
@@ -115,16 +347,83 @@ namespace mcp
     private:
         // This is the asset zip file. In the future, this may look different. This is purpose built right now.
         static constexpr const char* kAssetDirectory = "AssetsPkg.zip";
+        static constexpr size_t kDefaultCacheBudget = 16 * 1024 * 1024;
+        static constexpr size_t kDefaultSlowLoadLogCount = 10;
 
         MCP_DEFINE_SYSTEM(ResourceManager)
 
+        // A LoadAsync() request that hasn't reached the containers yet. Start is run on the main thread.
+        struct QueuedLoad
+        {
+            ResourceLoadHandle handle;
+            LoadPriority priority;
+            std::function<void()> start;
+        };
+
+        // A LoadAsync() request that has been started, but may not have completed. Release drops the load's reference.
+        struct InFlightLoad
+        {
+            ResourceLoadHandle handle;
+            std::function<void()> release;
+        };
+
+        // A completed load, kept until the slowest loads are logged.
+        struct SlowLoad
+        {
+            const char* pTypeName;
+            StringId path;
+            ResourceLoadStats stats;
+        };
+
+        AsyncResourceLoader m_asyncLoader;          // Worker pool for resources that are decoded off of the main thread.
+        std::vector<QueuedLoad> m_queuedLoads;      // Requests from any thread. Guarded by m_queueMutex.
+        std::vector<InFlightLoad> m_inFlightLoads;  // Only touched on the main thread.
+        std::vector<ResourceContainerBase*> m_containers; // Every container that has been created.
+        std::vector<SlowLoad> m_slowestLoads;       // Slowest loads since they were last logged, slowest first.
+        std::mutex m_queueMutex;
+        size_t m_defaultCacheBudget = kDefaultCacheBudget; // Cache budget of each container, unless it is set per type.
+        size_t m_slowLoadLogCount = kDefaultSlowLoadLogCount;
+
     public:
         template<typename ResourceType, typename DiskRequestType>
         ResourceType* LoadFromDisk(const DiskRequestType& request);
 
+        template<typename ResourceType, typename DiskRequestType>
+        ResourceType* LoadFromDiskAsync(const DiskRequestType& request);
+
+        template<typename ResourceType, typename DiskRequestType>
+        ResourceLoadHandle LoadAsync(const DiskRequestType& request, const LoadPriority priority = LoadPriority::kHigh, std::function<void(ResourceType*)>&& onLoaded = nullptr);
+
         template<typename ResourceType, typename RequestType>
         void FreeResource(const RequestType& request);
 
+        template<typename ResourceType, typename RequestType = DiskResourceRequest>
+        void SetCacheBudget(const size_t bytes);
+
+        template<typename ResourceType, typename RequestType = DiskResourceRequest>
+        [[nodiscard]] const ResourceCacheStats& GetCacheStats();
+
+        template<typename ResourceType, typename RequestType = DiskResourceRequest>
+        [[nodiscard]] ResourceTypeSummary GetSummary();
+
+        void SetCacheBudget(const size_t bytes);
+        void TrimCaches();
+        [[nodiscard]] ResourceCacheStats GetTotalCacheStats() const;
+        [[nodiscard]] std::vector<ResourceTypeSummary> GetSummaries() const;
+        bool DumpStatsToCsv(const char* pFilepath) const;
+        void RecordLoad(const char* pTypeName, const StringId& path, const ResourceLoadStats& stats);
+        void LogSlowestLoads(const char* pLabel);
+        void SetSlowLoadLogCount(const size_t count);
+
+        void LoadAsyncSettings(const XMLElement settingsRoot);
+        void LoadCacheSettings(const XMLElement settingsRoot);
+        void ProcessAsyncUploads();
+        [[nodiscard]] AsyncResourceLoader& GetAsyncLoader() { return m_asyncLoader; }
+        [[nodiscard]] size_t GetQueuedLoadCount();
+
+        static void CancelLoad(const ResourceLoadHandle& handle);
+        static void ReleaseLoad(const ResourceLoadHandle& handle);
+
         static ResourceManager* Get();
         static ResourceManager* AddFromData(const XMLElement) { return BLEACH_NEW(ResourceManager); }
 
@@ -134,6 +433,10 @@ namespace mcp
         
         template<typename ResourceType, typename RequestType>
         ResourceContainer<ResourceType, RequestType>& GetResourceContainer();
+
+        void StartQueuedLoads();
+        void UpdateInFlightLoads();
+        static void FinishLoad(const ResourceLoadHandle& handle, void* pResource, const ResourceLoadStatus status);
     };
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -151,6 +454,8 @@ namespace mcp
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      If the resource is still loading asynchronously, its load is finished before this returns, so the caller never
+    //      gets a placeholder.
     //		
     ///		@brief : Add a new Resource using the request data. If we already loaded the resource from an equal request, then we
     ///         will return the previously loaded resource.
@@ -167,22 +472,98 @@ namespace mcp
         // If we have the resource already, increase the refCount and return the resource.
         if (pResourcePtr)
         {
-            pResourcePtr->refCount += 1;
+            // It is freed once the references that were added before it failed are removed, so it can be loaded again.
+            if (pResourcePtr->hasFailed)
+                return nullptr;
+
+            AddRef(*pResourcePtr);
+
+            if constexpr (SupportsAsyncLoad<ResourceType>::value)
+            {
+                if (pResourcePtr->isLoading)
+                {
+                    // Our reference keeps the resource alive through the load's waiters, but they can still rehash the map.
+                    FinishAsyncLoadImpl(pResourcePtr->pResource);
+                    pResourcePtr = GetResourcePtr(request);
+
+                    if (pResourcePtr->hasFailed)
+                    {
+                        RemoveRef(request);
+                        return nullptr;
+                    }
+                }
+            }
+
             return pResourcePtr->pResource;
         }
 
+        ++m_cacheStats.misses;
         ResourceType* pResource = nullptr;
+        ResourceLoadStats loadStats;
+
+        HighPrecisionTimer timer;
+        timer.Start();
 
         // If we have a path, then it is intended that we use it.
         if (request.packagePath.IsValid())
         {
-            auto* pData = PackageManager::Get()->GetRawData(request.packagePath.GetCStr(), request.path.GetCStr());
-            if (!pData)
+            if constexpr (StreamsFromPackage<ResourceType>::value)
             {
-                return nullptr;
+                auto* pStream = PackageManager::Get()->OpenStream(request.packagePath, request.pathHash);
+                if (!pStream)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to find asset: ", request.path.GetCStr(), ", in package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                // We are on the main thread anyway, so decode LZ entries up front to time them apart from the load.
+                if (!pStream->DecodeWhole())
+                {
+                    MCP_ERROR("ResourceManager", "Failed to decode asset: ", request.path.GetCStr(), ", in package: ", request.packagePath.GetCStr());
+                    BLEACH_DELETE(pStream);
+                    return nullptr;
+                }
+
+                loadStats.source = ResourceSource::kPackage;
+                loadStats.sourceBytes = static_cast<size_t>(pStream->GetSize());
+                loadStats.decompressMs = pStream->GetDecodeMs();
+                loadStats.readMs = timer.GetTimer() - loadStats.decompressMs;
+
+                // The stream belongs to the implementation now, which frees it if the load fails.
+                timer.Start();
+                pResource = LoadFromStreamImpl(pStream, request);
+                if (!pResource)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to load asset: ", request.path.GetCStr(), ", from package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                loadStats.decodeMs = timer.GetTimer();
             }
 
-            pResource = LoadFromRawDataImpl(pData->pData, pData->size, request);
+            else
+            {
+                auto* pData = PackageManager::Get()->GetRawData(request.packagePath, request.pathHash, &loadStats.decompressMs);
+                if (!pData)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to find asset: ", request.path.GetCStr(), ", in package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                loadStats.source = ResourceSource::kPackage;
+                loadStats.sourceBytes = static_cast<size_t>(pData->size);
+                loadStats.readMs = timer.GetTimer() - loadStats.decompressMs;
+
+                timer.Start();
+                pResource = LoadFromRawDataImpl(pData->pData, pData->size, request);
+                if (!pResource)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to load asset: ", request.path.GetCStr(), ", from package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                loadStats.decodeMs = timer.GetTimer();
+            }
         }
 
         // Otherwise, load from disk.
@@ -194,40 +575,315 @@ namespace mcp
                 MCP_ERROR("ResourceManager", "Failed to load Resource at filePath: ", request.path.GetCStr());
                 return nullptr;
             }
+
+            loadStats.decodeMs = timer.GetTimer();
         }
 
         // Add a new Resource<ResourceType> to our ResourceMap.
-        m_resources.emplace(std::make_pair(request, ResourcePtr<ResourceType>(pResource, request.isPersistent)));
+        auto& resourcePtr = m_resources.emplace(std::make_pair(request, ResourcePtr<ResourceType>(pResource, request.isPersistent))).first->second;
+        resourcePtr.loadStats = loadStats;
+        ResourceManager::Get()->RecordLoad(GetTypeNameImpl(), request.path, loadStats);
 
         return pResource;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      If the resource has already been requested, this works exactly like AddFromDisk(). Otherwise, the resource that
+    //      is returned is a placeholder that will be completed once its async job is uploaded on the main thread.
+    //
+    //      Blocking requests, and resource types that can't be decoded on a worker, are loaded right away with AddFromDisk().
+    //      If the resource is already loading in the background, a blocking request finishes that load right away instead.
+    //		
+    ///		@brief : Add a new Resource using the request data, decoding it on a worker thread.
+    ///		@param request : The data that is necessary for loading the Resource.
+    ///		@param priority : How urgently the resource is needed.
+    ///		@param onLoaded : Optional. Called on the main thread once the resource is loaded, which may be right away. If the
+    ///             async load fails, this is called with nullptr, and the reference that this call added is still held.
+    ///		@returns : Ptr to the Resource in memory, or nullptr if the load could not be started, or an earlier async load of
+    ///             the resource failed. onLoaded is not called if this returns nullptr.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    ResourceType* ResourceContainer<ResourceType, RequestType>::AddFromDiskAsync(const RequestType& request, const LoadPriority priority, LoadCallback&& onLoaded)
+    {
+        static_assert(std::is_convertible_v<RequestType, DiskResourceRequest>, "RequestType must be convertible to DiskResourceRequest!");
+
+        ResourcePtr<ResourceType>* pResourcePtr = GetResourcePtr(request);
+
+        // A blocking request can't use the placeholder, so AddFromDisk() finishes the load.
+        const bool mustFinishLoad = pResourcePtr && pResourcePtr->isLoading && priority == LoadPriority::kBlocking;
+
+        // If we have the resource already (even if it is still loading), increase the refCount and return the resource.
+        if (pResourcePtr && !mustFinishLoad)
+        {
+            if (pResourcePtr->hasFailed)
+                return nullptr;
+
+            AddRef(*pResourcePtr);
+
+            if (onLoaded)
+            {
+                if (pResourcePtr->isLoading)
+                    pResourcePtr->loadWaiters.emplace_back(std::move(onLoaded));
+                else
+                    onLoaded(pResourcePtr->pResource);
+            }
+
+            return pResourcePtr->pResource;
+        }
+
+        if constexpr (SupportsAsyncLoad<ResourceType>::value)
+        {
+            if (priority != LoadPriority::kBlocking)
+            {
+                ++m_cacheStats.misses;
+                return BeginAsyncLoad(request, priority, std::move(onLoaded));
+            }
+        }
+
+        ResourceType* pResource = AddFromDisk(request);
+        if (pResource && onLoaded)
+            onLoaded(pResource);
+
+        return pResource;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Submit the async load of a resource that isn't in the container yet.
+    ///		@returns : Ptr to the placeholder resource, or nullptr if the load could not be started.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    ResourceType* ResourceContainer<ResourceType, RequestType>::BeginAsyncLoad(const RequestType& request, const LoadPriority priority, LoadCallback&& onLoaded)
+    {
+        ResourceType* pResource = nullptr;
+        ResourceLoadStats loadStats;
+        loadStats.isAsync = true;
+
+        HighPrecisionTimer timer;
+        timer.Start();
+
+        if (request.packagePath.IsValid())
+        {
+            // The stream is handed to the worker, which reads it (and decompresses it) while it decodes.
+            if constexpr (StreamsFromPackage<ResourceType>::value)
+            {
+                auto* pStream = PackageManager::Get()->OpenStream(request.packagePath, request.pathHash);
+                if (!pStream)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to find asset: ", request.path.GetCStr(), ", in package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                loadStats.source = ResourceSource::kPackage;
+                loadStats.sourceBytes = static_cast<size_t>(pStream->GetSize());
+                loadStats.readMs = timer.GetTimer();
+
+                // The container is a static, so it will outlive the job.
+                timer.Start();
+                auto onComplete = [this, request, timer](const bool succeeded, const double decompressMs) -> void { OnAsyncLoadComplete(request, succeeded, timer.GetTimer(), decompressMs); };
+                pResource = LoadFromStreamAsyncImpl(pStream, request, priority, std::move(onComplete));
+            }
+
+            // Package data is already in memory, so we only need to copy it for the worker.
+            else
+            {
+                auto* pData = PackageManager::Get()->GetRawData(request.packagePath, request.pathHash, &loadStats.decompressMs);
+                if (!pData)
+                {
+                    MCP_ERROR("ResourceManager", "Failed to find asset: ", request.path.GetCStr(), ", in package: ", request.packagePath.GetCStr());
+                    return nullptr;
+                }
+
+                loadStats.source = ResourceSource::kPackage;
+                loadStats.sourceBytes = static_cast<size_t>(pData->size);
+                loadStats.readMs = timer.GetTimer() - loadStats.decompressMs;
+
+                // The container is a static, so it will outlive the job.
+                timer.Start();
+                auto onComplete = [this, request, timer](const bool succeeded, const double) -> void { OnAsyncLoadComplete(request, succeeded, timer.GetTimer(), 0.0); };
+                pResource = LoadFromRawDataAsyncImpl(pData->pData, pData->size, request, priority, std::move(onComplete));
+            }
+        }
+
+        else
+        {
+            auto onComplete = [this, request, timer](const bool succeeded, const double) -> void { OnAsyncLoadComplete(request, succeeded, timer.GetTimer(), 0.0); };
+            pResource = LoadFromDiskAsyncImpl(request, priority, std::move(onComplete));
+        }
+
+        if (!pResource)
+        {
+            MCP_ERROR("ResourceManager", "Failed to begin async load of Resource at filePath: ", request.path.GetCStr());
+            return nullptr;
+        }
+
+        auto& resourcePtr = m_resources.emplace(std::make_pair(request, ResourcePtr<ResourceType>(pResource, request.isPersistent))).first->second;
+        resourcePtr.isLoading = true;
+        resourcePtr.loadStats = loadStats;
+
+        if (onLoaded)
+            resourcePtr.loadWaiters.emplace_back(std::move(onLoaded));
+
+        return pResource;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If every reference was removed before the upload, the job is canceled and this is never called. A failed resource
+    //      is kept until its references are removed, but isn't given to any more requests.
+    //
+    ///		@brief : Notify everyone that is waiting on an async load that it has completed.
+    ///		@param decodeMs : Time from submitting the job to completing the upload.
+    ///		@param decompressMs : Time that the worker spent decompressing package data, which is part of decodeMs.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::OnAsyncLoadComplete(const RequestType& request, const bool succeeded, const double decodeMs, const double decompressMs)
+    {
+        auto* pResourcePtr = GetResourcePtr(request);
+        if (!pResourcePtr)
+            return;
+
+        pResourcePtr->isLoading = false;
+        pResourcePtr->hasFailed = !succeeded;
+
+        if (succeeded)
+        {
+            pResourcePtr->loadStats.decompressMs = decompressMs;
+            pResourcePtr->loadStats.decodeMs = decodeMs - decompressMs;
+            ResourceManager::Get()->RecordLoad(GetTypeNameImpl(), request.path, pResourcePtr->loadStats);
+        }
+
+        // A waiter may free the resource, so don't touch the ResourcePtr after this.
+        auto waiters = std::move(pResourcePtr->loadWaiters);
+        pResourcePtr->loadWaiters.clear();
+
+        ResourceType* pResource = succeeded ? pResourcePtr->pResource : nullptr;
+        for (auto& waiter : waiters)
+        {
+            waiter(pResource);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Resources that are still loading asynchronously are freed right away, which cancels their job.
     //
     ///		@brief : Remove a reference to a resource that was loaded with the Request. If the refCount to this Resource becomes 0,
-    ///         the Resource will be freed.
+    ///         the Resource will be cached if it fits in the budget, or freed.
     //-----------------------------------------------------------------------------------------------------------------------------
     template<typename ResourceType, typename RequestType>
     void ResourceContainer<ResourceType, RequestType>::RemoveRef(const RequestType& request)
     {
-        auto* pResourcePtr = GetResourcePtr(request);
+        auto result = m_resources.find(request);
 
-        if (!pResourcePtr)
+        if (result == m_resources.end() || result->second.isCached)
         {
             MCP_WARN("ResourceContainer", "Tried to free a resource at filepath = '", *request.path, "' that wasn't in memory!");
             return;
         }
 
-        pResourcePtr->refCount -= 1;
+        auto& resourcePtr = result->second;
+        resourcePtr.refCount -= 1;
+        ++resourcePtr.releaseCount;
 
-        // If our refCount is now 0 and it isn't marked as persistent,
-        // then free the resource and erase it from our ResourceMap.
-        if (pResourcePtr->refCount == 0 && !pResourcePtr->isPersistent)
+        // Persistent resources stay in memory even when the refCount is 0, unless they failed to load.
+        if (resourcePtr.refCount > 0 || (resourcePtr.isPersistent && !resourcePtr.hasFailed))
+            return;
+
+        const size_t memorySize = GetMemoryUsage(resourcePtr).GetTotal();
+        if (memorySize == 0 || memorySize > m_cacheBudget)
         {
-            FreeResourceImpl(pResourcePtr->pResource);
-            m_resources.erase(request);
+            FreeResourcePtr(result);
+            return;
         }
+
+        resourcePtr.isCached = true;
+        resourcePtr.memorySize = memorySize;
+        resourcePtr.lastReleased = ++m_releaseCount;
+        m_cacheStats.cachedBytes += memorySize;
+        ++m_cacheStats.cachedCount;
+
+        EvictToBudget(m_cacheBudget);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Set the max bytes of unreferenced resources to keep in memory, evicting any that no longer fit. 0 disables
+    ///         the cache.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::SetCacheBudget(const size_t bytes)
+    {
+        m_cacheBudget = bytes;
+        EvictToBudget(m_cacheBudget);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Increase the refCount of a resource, reviving it if it was in the cache.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::AddRef(ResourcePtr<ResourceType>& resourcePtr)
+    {
+        resourcePtr.refCount += 1;
+        ++resourcePtr.acquireCount;
+        resourcePtr.peakRefCount = std::max(resourcePtr.peakRefCount, resourcePtr.refCount);
+
+        if (resourcePtr.isCached)
+        {
+            resourcePtr.isCached = false;
+            m_cacheStats.cachedBytes -= resourcePtr.memorySize;
+            --m_cacheStats.cachedCount;
+            ++m_cacheStats.hits;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Eviction is rare compared to requests, so we just search for the oldest resource each time instead of maintaining
+    //      a separate list, just like the AssetPackage's cache.
+    //
+    ///		@brief : Free the least recently released cached resources until the cache is within the budget.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::EvictToBudget(const size_t budget)
+    {
+        while (m_cacheStats.cachedBytes > budget)
+        {
+            auto oldest = m_resources.end();
+            for (auto it = m_resources.begin(); it != m_resources.end(); ++it)
+            {
+                if (!it->second.isCached)
+                    continue;
+
+                if (oldest == m_resources.end() || it->second.lastReleased < oldest->second.lastReleased)
+                    oldest = it;
+            }
+
+            if (oldest == m_resources.end())
+                return;
+
+            m_cacheStats.cachedBytes -= oldest->second.memorySize;
+            --m_cacheStats.cachedCount;
+            ++m_cacheStats.evictions;
+            FreeResourcePtr(oldest);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Free the resource and erase it from our ResourceMap.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::FreeResourcePtr(typename ResourceMap::iterator it)
+    {
+        FreeResourceImpl(it->second.pResource);
+        m_resources.erase(it);
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -248,6 +904,70 @@ namespace mcp
         return nullptr;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the memory used by a resource. Resources that are still loading (or failed to) are only a placeholder, so
+    ///         they use none, and are never cached.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    ResourceMemoryUsage ResourceContainer<ResourceType, RequestType>::GetMemoryUsage(const ResourcePtr<ResourceType>& resourcePtr) const
+    {
+        if (resourcePtr.isLoading || resourcePtr.hasFailed || !resourcePtr.pResource)
+            return {};
+
+        return GetMemoryUsageImpl(resourcePtr.pResource);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Add up the memory and load times of every resource in the container.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    ResourceTypeSummary ResourceContainer<ResourceType, RequestType>::GetSummary() const
+    {
+        ResourceTypeSummary summary;
+        summary.pTypeName = GetTypeNameImpl();
+
+        for (const auto& [request, resourcePtr] : m_resources)
+        {
+            const auto& loadStats = resourcePtr.loadStats;
+
+            ++summary.count;
+            summary.cachedCount += resourcePtr.isCached ? 1 : 0;
+            summary.packageCount += loadStats.source == ResourceSource::kPackage ? 1 : 0;
+            summary.memory += GetMemoryUsage(resourcePtr);
+            summary.sourceBytes += loadStats.sourceBytes;
+            summary.totalLoadMs += loadStats.GetTotalMs();
+            summary.slowestLoadMs = std::max(summary.slowestLoadMs, loadStats.GetTotalMs());
+        }
+
+        return summary;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The columns match the header that is written by ResourceManager::DumpStatsToCsv().
+    //
+    ///		@brief : Write a row for each resource in the container.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceContainer<ResourceType, RequestType>::WriteCsvRows(std::ostream& out) const
+    {
+        const char* pTypeName = GetTypeNameImpl();
+
+        for (const auto& [request, resourcePtr] : m_resources)
+        {
+            const auto& loadStats = resourcePtr.loadStats;
+            const auto memory = GetMemoryUsage(resourcePtr);
+
+            // Paths are quoted, in case they have commas.
+            out << pTypeName << ",\"" << (request.path.IsValid() ? request.path.GetCStr() : "") << "\","
+                << (loadStats.source == ResourceSource::kPackage ? "package" : "disk") << ','
+                << memory.cpuBytes << ',' << memory.gpuBytes << ',' << loadStats.sourceBytes << ','
+                << loadStats.readMs << ',' << loadStats.decompressMs << ',' << loadStats.decodeMs << ',' << loadStats.GetTotalMs() << ','
+                << (loadStats.isAsync ? 1 : 0) << ',' << (resourcePtr.isLoading ? 1 : 0) << ',' << (resourcePtr.isCached ? 1 : 0) << ','
+                << resourcePtr.refCount << ',' << resourcePtr.peakRefCount << ',' << resourcePtr.acquireCount << ',' << resourcePtr.releaseCount << '\n';
+        }
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
@@ -269,6 +989,94 @@ namespace mcp
         return pResource;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The resource type must define LoadFromDiskAsyncImpl() and LoadFromRawDataAsyncImpl() (or LoadFromStreamAsyncImpl(),
+    //      if it streams from packages). The returned resource is freed with FreeResource(), like any other resource, and it
+    //      is safe to do so before the load has completed.
+    //		
+    ///		@brief : Load a resource from Disk, decoding it on a worker thread.
+    ///		@tparam ResourceType : Type of resource we are loading.
+    ///		@tparam DiskRequestType : Type of request needed to load the resource.
+    ///		@param request : Data required to load the resource that we want.
+    ///		@returns : Pointer to the resource, or nullptr if it failed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename DiskRequestType>
+    ResourceType* ResourceManager::LoadFromDiskAsync(const DiskRequestType& request)
+    {
+        static_assert(std::is_convertible_v<DiskRequestType, DiskResourceRequest>, "RequestType must be convertible to DiskResourceRequest!");
+        auto& container = GetResourceContainer<ResourceType, DiskRequestType>();
+
+        return container.AddFromDiskAsync(request);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is safe to call from any thread. The request is queued and started on the main thread in
+    //      ProcessAsyncUploads(), which is also where onLoaded is called. Blocking requests are all completed by the next
+    //      ProcessAsyncUploads(), whatever the budget.
+    //
+    //      Once the handle is kReady, the load holds a reference to the resource, which must be released with
+    //      FreeResource() like any other, or with ReleaseLoad(). Failed and canceled loads hold nothing.
+    //		
+    ///		@brief : Request a resource to be loaded in the background.
+    ///		@tparam ResourceType : Type of resource we are loading.
+    ///		@tparam DiskRequestType : Type of request needed to load the resource.
+    ///		@param request : Data required to load the resource that we want.
+    ///		@param priority : How urgently the resource is needed.
+    ///		@param onLoaded : Optional. Called on the main thread with the resource, or nullptr if the load failed. It is not
+    ///             called if the load is canceled.
+    ///		@returns : Handle to check the status of the load, or cancel it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename DiskRequestType>
+    ResourceLoadHandle ResourceManager::LoadAsync(const DiskRequestType& request, const LoadPriority priority, std::function<void(ResourceType*)>&& onLoaded)
+    {
+        static_assert(std::is_convertible_v<DiskRequestType, DiskResourceRequest>, "RequestType must be convertible to DiskResourceRequest!");
+
+        auto handle = std::make_shared<ResourceLoadState>();
+
+        auto start = [this, request, priority, handle, onLoaded = std::move(onLoaded)]() -> void
+        {
+            auto release = [this, request]() -> void { FreeResource<ResourceType>(request); };
+            m_inFlightLoads.push_back(InFlightLoad{handle, release});
+
+            auto onComplete = [handle, release, onLoaded](ResourceType* pResource) -> void
+            {
+                // Canceled and released while we were loading.
+                if (handle->IsDone())
+                    return;
+
+                if (!pResource || handle->isCanceled)
+                {
+                    release();
+                    FinishLoad(handle, nullptr, handle->isCanceled ? ResourceLoadStatus::kCanceled : ResourceLoadStatus::kFailed);
+
+                    if (handle->HasFailed() && onLoaded)
+                        onLoaded(nullptr);
+
+                    return;
+                }
+
+                handle->release = release;
+                FinishLoad(handle, pResource, ResourceLoadStatus::kReady);
+                if (onLoaded)
+                    onLoaded(pResource);
+            };
+
+            auto& container = GetResourceContainer<ResourceType, DiskRequestType>();
+            if (!container.AddFromDiskAsync(request, priority, std::move(onComplete)))
+            {
+                FinishLoad(handle, nullptr, ResourceLoadStatus::kFailed);
+                if (onLoaded)
+                    onLoaded(nullptr);
+            }
+        };
+
+        std::lock_guard lock(m_queueMutex);
+        m_queuedLoads.push_back(QueuedLoad{handle, priority, std::move(start)});
+        return handle;
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //
@@ -282,6 +1090,36 @@ namespace mcp
         container.RemoveRef(request);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This overrides the budget set with SetCacheBudget(bytes), for this type only.
+    //
+    ///		@brief : Set the max bytes of unreferenced resources of this type to keep in memory. 0 disables the cache.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    void ResourceManager::SetCacheBudget(const size_t bytes)
+    {
+        GetResourceContainer<ResourceType, RequestType>().SetCacheBudget(bytes);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the cache counters of a single resource type.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    const ResourceCacheStats& ResourceManager::GetCacheStats()
+    {
+        return GetResourceContainer<ResourceType, RequestType>().GetCacheStats();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the memory and load time totals of a single resource type.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    template<typename ResourceType, typename RequestType>
+    ResourceTypeSummary ResourceManager::GetSummary()
+    {
+        return GetResourceContainer<ResourceType, RequestType>().GetSummary();
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //      This is a nifty trick for holding onto template data types. I don't want to be having a different ResourceManager
@@ -294,6 +1132,14 @@ namespace mcp
     ResourceContainer<ResourceType, RequestType>& ResourceManager::GetResourceContainer()
     {
         static ResourceContainer<ResourceType, RequestType> sContainer;
+        static const bool sIsRegistered = [this]() -> bool
+        {
+            sContainer.SetCacheBudget(m_defaultCacheBudget);
+            m_containers.push_back(&sContainer);
+            return true;
+        }();
+
+        (void)sIsRegistered;
         return sContainer;
     }
 }
@@ -0,0 +1,207 @@
+// CookedTexture.cpp
+
+#include "CookedTexture.h"
+
+#include <cstring>
+#include "MCP/Core/Resource/LzCodec.h"
+#include "MCP/Debug/Log.h"
+
+namespace mcp
+{
+    static constexpr uint32_t kBytesPerPixel = 4;
+
+    bool IsCookedTexture(const void* pData, const size_t dataSize)
+    {
+        if (!pData || dataSize < sizeof(CookedTextureHeader))
+            return false;
+
+        uint32_t signature = 0;
+        std::memcpy(&signature, pData, sizeof(signature));
+        return signature == kCookedTextureSignature;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Everything that the decode relies on is checked here, so a truncated or corrupt file fails to load instead of
+    //      reading past the end of the data.
+    //
+    ///		@brief : Read and validate the header of a cooked texture.
+    ///		@param pData : Start of the cooked texture file.
+    ///		@param dataSize : Size of the whole file.
+    ///		@returns : False if the data is not a valid cooked texture.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool ReadCookedTextureHeader(const void* pData, const size_t dataSize, CookedTextureHeader& headerOut)
+    {
+        if (!IsCookedTexture(pData, dataSize))
+        {
+            MCP_ERROR("CookedTexture", "Data is not a cooked texture!");
+            return false;
+        }
+
+        std::memcpy(&headerOut, pData, sizeof(CookedTextureHeader));
+
+        if (headerOut.version != kCookedTextureVersion)
+        {
+            MCP_ERROR("CookedTexture", "Unsupported cooked texture version: ", headerOut.version, ". Expected: ", kCookedTextureVersion);
+            return false;
+        }
+
+        if (headerOut.format >= static_cast<uint8_t>(CookedPixelFormat::kCount))
+        {
+            MCP_ERROR("CookedTexture", "Cooked texture has an unknown pixel format: ", static_cast<int>(headerOut.format));
+            return false;
+        }
+
+        const auto codec = static_cast<PackageCodec>(headerOut.codec);
+        if (codec != PackageCodec::kStore && codec != PackageCodec::kLz)
+        {
+            MCP_ERROR("CookedTexture", "Cooked texture has an unsupported codec: ", static_cast<int>(headerOut.codec));
+            return false;
+        }
+
+        const uint64_t decodedSize = static_cast<uint64_t>(headerOut.pitch) * headerOut.height;
+
+        if (headerOut.width == 0 || headerOut.height == 0
+            || static_cast<uint64_t>(headerOut.pitch) < static_cast<uint64_t>(headerOut.width) * kBytesPerPixel
+            || decodedSize > static_cast<uint64_t>(INT32_MAX))
+        {
+            MCP_ERROR("CookedTexture", "Cooked texture has invalid dimensions: ", headerOut.width, "x", headerOut.height, ", pitch: ", headerOut.pitch);
+            return false;
+        }
+
+        if (headerOut.storedSize > dataSize - sizeof(CookedTextureHeader)
+            || (codec == PackageCodec::kStore && headerOut.storedSize != decodedSize))
+        {
+            MCP_ERROR("CookedTexture", "Cooked texture is truncated! Stored size: ", headerOut.storedSize, ", data size: ", dataSize);
+            return false;
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      When the destination has the same pitch as the cooked data (which is the case for a tightly packed RGBA surface),
+    //      the pixels are copied or decompressed straight into the destination in one go.
+    //
+    ///		@brief : Write the pixels of a cooked texture into a buffer.
+    ///		@param header : Header from ReadCookedTextureHeader().
+    ///		@param pData : Start of the cooked texture file.
+    ///		@param pPixelsOut : Destination. Must hold header.height rows of 'pitch' bytes.
+    ///		@param pitch : Bytes per row of the destination.
+    ///		@returns : False if the compressed data is corrupt.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool DecodeCookedTexture(const CookedTextureHeader& header, const void* pData, void* pPixelsOut, const size_t pitch)
+    {
+        const auto* pStored = static_cast<const uint8_t*>(pData) + sizeof(CookedTextureHeader);
+        auto* pDest = static_cast<uint8_t*>(pPixelsOut);
+        const size_t decodedSize = static_cast<size_t>(header.pitch) * header.height;
+        const bool isCompressed = static_cast<PackageCodec>(header.codec) == PackageCodec::kLz;
+
+        if (pitch == header.pitch)
+        {
+            if (!isCompressed)
+            {
+                std::memcpy(pDest, pStored, decodedSize);
+                return true;
+            }
+
+            return LzDecompress(pStored, header.storedSize, pDest, decodedSize);
+        }
+
+        std::vector<uint8_t> decoded;
+        if (isCompressed)
+        {
+            decoded.resize(decodedSize);
+            if (!LzDecompress(pStored, header.storedSize, decoded.data(), decoded.size()))
+                return false;
+
+            pStored = decoded.data();
+        }
+
+        const size_t rowSize = static_cast<size_t>(header.width) * kBytesPerPixel;
+        for (uint32_t y = 0; y < header.height; ++y)
+        {
+            std::memcpy(pDest + y * pitch, pStored + y * static_cast<size_t>(header.pitch), rowSize);
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The cooked pixels are always tightly packed. If the LZ codec doesn't make the pixels smaller, they are stored.
+    //
+    ///		@brief : Build a cooked texture file from decoded pixels.
+    ///		@param pPixels : Source pixels, in R, G, B, A byte order.
+    ///		@param pitch : Bytes per row of the source pixels.
+    ///		@param premultiply : If true, the color channels are multiplied by alpha.
+    ///		@param codec : kStore or kLz.
+    ///		@param dataOut : The whole file.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool CookTexture(const void* pPixels, const uint32_t width, const uint32_t height, const uint32_t pitch, const bool premultiply, const PackageCodec codec, std::vector<uint8_t>& dataOut)
+    {
+        if (!pPixels || width == 0 || height == 0 || pitch < width * kBytesPerPixel)
+        {
+            MCP_ERROR("CookedTexture", "Can't cook a texture with no pixels!");
+            return false;
+        }
+
+        if (codec != PackageCodec::kStore && codec != PackageCodec::kLz)
+        {
+            MCP_ERROR("CookedTexture", "Cooked textures only support the store and lz codecs!");
+            return false;
+        }
+
+        CookedTextureHeader header;
+        header.signature = kCookedTextureSignature;
+        header.version = kCookedTextureVersion;
+        header.format = static_cast<uint8_t>(premultiply ? CookedPixelFormat::kRGBA8Premultiplied : CookedPixelFormat::kRGBA8);
+        header.codec = static_cast<uint8_t>(PackageCodec::kStore);
+        header.width = width;
+        header.height = height;
+        header.pitch = width * kBytesPerPixel;
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(header.pitch) * height);
+        const auto* pSource = static_cast<const uint8_t*>(pPixels);
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            uint8_t* pRow = pixels.data() + y * static_cast<size_t>(header.pitch);
+            std::memcpy(pRow, pSource + y * static_cast<size_t>(pitch), header.pitch);
+
+            if (!premultiply)
+                continue;
+
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                uint8_t* pPixel = pRow + x * kBytesPerPixel;
+                const uint32_t alpha = pPixel[3];
+
+                for (int channel = 0; channel < 3; ++channel)
+                    pPixel[channel] = static_cast<uint8_t>((pPixel[channel] * alpha + 127) / 255);
+            }
+        }
+
+        std::vector<uint8_t> compressed;
+        if (codec == PackageCodec::kLz)
+        {
+            compressed.resize(LzCompressBound(pixels.size()));
+            const size_t compressedSize = LzCompress(pixels.data(), pixels.size(), compressed.data(), compressed.size());
+
+            if (compressedSize > 0 && compressedSize < pixels.size())
+            {
+                compressed.resize(compressedSize);
+                header.codec = static_cast<uint8_t>(PackageCodec::kLz);
+            }
+        }
+
+        const std::vector<uint8_t>& stored = header.codec == static_cast<uint8_t>(PackageCodec::kLz) ? compressed : pixels;
+        header.storedSize = static_cast<uint32_t>(stored.size());
+
+        dataOut.resize(sizeof(CookedTextureHeader) + stored.size());
+        std::memcpy(dataOut.data(), &header, sizeof(CookedTextureHeader));
+        std::memcpy(dataOut.data() + sizeof(CookedTextureHeader), stored.data(), stored.size());
+        return true;
+    }
+}
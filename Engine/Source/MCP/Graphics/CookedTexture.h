@@ -0,0 +1,54 @@
+#pragma once
+// CookedTexture.h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MCP/Core/Resource/PackageFormat.h"
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      The engine's own texture format, written by the TextureCooker tool. The pixels are already decoded, so loading one is a
+//      copy (or an LZ decompress) straight into the surface, instead of a PNG decode. The layout is:
+//          - CookedTextureHeader
+//          - The pixel data, height rows of pitch bytes each, top row first. It may be compressed, see the header's codec.
+//
+//      Cooked textures are found by their signature, not by their extension, so a cooked file can replace the source image
+//      under the same name and none of the scenes that request it have to change.
+//
+//      All values are little-endian.
+//-----------------------------------------------------------------------------------------------------------------------------
+
+namespace mcp
+{
+    static constexpr uint32_t kCookedTextureSignature = 0x5854434D; // "MCTX"
+    static constexpr uint16_t kCookedTextureVersion = 1;
+
+    enum class CookedPixelFormat : uint8_t
+    {
+        kRGBA8 = 0,             // 8 bits per channel, in R, G, B, A byte order.
+        kRGBA8Premultiplied = 1,// Same as kRGBA8, but the color channels are already multiplied by alpha.
+        kCount,
+    };
+
+#pragma pack(1)
+    struct CookedTextureHeader
+    {
+        uint32_t signature          = 0; // kCookedTextureSignature.
+        uint16_t version            = 0; // kCookedTextureVersion.
+        uint8_t format              = 0; // CookedPixelFormat.
+        uint8_t codec               = 0; // PackageCodec. Only kStore and kLz are supported.
+        uint32_t width              = 0;
+        uint32_t height             = 0;
+        uint32_t pitch              = 0; // Bytes per row of the decoded pixels.
+        uint32_t storedSize         = 0; // Size of the pixel data that follows the header.
+    };
+#pragma pack()
+
+    static_assert(sizeof(CookedTextureHeader) == 24, "CookedTextureHeader must match the file format!");
+
+    [[nodiscard]] bool IsCookedTexture(const void* pData, const size_t dataSize);
+    [[nodiscard]] bool ReadCookedTextureHeader(const void* pData, const size_t dataSize, CookedTextureHeader& headerOut);
+    [[nodiscard]] bool DecodeCookedTexture(const CookedTextureHeader& header, const void* pData, void* pPixelsOut, const size_t pitch);
+    [[nodiscard]] bool CookTexture(const void* pPixels, const uint32_t width, const uint32_t height, const uint32_t pitch, const bool premultiply, const PackageCodec codec, std::vector<uint8_t>& dataOut);
+}
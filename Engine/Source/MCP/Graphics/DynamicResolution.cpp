@@ -0,0 +1,89 @@
+// DynamicResolution.cpp
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Utility/Time/FrameTimer.h"
+
+namespace mcp
+{
+    namespace
+    {
+        constexpr double kDefaultFrameMs = 1000.0 / 60.0;
+    }
+
+    DynamicResolutionController::DynamicResolutionController(const DynamicResolutionSettings& settings)
+    {
+        SetSettings(settings);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This should be called once a frame, after FrameTimer::NewFrame().
+    //
+    ///		@brief : Adjust the scale based on the FrameTimer's recent work times.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DynamicResolutionController::Update(const FrameTimer& frameTimer)
+    {
+        if (!m_settings.isEnabled)
+            return;
+
+        ++m_framesSinceChange;
+        if (m_framesSinceChange < m_settings.cooldownFrames || frameTimer.GetWorkHistoryCount() < m_settings.sampleFrames)
+            return;
+
+        double budgetMs = m_settings.targetFrameMs;
+        if (budgetMs <= 0.0)
+            budgetMs = frameTimer.GetTargetFrameMs() > 0.0 ? frameTimer.GetTargetFrameMs() : kDefaultFrameMs;
+
+        const double averageMs = frameTimer.GetAverageWorkMs(m_settings.sampleFrames);
+        if (averageMs <= 0.0)
+            return;
+
+        const double usage = averageMs / budgetMs;
+        if (usage <= m_settings.scaleDownRatio && usage >= m_settings.scaleUpRatio)
+            return;
+
+        // Aim for the middle of the two thresholds. Fill cost scales with the area, so the scale changes by the square root.
+        const double targetUsage = (m_settings.scaleDownRatio + m_settings.scaleUpRatio) / 2.0;
+        const auto desiredScale = static_cast<float>(static_cast<double>(m_scale) * std::sqrt(targetUsage / usage));
+        const float step = std::clamp(desiredScale - m_scale, -m_settings.maxStep, m_settings.maxStep);
+        const float newScale = std::clamp(m_scale + step, m_settings.minScale, m_settings.maxScale);
+
+        if (newScale == m_scale)
+            return;
+
+        m_scale = newScale;
+        m_framesSinceChange = 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Set the settings, fixing up any values that are out of range.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings)
+    {
+        m_settings = settings;
+        m_settings.maxScale = std::clamp(m_settings.maxScale, 0.1f, 1.f);
+        m_settings.minScale = std::clamp(m_settings.minScale, 0.1f, m_settings.maxScale);
+        m_settings.maxStep = std::max(m_settings.maxStep, 0.01f);
+        m_settings.sampleFrames = std::clamp<uint32_t>(m_settings.sampleFrames, 1, static_cast<uint32_t>(FrameTimer::kWorkHistorySize));
+        m_settings.scaleUpRatio = std::min(m_settings.scaleUpRatio, m_settings.scaleDownRatio);
+
+        m_scale = std::clamp(m_scale, m_settings.minScale, m_settings.maxScale);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Enable or disable scaling. When re-enabled, we start back at the max scale.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DynamicResolutionController::SetEnabled(const bool isEnabled)
+    {
+        if (isEnabled && !m_settings.isEnabled)
+        {
+            m_scale = m_settings.maxScale;
+            m_framesSinceChange = 0;
+        }
+
+        m_settings.isEnabled = isEnabled;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+// DynamicResolution.h
+
+#include <cstdint>
+
+class FrameTimer;
+
+namespace mcp
+{
+    struct DynamicResolutionSettings
+    {
+        float minScale = 0.5f;              // Lowest scale the world will be rendered at.
+        float maxScale = 1.f;               // Highest scale. Values above 1 are clamped, as we never supersample.
+        float maxStep = 0.1f;               // Largest change in scale that can be made at once.
+        double targetFrameMs = 0.0;         // Frame budget. 0 uses the FrameTimer's target, or 60fps if it is uncapped.
+        double scaleDownRatio = 0.95;       // Scale down when the average work time is above this fraction of the budget.
+        double scaleUpRatio = 0.75;         // Scale up when the average work time is below this fraction of the budget.
+        uint32_t sampleFrames = 16;         // Number of frames of history that are averaged.
+        uint32_t cooldownFrames = 30;       // Frames to wait after a change, so the history reflects the new scale.
+        bool isEnabled = false;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The scale applies to both axes, so the number of pixels that are filled is proportional to scale^2. When we are over
+    //      budget, the new scale is picked so the estimated fill cost lands in the middle of the two thresholds, limited to
+    //      maxStep per change. The gap between the two thresholds, and the cooldown after each change, keep the scale from
+    //      oscillating.
+    //
+    //      This only helps when the frame is bound by rendering. A CPU bound scene will settle at the minimum scale.
+    //
+    ///		@brief : Picks the scale that the world is rendered at, based on the recent frame times.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class DynamicResolutionController
+    {
+        DynamicResolutionSettings m_settings;
+        float m_scale = 1.f;
+        uint32_t m_framesSinceChange = 0;
+
+    public:
+        DynamicResolutionController() = default;
+        explicit DynamicResolutionController(const DynamicResolutionSettings& settings);
+
+        void Update(const FrameTimer& frameTimer);
+        void SetSettings(const DynamicResolutionSettings& settings);
+        void SetEnabled(const bool isEnabled);
+
+        [[nodiscard]] float GetScale() const { return m_settings.isEnabled ? m_scale : 1.f; }
+        [[nodiscard]] bool IsEnabled() const { return m_settings.isEnabled; }
+        [[nodiscard]] const DynamicResolutionSettings& GetSettings() const { return m_settings; }
+    };
+}
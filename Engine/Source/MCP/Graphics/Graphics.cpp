@@ -2,6 +2,8 @@
 
 #include "Graphics.h"
 
+#include "LuaSource.h"
+#include "RenderCapture.h"
 #include "MCP/Core/Config.h"
 #include "MCP/Debug/Log.h"
 #include "MCP/Core/Application/Window/WindowBase.h"
@@ -21,8 +23,12 @@ namespace mcp
 {
     MCP_DEFINE_STATIC_SYSTEM_GETTER(GraphicsManager)
 
+    // Incremented each time the contents of the target textures are lost.
+    static uint32_t s_targetTextureGeneration = 0;
+
     GraphicsManager::GraphicsManager(WindowConstructionData&& data)
         : m_mainWindowData(std::move(data))
+        , m_dynamicResolution(m_mainWindowData.dynamicResolution)
     {
         //
     }
@@ -39,7 +45,7 @@ namespace mcp
         m_pWindow = BLEACH_NEW(WindowBase);
 
         // Initialize the Renderer with the Window class.
-        if (!Renderer::Init())
+        if (!Renderer::Init(IsHeadless()))
         {
             MCP_ERROR("Renderer", "Failed to initialize GraphicsManager! Failed to initialize Renderer!");
             Close();
@@ -47,7 +53,7 @@ namespace mcp
         }
 
         // Create/Initialize the main window:
-        if (!m_pWindow->Init(m_mainWindowData.windowName.c_str(), m_mainWindowData.dimensions.x, m_mainWindowData.dimensions.y))
+        if (!m_pWindow->Init(m_mainWindowData.windowName.c_str(), m_mainWindowData.dimensions.x, m_mainWindowData.dimensions.y, IsHeadless()))
         {
             MCP_ERROR("Renderer", "Failed to initialize GraphicsManager! Failed to initialize MainWindow!");
             Close();
@@ -72,6 +78,10 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void GraphicsManager::Close()
     {
+        // The scaled target and the pending texture placeholder belong to the window's renderer, so they have to go first.
+        Renderer::ReleaseScaledTarget();
+        Renderer::ReleasePendingTexturePlaceholder();
+
         // Close and delete the Window.
         m_pWindow->Close();
         BLEACH_DELETE(m_pWindow);
@@ -96,6 +106,104 @@ namespace mcp
     void GraphicsManager::Display()
     {
         Renderer::Display();
+        RenderCapture::OnFrameDisplayed();
+        ++m_frameIndex;
+
+        const auto interval = m_mainWindowData.statsLogInterval;
+        if (interval > 0 && m_frameIndex % interval == 0)
+        {
+            const auto& stats = GetLastFrameStats();
+            MCP_LOG("Renderer", "Frame ", m_frameIndex
+                , " | Draw Calls: ", stats.drawCalls
+                , " | Texture Binds: ", stats.textureBinds
+                , " | State Changes: ", stats.stateChanges, " (", stats.skippedStateChanges, " skipped)"
+                , " | Quads: ", stats.quads
+                , " | Vertices: ", stats.vertices
+                , " | Target Switches: ", stats.targetSwitches
+                , " | Resolution Scale: ", GetResolutionScale());
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the RenderStats of the last frame that was displayed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    const RenderStats& GraphicsManager::GetLastFrameStats() const
+    {
+        return Renderer::GetLastFrameStats();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Get the RenderStats counted so far in the frame that is being rendered.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    const RenderStats& GraphicsManager::GetCurrentFrameStats() const
+    {
+        return Renderer::GetCurrentFrameStats();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This reads back what has been rendered so far this frame, so call it before Display().
+    //
+    ///		@brief : Copy the current contents of the framebuffer, as tightly packed RGBA32 pixels.
+    ///		@param outPixels : Resized to hold width * height * 4 bytes.
+    ///		@param outSize : Set to the width and height of the framebuffer.
+    ///		@returns : False if the pixels could not be read.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool GraphicsManager::ReadFramebuffer(std::vector<uint8_t>& outPixels, Vec2Int& outSize) const
+    {
+        return Renderer::ReadPixels(outPixels, outSize);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Used to capture golden images when running headless.
+    //
+    ///		@brief : Save the current contents of the framebuffer to a PNG file.
+    ///		@returns : False if the pixels could not be read or the file could not be written.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool GraphicsManager::SaveFramebuffer(const char* pFilepath) const
+    {
+        std::vector<uint8_t> pixels;
+        Vec2Int size;
+        if (!ReadFramebuffer(pixels, size))
+        {
+            MCP_ERROR("Renderer", "Failed to save framebuffer to: ", pFilepath);
+            return false;
+        }
+
+        return Renderer::SavePixels(pFilepath, pixels, size);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This should be called once a frame, right after the FrameTimer has started the new frame.
+    //
+    ///		@brief : Let the dynamic resolution controller pick the scale for this frame's world render.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void GraphicsManager::UpdateDynamicResolution(const FrameTimer& frameTimer)
+    {
+        m_dynamicResolution.Update(frameTimer);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The world is drawn with the same coordinates regardless of the scale. UI should be rendered after EndWorldRender(),
+    //      so that it stays at the native resolution.
+    //
+    ///		@brief : Start rendering the world. If dynamic resolution has lowered the scale, this goes to an offscreen target.
+    ///		@returns : True if the world is being rendered offscreen.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool GraphicsManager::BeginWorldRender() const
+    {
+        return BeginScaledRender(m_dynamicResolution.GetScale());
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Finish rendering the world, upscaling it to the window if it was rendered offscreen.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void GraphicsManager::EndWorldRender() const
+    {
+        EndScaledRender();
     }
 
     bool GraphicsManager::SetRenderTarget(WindowBase* pTarget) const
@@ -134,14 +242,167 @@ namespace mcp
             data.windowName = windowChildElement.GetAttributeValue<const char*>("name", "Game");
         }
 
+        // Optional Renderer element. Ex: <Renderer backend="Headless" statsLogInterval="120"/>
+        const auto rendererElement = element.GetChildElement("Renderer");
+        if (rendererElement.IsValid())
+        {
+            data.statsLogInterval = rendererElement.GetAttributeValue<uint32_t>("statsLogInterval", 0);
+
+            const std::string backend = rendererElement.GetAttributeValue<const char*>("backend", "Hardware");
+            if (backend == "Headless")
+                data.backend = RendererBackend::kHeadless;
+
+            else if (backend != "Hardware")
+                MCP_WARN("GraphicsManager", "Unknown Renderer backend '", backend, "'. Using Hardware.");
+        }
+
+        // Optional DynamicResolution element. Ex: <DynamicResolution enabled="true" minScale="0.5" targetFps="60"/>
+        const auto resolutionElement = element.GetChildElement("DynamicResolution");
+        if (resolutionElement.IsValid())
+        {
+            auto& settings = data.dynamicResolution;
+            settings.isEnabled = resolutionElement.GetAttributeValue<bool>("enabled", true);
+            settings.minScale = resolutionElement.GetAttributeValue<float>("minScale", settings.minScale);
+            settings.maxScale = resolutionElement.GetAttributeValue<float>("maxScale", settings.maxScale);
+            settings.maxStep = resolutionElement.GetAttributeValue<float>("maxStep", settings.maxStep);
+            settings.scaleDownRatio = resolutionElement.GetAttributeValue<double>("scaleDownRatio", settings.scaleDownRatio);
+            settings.scaleUpRatio = resolutionElement.GetAttributeValue<double>("scaleUpRatio", settings.scaleUpRatio);
+            settings.sampleFrames = resolutionElement.GetAttributeValue<uint32_t>("sampleFrames", settings.sampleFrames);
+            settings.cooldownFrames = resolutionElement.GetAttributeValue<uint32_t>("cooldownFrames", settings.cooldownFrames);
+
+            const double targetFps = resolutionElement.GetAttributeValue<double>("targetFps", 0.0);
+            settings.targetFrameMs = targetFps > 0.0 ? 1000.0 / targetFps : 0.0;
+        }
+
         return BLEACH_NEW(GraphicsManager(std::move(data)));
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Get the RenderStats of the last frame.
+    ///
+    ///     \n LUA PARAMS: NONE
+    ///     \n RETURNS: Table with the fields: drawCalls, textureBinds, stateChanges, skippedStateChanges, quads, vertices
+    ///         and targetSwitches.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int ScriptGetRenderStats(lua_State* pState)
+    {
+        const auto& stats = GraphicsManager::Get()->GetLastFrameStats();
+
+        lua_createtable(pState, 0, 7);
+
+        const auto setField = [pState](const char* pName, const uint32_t value)
+        {
+            lua_pushinteger(pState, static_cast<lua_Integer>(value));
+            lua_setfield(pState, -2, pName);
+        };
+
+        setField("drawCalls", stats.drawCalls);
+        setField("textureBinds", stats.textureBinds);
+        setField("stateChanges", stats.stateChanges);
+        setField("skippedStateChanges", stats.skippedStateChanges);
+        setField("quads", stats.quads);
+        setField("vertices", stats.vertices);
+        setField("targetSwitches", stats.targetSwitches);
+
+        return 1;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Set how often the RenderStats are logged.
+    ///
+    ///     \n LUA PARAMS: int frameInterval (0 disables logging)
+    ///     \n RETURNS: VOID
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int ScriptSetStatsLogInterval(lua_State* pState)
+    {
+        const auto interval = static_cast<uint32_t>(std::max(lua_tointeger(pState, -1), static_cast<lua_Integer>(0)));
+        lua_pop(pState, 1);
+
+        GraphicsManager::Get()->SetStatsLogInterval(interval);
+        return 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Get the scale that the world is currently rendered at.
+    ///
+    ///     \n LUA PARAMS: NONE
+    ///     \n RETURNS: float scale (1 is native resolution)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int ScriptGetResolutionScale(lua_State* pState)
+    {
+        lua_pushnumber(pState, static_cast<lua_Number>(GraphicsManager::Get()->GetResolutionScale()));
+        return 1;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Enable or disable dynamic resolution scaling of the world.
+    ///
+    ///     \n LUA PARAMS: bool isEnabled
+    ///     \n RETURNS: VOID
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int ScriptSetDynamicResolutionEnabled(lua_State* pState)
+    {
+        const bool isEnabled = lua_toboolean(pState, -1);
+        lua_pop(pState, 1);
+
+        GraphicsManager::Get()->GetDynamicResolution().SetEnabled(isEnabled);
+        return 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Capture the render commands of the next frames to a file, to be run by the RenderReplay tool.
+    ///
+    ///     \n LUA PARAMS: string filepath, int frameCount (optional, defaults to 1)
+    ///     \n RETURNS: bool (false if a capture is already in progress)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int ScriptCaptureFrames(lua_State* pState)
+    {
+        const char* pFilepath = lua_tostring(pState, 1);
+        const auto frameCount = static_cast<uint32_t>(std::max(luaL_optinteger(pState, 2, 1), static_cast<lua_Integer>(1)));
+        const bool result = RenderCapture::BeginCapture(pFilepath, frameCount);
+        lua_pop(pState, lua_gettop(pState));
+
+        lua_pushboolean(pState, result);
+        return 1;
+    }
+
+    void GraphicsManager::RegisterLuaFunctions(lua_State* pState)
+    {
+        static constexpr luaL_Reg kFuncs[]
+        {
+             {"GetRenderStats", &ScriptGetRenderStats}
+            ,{"SetStatsLogInterval", &ScriptSetStatsLogInterval}
+            ,{"GetResolutionScale", &ScriptGetResolutionScale}
+            ,{"SetDynamicResolutionEnabled", &ScriptSetDynamicResolutionEnabled}
+            ,{"CaptureFrames", &ScriptCaptureFrames}
+            ,{nullptr, nullptr}
+        };
+
+        lua_getglobal(pState, "Graphics");
+        MCP_CHECK(lua_type(pState, -1) == LUA_TTABLE);
+        luaL_setfuncs(pState, kFuncs, 0);
+        // Pop the table off the stack.
+        lua_pop(pState, 1);
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     ///		@brief : Set the draw color for primitive draw calls.
     //-----------------------------------------------------------------------------------------------------------------------------
     void SetDrawColor(const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordSetDrawColor(color);
+
         Renderer::SetDrawColor(color);
     }
 
@@ -152,6 +413,9 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void FillScreen(const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordFillScreen(color);
+
         Renderer::FillScreen(color);
     }
 
@@ -162,9 +426,25 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void DrawLine(const Vec2Int& a, const Vec2Int& b, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordLine(a.GetAs<float>(), b.GetAs<float>(), 1.f, color);
+
         Renderer::DrawLine(a, b, color);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //
+    ///		@brief : Draw a line between two points with a thickness in pixels.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DrawLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color)
+    {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordLine(a, b, thickness, color);
+
+        Renderer::DrawLine(a, b, thickness, color);
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //
@@ -172,6 +452,9 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void DrawFillRect(const RectInt& rect, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordRect(rect.GetRectAs<float>(), color, true);
+
         Renderer::DrawFillRect(rect, color);
     }
 
@@ -182,6 +465,9 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void DrawFillRect(const RectF& rect, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordRect(rect, color, true);
+
         Renderer::DrawFillRect(rect, color);
     }
 
@@ -192,6 +478,9 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void DrawRect(const RectInt& rect, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordRect(rect.GetRectAs<float>(), color, false);
+
         Renderer::DrawRect(rect, color);
     }
 
@@ -202,16 +491,151 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     void DrawRect(const RectF& rect, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordRect(rect, color, false);
+
         Renderer::DrawRect(rect, color);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Draw the outline of a circle.
+    //-----------------------------------------------------------------------------------------------------------------------------
     void DrawCircle(const Vec2& pos, const float radius, const Color& color)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordCircle(pos, radius, color, false);
+
         Renderer::DrawCircle(pos, radius, color);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Draw a filled circle.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DrawFillCircle(const Vec2& pos, const float radius, const Color& color)
+    {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordCircle(pos, radius, color, true);
+
+        Renderer::DrawFillCircle(pos, radius, color);
+    }
+
     void DrawTexture(const TextureRenderData& context)
     {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordTexture(context);
+
         Renderer::DrawTexture(context);
     }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every quad uses the same texture and crop, and the color of each quad tints the texture. This is meant for large
+    //      numbers of small quads, like particles, that would be too expensive to submit one at a time.
+    //		
+    ///		@brief : Draw a batch of quads in as few draw calls as the Renderer allows.
+    ///		@param pTexture : Texture to draw on each quad. If nullptr, the quads are filled with their color.
+    ///		@param crop : Area of the texture to draw on each quad. Ignored if there is no texture.
+    ///		@param pQuads : Array of quads to draw.
+    ///		@param count : Number of quads in the array.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void DrawQuads(void* pTexture, const RectInt& crop, const ColoredQuad* pQuads, const size_t count)
+    {
+        if (!pQuads || count == 0)
+            return;
+
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordQuads(pTexture, crop, pQuads, count);
+
+        Renderer::DrawQuads(pTexture, crop, pQuads, count);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Create a texture that can be drawn into with SetTargetTexture(). Free it with DestroyTargetTexture().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void* CreateTargetTexture(const Vec2Int& size)
+    {
+        void* pTexture = Renderer::CreateTargetTexture(size);
+
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordCreateTarget(pTexture, size);
+
+        return pTexture;
+    }
+
+    void DestroyTargetTexture(void* pTexture)
+    {
+        if (!pTexture)
+            return;
+
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordDestroyTarget(pTexture);
+
+        Renderer::DestroyTargetTexture(pTexture);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Set the texture that all draw calls render into. Pass nullptr to render to the window again.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool SetTargetTexture(void* pTexture)
+    {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordSetTarget(pTexture);
+
+        return Renderer::SetTargetTexture(pTexture);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Some renderers (Direct3D) throw away the contents of every target texture when their device is reset, ex: on alt-tab
+    //      or a display mode change. The window calls this when that happens. Anything that bakes into a target texture should
+    //      keep the generation that it baked in, and rebake (into a new texture) once GetTargetTextureGeneration() changes.
+    //		
+    ///		@brief : Mark the contents of every target texture as lost.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void OnTargetTexturesLost()
+    {
+        ++s_targetTextureGeneration;
+        Renderer::InvalidateStateCache();
+
+        MCP_LOG("Graphics", "Render targets were reset. Baked textures will be rebaked.");
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns a number that changes every time the contents of the target textures are lost.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    uint32_t GetTargetTextureGeneration()
+    {
+        return s_targetTextureGeneration;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Everything drawn until EndScaledRender() uses the same coordinates as the window, but is rendered at a fraction of
+    //      its resolution and upscaled at the end. A scale of 1 draws directly to the window.
+    //		
+    ///		@brief : Start drawing into an offscreen target that is scaled down by scale on each axis.
+    ///		@returns : True if drawing is going to the offscreen target.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool BeginScaledRender(const float scale)
+    {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordBeginScaled(scale);
+
+        return Renderer::BeginScaledRender(scale);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Upscale what was drawn since BeginScaledRender() to the window.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void EndScaledRender()
+    {
+        if (RenderCapture::IsRecording())
+            RenderCapture::RecordEndScaled();
+
+        Renderer::EndScaledRender();
+    }
 }
\ No newline at end of file
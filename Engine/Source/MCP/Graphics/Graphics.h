@@ -1,11 +1,15 @@
 #pragma once
 // Graphics.h
 
+#include <vector>
+#include "DynamicResolution.h"
 #include "MCP/Core/Application/Window/WindowBase.h"
 #include "RenderData/BaseRenderData.h"
 #include "Utility/Types/Color.h"
 #include "MCP/Core/System.h"
 
+struct lua_State;
+
 namespace mcp
 {
     struct TextureRenderData final : public BaseRenderData
@@ -14,18 +18,63 @@ namespace mcp
         Color tint = {255,255,255, 255};   // Tint color including alpha value.
     };
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : A single axis-aligned quad in a batch drawn with DrawQuads().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ColoredQuad
+    {
+        RectF rect;
+        Color color;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      kHeadless doesn't open a window; everything is rasterized in software into an in-memory RGBA framebuffer,
+    //      so rendering code can run on machines without a display (tests, benchmarks, servers).
+    //		
+    ///		@brief : What the Renderer draws to.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    enum class RendererBackend
+    {
+        kHardware,
+        kHeadless,
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Counted by the Renderer between calls to Display().
+    //		
+    ///		@brief : Statistics about the work submitted to the Renderer in a single frame.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct RenderStats
+    {
+        uint32_t drawCalls = 0;             // Calls that submit geometry to the underlying API.
+        uint32_t textureBinds = 0;          // Number of times a different texture was drawn from the previous draw.
+        uint32_t stateChanges = 0;          // Draw color, color mod and alpha mod changes that were sent to the API.
+        uint32_t skippedStateChanges = 0;   // State changes skipped because the value was already set.
+        uint32_t quads = 0;                 // Textured quads and primitive rects submitted.
+        uint32_t vertices = 0;              // Vertices submitted, including those of quads.
+        uint32_t targetSwitches = 0;        // Number of times the render target was changed.
+    };
+
     struct WindowConstructionData
     {
         std::string windowName = "Game";
         Vec2Int dimensions = {1600, 900};
+        RendererBackend backend = RendererBackend::kHardware;
+        uint32_t statsLogInterval = 0;  // Log the RenderStats every N frames. 0 disables logging.
+        DynamicResolutionSettings dynamicResolution;
     };
 
     class GraphicsManager final : public System
     {
         MCP_DEFINE_SYSTEM(GraphicsManager)
+        friend class RenderReplay;
 
         WindowConstructionData m_mainWindowData;
         WindowBase* m_pWindow = nullptr;
+        DynamicResolutionController m_dynamicResolution;
+        uint64_t m_frameIndex = 0;
 
         GraphicsManager(WindowConstructionData&& data);
 
@@ -33,8 +82,23 @@ namespace mcp
         static GraphicsManager* Get();
         [[nodiscard]] WindowBase* GetWindow() const { return m_pWindow; }
         [[nodiscard]] void* GetRenderer() const;
+        [[nodiscard]] bool IsHeadless() const { return m_mainWindowData.backend == RendererBackend::kHeadless; }
+        bool ReadFramebuffer(std::vector<uint8_t>& outPixels, Vec2Int& outSize) const;
+        bool SaveFramebuffer(const char* pFilepath) const;
+        void SetStatsLogInterval(const uint32_t frameInterval) { m_mainWindowData.statsLogInterval = frameInterval; }
+        [[nodiscard]] const RenderStats& GetLastFrameStats() const;
+        [[nodiscard]] const RenderStats& GetCurrentFrameStats() const;
+
+        // Dynamic Resolution
+        void UpdateDynamicResolution(const FrameTimer& frameTimer);
+        bool BeginWorldRender() const;
+        void EndWorldRender() const;
+        [[nodiscard]] DynamicResolutionController& GetDynamicResolution() { return m_dynamicResolution; }
+        [[nodiscard]] float GetResolutionScale() const { return m_dynamicResolution.GetScale(); }
 
         static GraphicsManager* AddFromData(const XMLElement element);
+        static void RegisterLuaFunctions(lua_State* pState);
+
     private:
         virtual bool Init() override;
         virtual void Close() override;
@@ -48,10 +112,24 @@ namespace mcp
     void SetDrawColor(const Color& color);
     void FillScreen(const Color& color);
     void DrawLine(const Vec2Int& a, const Vec2Int& b, const Color& color);
+    void DrawLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color);
     void DrawFillRect(const RectInt& rect, const Color& color);
     void DrawFillRect(const RectF& rect, const Color& color);
     void DrawRect(const RectInt& rect, const Color& color);
     void DrawRect(const RectF& rect, const Color& color);
     void DrawCircle(const Vec2& pos, const float radius, const Color& color);
+    void DrawFillCircle(const Vec2& pos, const float radius, const Color& color);
     void DrawTexture(const TextureRenderData& context);
+    void DrawQuads(void* pTexture, const RectInt& crop, const ColoredQuad* pQuads, const size_t count);
+
+    // Render Targets
+    void* CreateTargetTexture(const Vec2Int& size);
+    void DestroyTargetTexture(void* pTexture);
+    bool SetTargetTexture(void* pTexture);
+    void OnTargetTexturesLost();
+    [[nodiscard]] uint32_t GetTargetTextureGeneration();
+
+    // Scaled Rendering
+    bool BeginScaledRender(const float scale);
+    void EndScaledRender();
 }
\ No newline at end of file
@@ -0,0 +1,272 @@
+// ParticlePool.cpp
+
+#include "ParticlePool.h"
+
+#include <algorithm>
+#include "Utility/Time/HighPrecisionTimer.h"
+
+#if MCP_PARTICLES_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace mcp
+{
+    ParticlePool::ParticlePool(const size_t capacity)
+    {
+        SetCapacity(capacity);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If the new capacity is smaller than the number of live particles, the extra particles are dropped.
+    //
+    ///		@brief : Set the maximum number of particles that can be alive at once.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticlePool::SetCapacity(const size_t capacity)
+    {
+        m_posX.resize(capacity);
+        m_posY.resize(capacity);
+        m_velX.resize(capacity);
+        m_velY.resize(capacity);
+        m_normalizedAge.resize(capacity);
+        m_invLifetime.resize(capacity);
+        m_sizeScale.resize(capacity);
+
+        m_count = std::min(m_count, capacity);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Spawn a new particle.
+    ///		@param position : World position of the particle.
+    ///		@param velocity : Starting velocity, in units per second.
+    ///		@param lifetimeS : How long the particle lives for, in seconds.
+    ///		@param sizeScale : Multiplier on the size of this particle.
+    ///		@returns : False if the pool is full.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool ParticlePool::Emit(const Vec2& position, const Vec2& velocity, const float lifetimeS, const float sizeScale)
+    {
+        if (IsFull() || lifetimeS <= 0.f)
+            return false;
+
+        const size_t index = m_count;
+        m_posX[index] = position.x;
+        m_posY[index] = position.y;
+        m_velX[index] = velocity.x;
+        m_velY[index] = velocity.y;
+        m_normalizedAge[index] = 0.f;
+        m_invLifetime[index] = 1.f / lifetimeS;
+        m_sizeScale[index] = sizeScale;
+
+        ++m_count;
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The velocity is damped by the drag before the acceleration is applied, which is cheap and stable enough for
+    //      visual effects at normal frame rates.
+    //
+    ///		@brief : Move every live particle forward in time, and remove any that have died.
+    ///		@param deltaTimeS : Time since the last update, in seconds.
+    ///		@param acceleration : Acceleration applied to every particle, like gravity, in units per second squared.
+    ///		@param drag : Fraction of the velocity lost per second.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticlePool::Update(const float deltaTimeS, const Vec2& acceleration, const float drag)
+    {
+        if (m_count == 0)
+            return;
+
+        const float damping = std::max(0.f, 1.f - drag * deltaTimeS);
+
+#if MCP_PARTICLES_USE_SSE2
+        const size_t processed = IntegrateSse2(deltaTimeS, acceleration, damping);
+        IntegrateScalar(processed, deltaTimeS, acceleration, damping);
+#else
+        IntegrateScalar(0, deltaTimeS, acceleration, damping);
+#endif
+
+        RemoveDeadParticles();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is the fallback when SSE2 isn't available, and it also handles the particles left over at the end of the
+    //      arrays that don't fill a full group of 4.
+    //
+    ///		@brief : Integrate the particles from begin to the end of the live particles, one at a time.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticlePool::IntegrateScalar(const size_t begin, const float deltaTimeS, const Vec2& acceleration, const float damping)
+    {
+        const float accelX = acceleration.x * deltaTimeS;
+        const float accelY = acceleration.y * deltaTimeS;
+
+        for (size_t i = begin; i < m_count; ++i)
+        {
+            m_velX[i] = m_velX[i] * damping + accelX;
+            m_velY[i] = m_velY[i] * damping + accelY;
+            m_posX[i] += m_velX[i] * deltaTimeS;
+            m_posY[i] += m_velY[i] * deltaTimeS;
+            m_normalizedAge[i] += m_invLifetime[i] * deltaTimeS;
+        }
+    }
+
+#if MCP_PARTICLES_USE_SSE2
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The vectors aren't guaranteed to be 16 byte aligned, so we use unaligned loads and stores. On any CPU from the last
+    //      decade these cost the same as aligned ones when the data happens to be aligned.
+    //
+    ///		@brief : Integrate the particles 4 at a time.
+    ///		@returns : The number of particles that were processed. The rest must be done with IntegrateScalar().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    size_t ParticlePool::IntegrateSse2(const float deltaTimeS, const Vec2& acceleration, const float damping)
+    {
+        const __m128 dt = _mm_set1_ps(deltaTimeS);
+        const __m128 damp = _mm_set1_ps(damping);
+        const __m128 accelX = _mm_set1_ps(acceleration.x * deltaTimeS);
+        const __m128 accelY = _mm_set1_ps(acceleration.y * deltaTimeS);
+
+        float* pPosX = m_posX.data();
+        float* pPosY = m_posY.data();
+        float* pVelX = m_velX.data();
+        float* pVelY = m_velY.data();
+        float* pAge = m_normalizedAge.data();
+        const float* pInvLifetime = m_invLifetime.data();
+
+        const size_t simdCount = m_count & ~static_cast<size_t>(3);
+        for (size_t i = 0; i < simdCount; i += 4)
+        {
+            const __m128 velX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pVelX + i), damp), accelX);
+            const __m128 velY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pVelY + i), damp), accelY);
+            _mm_storeu_ps(pVelX + i, velX);
+            _mm_storeu_ps(pVelY + i, velY);
+
+            _mm_storeu_ps(pPosX + i, _mm_add_ps(_mm_loadu_ps(pPosX + i), _mm_mul_ps(velX, dt)));
+            _mm_storeu_ps(pPosY + i, _mm_add_ps(_mm_loadu_ps(pPosY + i), _mm_mul_ps(velY, dt)));
+            _mm_storeu_ps(pAge + i, _mm_add_ps(_mm_loadu_ps(pAge + i), _mm_mul_ps(_mm_loadu_ps(pInvLifetime + i), dt)));
+        }
+
+        return simdCount;
+    }
+#endif
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Most frames only a few particles die, so with SSE2 we test 4 ages at once and skip the whole group if none of them
+    //      have reached the end of their life.
+    //
+    ///		@brief : Swap remove every particle whose normalized age has reached 1.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void ParticlePool::RemoveDeadParticles()
+    {
+        size_t i = 0;
+
+#if MCP_PARTICLES_USE_SSE2
+        const __m128 one = _mm_set1_ps(1.f);
+#endif
+
+        while (i < m_count)
+        {
+#if MCP_PARTICLES_USE_SSE2
+            if (i + 4 <= m_count)
+            {
+                const __m128 ages = _mm_loadu_ps(m_normalizedAge.data() + i);
+                if (_mm_movemask_ps(_mm_cmpge_ps(ages, one)) == 0)
+                {
+                    i += 4;
+                    continue;
+                }
+            }
+#endif
+
+            if (m_normalizedAge[i] < 1.f)
+            {
+                ++i;
+                continue;
+            }
+
+            // Replace this particle with the last one, and check the same index again.
+            --m_count;
+            if (i != m_count)
+                MoveParticle(m_count, i);
+        }
+    }
+
+    void ParticlePool::MoveParticle(const size_t from, const size_t to)
+    {
+        m_posX[to] = m_posX[from];
+        m_posY[to] = m_posY[from];
+        m_velX[to] = m_velX[from];
+        m_velY[to] = m_velY[from];
+        m_normalizedAge[to] = m_normalizedAge[from];
+        m_invLifetime[to] = m_invLifetime[from];
+        m_sizeScale[to] = m_sizeScale[from];
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The particles are given lifetimes longer than the benchmark so that the count stays constant, and every frame
+    //      measures the same amount of work. When SSE2 is enabled, the scalar path is timed as well for comparison. See the
+    //      ParticleBenchmark tool.
+    //
+    ///		@brief : Time the update of a full pool of particles.
+    ///		@param particleCount : Number of live particles to update.
+    ///		@param frameCount : Number of updates to average over.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ParticleBenchmarkResult ParticlePool::RunBenchmark(const size_t particleCount, const size_t frameCount)
+    {
+        ParticleBenchmarkResult result;
+        if (particleCount == 0 || frameCount == 0)
+            return result;
+
+        constexpr float kDeltaTimeS = 1.f / 60.f;
+        const Vec2 gravity {0.f, 98.f};
+        const float lifetimeS = kDeltaTimeS * static_cast<float>(frameCount) * 2.f;
+
+        const auto fillPool = [&](ParticlePool& pool) -> void
+        {
+            pool.Clear();
+            for (size_t i = 0; i < particleCount; ++i)
+            {
+                const auto offset = static_cast<float>(i % 1024);
+                pool.Emit(Vec2{offset, offset * 0.5f}, Vec2{offset * 0.1f, -offset * 0.2f}, lifetimeS);
+            }
+        };
+
+        const auto runFrames = [&](ParticlePool& pool, const auto& updateFunc, double& outAverageMs, double& outMinMs) -> void
+        {
+            HighPrecisionTimer timer;
+            double totalMs = 0.0;
+            outMinMs = 0.0;
+
+            for (size_t frame = 0; frame < frameCount; ++frame)
+            {
+                timer.Start();
+                updateFunc(pool);
+                const double elapsedMs = timer.GetTimer();
+
+                totalMs += elapsedMs;
+                if (frame == 0 || elapsedMs < outMinMs)
+                    outMinMs = elapsedMs;
+            }
+
+            outAverageMs = totalMs / static_cast<double>(frameCount);
+        };
+
+        ParticlePool pool(particleCount);
+
+        fillPool(pool);
+        runFrames(pool, [&](ParticlePool& p) { p.Update(kDeltaTimeS, gravity, 0.5f); }, result.averageMs, result.minMs);
+
+#if MCP_PARTICLES_USE_SSE2
+        fillPool(pool);
+        runFrames(pool, [&](ParticlePool& p)
+        {
+            p.IntegrateScalar(0, kDeltaTimeS, gravity, 1.f - 0.5f * kDeltaTimeS);
+            p.RemoveDeadParticles();
+        }, result.scalarAverageMs, result.scalarMinMs);
+#endif
+
+        return result;
+    }
+}
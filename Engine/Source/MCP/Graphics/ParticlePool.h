@@ -0,0 +1,80 @@
+#pragma once
+// ParticlePool.h
+
+#include <vector>
+#include "Utility/Types/Vector2.h"
+
+// SSE2 is part of every x64 target, and MSVC sets _M_IX86_FP to 2 when it is enabled for x86.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MCP_PARTICLES_USE_SSE2 1
+#else
+    #define MCP_PARTICLES_USE_SSE2 0
+#endif
+
+namespace mcp
+{
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Update times measured by ParticlePool::RunBenchmark(), in milliseconds.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ParticleBenchmarkResult
+    {
+        double averageMs = 0.0;
+        double minMs = 0.0;
+        double scalarAverageMs = 0.0;   // The scalar path, timed for comparison. 0 if SSE2 is disabled, as it is the same.
+        double scalarMinMs = 0.0;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Each particle attribute is stored in its own tightly packed array (structure of arrays), so the update loop streams
+    //      through contiguous floats and can work on 4 particles at a time with SSE2. When SSE2 isn't available, the same
+    //      update is done one particle at a time.
+    //
+    //      Particles are kept packed at the front of the arrays; a dead particle is replaced by the last live one, so the order
+    //      of particles is not stable.
+    //
+    //      Age is stored normalized, from 0 at birth to 1 at death, along with the inverse of the lifetime. This lets the
+    //      update advance every particle with a single multiply-add, and lets curves be sampled directly with the age.
+    //
+    ///		@brief : Fixed capacity pool of particles that is updated in bulk.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class ParticlePool
+    {
+        std::vector<float> m_posX;
+        std::vector<float> m_posY;
+        std::vector<float> m_velX;
+        std::vector<float> m_velY;
+        std::vector<float> m_normalizedAge;     // [0, 1]. The particle dies when this reaches 1.
+        std::vector<float> m_invLifetime;       // 1 / lifetime in seconds.
+        std::vector<float> m_sizeScale;         // Per particle multiplier applied on top of the size curve.
+        size_t m_count = 0;
+
+    public:
+        ParticlePool() = default;
+        explicit ParticlePool(const size_t capacity);
+
+        void SetCapacity(const size_t capacity);
+        bool Emit(const Vec2& position, const Vec2& velocity, const float lifetimeS, const float sizeScale = 1.f);
+        void Update(const float deltaTimeS, const Vec2& acceleration, const float drag);
+        void Clear() { m_count = 0; }
+
+        [[nodiscard]] size_t GetCount() const { return m_count; }
+        [[nodiscard]] size_t GetCapacity() const { return m_posX.size(); }
+        [[nodiscard]] bool IsFull() const { return m_count >= m_posX.size(); }
+        [[nodiscard]] const float* GetPositionsX() const { return m_posX.data(); }
+        [[nodiscard]] const float* GetPositionsY() const { return m_posY.data(); }
+        [[nodiscard]] const float* GetNormalizedAges() const { return m_normalizedAge.data(); }
+        [[nodiscard]] const float* GetSizeScales() const { return m_sizeScale.data(); }
+
+        static ParticleBenchmarkResult RunBenchmark(const size_t particleCount = 100000, const size_t frameCount = 300);
+        static constexpr bool IsSimdEnabled() { return MCP_PARTICLES_USE_SSE2 != 0; }
+
+    private:
+        void IntegrateScalar(const size_t begin, const float deltaTimeS, const Vec2& acceleration, const float damping);
+#if MCP_PARTICLES_USE_SSE2
+        size_t IntegrateSse2(const float deltaTimeS, const Vec2& acceleration, const float damping);
+#endif
+        void RemoveDeadParticles();
+        void MoveParticle(const size_t from, const size_t to);
+    };
+}
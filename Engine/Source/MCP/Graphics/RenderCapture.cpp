@@ -0,0 +1,430 @@
+// RenderCapture.cpp
+
+#include "RenderCapture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include "Graphics.h"
+#include "MCP/Debug/Log.h"
+
+namespace mcp
+{
+    namespace
+    {
+        struct CaptureTexture
+        {
+            int32_t width = 0;
+            int32_t height = 0;
+            uint8_t flags = 0;
+            std::string path;
+            std::string packagePath;
+        };
+
+        struct CaptureState
+        {
+            std::string filepath;
+            std::vector<uint8_t> commands;
+            std::vector<CaptureTexture> textures;                   // Indexed by id - 1, as 0 means no texture.
+            std::unordered_map<const void*, uint32_t> textureIds;   // Textures referenced so far in this capture.
+            uint32_t framesRemaining = 0;
+            uint32_t framesRecorded = 0;
+            int lastZOrder = 0;
+            bool hasZOrder = false;
+            bool isPending = false;
+        };
+
+        CaptureState s_capture;
+
+        // Every texture currently loaded as a resource, whether or not we are capturing.
+        std::unordered_map<const void*, DiskResourceRequest> s_resourceTextures;
+
+        template<typename Type>
+        void Write(const Type value)
+        {
+            static_assert(std::is_arithmetic_v<Type>, "Only arithmetic types can be written directly!");
+
+            const size_t offset = s_capture.commands.size();
+            s_capture.commands.resize(offset + sizeof(Type));
+            std::memcpy(s_capture.commands.data() + offset, &value, sizeof(Type));
+        }
+
+        void Write(const RenderCommandType type)
+        {
+            Write(static_cast<uint8_t>(type));
+        }
+
+        void Write(const Color& color)
+        {
+            Write(color.r);
+            Write(color.g);
+            Write(color.b);
+            Write(color.alpha);
+        }
+
+        void Write(const Vec2& vec)
+        {
+            Write(vec.x);
+            Write(vec.y);
+        }
+
+        void Write(const RectF& rect)
+        {
+            Write(rect.x);
+            Write(rect.y);
+            Write(rect.width);
+            Write(rect.height);
+        }
+
+        void Write(const RectInt& rect)
+        {
+            Write(static_cast<int32_t>(rect.x));
+            Write(static_cast<int32_t>(rect.y));
+            Write(static_cast<int32_t>(rect.width));
+            Write(static_cast<int32_t>(rect.height));
+        }
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      For textures that can't be reloaded, we keep track of the largest area drawn from them, so the replay can create
+        //      a placeholder of roughly the same size.
+        //
+        ///		@brief : Get the capture's id for a texture, adding it to the texture table if this is the first time it is used.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        uint32_t GetTextureId(const void* pTexture, const RectInt& crop = {})
+        {
+            if (!pTexture)
+                return 0;
+
+            uint32_t id = 0;
+            if (const auto result = s_capture.textureIds.find(pTexture); result != s_capture.textureIds.end())
+            {
+                id = result->second;
+            }
+
+            else
+            {
+                CaptureTexture texture;
+                if (const auto resource = s_resourceTextures.find(pTexture); resource != s_resourceTextures.end())
+                {
+                    texture.flags = RenderCaptureHeader::kTextureFromResource;
+                    texture.path = resource->second.path.GetCStr();
+                    texture.packagePath = resource->second.packagePath.IsValid() ? resource->second.packagePath.GetCStr() : "";
+                }
+
+                s_capture.textures.emplace_back(std::move(texture));
+                id = static_cast<uint32_t>(s_capture.textures.size());
+                s_capture.textureIds.emplace(pTexture, id);
+            }
+
+            auto& texture = s_capture.textures[id - 1];
+            if (!(texture.flags & RenderCaptureHeader::kTextureRenderTarget))
+            {
+                texture.width = std::max(texture.width, static_cast<int32_t>(crop.x + crop.width));
+                texture.height = std::max(texture.height, static_cast<int32_t>(crop.y + crop.height));
+            }
+
+            return id;
+        }
+
+        void ResetCapture()
+        {
+            s_capture = CaptureState{};
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Request a capture of the next frames.
+    ///		@param pFilepath : File that the capture is written to once it is finished.
+    ///		@param frameCount : Number of frames to capture.
+    ///		@returns : False if a capture is already in progress, or the parameters are invalid.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool RenderCapture::BeginCapture(const char* pFilepath, const uint32_t frameCount)
+    {
+        if (!pFilepath || frameCount == 0)
+        {
+            MCP_ERROR("RenderCapture", "Failed to begin capture! A filepath and a frame count greater than 0 are required.");
+            return false;
+        }
+
+        if (s_isRecording || s_capture.isPending)
+        {
+            MCP_WARN("RenderCapture", "Failed to begin capture! A capture is already in progress.");
+            return false;
+        }
+
+        ResetCapture();
+        s_capture.filepath = pFilepath;
+        s_capture.framesRemaining = frameCount;
+        s_capture.isPending = true;
+
+        MCP_LOG("RenderCapture", "Capturing ", frameCount, " frame(s) to: ", pFilepath);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Stop the current capture without writing anything.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void RenderCapture::CancelCapture()
+    {
+        s_isRecording = false;
+        ResetCapture();
+    }
+
+    bool RenderCapture::IsCapturePending()
+    {
+        return s_capture.isPending;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Called by the GraphicsManager after each frame is displayed. This is where a requested capture actually starts, so
+    //      that only whole frames are recorded.
+    //
+    ///		@brief : End the current frame of the capture, writing the file if this was the last one.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void RenderCapture::OnFrameDisplayed()
+    {
+        if (s_capture.isPending)
+        {
+            s_capture.isPending = false;
+            s_isRecording = true;
+            return;
+        }
+
+        if (!s_isRecording)
+            return;
+
+        Write(RenderCommandType::kFrameEnd);
+        ++s_capture.framesRecorded;
+
+        // The zOrder is reissued at the start of each frame so that frames can be replayed on their own.
+        s_capture.hasZOrder = false;
+
+        if (--s_capture.framesRemaining > 0)
+            return;
+
+        s_isRecording = false;
+        WriteFile();
+        ResetCapture();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Track a texture that was loaded as a resource, so that captures can reference it by its path.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void RenderCapture::RegisterTexture(const void* pTexture, const DiskResourceRequest& request)
+    {
+        if (pTexture)
+            s_resourceTextures[pTexture] = request;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The pointer can be reused by a different texture, so it must also be forgotten by the current capture.
+    //
+    ///		@brief : Stop tracking a texture that is about to be destroyed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void RenderCapture::UnregisterTexture(const void* pTexture)
+    {
+        s_resourceTextures.erase(pTexture);
+        s_capture.textureIds.erase(pTexture);
+    }
+
+    void RenderCapture::RecordZOrder(const int zOrder)
+    {
+        if (s_capture.hasZOrder && s_capture.lastZOrder == zOrder)
+            return;
+
+        s_capture.hasZOrder = true;
+        s_capture.lastZOrder = zOrder;
+        Write(RenderCommandType::kZOrder);
+        Write(static_cast<int32_t>(zOrder));
+    }
+
+    void RenderCapture::RecordSetDrawColor(const Color& color)
+    {
+        Write(RenderCommandType::kSetDrawColor);
+        Write(color);
+    }
+
+    void RenderCapture::RecordFillScreen(const Color& color)
+    {
+        Write(RenderCommandType::kFillScreen);
+        Write(color);
+    }
+
+    void RenderCapture::RecordLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color)
+    {
+        Write(RenderCommandType::kLine);
+        Write(a);
+        Write(b);
+        Write(thickness);
+        Write(color);
+    }
+
+    void RenderCapture::RecordRect(const RectF& rect, const Color& color, const bool isFilled)
+    {
+        Write(isFilled ? RenderCommandType::kFillRect : RenderCommandType::kRect);
+        Write(rect);
+        Write(color);
+    }
+
+    void RenderCapture::RecordCircle(const Vec2& center, const float radius, const Color& color, const bool isFilled)
+    {
+        Write(isFilled ? RenderCommandType::kFillCircle : RenderCommandType::kCircle);
+        Write(center);
+        Write(radius);
+        Write(color);
+    }
+
+    void RenderCapture::RecordTexture(const TextureRenderData& context)
+    {
+        const uint32_t id = GetTextureId(context.pTexture, context.crop);
+
+        Write(RenderCommandType::kTexture);
+        Write(id);
+        Write(context.destinationRect);
+        Write(context.crop);
+        Write(context.anglePivot);
+        Write(static_cast<float>(context.angle));
+        Write(static_cast<uint8_t>(context.flip));
+        Write(context.tint);
+    }
+
+    void RenderCapture::RecordQuads(const void* pTexture, const RectInt& crop, const ColoredQuad* pQuads, const size_t count)
+    {
+        const uint32_t id = GetTextureId(pTexture, crop);
+
+        Write(RenderCommandType::kQuads);
+        Write(id);
+        Write(crop);
+        Write(static_cast<uint32_t>(count));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Write(pQuads[i].rect);
+            Write(pQuads[i].color);
+        }
+    }
+
+    void RenderCapture::RecordCreateTarget(const void* pTexture, const Vec2Int& size)
+    {
+        if (!pTexture)
+            return;
+
+        CaptureTexture texture;
+        texture.width = size.x;
+        texture.height = size.y;
+        texture.flags = RenderCaptureHeader::kTextureRenderTarget;
+        s_capture.textures.emplace_back(std::move(texture));
+
+        const auto id = static_cast<uint32_t>(s_capture.textures.size());
+        s_capture.textureIds[pTexture] = id;
+
+        Write(RenderCommandType::kCreateTarget);
+        Write(id);
+        Write(static_cast<int32_t>(size.x));
+        Write(static_cast<int32_t>(size.y));
+    }
+
+    void RenderCapture::RecordDestroyTarget(const void* pTexture)
+    {
+        const auto result = s_capture.textureIds.find(pTexture);
+        if (result == s_capture.textureIds.end())
+            return;
+
+        Write(RenderCommandType::kDestroyTarget);
+        Write(result->second);
+        s_capture.textureIds.erase(result);
+    }
+
+    void RenderCapture::RecordSetTarget(const void* pTexture)
+    {
+        Write(RenderCommandType::kSetTarget);
+        Write(GetTextureId(pTexture));
+    }
+
+    void RenderCapture::RecordBeginScaled(const float scale)
+    {
+        Write(RenderCommandType::kBeginScaled);
+        Write(scale);
+    }
+
+    void RenderCapture::RecordEndScaled()
+    {
+        Write(RenderCommandType::kEndScaled);
+    }
+
+    const char* RenderCapture::GetCommandName(const RenderCommandType type)
+    {
+        switch (type)
+        {
+            case RenderCommandType::kFrameEnd: return "FrameEnd";
+            case RenderCommandType::kZOrder: return "ZOrder";
+            case RenderCommandType::kSetDrawColor: return "SetDrawColor";
+            case RenderCommandType::kFillScreen: return "FillScreen";
+            case RenderCommandType::kLine: return "Line";
+            case RenderCommandType::kFillRect: return "FillRect";
+            case RenderCommandType::kRect: return "Rect";
+            case RenderCommandType::kCircle: return "Circle";
+            case RenderCommandType::kFillCircle: return "FillCircle";
+            case RenderCommandType::kTexture: return "Texture";
+            case RenderCommandType::kQuads: return "Quads";
+            case RenderCommandType::kCreateTarget: return "CreateTarget";
+            case RenderCommandType::kDestroyTarget: return "DestroyTarget";
+            case RenderCommandType::kSetTarget: return "SetTarget";
+            case RenderCommandType::kBeginScaled: return "BeginScaled";
+            case RenderCommandType::kEndScaled: return "EndScaled";
+            default: return "Unknown";
+        }
+    }
+
+    bool RenderCapture::WriteFile()
+    {
+        std::ofstream file(s_capture.filepath, std::ios::binary);
+        if (!file.is_open())
+        {
+            MCP_ERROR("RenderCapture", "Failed to write capture! Couldn't open file: ", s_capture.filepath);
+            return false;
+        }
+
+        RenderCaptureHeader header;
+        header.frameCount = s_capture.framesRecorded;
+        header.textureCount = static_cast<uint32_t>(s_capture.textures.size());
+        header.commandBytes = s_capture.commands.size();
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        const auto writeString = [&file](const std::string& string)
+        {
+            const auto length = static_cast<uint16_t>(std::min<size_t>(string.size(), UINT16_MAX));
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(string.data(), length);
+        };
+
+        for (size_t i = 0; i < s_capture.textures.size(); ++i)
+        {
+            const auto& texture = s_capture.textures[i];
+            const auto id = static_cast<uint32_t>(i + 1);
+            file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+            file.write(reinterpret_cast<const char*>(&texture.width), sizeof(texture.width));
+            file.write(reinterpret_cast<const char*>(&texture.height), sizeof(texture.height));
+            file.write(reinterpret_cast<const char*>(&texture.flags), sizeof(texture.flags));
+            writeString(texture.path);
+            writeString(texture.packagePath);
+        }
+
+        file.write(reinterpret_cast<const char*>(s_capture.commands.data()), static_cast<std::streamsize>(s_capture.commands.size()));
+
+        if (!file.good())
+        {
+            MCP_ERROR("RenderCapture", "Failed to write capture to: ", s_capture.filepath);
+            return false;
+        }
+
+        MCP_LOG("RenderCapture", "Wrote ", header.frameCount, " frame(s), ", header.textureCount, " texture(s) and "
+            , header.commandBytes, " bytes of commands to: ", s_capture.filepath);
+        return true;
+    }
+}
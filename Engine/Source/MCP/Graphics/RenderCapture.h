@@ -0,0 +1,120 @@
+#pragma once
+// RenderCapture.h
+
+#include <cstdint>
+#include <string>
+#include "MCP/Core/Resource/Resource.h"
+#include "Utility/Types/Color.h"
+#include "Utility/Types/Rect.h"
+
+namespace mcp
+{
+    struct ColoredQuad;
+    struct TextureRenderData;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every command is a 1 byte RenderCommandType, followed by its fields packed with no padding. Textures are referenced
+    //      by an id into the capture's texture table.
+    //
+    ///		@brief : Types of commands stored in a render capture file.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    enum class RenderCommandType : uint8_t
+    {
+        kFrameEnd,          //
+        kZOrder,            // int32 zOrder of the renderable that issues the following commands.
+        kSetDrawColor,      // Color
+        kFillScreen,        // Color
+        kLine,              // Vec2 a, Vec2 b, float thickness, Color
+        kFillRect,          // RectF, Color
+        kRect,              // RectF, Color
+        kCircle,            // Vec2 center, float radius, Color
+        kFillCircle,        // Vec2 center, float radius, Color
+        kTexture,           // uint32 textureId, RectF destination, RectInt crop, Vec2 pivot, float angle, uint8 flip, Color tint
+        kQuads,             // uint32 textureId, RectInt crop, uint32 count, count * (RectF, Color)
+        kCreateTarget,      // uint32 textureId, int32 width, int32 height
+        kDestroyTarget,     // uint32 textureId
+        kSetTarget,         // uint32 textureId. 0 is the window.
+        kBeginScaled,       // float scale
+        kEndScaled,         //
+
+        kCount
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      File layout:
+    //          - RenderCaptureHeader
+    //          - textureCount * texture entries: uint32 id, int32 width, int32 height, uint8 flags, then the resource path and
+    //            package path, each as a uint16 length followed by the characters.
+    //          - commandBytes of commands.
+    //
+    ///		@brief : Header at the start of a render capture file.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct RenderCaptureHeader
+    {
+        static constexpr uint32_t kMagic = 0x5250434D;     // "MCPR"
+        static constexpr uint16_t kVersion = 1;
+
+        // Flags of an entry in the texture table.
+        static constexpr uint8_t kTextureFromResource = 1 << 0;     // The texture can be reloaded from its resource path.
+        static constexpr uint8_t kTextureRenderTarget = 1 << 1;     // The texture is created by a kCreateTarget command.
+
+        uint32_t magic = kMagic;
+        uint16_t version = kVersion;
+        uint16_t reserved = 0;
+        uint32_t frameCount = 0;
+        uint32_t textureCount = 0;
+        uint64_t commandBytes = 0;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The Graphics functions record into the capture while it is active, so whatever backend is in use, the capture holds
+    //      exactly what the engine asked to draw. Recording begins at the start of the next frame, and the file is written
+    //      after the requested number of frames have been displayed.
+    //
+    //      Textures loaded as resources are tracked by the Renderer with RegisterTexture(), so they can be referenced by their
+    //      resource path. Any other texture that was created before the capture started (ex: cached text) is stored with the
+    //      largest area that was drawn from it, and replaced with a placeholder of that size when replayed.
+    //
+    //      When nothing is being captured, the cost is a single bool check per draw call.
+    //
+    ///		@brief : Records the render commands of one or more frames into a compact binary file, to be run by the RenderReplay.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class RenderCapture
+    {
+        static inline bool s_isRecording = false;
+
+    public:
+        static bool BeginCapture(const char* pFilepath, const uint32_t frameCount = 1);
+        static void CancelCapture();
+        static void OnFrameDisplayed();
+        [[nodiscard]] static bool IsRecording() { return s_isRecording; }
+        [[nodiscard]] static bool IsCapturePending();
+
+        // Texture tracking, called by the Renderer's resource implementation.
+        static void RegisterTexture(const void* pTexture, const DiskResourceRequest& request);
+        static void UnregisterTexture(const void* pTexture);
+
+        // Commands
+        static void RecordZOrder(const int zOrder);
+        static void RecordSetDrawColor(const Color& color);
+        static void RecordFillScreen(const Color& color);
+        static void RecordLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color);
+        static void RecordRect(const RectF& rect, const Color& color, const bool isFilled);
+        static void RecordCircle(const Vec2& center, const float radius, const Color& color, const bool isFilled);
+        static void RecordTexture(const TextureRenderData& context);
+        static void RecordQuads(const void* pTexture, const RectInt& crop, const ColoredQuad* pQuads, const size_t count);
+        static void RecordCreateTarget(const void* pTexture, const Vec2Int& size);
+        static void RecordDestroyTarget(const void* pTexture);
+        static void RecordSetTarget(const void* pTexture);
+        static void RecordBeginScaled(const float scale);
+        static void RecordEndScaled();
+
+        static const char* GetCommandName(const RenderCommandType type);
+
+    private:
+        static bool WriteFile();
+    };
+}
@@ -0,0 +1,607 @@
+// RenderReplay.cpp
+
+#include "RenderReplay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "BleachNew.h"
+#include "Graphics.h"
+#include "Texture.h"
+#include "MCP/Debug/Log.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+namespace mcp
+{
+    namespace
+    {
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ///		@brief : Reads the packed fields of the commands, failing instead of reading past the end.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        class CommandReader
+        {
+            const std::vector<uint8_t>& m_data;
+            size_t m_offset = 0;
+            bool m_isValid = true;
+
+        public:
+            explicit CommandReader(const std::vector<uint8_t>& data) : m_data(data) {}
+
+            template<typename Type>
+            Type Read()
+            {
+                static_assert(std::is_arithmetic_v<Type>, "Only arithmetic types can be read directly!");
+
+                Type value {};
+                if (m_offset + sizeof(Type) > m_data.size())
+                {
+                    m_isValid = false;
+                    return value;
+                }
+
+                std::memcpy(&value, m_data.data() + m_offset, sizeof(Type));
+                m_offset += sizeof(Type);
+                return value;
+            }
+
+            Color ReadColor()
+            {
+                Color color;
+                color.r = Read<uint8_t>();
+                color.g = Read<uint8_t>();
+                color.b = Read<uint8_t>();
+                color.alpha = Read<uint8_t>();
+                return color;
+            }
+
+            Vec2 ReadVec2()
+            {
+                const float x = Read<float>();
+                const float y = Read<float>();
+                return Vec2(x, y);
+            }
+
+            RectF ReadRectF()
+            {
+                RectF rect;
+                rect.x = Read<float>();
+                rect.y = Read<float>();
+                rect.width = Read<float>();
+                rect.height = Read<float>();
+                return rect;
+            }
+
+            RectInt ReadRectInt()
+            {
+                RectInt rect;
+                rect.x = Read<int32_t>();
+                rect.y = Read<int32_t>();
+                rect.width = Read<int32_t>();
+                rect.height = Read<int32_t>();
+                return rect;
+            }
+
+            // Check that a count read from the capture fits in what's left, before we allocate for it. The reader is invalid
+            // if it doesn't.
+            bool HasBytes(const uint64_t byteCount)
+            {
+                if (byteCount > m_data.size() - m_offset)
+                    m_isValid = false;
+
+                return m_isValid;
+            }
+
+            [[nodiscard]] bool IsValid() const { return m_isValid; }
+            [[nodiscard]] bool IsAtEnd() const { return m_offset >= m_data.size(); }
+        };
+
+        bool ReadString(std::ifstream& file, std::string& outString)
+        {
+            uint16_t length = 0;
+            file.read(reinterpret_cast<char*>(&length), sizeof(length));
+            outString.resize(length);
+
+            if (length > 0)
+                file.read(outString.data(), length);
+
+            return file.good();
+        }
+    }
+
+    RenderReplay::~RenderReplay()
+    {
+        ReleaseTextures();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Load a capture file written by the RenderCapture.
+    ///		@returns : False if the file couldn't be read, or isn't a capture of the current version.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool RenderReplay::Load(const char* pFilepath)
+    {
+        ReleaseTextures();
+        m_textures.clear();
+        m_commands.clear();
+
+        std::ifstream file(pFilepath, std::ios::binary);
+        if (!file.is_open())
+        {
+            MCP_ERROR("RenderReplay", "Failed to open capture: ", pFilepath);
+            return false;
+        }
+
+        RenderCaptureHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file.good() || header.magic != RenderCaptureHeader::kMagic)
+        {
+            MCP_ERROR("RenderReplay", "Failed to load capture! File is not a render capture: ", pFilepath);
+            return false;
+        }
+
+        if (header.version != RenderCaptureHeader::kVersion)
+        {
+            MCP_ERROR("RenderReplay", "Failed to load capture! Version ", header.version, " is not supported. Expected: ", RenderCaptureHeader::kVersion);
+            return false;
+        }
+
+        m_textures.resize(header.textureCount);
+        for (auto& texture : m_textures)
+        {
+            uint32_t id = 0;
+            file.read(reinterpret_cast<char*>(&id), sizeof(id));
+            file.read(reinterpret_cast<char*>(&texture.width), sizeof(texture.width));
+            file.read(reinterpret_cast<char*>(&texture.height), sizeof(texture.height));
+            file.read(reinterpret_cast<char*>(&texture.flags), sizeof(texture.flags));
+
+            if (!ReadString(file, texture.path) || !ReadString(file, texture.packagePath))
+            {
+                MCP_ERROR("RenderReplay", "Failed to load capture! The texture table is truncated.");
+                return false;
+            }
+        }
+
+        // Don't trust the header's size until we know the file is actually that long.
+        const auto commandStart = file.tellg();
+        file.seekg(0, std::ios::end);
+        const auto remainingBytes = static_cast<uint64_t>(file.tellg() - commandStart);
+        file.seekg(commandStart);
+
+        if (header.commandBytes > remainingBytes)
+        {
+            MCP_ERROR("RenderReplay", "Failed to load capture! Expected ", header.commandBytes, " bytes of commands, but only "
+                , remainingBytes, " are left in the file.");
+            return false;
+        }
+
+        m_commands.resize(static_cast<size_t>(header.commandBytes));
+        file.read(reinterpret_cast<char*>(m_commands.data()), static_cast<std::streamsize>(m_commands.size()));
+        if (static_cast<uint64_t>(file.gcount()) != header.commandBytes)
+        {
+            MCP_ERROR("RenderReplay", "Failed to load capture! Expected ", header.commandBytes, " bytes of commands.");
+            m_commands.clear();
+            return false;
+        }
+
+        m_frameCount = header.frameCount;
+        MCP_LOG("RenderReplay", "Loaded capture: ", pFilepath, " | Frames: ", m_frameCount, " | Textures: ", header.textureCount
+            , " | Command Bytes: ", header.commandBytes);
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The timings from previous runs are cleared. If a CSV path is given, every command of every iteration is written to it
+    //      as a row, which is useful for finding the individual draws that spike.
+    //
+    ///		@brief : Run every frame of the capture, timing each command.
+    ///		@param iterations : Number of times to run the whole capture.
+    ///		@param pCsvFilepath : Optional file to write the time of each command to.
+    ///		@returns : False if the capture is malformed, or the window was closed before we finished.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool RenderReplay::Run(const uint32_t iterations, const char* pCsvFilepath)
+    {
+        auto* pGraphics = GraphicsManager::Get();
+        if (!pGraphics)
+        {
+            MCP_ERROR("RenderReplay", "Failed to run replay! There is no GraphicsManager.");
+            return false;
+        }
+
+        if (!CreateTextures())
+            return false;
+
+        std::ofstream csv;
+        if (pCsvFilepath)
+        {
+            csv.open(pCsvFilepath);
+            if (!csv.is_open())
+                MCP_WARN("RenderReplay", "Failed to open CSV file: ", pCsvFilepath, ". Continuing without it.");
+            else
+                csv << "iteration,frame,command,type,zOrder,ms\n";
+        }
+
+        for (auto& stats : m_stats)
+            stats = ReplayCommandStats{};
+
+        m_frameTimes.clear();
+        m_totalDrawCalls = 0;
+
+        std::vector<ColoredQuad> quads;
+        HighPrecisionTimer timer;
+
+        for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            CommandReader reader(m_commands);
+            uint32_t frame = 0;
+            uint64_t commandIndex = 0;
+            int32_t zOrder = 0;
+            double frameMs = 0.0;
+
+            while (!reader.IsAtEnd())
+            {
+                const auto type = static_cast<RenderCommandType>(reader.Read<uint8_t>());
+                double elapsedMs = 0.0;
+
+                // Read the command's fields first, so that only the call itself is timed.
+                switch (type)
+                {
+                    case RenderCommandType::kFrameEnd:
+                    {
+                        timer.Start();
+                        pGraphics->Display();
+                        elapsedMs = timer.GetTimer();
+
+                        m_totalDrawCalls += pGraphics->GetLastFrameStats().drawCalls;
+                        break;
+                    }
+
+                    case RenderCommandType::kZOrder:
+                    {
+                        zOrder = reader.Read<int32_t>();
+                        break;
+                    }
+
+                    case RenderCommandType::kSetDrawColor:
+                    case RenderCommandType::kFillScreen:
+                    {
+                        const Color color = reader.ReadColor();
+
+                        timer.Start();
+                        if (type == RenderCommandType::kSetDrawColor)
+                            SetDrawColor(color);
+                        else
+                            FillScreen(color);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kLine:
+                    {
+                        const Vec2 a = reader.ReadVec2();
+                        const Vec2 b = reader.ReadVec2();
+                        const float thickness = reader.Read<float>();
+                        const Color color = reader.ReadColor();
+
+                        timer.Start();
+                        DrawLine(a, b, thickness, color);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kFillRect:
+                    case RenderCommandType::kRect:
+                    {
+                        const RectF rect = reader.ReadRectF();
+                        const Color color = reader.ReadColor();
+
+                        timer.Start();
+                        if (type == RenderCommandType::kFillRect)
+                            DrawFillRect(rect, color);
+                        else
+                            DrawRect(rect, color);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kCircle:
+                    case RenderCommandType::kFillCircle:
+                    {
+                        const Vec2 center = reader.ReadVec2();
+                        const float radius = reader.Read<float>();
+                        const Color color = reader.ReadColor();
+
+                        timer.Start();
+                        if (type == RenderCommandType::kFillCircle)
+                            DrawFillCircle(center, radius, color);
+                        else
+                            DrawCircle(center, radius, color);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kTexture:
+                    {
+                        TextureRenderData context;
+                        context.pTexture = GetTexture(reader.Read<uint32_t>());
+                        context.destinationRect = reader.ReadRectF();
+                        context.crop = reader.ReadRectInt();
+                        context.anglePivot = reader.ReadVec2();
+                        context.angle = static_cast<double>(reader.Read<float>());
+                        context.flip = static_cast<RenderFlip2D>(reader.Read<uint8_t>());
+                        context.tint = reader.ReadColor();
+
+                        if (!context.pTexture)
+                            break;
+
+                        timer.Start();
+                        DrawTexture(context);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kQuads:
+                    {
+                        void* pTexture = GetTexture(reader.Read<uint32_t>());
+                        const RectInt crop = reader.ReadRectInt();
+                        const auto count = reader.Read<uint32_t>();
+
+                        // Each quad is a RectF and a Color.
+                        constexpr uint64_t kQuadBytes = sizeof(float) * 4 + sizeof(uint8_t) * 4;
+                        if (!reader.HasBytes(static_cast<uint64_t>(count) * kQuadBytes))
+                            break;
+
+                        quads.resize(count);
+                        for (auto& quad : quads)
+                        {
+                            quad.rect = reader.ReadRectF();
+                            quad.color = reader.ReadColor();
+                        }
+
+                        if (!reader.IsValid())
+                            break;
+
+                        timer.Start();
+                        DrawQuads(pTexture, crop, quads.data(), quads.size());
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kCreateTarget:
+                    {
+                        const auto id = reader.Read<uint32_t>();
+                        const auto width = reader.Read<int32_t>();
+                        const auto height = reader.Read<int32_t>();
+                        const Vec2Int size(width, height);
+                        if (id == 0 || id > m_textures.size())
+                        {
+                            MCP_ERROR("RenderReplay", "Failed to run replay! Invalid texture id: ", id);
+                            return false;
+                        }
+
+                        // The target may still exist from a previous iteration.
+                        auto& texture = m_textures[id - 1];
+                        if (texture.pTexture)
+                            DestroyTargetTexture(texture.pTexture);
+
+                        timer.Start();
+                        texture.pTexture = CreateTargetTexture(size);
+                        elapsedMs = timer.GetTimer();
+
+                        texture.isTarget = true;
+                        break;
+                    }
+
+                    case RenderCommandType::kDestroyTarget:
+                    {
+                        const auto id = reader.Read<uint32_t>();
+                        if (id == 0 || id > m_textures.size())
+                        {
+                            MCP_ERROR("RenderReplay", "Failed to run replay! Invalid texture id: ", id);
+                            return false;
+                        }
+
+                        auto& texture = m_textures[id - 1];
+                        timer.Start();
+                        DestroyTargetTexture(texture.pTexture);
+                        elapsedMs = timer.GetTimer();
+
+                        texture.pTexture = nullptr;
+                        break;
+                    }
+
+                    case RenderCommandType::kSetTarget:
+                    {
+                        void* pTexture = GetTexture(reader.Read<uint32_t>());
+
+                        timer.Start();
+                        SetTargetTexture(pTexture);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kBeginScaled:
+                    {
+                        const float scale = reader.Read<float>();
+
+                        timer.Start();
+                        BeginScaledRender(scale);
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    case RenderCommandType::kEndScaled:
+                    {
+                        timer.Start();
+                        EndScaledRender();
+                        elapsedMs = timer.GetTimer();
+                        break;
+                    }
+
+                    default:
+                    {
+                        MCP_ERROR("RenderReplay", "Failed to run replay! Unknown command type: ", static_cast<int>(type), " at command ", commandIndex);
+                        return false;
+                    }
+                }
+
+                if (!reader.IsValid())
+                {
+                    MCP_ERROR("RenderReplay", "Failed to run replay! The capture ended in the middle of a ", RenderCapture::GetCommandName(type), " command.");
+                    return false;
+                }
+
+                auto& stats = m_stats[static_cast<size_t>(type)];
+                ++stats.count;
+                stats.totalMs += elapsedMs;
+                stats.maxMs = std::max(stats.maxMs, elapsedMs);
+                frameMs += elapsedMs;
+
+                if (csv.is_open())
+                    csv << iteration << ',' << frame << ',' << commandIndex << ',' << RenderCapture::GetCommandName(type) << ',' << zOrder << ',' << elapsedMs << '\n';
+
+                ++commandIndex;
+
+                if (type == RenderCommandType::kFrameEnd)
+                {
+                    m_frameTimes.emplace_back(frameMs);
+                    frameMs = 0.0;
+                    ++frame;
+
+                    // Keep the window responsive, and allow it to be closed to stop the replay.
+                    if (auto* pWindow = pGraphics->GetWindow(); pWindow && !pWindow->ProcessEvents())
+                    {
+                        MCP_WARN("RenderReplay", "Replay stopped. The window was closed.");
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Log the timings of each command type and the frames from the last Run().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void RenderReplay::LogResults() const
+    {
+        if (m_frameTimes.empty())
+        {
+            MCP_WARN("RenderReplay", "No frames were replayed.");
+            return;
+        }
+
+        const size_t frameCount = m_frameTimes.size();
+        double totalMs = 0.0;
+        for (const double frameMs : m_frameTimes)
+            totalMs += frameMs;
+
+        const auto [minIt, maxIt] = std::minmax_element(m_frameTimes.begin(), m_frameTimes.end());
+        MCP_LOG("RenderReplay", "Frames: ", frameCount
+            , " | Avg: ", totalMs / static_cast<double>(frameCount), "ms"
+            , " | Min: ", *minIt, "ms"
+            , " | Max: ", *maxIt, "ms"
+            , " | Avg Draw Calls: ", static_cast<double>(m_totalDrawCalls) / static_cast<double>(frameCount));
+
+        for (size_t i = 0; i < static_cast<size_t>(RenderCommandType::kCount); ++i)
+        {
+            const auto& stats = m_stats[i];
+            if (stats.count == 0)
+                continue;
+
+            MCP_LOG("RenderReplay", RenderCapture::GetCommandName(static_cast<RenderCommandType>(i))
+                , " | Count: ", stats.count
+                , " | Total: ", stats.totalMs, "ms"
+                , " | Avg: ", stats.totalMs / static_cast<double>(stats.count), "ms"
+                , " | Max: ", stats.maxMs, "ms");
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Render targets are skipped, as they are created by the commands themselves.
+    //
+    ///		@brief : Load or create every texture in the capture's texture table.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool RenderReplay::CreateTextures()
+    {
+        ReleaseTextures();
+
+        for (auto& texture : m_textures)
+        {
+            if (texture.flags & RenderCaptureHeader::kTextureRenderTarget)
+                continue;
+
+            if (texture.flags & RenderCaptureHeader::kTextureFromResource)
+            {
+                texture.pResource = BLEACH_NEW(Texture);
+                const DiskResourceRequest request(texture.path, texture.packagePath.empty() ? nullptr : texture.packagePath.c_str());
+
+                if (texture.pResource->Load(request))
+                {
+                    texture.pTexture = texture.pResource->Get();
+                    continue;
+                }
+
+                MCP_WARN("RenderReplay", "Failed to load texture: ", texture.path, ". Using a placeholder.");
+                BLEACH_DELETE(texture.pResource);
+                texture.pResource = nullptr;
+            }
+
+            texture.pTexture = CreatePlaceholder(texture.width, texture.height);
+            if (!texture.pTexture)
+            {
+                MCP_ERROR("RenderReplay", "Failed to create placeholder texture!");
+                return false;
+            }
+
+            texture.isTarget = true;
+        }
+
+        return true;
+    }
+
+    void RenderReplay::ReleaseTextures()
+    {
+        for (auto& texture : m_textures)
+        {
+            if (texture.pResource)
+            {
+                BLEACH_DELETE(texture.pResource);
+                texture.pResource = nullptr;
+            }
+
+            else if (texture.isTarget)
+            {
+                DestroyTargetTexture(texture.pTexture);
+            }
+
+            texture.pTexture = nullptr;
+            texture.isTarget = false;
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Create a texture that is filled with magenta, so that it stands out in the replay.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void* RenderReplay::CreatePlaceholder(const int32_t width, const int32_t height) const
+    {
+        void* pTexture = CreateTargetTexture(Vec2Int(std::max(width, 1), std::max(height, 1)));
+        if (!pTexture)
+            return nullptr;
+
+        SetTargetTexture(pTexture);
+        FillScreen(Color(255, 0, 255));
+        SetTargetTexture(nullptr);
+
+        return pTexture;
+    }
+
+    void* RenderReplay::GetTexture(const uint32_t id) const
+    {
+        if (id == 0 || id > m_textures.size())
+            return nullptr;
+
+        return m_textures[id - 1].pTexture;
+    }
+}
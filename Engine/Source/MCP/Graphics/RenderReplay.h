@@ -0,0 +1,78 @@
+#pragma once
+// RenderReplay.h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RenderCapture.h"
+
+namespace mcp
+{
+    class Texture;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Timing results for a single type of command.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct ReplayCommandStats
+    {
+        uint64_t count = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The replay issues the commands through the same Graphics functions that the game used, so the results can be
+    //      compared across Renderer changes without running the game itself. The times measure how long each call takes to
+    //      submit on the CPU; the GPU cost of a frame shows up in the FrameEnd command, which presents the frame.
+    //
+    //      Textures that were loaded as resources are loaded again from their paths. Any other texture is replaced with a
+    //      magenta placeholder of the size that was recorded in the capture.
+    //
+    ///		@brief : Loads a file written by the RenderCapture and runs its commands against the active Renderer.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class RenderReplay
+    {
+        struct ReplayTexture
+        {
+            std::string path;
+            std::string packagePath;
+            Texture* pResource = nullptr;   // Set if the texture was loaded from its resource path.
+            void* pTexture = nullptr;       // Texture handed to the Renderer.
+            int32_t width = 0;
+            int32_t height = 0;
+            uint8_t flags = 0;
+            bool isTarget = false;          // True if pTexture was created with CreateTargetTexture().
+        };
+
+        std::vector<ReplayTexture> m_textures;
+        std::vector<uint8_t> m_commands;
+        ReplayCommandStats m_stats[static_cast<size_t>(RenderCommandType::kCount)] {};
+        std::vector<double> m_frameTimes;
+        uint64_t m_totalDrawCalls = 0;
+        uint32_t m_frameCount = 0;
+
+    public:
+        RenderReplay() = default;
+        ~RenderReplay();
+
+        RenderReplay(const RenderReplay&) = delete;
+        RenderReplay& operator=(const RenderReplay&) = delete;
+        RenderReplay(RenderReplay&&) = delete;
+        RenderReplay& operator=(RenderReplay&&) = delete;
+
+        bool Load(const char* pFilepath);
+        bool Run(const uint32_t iterations = 1, const char* pCsvFilepath = nullptr);
+        void LogResults() const;
+
+        [[nodiscard]] uint32_t GetFrameCount() const { return m_frameCount; }
+        [[nodiscard]] const ReplayCommandStats& GetStats(const RenderCommandType type) const { return m_stats[static_cast<size_t>(type)]; }
+        [[nodiscard]] const std::vector<double>& GetFrameTimes() const { return m_frameTimes; }
+
+    private:
+        bool CreateTextures();
+        void ReleaseTextures();
+        void* CreatePlaceholder(const int32_t width, const int32_t height) const;
+        [[nodiscard]] void* GetTexture(const uint32_t id) const;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "Texture.h"
 
+#include "MCP/Core/Resource/PreloadManifest.h"
 #include "MCP/Core/Resource/ResourceManager.h"
 
 #if MCP_RENDERER_API == MCP_RENDERER_API_SDL
@@ -11,6 +12,8 @@ struct SDL_Texture;
 namespace mcp
 {
     using TextureAssetType = SDL_Texture;
+
+    template<> struct StreamsFromPackage<TextureData> : std::true_type {};
 }
 #else
 #error "We don't have a resource implementation for Texture loading for current API!'"
@@ -74,8 +77,41 @@ namespace mcp
         return *this;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The texture is usable immediately, but will render a placeholder (and report the placeholder's size) until the
+    //      image has been decoded and uploaded. Use IsPending() to check if it has finished. If the texture was already loaded,
+    //      this is the same as Load().
+    //
+    ///		@brief : Load the texture, decoding the image on a worker thread.
+    ///		@returns : False if the request could not be queued.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool Texture::LoadAsync(const DiskResourceRequest& request)
+    {
+        if (m_pResource)
+            Free();
+
+        m_request = request;
+        PreloadManifest::Record(PreloadAssetType::kTexture, m_request);
+        m_pResource = ResourceManager::Get()->LoadFromDiskAsync<TextureData>(m_request);
+        return m_pResource;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The load holds a reference until it is released with ResourceManager::ReleaseLoad(), so that the texture is ready
+    //      when it is loaded for real.
+    //
+    ///		@brief : Start loading a texture in the background, without keeping a handle to it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ResourceLoadHandle Texture::Preload(const DiskResourceRequest& request)
+    {
+        return ResourceManager::Get()->LoadAsync<TextureData>(request, LoadPriority::kBackground);
+    }
+
     void* Texture::LoadResourceType()
     {
+        PreloadManifest::Record(PreloadAssetType::kTexture, m_request);
         return ResourceManager::Get()->LoadFromDisk<TextureData>(m_request);
     }
 
@@ -90,6 +126,17 @@ namespace mcp
         return static_cast<TextureData*>(m_pResource)->pTexture;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns true if the texture is still waiting on an async load to complete.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool Texture::IsPending() const
+    {
+        if (!m_pResource)
+            return false;
+
+        return static_cast<TextureData*>(m_pResource)->IsPending();
+    }
+
     Vec2Int Texture::GetTextureSize() const
     {
         if (!m_pResource)
@@ -1,7 +1,9 @@
 #pragma once
 // Texture.h
 
+#include "MCP/Core/Resource/AsyncResourceLoader.h"
 #include "MCP/Core/Resource/Resource.h"
+#include "MCP/Core/Resource/ResourceLoadHandle.h"
 #include "Utility/Types/Color.h"
 #include "Utility/Types/Vector2.h"
 
@@ -14,8 +16,14 @@ namespace mcp
         void* pTexture = nullptr;   // Pointer to the actual texture resource.
         int width = 0;              // Base image width
         int height = 0;             // Base image height
+        AsyncJobHandle pendingJob;  // Valid while an async load is in progress. Until then, pTexture is a placeholder.
+
+        [[nodiscard]] bool IsPending() const { return pendingJob != nullptr; }
     };
 
+    template<>
+    struct SupportsAsyncLoad<TextureData> : std::true_type {};
+
     class Texture final : public DiskResource
     {
     public:
@@ -27,10 +35,14 @@ namespace mcp
         Texture& operator=(const Texture& right);
         Texture& operator=(Texture&& right) noexcept;
 
+        [[nodiscard]] bool LoadAsync(const DiskResourceRequest& request);
         [[nodiscard]] virtual void* Get() const override;
+        [[nodiscard]] bool IsPending() const;
         [[nodiscard]] Vec2Int GetTextureSize() const;
         [[nodiscard]] Vec2 GetTextureSizeAsVec2() const;
 
+        static ResourceLoadHandle Preload(const DiskResourceRequest& request);
+
     protected:
         virtual void* LoadResourceType() override;
         virtual void Free() override;
@@ -1,8 +1,14 @@
 // LuaSystem.cpp
 
 #include "LuaContext.h"
+
+#include <algorithm>
+#include <cstdio>
 #include "LuaSource.h"
 #include "MCP/Core/Application/Application.h"
+#include "MCP/Core/Resource/PackageManager.h"
+#include "MCP/Core/Resource/PreloadManifest.h"
+#include "MCP/Graphics/Graphics.h"
 
 #include "MCP/Lua/LuaDebug.h"
 #include "MCP/Scene/SceneManager.h"
@@ -13,6 +19,7 @@
 #include "MCP/UI/TextWidget.h"
 #include "MCP/UI/ToggleWidget.h"
 #include "MCP/UI/Widget.h"
+#include "Utility/Generic/Hash.h"
 
 namespace mcp
 {
@@ -44,6 +51,15 @@ namespace mcp
         lua_pop(pState, 1);
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : lua_Writer that appends the dumped bytecode to a std::string.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static int WriteBytecode([[maybe_unused]] lua_State* pState, const void* pData, const size_t size, void* pUserData)
+    {
+        static_cast<std::string*>(pUserData)->append(static_cast<const char*>(pData), size);
+        return 0;
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
@@ -60,17 +76,16 @@ namespace mcp
         AddSearchPath(m_pState, "..\\MCPEngine\\?.lua");
         AddSearchPath(m_pState, "Engine\\Scripts\\?.lua");
 
-        std::string scriptsPath = Application::Get()->GetContext().workingDirectory;
-
 #if MCP_EDITOR
-        const std::string projectSearchPath = scriptsPath + "?.lua";
+        const std::string projectSearchPath = Application::Get()->GetContext().workingDirectory + "?.lua";
         AddSearchPath(m_pState, projectSearchPath.c_str());
 #endif
 
-        scriptsPath += R"(Engine\Scripts\Core\MCP.lua)";
+        // Find modules in loaded packages, and through the script cache.
+        InstallScriptSearcher();
 
         // Sets the initial require for each of our modules.
-        if (luaL_dofile(m_pState, scriptsPath.c_str()) != 0)
+        if (!DoFile(R"(Engine\Scripts\Core\MCP.lua)"))
         {
             [[maybe_unused]] const auto errorMsg = lua_tostring(m_pState, -1);
             lua_pop(m_pState, 1); // Pop the error message off the stack.
@@ -87,6 +102,7 @@ namespace mcp
         // Register each of the types' lua capabilities to the state.
         Application::RegisterLuaFunctions(m_pState);
         SceneManager::RegisterLuaFunctions(m_pState);
+        GraphicsManager::RegisterLuaFunctions(m_pState);
         Widget::RegisterLuaFunctions(m_pState);
         ImageWidget::RegisterLuaFunctions(m_pState);
         CanvasWidget::RegisterLuaFunctions(m_pState);
@@ -116,6 +132,7 @@ namespace mcp
 #endif
 
         lua_close(m_pState);
+        ClearScriptCache();
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -131,11 +148,8 @@ namespace mcp
     {
         MCP_CHECK(functionArray);
 
-        std::string scriptsPath = Application::Get()->GetContext().workingDirectory;
-        scriptsPath += pScriptFilepath;
-
         // HACK: I am assuming that this class is going to have a global table named 'pTypename'.
-        if (luaL_dofile(m_pState, scriptsPath.c_str()) != 0)
+        if (!DoFile(pScriptFilepath))
         {
             lua_pop(m_pState, 1);
             MCP_ERROR("Lua", "Failed to run Script lib! Filepath: ", pScriptFilepath);
@@ -164,9 +178,7 @@ namespace mcp
     //-----------------------------------------------------------------------------------------------------------------------------
     bool LuaContext::LoadScript(const char* pFilepath) const
     {
-        std::string scriptsPath = Application::Get()->GetContext().workingDirectory;
-        scriptsPath += pFilepath;
-        if (luaL_dofile(m_pState, scriptsPath.c_str()) != 0)
+        if (!DoFile(pFilepath))
         {
             lua_pop(m_pState, 1); // Pop the error message off the stack.
             MCP_ERROR("Lua", "Failed to load Lua Script! Filepath: ", pFilepath);
@@ -180,18 +192,21 @@ namespace mcp
     //		NOTES:
     //      In the future, I may want to setup a table registry over using the default one.
     //		
+    //      The script is only compiled the first time; every instance after that is loaded from the cached bytecode.
+    //
     ///		@brief : Load a lua script and return a reference to the object.
     ///		@param pFilepath : File path to the script.
     ///		@returns : A integer value that serves as our reference key. If we failed to get the instance, it returns LuaSystem::kInvalidRef.
     //-----------------------------------------------------------------------------------------------------------------------------
     LuaResourcePtr LuaContext::LoadScriptInstance(const char* pFilepath) const
     {
-        std::string scriptsPath = Application::Get()->GetContext().workingDirectory;
-        scriptsPath += pFilepath;
-        if (luaL_dofile(m_pState, scriptsPath.c_str()) != 0)
+        PreloadManifest::Record(PreloadAssetType::kScript, pFilepath, nullptr);
+
+        if (!DoFile(pFilepath))
         {
+            [[maybe_unused]] const auto errorMsg = lua_tostring(m_pState, -1);
             lua_pop(m_pState, 1); // Pop the error message off the stack.
-            MCP_ERROR("Lua", "Failed to load Lua Script! Filepath: ", scriptsPath);
+            MCP_ERROR("Lua", "Failed to load Lua Script! Filepath: ", pFilepath, "\nLua Error: ", errorMsg);
             return LuaResourcePtr();
         }
 
@@ -241,6 +256,254 @@ namespace mcp
         return script;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Scripts are compiled again the next time they are loaded.
+    //		
+    ///		@brief : Release all of the cached bytecode.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void LuaContext::ClearScriptCache() const
+    {
+        m_scriptCache.clear();
+        m_cacheStats.bytecodeSize = 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Same as luaL_dofile(), but the script is loaded through the script cache, from a loose file or a loaded package.
+    //		
+    ///		@brief : Load and run a script.
+    ///		@param pFilepath : Path to the script, relative to the working directory.
+    ///		@returns : False on failure, with the error message on top of the stack.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool LuaContext::DoFile(const char* pFilepath) const
+    {
+        return LoadFile(GetScriptName(pFilepath)) && lua_pcall(m_pState, 0, LUA_MULTRET, 0) == LUA_OK;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Text is compiled and then dumped to bytecode for the cache. Files that are already bytecode are cached as they are.
+    //      Debug info is kept in the bytecode, so errors still report the script's line numbers.
+    //		
+    ///		@brief : Push the main function of a script onto the stack, without running it.
+    ///		@param scriptName : Path to the script from GetScriptName().
+    ///		@param pFoundOut : Optional. Set to false if the script doesn't exist, as opposed to failing to compile.
+    ///		@returns : False on failure, with the error message on top of the stack.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool LuaContext::LoadFile(const std::string& scriptName, bool* pFoundOut) const
+    {
+        if (pFoundOut)
+            *pFoundOut = true;
+
+        const auto cached = m_scriptCache.find(scriptName);
+
+#if !MCP_EDITOR
+        if (cached != m_scriptCache.end())
+            return LoadFromCache(scriptName, cached->second);
+#endif
+
+        ScriptSource source;
+        if (!ReadScript(scriptName, source))
+        {
+            if (pFoundOut)
+                *pFoundOut = false;
+
+            lua_pushfstring(m_pState, "cannot open %s", scriptName.c_str());
+            return false;
+        }
+
+        const uint64_t sourceHash = HashString64(source.pData, source.size);
+
+#if MCP_EDITOR
+        if (cached != m_scriptCache.end() && cached->second.sourceHash == sourceHash)
+            return LoadFromCache(scriptName, cached->second);
+#endif
+
+        const std::string chunkName = "@" + scriptName;
+        if (luaL_loadbufferx(m_pState, source.pData, source.size, chunkName.c_str(), "bt") != LUA_OK)
+            return false;
+
+        auto& script = m_scriptCache[scriptName];
+        m_cacheStats.bytecodeSize -= script.bytecode.size();
+        script.sourceHash = sourceHash;
+
+        const bool isPrecompiled = source.size > 0 && source.pData[0] == LUA_SIGNATURE[0];
+        if (isPrecompiled)
+        {
+            script.bytecode.assign(source.pData, source.size);
+            ++m_cacheStats.precompiledCount;
+        }
+
+        else
+        {
+            script.bytecode.clear();
+            if (lua_dump(m_pState, &WriteBytecode, &script.bytecode, 0) != 0)
+            {
+                // We still have the function, so this load worked. It just gets compiled again next time.
+                MCP_WARN("Lua", "Failed to dump bytecode for script: ", scriptName);
+                m_scriptCache.erase(scriptName);
+                return true;
+            }
+
+            ++m_cacheStats.compiledCount;
+        }
+
+        m_cacheStats.bytecodeSize += script.bytecode.size();
+        return true;
+    }
+
+    bool LuaContext::LoadFromCache(const std::string& scriptName, const CompiledScript& script) const
+    {
+        ++m_cacheStats.cachedLoadCount;
+
+        const std::string chunkName = "@" + scriptName;
+        return luaL_loadbufferx(m_pState, script.bytecode.data(), script.bytecode.size(), chunkName.c_str(), "b") == LUA_OK;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Loose files override packaged scripts in the editor and debug builds, so scripts can be edited without repacking.
+    //      Other builds look in the loaded packages first, so a packaged script costs a single package read, and only fall back
+    //      to a loose file for scripts that weren't packed.
+    //
+    //      Package data is used in place. It is only valid until the next request to the same package.
+    //		
+    ///		@brief : Find a script's contents, in a loose file or a loaded package.
+    ///		@returns : False if the script doesn't exist.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool LuaContext::ReadScript(const std::string& scriptName, ScriptSource& source)
+    {
+#if MCP_EDITOR || defined(_DEBUG)
+        static constexpr bool kPreferLooseFiles = true;
+#else
+        static constexpr bool kPreferLooseFiles = false;
+#endif
+
+        const auto readLooseFile = [&scriptName, &source]() -> bool
+        {
+            const std::string path = Application::Get()->GetContext().workingDirectory + scriptName;
+            if (!ReadScriptFile(path, source.fileData))
+                return false;
+
+            source.pData = source.fileData.data();
+            source.size = source.fileData.size();
+            return true;
+        };
+
+        const auto readPackage = [&scriptName, &source]() -> bool
+        {
+            auto* pPackageManager = PackageManager::Get();
+            if (!pPackageManager)
+                return false;
+
+            const auto* pData = pPackageManager->FindRawData(AssetPackage::HashPath(scriptName.c_str()));
+            if (!pData)
+                return false;
+
+            source.pData = pData->pData;
+            source.size = static_cast<size_t>(pData->size);
+            return true;
+        };
+
+        if (kPreferLooseFiles)
+            return readLooseFile() || readPackage();
+
+        return readPackage() || readLooseFile();
+    }
+
+    bool LuaContext::ReadScriptFile(const std::string& path, std::vector<char>& data)
+    {
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.c_str(), "rb") != 0 || !pFile)
+            return false;
+
+        bool succeeded = std::fseek(pFile, 0, SEEK_END) == 0;
+        const long size = succeeded ? std::ftell(pFile) : -1;
+        succeeded = size >= 0 && std::fseek(pFile, 0, SEEK_SET) == 0;
+
+        if (succeeded)
+        {
+            data.resize(static_cast<size_t>(size));
+            succeeded = data.empty() || std::fread(data.data(), data.size(), 1, pFile) == 1;
+        }
+
+        std::fclose(pFile);
+        return succeeded;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Packages name their assets with forward slashes, so the cache and the packages both use that form.
+    //		
+    ///		@brief : Get the name that a script is cached and packed under, from its path relative to the working directory.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    std::string LuaContext::GetScriptName(const char* pFilepath)
+    {
+        std::string name = pFilepath;
+        std::replace(name.begin(), name.end(), '\\', '/');
+        return name;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This is installed in package.searchers right after the preload searcher, so 'require' finds modules through the
+    //      script cache, in loose files and loaded packages. Module names are paths from the working directory, with '.' in
+    //      place of the slashes (ex: 'Engine.Scripts.Core.Class'). If the module isn't found, Lua moves on to its own searchers,
+    //      which use package.path.
+    //		
+    ///		@brief : package.searchers entry. Upvalue 1 is the LuaContext.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    int LuaContext::SearchScripts(lua_State* pState)
+    {
+        const char* pModuleName = luaL_checkstring(pState, 1);
+        const auto* pContext = static_cast<const LuaContext*>(lua_touserdata(pState, lua_upvalueindex(1)));
+
+        std::string scriptName = pModuleName;
+        std::replace(scriptName.begin(), scriptName.end(), '.', '/');
+        scriptName += ".lua";
+
+        bool isFound = false;
+        if (pContext->LoadFile(scriptName, &isFound))
+        {
+            // Lua passes the second value to the loader, like it does with the file name for its own searchers.
+            lua_pushstring(pState, scriptName.c_str());
+            return 2;
+        }
+
+        if (!isFound)
+        {
+            lua_pop(pState, 1);
+            lua_pushfstring(pState, "no script '%s' in the working directory or loaded packages", scriptName.c_str());
+            return 1;
+        }
+
+        return luaL_error(pState, "error loading module '%s' from script '%s':\n\t%s", pModuleName, scriptName.c_str(), lua_tostring(pState, -1));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Put SearchScripts() in package.searchers, after the preload searcher and before Lua's own searchers.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void LuaContext::InstallScriptSearcher()
+    {
+        lua_getglobal(m_pState, "package");
+        lua_getfield(m_pState, -1, "searchers");
+
+        // Move every searcher after the first one up a slot.
+        for (auto i = static_cast<lua_Integer>(luaL_len(m_pState, -1)); i >= 2; --i)
+        {
+            lua_rawgeti(m_pState, -1, i);
+            lua_rawseti(m_pState, -2, i + 1);
+        }
+
+        lua_pushlightuserdata(m_pState, this);
+        lua_pushcclosure(m_pState, &LuaContext::SearchScripts, 1);
+        lua_rawseti(m_pState, -2, 2);
+
+        // Pop the searchers and package tables.
+        lua_pop(m_pState, 2);
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
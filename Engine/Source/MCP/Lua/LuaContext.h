@@ -1,7 +1,11 @@
 #pragma once
 // LuaSystem.h
 
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "LuaResource.h"
 #include "MCP/Debug/Log.h"
@@ -14,9 +18,49 @@ struct luaL_Reg;
 
 namespace mcp
 {
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : How many scripts were compiled from source, and how many were loaded from already compiled bytecode.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct LuaScriptCacheStats
+    {
+        uint32_t compiledCount = 0;     // Scripts that were compiled from source.
+        uint32_t cachedLoadCount = 0;   // Loads that used bytecode from the cache.
+        uint32_t precompiledCount = 0;  // Scripts that were already bytecode on disk (see the ScriptCooker tool).
+        size_t bytecodeSize = 0;        // Total size of the cached bytecode, in bytes.
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every script file is compiled once, and the bytecode (from lua_dump) is cached by path. Loading the same script
+    //      again just loads the bytecode from memory, which skips reading the file and compiling it. Scripts that were
+    //      precompiled by the ScriptCooker are already bytecode, so they are cached as they are.
+    //
+    //      In the editor, the file is still read on each load and its content hash checked against the cache entry, so edits
+    //      to a script are picked up without restarting. It is still only compiled when it has changed.
+    //
+    //      Scripts are found in loose files or in loaded AssetPackages (see ReadScript() for which wins). 'require' goes through
+    //      the same path, with a custom package.searchers entry.
+    //
+    ///		@brief : Owns the lua state, and loads scripts into it.
+    //-----------------------------------------------------------------------------------------------------------------------------
     class LuaContext
     {
+        struct CompiledScript
+        {
+            std::string bytecode;
+            uint64_t sourceHash = 0;    // Hash of the file's contents that the bytecode was compiled from.
+        };
+
+        struct ScriptSource
+        {
+            std::vector<char> fileData; // Loose files are read into here.
+            const char* pData = nullptr;// Either fileData, or the package's data, used in place.
+            size_t size = 0;
+        };
+
         lua_State* m_pState = nullptr;
+        mutable std::unordered_map<std::string, CompiledScript> m_scriptCache;
+        mutable LuaScriptCacheStats m_cacheStats;
 
     public:
         // Initialization
@@ -30,6 +74,8 @@ namespace mcp
         [[nodiscard]] LuaResourcePtr CreateTable() const;
         void FreeScriptInstance(const LuaResourceId ref) const;
         bool RegisterScriptFunctions(const char* pTypename, const char* pScriptFilepath, const luaL_Reg* functionArray) const;
+        void ClearScriptCache() const;
+        [[nodiscard]] LuaScriptCacheStats GetScriptCacheStats() const { return m_cacheStats; }
 
         // Get Global Variables
         std::optional<bool> GetBoolean(const char* varName) const;
@@ -62,6 +108,16 @@ namespace mcp
         void CallMemberFunction(const LuaResourcePtr resource, const char* pMemberFunctionName,  Args&&...params) const;
 
     private:
+        // Script Loading
+        bool DoFile(const char* pFilepath) const;
+        bool LoadFile(const std::string& scriptName, bool* pFoundOut = nullptr) const;
+        bool LoadFromCache(const std::string& scriptName, const CompiledScript& script) const;
+        void InstallScriptSearcher();
+        static bool ReadScript(const std::string& scriptName, ScriptSource& source);
+        static bool ReadScriptFile(const std::string& path, std::vector<char>& data);
+        static std::string GetScriptName(const char* pFilepath);
+        static int SearchScripts(lua_State* pState);
+
         // Lua Function Call Helpers
         void CallFunctionImpl(const int paramCount) const;
         bool PushFunction(const char* pFunctionName) const;
@@ -54,8 +54,11 @@ namespace mcp
                 return false;
             }
 
+            // Resident packages are fully decoded now, instead of as each asset is requested.
+            const bool isResident = packageElement.GetAttributeValue<bool>("resident", false);
+
             // Load the package.
-            if (!PackageManager::Get()->LoadPackage(pPackageFilePath))
+            if (!PackageManager::Get()->LoadPackage(pPackageFilePath, isResident))
             {
                 MCP_ERROR("Scene", "Failed to load scene! Couldn't load package defined in xml 'path' attribute. Path: ", pPackageFilePath);
                 return false;
@@ -189,12 +192,19 @@ namespace mcp
 
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
+    //      The World may be rendered at a lower resolution by dynamic resolution scaling. The UI is always rendered at the
+    //      native resolution.
     //
     ///		@brief : Render each scene layer from the bottom up.
     //-----------------------------------------------------------------------------------------------------------------------------
     void Scene::Render() const
     {
+        const auto* pGraphics = GraphicsManager::Get();
+
+        pGraphics->BeginWorldRender();
         m_pWorldLayer->Render();
+        pGraphics->EndWorldRender();
+
         m_pUILayer->Render();
     }
 
@@ -25,6 +25,7 @@ namespace mcp
         , m_id(s_idCounter++)
         , m_tag(data.tag)
         , m_isActive(data.startActive)
+        , m_isStatic(data.isStatic)
 #if MCP_EDITOR
         , m_dirty(false)
 #endif
@@ -327,6 +328,9 @@ namespace mcp
         // Tag
         data.tag = element.GetAttributeValue<const char*>("tag", nullptr);
 
+        // Static flag
+        data.isStatic = element.GetAttributeValue<bool>("static", false);
+
 #if MCP_EDITOR
         data.root = element;
 #endif
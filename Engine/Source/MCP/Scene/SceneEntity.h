@@ -37,6 +37,7 @@ private:
 #endif
         StringId tag;
         bool startActive = true;
+        bool isStatic = false;      // Static entities are not expected to move or change, so their rendering can be baked.
     };
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -66,6 +67,7 @@ private:
         const StringId m_tag = kInvalidTag;
         bool m_isActive = true;
         bool m_isQueuedForDeletion = false;
+        bool m_isStatic = false;
 
     public:
         SceneEntity();
@@ -114,6 +116,7 @@ private:
         // Entity Info
         [[nodiscard]] EntityId GetId() const { return m_id; }
         [[nodiscard]] StringId GetTag() const { return m_tag; }
+        [[nodiscard]] bool IsStatic() const { return m_isStatic; }
         [[nodiscard]] virtual SceneEntity* GetParent() const { return m_pParent; }
 
         // Utils
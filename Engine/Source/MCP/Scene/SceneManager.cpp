@@ -2,12 +2,19 @@
 
 #include "SceneManager.h"
 
+#include <algorithm>
 #include <BleachNew.h>
 #include "LuaSource.h"
 #include "SceneAsset.h"
+#include "MCP/Audio/AudioClip.h"
+#include "MCP/Audio/AudioResource.h"
+#include "MCP/Audio/AudioTrack.h"
 #include "MCP/Core/Application/Application.h"
+#include "MCP/Core/Resource/Font.h"
+#include "MCP/Core/Resource/ResourceManager.h"
 #include "MCP/Debug/Log.h"
 #include "MCP/Graphics/Graphics.h"
+#include "MCP/Graphics/Texture.h"
 #include "Utility/String/Path.h"
 
 namespace mcp
@@ -81,6 +88,7 @@ namespace mcp
         // Delete all of our scenes.
         for (auto&[id, data] : m_sceneList)
         {
+            ReleasePreloadedAssets(data);
             BLEACH_DELETE(data.pScene);
             data.pScene = nullptr;
         }
@@ -155,6 +163,103 @@ namespace mcp
         m_sceneToTransitionTo = identifier;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The assets are loaded with background priority, so they are streamed in over the next few frames without
+    //      stalling the active scene. Each preloaded asset is kept in memory until the scene is entered, which makes the
+    //      transition a matter of finding assets that are already loaded.
+    //
+    //      The manifest is generated the first time the scene is entered, so the first transition to a scene can't be
+    //      preloaded. Scripts are listed in the manifest, but are not preloaded: they are run when they are instanced.
+    //		
+    ///		@brief : Start loading the assets that a scene needs in the background, so that transitioning to it is fast.
+    ///		@returns : False if there is no manifest for the scene yet.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool SceneManager::PreloadScene(const SceneIdentifier& identifier)
+    {
+        const auto result = m_sceneList.find(identifier);
+        if (result == m_sceneList.end())
+        {
+            MCP_WARN("SceneManager", "Attempted to preload Scene with no valid identifier! Identifier: ", identifier.GetCStr());
+            return false;
+        }
+
+        SceneData& sceneData = result->second;
+        LoadManifest(sceneData);
+
+        if (sceneData.manifest.IsEmpty())
+        {
+            MCP_LOG("SceneManager", "No preload manifest for Scene: ", identifier.GetCStr(), ". It will be generated when the scene is loaded.");
+            return false;
+        }
+
+        // Already preloading.
+        if (!sceneData.preloadedAssets.empty())
+            return true;
+
+        for (const auto& entry : sceneData.manifest.GetEntries())
+        {
+            ResourceLoadHandle handle;
+
+            switch (entry.type)
+            {
+                case PreloadAssetType::kTexture:
+                    handle = Texture::Preload(DiskResourceRequest(entry.path, entry.GetPackagePath()));
+                    break;
+
+                case PreloadAssetType::kFont:
+                    handle = Font::Preload({ DiskResourceRequest(entry.path, entry.GetPackagePath()), entry.param });
+                    break;
+
+                case PreloadAssetType::kAudioClip:
+                    handle = AudioClip::Preload(DiskResourceRequest(entry.path, entry.GetPackagePath()));
+                    break;
+
+                case PreloadAssetType::kAudioTrack:
+                    handle = AudioTrack::Preload(DiskResourceRequest(entry.path, entry.GetPackagePath()));
+                    break;
+
+                case PreloadAssetType::kAudioResource:
+                {
+                    // AudioSourceComponents request the path as it was written, so we need to match it.
+                    AudioResourceRequest request;
+                    request.path = entry.path.c_str();
+                    if (!entry.packagePath.empty())
+                        request.packagePath = entry.packagePath.c_str();
+                    request.isMusicResource = entry.param != 0;
+                    handle = AudioResource::Preload(request);
+                    break;
+                }
+
+                default: break;
+            }
+
+            if (handle)
+                sceneData.preloadedAssets.push_back(PreloadedAsset{entry, std::move(handle)});
+        }
+
+        MCP_LOG("SceneManager", "Preloading ", sceneData.preloadedAssets.size(), " assets for Scene: ", identifier.GetCStr());
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Stop preloading a scene, and release any of its assets that have already been loaded.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void SceneManager::CancelPreload(const SceneIdentifier& identifier)
+    {
+        if (const auto result = m_sceneList.find(identifier); result != m_sceneList.end())
+        {
+            ReleasePreloadedAssets(result->second);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Every asset that is requested while the scene is being loaded is recorded, and the scene's manifest is updated if
+    //      it changed. The assets that were preloaded are released once the scene holds its own references.
+    //
+    ///		@brief : Destroy the active scene, and load the scene that is queued.
+    //-----------------------------------------------------------------------------------------------------------------------------
     bool SceneManager::TransitionToScene()
     {
         if (m_pActiveScene)
@@ -164,19 +269,26 @@ namespace mcp
         }
 
         // This is guaranteed to be valid. Invalid Ids cannot be queued.
-        const SceneData& sceneData = m_sceneList[m_sceneToTransitionTo];
+        SceneData& sceneData = m_sceneList[m_sceneToTransitionTo];
         m_pActiveScene = sceneData.pScene;
         MCP_CHECK(m_pActiveScene);
 
+        PreloadManifest requested;
+        PreloadManifest::BeginRecording(&requested);
+
         // Load the Scene
         if (!m_pActiveScene->Load(sceneData.dataPath.c_str()))
         {
+            PreloadManifest::EndRecording();
+            ReleasePreloadedAssets(sceneData);
             MCP_ERROR("SceneManager", "Failed to Load Scene: ", m_sceneToTransitionTo.GetCStr());
             return false;
         }
 
         if (!m_pActiveScene->OnSceneLoad())
         {
+            PreloadManifest::EndRecording();
+            ReleasePreloadedAssets(sceneData);
             MCP_ERROR("SceneManager", "Failed to Load Scene: ", m_sceneToTransitionTo.GetCStr());
             return false;
         }
@@ -185,9 +297,99 @@ namespace mcp
 
         m_pActiveScene->Begin();
 
+        PreloadManifest::EndRecording();
+        ReportPreloadResults(sceneData, requested);
+        ReleasePreloadedAssets(sceneData);
+
+        // This includes the scene's preloads, and anything else that was loaded since the last transition.
+        ResourceManager::Get()->LogSlowestLoads(m_sceneToTransitionTo.GetCStr());
+
+        // Save the manifest if the scene requested something different from last time.
+        LoadManifest(sceneData);
+        if (requested.GetEntries() != sceneData.manifest.GetEntries())
+        {
+            sceneData.manifest = std::move(requested);
+            sceneData.manifest.Save(PreloadManifest::GetManifestPath(sceneData.dataPath).c_str());
+        }
+
         return true;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Assets that weren't preloaded, or hadn't finished preloading, were loaded on demand during the transition.
+    //		
+    ///		@brief : Log which of the requested assets were loaded during the transition instead of before it.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void SceneManager::ReportPreloadResults(const SceneData& sceneData, const PreloadManifest& requested) const
+    {
+        if (sceneData.preloadedAssets.empty())
+        {
+            MCP_LOG("SceneManager", "Scene '", m_sceneToTransitionTo.GetCStr(), "' was not preloaded. ", requested.GetEntries().size(), " assets were loaded on demand.");
+            return;
+        }
+
+        size_t readyCount = 0;
+        size_t lateCount = 0;
+        size_t missedCount = 0;
+
+        for (const auto& entry : requested.GetEntries())
+        {
+            const auto preloaded = std::find_if(sceneData.preloadedAssets.begin(), sceneData.preloadedAssets.end(), [&entry](const PreloadedAsset& asset) -> bool
+            {
+                return asset.entry == entry;
+            });
+
+            if (preloaded == sceneData.preloadedAssets.end())
+            {
+                // Scripts are never preloaded, so they aren't worth reporting.
+                if (entry.type == PreloadAssetType::kScript)
+                    continue;
+
+                ++missedCount;
+                MCP_WARN("SceneManager", "Asset was not preloaded: ", PreloadManifest::GetTypeName(entry.type), " '", entry.path, "'");
+            }
+
+            else if (!preloaded->handle->IsReady())
+            {
+                ++lateCount;
+                MCP_WARN("SceneManager", "Asset was still preloading when it was needed: ", PreloadManifest::GetTypeName(entry.type), " '", entry.path, "'");
+            }
+
+            else
+            {
+                ++readyCount;
+            }
+        }
+
+        MCP_LOG("SceneManager", "Entered Scene '", m_sceneToTransitionTo.GetCStr(), "'. Preloaded: ", readyCount, ", Still loading: ", lateCount, ", Not preloaded: ", missedCount);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Load the scene's manifest from disk, if we haven't tried already.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void SceneManager::LoadManifest(SceneData& sceneData)
+    {
+        if (sceneData.manifestIsLoaded)
+            return;
+
+        sceneData.manifestIsLoaded = true;
+        sceneData.manifest.Load(PreloadManifest::GetManifestPath(sceneData.dataPath).c_str());
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Release the references that the preloads hold, canceling any that haven't finished.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void SceneManager::ReleasePreloadedAssets(SceneData& sceneData)
+    {
+        for (auto& asset : sceneData.preloadedAssets)
+        {
+            ResourceManager::ReleaseLoad(asset.handle);
+        }
+
+        sceneData.preloadedAssets.clear();
+    }
+
 #if MCP_EDITOR
     bool SceneManager::LoadEditorScene()
     {
@@ -308,6 +510,16 @@ namespace mcp
         return 0;
     }
 
+    static int ScriptPreloadScene(lua_State* pState)
+    {
+        auto* pSceneId = lua_tostring(pState, -1);
+        lua_pop(pState, 1);
+
+        SceneManager::Get()->PreloadScene(pSceneId);
+
+        return 0;
+    }
+
     static int PauseWorld([[maybe_unused]] lua_State* pState)
     {
         auto* pScene = SceneManager::Get()->GetActiveScene();
@@ -331,6 +543,7 @@ namespace mcp
         static constexpr luaL_Reg kFuncs[]
         {
              {"TransitionToScene", &ScriptTransitionToScene}
+             ,{"PreloadScene", &ScriptPreloadScene}
              ,{"PauseWorld", &PauseWorld}
              ,{"ResumeWorld", &ResumeWorld}
             ,{nullptr, nullptr}
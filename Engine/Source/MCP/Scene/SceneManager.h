@@ -2,6 +2,8 @@
 // SceneManager.h
 #include "Scene.h"
 #include "MCP/Core/System.h"
+#include "MCP/Core/Resource/PreloadManifest.h"
+#include "MCP/Core/Resource/ResourceLoadHandle.h"
 
 struct lua_State;
 
@@ -10,6 +12,12 @@ namespace mcp
     class SceneEntity;
     using SceneIdentifier = StringId;
 
+    struct PreloadedAsset
+    {
+        PreloadManifest::Entry entry;   // The asset that was requested.
+        ResourceLoadHandle handle;      // Holds a reference to the asset until the scene has been entered.
+    };
+
     struct SceneData
     {
         SceneData() = default;
@@ -23,6 +31,9 @@ namespace mcp
 
         std::string dataPath;           // Path to the scene data on disk. To be used to load the scene.
         Scene* pScene = nullptr;        // The Scene resource.
+        PreloadManifest manifest;       // Assets requested the last time the scene was loaded.
+        std::vector<PreloadedAsset> preloadedAssets; // Assets that are being loaded before we enter the scene.
+        bool manifestIsLoaded = false;  // Whether we have tried to load the manifest from disk.
     };
 
     class SceneManager final : public System
@@ -38,7 +49,7 @@ namespace mcp
         SceneIdentifier m_sceneToTransitionTo;
 
 #if MCP_EDITOR
-        const SceneIdentifier m_editorScene = "EditorScene";
+        const SceneIdentifier m_editorScene = "EditorScene"_sid;
         XMLParser m_loadedAsset;
 #endif
 
@@ -46,6 +57,8 @@ namespace mcp
         
     public:
         void QueueTransition(const SceneIdentifier& identifier);
+        bool PreloadScene(const SceneIdentifier& identifier);
+        void CancelPreload(const SceneIdentifier& identifier);
         [[nodiscard]] Scene* GetActiveScene() const { return m_pActiveScene; }
 
 #if MCP_EDITOR
@@ -64,6 +77,9 @@ namespace mcp
         void Update(const float deltaTimeMs);
         void Render() const;
         bool TransitionToScene();
+        void ReportPreloadResults(const SceneData& sceneData, const PreloadManifest& requested) const;
+        static void LoadManifest(SceneData& sceneData);
+        static void ReleasePreloadedAssets(SceneData& sceneData);
 
 #if MCP_EDITOR
         bool LoadEditorScene();
@@ -0,0 +1,380 @@
+// StaticSpriteChunks.cpp
+
+#include "StaticSpriteChunks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <BleachNew.h>
+#include "SceneLayer.h"
+#include "MCP/Components/ImageComponent.h"
+#include "MCP/Core/Application/Window/WindowBase.h"
+#include "MCP/Debug/Log.h"
+#include "MCP/Graphics/Graphics.h"
+
+namespace mcp
+{
+    namespace
+    {
+        constexpr double kDegreesToRadians = 3.14159265358979 / 180.0;
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      The renderer rotates the destination rect by angle degrees around anglePivot, which is relative to the top left
+        //      of the rect.
+        //
+        ///		@brief : Get the axis aligned bounds of a sprite's destination rect after its rotation is applied.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        RectF GetRotatedBounds(const TextureRenderData& data)
+        {
+            const RectF& rect = data.destinationRect;
+            if (data.angle == 0.0)
+                return rect;
+
+            const double radians = data.angle * kDegreesToRadians;
+            const auto cosAngle = static_cast<float>(std::cos(radians));
+            const auto sinAngle = static_cast<float>(std::sin(radians));
+            const float pivotX = rect.x + data.anglePivot.x;
+            const float pivotY = rect.y + data.anglePivot.y;
+
+            const float cornersX[4] = { rect.x, rect.x + rect.width, rect.x + rect.width, rect.x };
+            const float cornersY[4] = { rect.y, rect.y, rect.y + rect.height, rect.y + rect.height };
+
+            float minX = 0.f;
+            float minY = 0.f;
+            float maxX = 0.f;
+            float maxY = 0.f;
+            for (int i = 0; i < 4; ++i)
+            {
+                const float offsetX = cornersX[i] - pivotX;
+                const float offsetY = cornersY[i] - pivotY;
+                const float x = pivotX + offsetX * cosAngle - offsetY * sinAngle;
+                const float y = pivotY + offsetX * sinAngle + offsetY * cosAngle;
+
+                if (i == 0)
+                {
+                    minX = maxX = x;
+                    minY = maxY = y;
+                    continue;
+                }
+
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+
+            return RectF{minX, minY, maxX - minX, maxY - minY};
+        }
+    }
+
+    StaticSpriteChunk::StaticSpriteChunk(const int zOrder)
+        : IRenderable(RenderLayer::kWorld, zOrder)
+    {
+        //
+    }
+
+    StaticSpriteChunk::~StaticSpriteChunk()
+    {
+        FreeTargetTexture();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Chunks outside of the window are skipped entirely, and are only baked once they become visible.
+    //
+    ///		@brief : Draw the baked texture of this chunk, rebaking it first if any of our members have changed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunk::Render() const
+    {
+        CheckPendingMembers();
+
+        // Our texture's contents were lost, so bake into a new one.
+        if (m_pTargetTexture && m_targetGeneration != GetTargetTextureGeneration())
+        {
+            FreeTargetTexture();
+            m_isDirty = true;
+        }
+
+        if (m_isDirty)
+        {
+            // Recalculate our bounds, so that we can tell if we are visible before doing the work of baking.
+            m_bounds = {};
+            for (size_t i = 0; i < m_members.size(); ++i)
+            {
+                const RectF rect = GetRotatedBounds(m_members[i]->GetRenderData());
+                if (i == 0)
+                {
+                    m_bounds = rect;
+                    continue;
+                }
+
+                const float right = std::max(m_bounds.x + m_bounds.width, rect.x + rect.width);
+                const float bottom = std::max(m_bounds.y + m_bounds.height, rect.y + rect.height);
+                m_bounds.x = std::min(m_bounds.x, rect.x);
+                m_bounds.y = std::min(m_bounds.y, rect.y);
+                m_bounds.width = right - m_bounds.x;
+                m_bounds.height = bottom - m_bounds.y;
+            }
+        }
+
+        const RectF windowRect = GraphicsManager::Get()->GetWindow()->GetDimensions().GetRectAs<float>();
+        if (!m_bounds.Intersects(windowRect))
+            return;
+
+        if (m_isDirty)
+            Bake();
+
+        if (!m_pTargetTexture)
+            return;
+
+        TextureRenderData renderData;
+        renderData.pTexture = m_pTargetTexture;
+        renderData.crop = RectInt{0, 0, static_cast<int>(std::ceil(m_bounds.width)), static_cast<int>(std::ceil(m_bounds.height))};
+        renderData.destinationRect = RectF{m_bounds.x, m_bounds.y, static_cast<float>(renderData.crop.width), static_cast<float>(renderData.crop.height)};
+        renderData.tint = Color::White();
+
+        DrawTexture(renderData);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The target texture is only recreated when the size of our bounds change.
+    //
+    ///		@brief : Draw each of our members into our target texture.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunk::Bake() const
+    {
+        m_isDirty = false;
+        m_pendingMembers.clear();
+        m_targetGeneration = GetTargetTextureGeneration();
+
+        const Vec2Int size
+        {
+            static_cast<int>(std::ceil(m_bounds.width))
+            , static_cast<int>(std::ceil(m_bounds.height))
+        };
+
+        if (size.x <= 0 || size.y <= 0)
+        {
+            FreeTargetTexture();
+            return;
+        }
+
+        if (m_pTargetTexture && !(m_textureSize == size))
+            FreeTargetTexture();
+
+        if (!m_pTargetTexture)
+        {
+            m_pTargetTexture = CreateTargetTexture(size);
+            m_textureSize = size;
+
+            if (!m_pTargetTexture)
+                return;
+        }
+
+        if (!SetTargetTexture(m_pTargetTexture))
+        {
+            FreeTargetTexture();
+            return;
+        }
+
+        // Clear to transparent, then draw the members relative to the top left of our bounds.
+        FillScreen(Color{0,0,0,0});
+
+        for (const auto* pImage : m_members)
+        {
+            TextureRenderData data = pImage->GetRenderData();
+            data.destinationRect.x -= m_bounds.x;
+            data.destinationRect.y -= m_bounds.y;
+            DrawTexture(data);
+
+            // If the image is still loading, we will need to bake again once it is ready.
+            if (pImage->IsTexturePending())
+                m_pendingMembers.push_back(pImage);
+        }
+
+        // Go back to rendering to the window.
+        SetTargetTexture(nullptr);
+    }
+
+    void StaticSpriteChunk::FreeTargetTexture() const
+    {
+        if (!m_pTargetTexture)
+            return;
+
+        DestroyTargetTexture(m_pTargetTexture);
+        m_pTargetTexture = nullptr;
+        m_textureSize = {};
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : If all of the members that were baked with a placeholder texture have finished loading, mark us as dirty.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunk::CheckPendingMembers() const
+    {
+        if (m_pendingMembers.empty())
+            return;
+
+        for (const auto* pImage : m_pendingMembers)
+        {
+            if (pImage->IsTexturePending())
+                return;
+        }
+
+        m_pendingMembers.clear();
+        m_isDirty = true;
+    }
+
+    StaticSpriteChunks::StaticSpriteChunks(SceneLayer* pLayer)
+        : m_pLayer(pLayer)
+    {
+        //
+    }
+
+    StaticSpriteChunks::~StaticSpriteChunks()
+    {
+        // The layer is being destroyed along with us, so we don't need to unregister the chunks.
+        for (auto& [key, pChunk] : m_chunks)
+        {
+            BLEACH_DELETE(pChunk);
+        }
+
+        m_chunks.clear();
+        m_members.clear();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If baking is disabled, this returns false and the image should be registered as a normal renderable.
+    //
+    ///		@brief : Add a static image to the chunk that contains it.
+    ///		@returns : True if the image is now rendered by a chunk.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool StaticSpriteChunks::Add(const ImageComponent* pImage)
+    {
+        if (!m_isEnabled)
+            return false;
+
+        if (Contains(pImage))
+            return true;
+
+        const ChunkKey key = GetChunkKey(pImage);
+        auto* pChunk = GetOrCreateChunk(key, pImage->GetZOrder());
+        pChunk->m_members.push_back(pImage);
+        pChunk->m_isDirty = true;
+
+        m_members.emplace(pImage, MemberInfo{key, pChunk});
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Remove an image from its chunk, deleting the chunk if it is now empty.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunks::Remove(const ImageComponent* pImage)
+    {
+        const auto result = m_members.find(pImage);
+        if (result == m_members.end())
+            return;
+
+        const MemberInfo info = result->second;
+        m_members.erase(result);
+        RemoveFromChunk(pImage, info);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If the image has moved into a different cell, or changed its zOrder, it is moved to the new chunk and both chunks
+    //      are rebaked.
+    //
+    ///		@brief : Let the chunk that contains this image know that it needs to be rebaked.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunks::MarkDirty(const ImageComponent* pImage)
+    {
+        const auto result = m_members.find(pImage);
+        if (result == m_members.end())
+            return;
+
+        const ChunkKey key = GetChunkKey(pImage);
+        if (key == result->second.key)
+        {
+            result->second.pChunk->m_isDirty = true;
+            return;
+        }
+
+        Remove(pImage);
+        Add(pImage);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This should be set before any images are added.
+    //
+    ///		@brief : Set the width and height of the world cells that images are grouped into.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void StaticSpriteChunks::SetChunkSize(const float size)
+    {
+        if (size <= 0.f)
+        {
+            MCP_WARN("StaticSpriteChunks", "Tried to set an invalid chunk size: ", size);
+            return;
+        }
+
+        if (!m_members.empty())
+        {
+            MCP_WARN("StaticSpriteChunks", "Tried to set the chunk size after images were added!");
+            return;
+        }
+
+        m_chunkSize = size;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The key packs the zOrder in the upper 32 bits, and the cell coordinates in 16 bits each.
+    //
+    ///		@brief : Get the key of the chunk that an image belongs in, based on the center of its rotated bounds and its zOrder.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    StaticSpriteChunks::ChunkKey StaticSpriteChunks::GetChunkKey(const ImageComponent* pImage) const
+    {
+        const RectF rect = GetRotatedBounds(pImage->GetRenderData());
+        const auto cellX = static_cast<int>(std::floor((rect.x + rect.width / 2.f) / m_chunkSize));
+        const auto cellY = static_cast<int>(std::floor((rect.y + rect.height / 2.f) / m_chunkSize));
+
+        return (static_cast<ChunkKey>(static_cast<uint32_t>(pImage->GetZOrder())) << 32)
+            | (static_cast<ChunkKey>(static_cast<uint16_t>(cellX)) << 16)
+            | static_cast<ChunkKey>(static_cast<uint16_t>(cellY));
+    }
+
+    StaticSpriteChunk* StaticSpriteChunks::GetOrCreateChunk(const ChunkKey key, const int zOrder)
+    {
+        const auto result = m_chunks.find(key);
+        if (result != m_chunks.end())
+            return result->second;
+
+        auto* pChunk = BLEACH_NEW(StaticSpriteChunk(zOrder));
+        m_chunks.emplace(key, pChunk);
+        m_pLayer->AddRenderable(pChunk);
+
+        return pChunk;
+    }
+
+    void StaticSpriteChunks::RemoveFromChunk(const ImageComponent* pImage, const MemberInfo& info)
+    {
+        auto* pChunk = info.pChunk;
+        auto& members = pChunk->m_members;
+        members.erase(std::remove(members.begin(), members.end(), pImage), members.end());
+
+        auto& pendingMembers = pChunk->m_pendingMembers;
+        pendingMembers.erase(std::remove(pendingMembers.begin(), pendingMembers.end(), pImage), pendingMembers.end());
+
+        if (!members.empty())
+        {
+            pChunk->m_isDirty = true;
+            return;
+        }
+
+        m_pLayer->RemoveRenderable(pChunk);
+        m_chunks.erase(info.key);
+        BLEACH_DELETE(pChunk);
+    }
+}
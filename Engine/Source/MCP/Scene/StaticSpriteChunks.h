@@ -0,0 +1,103 @@
+#pragma once
+// StaticSpriteChunks.h
+
+#include <unordered_map>
+#include <vector>
+#include "IRenderable.h"
+#include "Utility/Types/Rect.h"
+#include "Utility/Types/Vector2.h"
+
+namespace mcp
+{
+    class ImageComponent;
+    class SceneLayer;
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The chunk's texture covers the bounds of all of its members, which can extend past the grid cell that they were
+    //      sorted into. The chunk is registered as a single renderable with the layer, so it is still sorted with everything
+    //      else using the zOrder of its members.
+    //
+    ///		@brief : A group of static images in the same grid cell and zOrder, that are baked into a single render target texture.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class StaticSpriteChunk final : public IRenderable
+    {
+        friend class StaticSpriteChunks;
+
+        std::vector<const ImageComponent*> m_members;           // Images that are baked into this chunk.
+        mutable std::vector<const ImageComponent*> m_pendingMembers; // Members baked while their texture was still loading.
+        mutable RectF m_bounds;                                 // World bounds of all of our members.
+        mutable void* m_pTargetTexture = nullptr;               // Texture that our members are baked into.
+        mutable Vec2Int m_textureSize;                          // Size of our target texture.
+        mutable uint32_t m_targetGeneration = 0;                // Target texture generation that we last baked in.
+        mutable bool m_isDirty = true;                          // Whether we need to rebake before the next render.
+
+    public:
+        StaticSpriteChunk(const int zOrder);
+        virtual ~StaticSpriteChunk() override;
+
+        StaticSpriteChunk(const StaticSpriteChunk&) = delete;
+        StaticSpriteChunk& operator=(const StaticSpriteChunk&) = delete;
+        StaticSpriteChunk(StaticSpriteChunk&&) = delete;
+        StaticSpriteChunk& operator=(StaticSpriteChunk&&) = delete;
+
+        virtual void Render() const override;
+
+    private:
+        void Bake() const;
+        void FreeTargetTexture() const;
+        void CheckPendingMembers() const;
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Static images are sorted into fixed size world cells, by the center of their rotated bounds, with a separate chunk
+    //      for each zOrder in a cell. Each chunk is only rebaked when one of its members changes, and only chunks that are
+    //      visible in the window are drawn.
+    //
+    ///		@brief : Manages the StaticSpriteChunks of a layer.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    class StaticSpriteChunks
+    {
+        using ChunkKey = uint64_t;
+
+        struct MemberInfo
+        {
+            ChunkKey key;
+            StaticSpriteChunk* pChunk;
+        };
+
+        static constexpr float kDefaultChunkSize = 512.f;
+
+        std::unordered_map<ChunkKey, StaticSpriteChunk*> m_chunks;
+        std::unordered_map<const ImageComponent*, MemberInfo> m_members;
+        SceneLayer* m_pLayer;
+        float m_chunkSize = kDefaultChunkSize;
+        bool m_isEnabled = true;
+
+    public:
+        StaticSpriteChunks(SceneLayer* pLayer);
+        ~StaticSpriteChunks();
+
+        StaticSpriteChunks(const StaticSpriteChunks&) = delete;
+        StaticSpriteChunks& operator=(const StaticSpriteChunks&) = delete;
+        StaticSpriteChunks(StaticSpriteChunks&&) = delete;
+        StaticSpriteChunks& operator=(StaticSpriteChunks&&) = delete;
+
+        bool Add(const ImageComponent* pImage);
+        void Remove(const ImageComponent* pImage);
+        void MarkDirty(const ImageComponent* pImage);
+
+        void SetChunkSize(const float size);
+        void SetEnabled(const bool isEnabled) { m_isEnabled = isEnabled; }
+
+        [[nodiscard]] bool IsEnabled() const { return m_isEnabled; }
+        [[nodiscard]] bool Contains(const ImageComponent* pImage) const { return m_members.find(pImage) != m_members.end(); }
+        [[nodiscard]] size_t GetChunkCount() const { return m_chunks.size(); }
+
+    private:
+        ChunkKey GetChunkKey(const ImageComponent* pImage) const;
+        StaticSpriteChunk* GetOrCreateChunk(const ChunkKey key, const int zOrder);
+        void RemoveFromChunk(const ImageComponent* pImage, const MemberInfo& info);
+    };
+}
@@ -5,6 +5,7 @@
 #include "LuaSource.h"
 #include "SceneAsset.h"
 #include "MCP/Core/Event/ApplicationEvent.h"
+#include "MCP/Graphics/RenderCapture.h"
 #include "MCP/UI/Widget.h"
 #include "MCP/UI/CanvasWidget.h"
 #include "MCP/UI/ImageWidget.h"
@@ -274,6 +275,9 @@ namespace mcp
         // Render each renderable.
         for (const auto* pRenderable : renderableArray)
         {
+            if (RenderCapture::IsRecording())
+                RenderCapture::RecordZOrder(pRenderable->GetZOrder());
+
             pRenderable->Render();
         }
 
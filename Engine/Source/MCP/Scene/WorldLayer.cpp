@@ -4,6 +4,7 @@
 
 #include "SceneAsset.h"
 #include "MCP/Graphics/Graphics.h"
+#include "MCP/Graphics/RenderCapture.h"
 #include "MCP/Scene/Scene.h"
 #include "MCP/Components/InputComponent.h"
 #include "MCP/Core/Event/ApplicationEvent.h"
@@ -13,6 +14,7 @@ namespace mcp
     WorldLayer::WorldLayer(Scene* pScene)
         : SceneLayer(pScene)
         , m_collisionSystem(QuadtreeBehaviorData{ 4, 4, 1600.f, 900.f }) // Some Default data...
+        , m_staticChunks(this)
         , m_activeInput(nullptr)
         , m_isPaused(false)
     {
@@ -38,6 +40,14 @@ namespace mcp
         data.maxObjectsInCell = setting.GetAttributeValue<unsigned>("maxObjectsInCell", 4);
         SetCollisionSettings(data);
 
+        // Static Chunk Settings. Ex: <StaticChunks enabled="true" size="512"/>
+        setting = worldSettings.GetChildElement("StaticChunks");
+        if (setting.IsValid())
+        {
+            m_staticChunks.SetEnabled(setting.GetAttributeValue<bool>("enabled", true));
+            m_staticChunks.SetChunkSize(setting.GetAttributeValue<float>("size", 512.f));
+        }
+
         // Entities:
         const XMLElement element = layer.GetChildElement(kEntityElementTag);
         LoadLayerAssetsAndEntities(element);
@@ -265,6 +275,9 @@ namespace mcp
         // Render each renderable.
         for (const auto* pRenderable : renderableArray)
         {
+            if (RenderCapture::IsRecording())
+                RenderCapture::RecordZOrder(pRenderable->GetZOrder());
+
             pRenderable->Render();
         }
 
@@ -315,6 +328,35 @@ namespace mcp
         m_activeInput = nullptr;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Static images are baked into chunks of the world, which are drawn as a single texture. If static chunks are disabled
+    //      in the World settings, this will return false.
+    //		
+    ///		@brief : Add the image of a static Object to be rendered as part of a static chunk.
+    ///		@returns : True if the image will be rendered by a static chunk.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool WorldLayer::AddStaticImage(const ImageComponent* pImage)
+    {
+        return m_staticChunks.Add(pImage);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Remove a static image from its chunk.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void WorldLayer::RemoveStaticImage(const ImageComponent* pImage)
+    {
+        m_staticChunks.Remove(pImage);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Let the chunk that contains this image know that it needs to be rebaked.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void WorldLayer::MarkStaticImageDirty(const ImageComponent* pImage)
+    {
+        m_staticChunks.MarkDirty(pImage);
+    }
+
     //-----------------------------------------------------------------------------------------------------------------------------
     //		NOTES:
     //		
@@ -5,9 +5,11 @@
 #include "MCP/Core/Event/MessageManager.h"
 #include "MCP/Scene/Object.h"
 #include "MCP/Scene/SceneLayer.h"
+#include "MCP/Scene/StaticSpriteChunks.h"
 
 namespace mcp
 {
+    class ImageComponent;
     class InputComponent;
 
     class WorldLayer final : public SceneLayer
@@ -16,6 +18,7 @@ namespace mcp
 
         CollisionSystem m_collisionSystem;
         MessageManager m_messageManager;
+        StaticSpriteChunks m_staticChunks;
         InputComponent* m_activeInput; // TODO: Only 1 active input receiver is active at a time.
         bool m_isPaused;
 
@@ -33,6 +36,10 @@ namespace mcp
         void AddInputListener(InputComponent* pInputComponent);
         void RemoveInputListener(InputComponent* pInputComponent);
 
+        // Static Rendering
+        bool AddStaticImage(const ImageComponent* pImage);
+        void RemoveStaticImage(const ImageComponent* pImage);
+        void MarkStaticImageDirty(const ImageComponent* pImage);
 
         // World Systems
         [[nodiscard]] MessageManager* GetMessageManager() { return &m_messageManager;}
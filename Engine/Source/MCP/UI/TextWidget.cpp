@@ -2,6 +2,7 @@
 
 #include "TextWidget.h"
 
+#include <cmath>
 #include "LuaSource.h"
 #include "MCP/Core/Event/Event.h"
 #include "MCP/Graphics/Graphics.h"
@@ -19,7 +20,7 @@ namespace mcp
         , m_format(textData)
         , m_text(pText)
     {
-        m_text.m_onStringUpdated.AddListener(this, [this]() { this->SetGlyphData(); });
+        m_text.m_onStringUpdated.AddListener(this, [this]() { this->RefreshText(); });
     }
 
     TextWidget::~TextWidget()
@@ -28,6 +29,7 @@ namespace mcp
             GetUILayer()->RemoveRenderable(this);
 
         m_text.m_onStringUpdated.RemoveListener(this);
+        FreeTargetTexture();
     }
 
     bool TextWidget::Init()
@@ -69,30 +71,61 @@ namespace mcp
         // Debug Render the text Boundaries:
         //DrawRect( visibleRect, Color::Black());
 #endif
-        
-        const float startPosY = GetTextStartYPos(rect);
-        int glyphIndex = 0;
 
-        for(size_t i = 0; i < m_lines.size(); ++i)
+        // Our baked texture's contents were lost, so bake into a new one.
+        if (m_renderCache.pTargetTexture && m_renderCache.targetGeneration != GetTargetTextureGeneration())
+            m_renderCache.isDirty = true;
+
+        if (m_renderCache.isDirty)
+            RebuildRenderCache();
+
+        // The anchor is where a line with a width of zero would start. Each glyph quad is already offset from it
+        // by its line's alignment.
+        const Vec2 anchor
+        {
+            rect.x + ((m_format.alignment.x - 0.5f) * rect.width)
+            , GetTextStartYPos(rect)
+        };
+
+        if (m_renderCache.pTargetTexture)
+            RenderTargetTexture(anchor, visibleRect);
+
+        else
+            RenderGlyphQuads(anchor, visibleRect);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If the whole block of text is inside of the visible rect, we can skip the per glyph crop calculations.
+    //		
+    ///		@brief : Render each cached glyph quad, clipping them against the visible rect.
+    ///		@param anchor : Screen position of the text anchor.
+    ///		@param visibleRect : The visible rect of this Widget.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::RenderGlyphQuads(const Vec2 anchor, const RectF& visibleRect) const
+    {
+        const RectF textRect
         {
-            auto& line = m_lines[i];
+            anchor.x + m_renderCache.bounds.x
+            , anchor.y + m_renderCache.bounds.y
+            , m_renderCache.bounds.width
+            , m_renderCache.bounds.height
+        };
 
-            // Get the start of the line according to the text alignment.
-            const float startPosX = GetLineStartXPos(rect, i);
+        const bool isFullyVisible = textRect.x >= visibleRect.x
+            && textRect.y >= visibleRect.y
+            && textRect.x + textRect.width <= visibleRect.x + visibleRect.width
+            && textRect.y + textRect.height <= visibleRect.y + visibleRect.height;
 
-            // Debug:
-            //DrawRect(RectF{startPosX, startPosY + static_cast<float>(m_font.GetNewlineDistance() * i), static_cast<float>(line.lineWidth), static_cast<float>(line.lineHeight)}, Color{255,0,0});
+        for (const auto& quad : m_renderCache.glyphQuads)
+        {
+            TextureRenderData data = quad;
+            data.destinationRect.x += anchor.x;
+            data.destinationRect.y += anchor.y;
 
-            for (size_t ii = 0; ii < line.glyphCount; ++ii)
+            if (!isFullyVisible)
             {
-                const auto& glyphData = m_glyphs[glyphIndex];
-                const RectF glyphDestRect
-                {
-                    static_cast<float>(glyphData.localPos.x) + startPosX,
-                    static_cast<float>(glyphData.localPos.y) + startPosY,
-                    static_cast<float>(glyphData.pTextureData->width),
-                    static_cast<float>(glyphData.pTextureData->height)
-                };
+                const RectF glyphDestRect = data.destinationRect;
 
                 // Calculate the crop of the glyph, accounting for any masking:
                 // This is the rect that is visible for this glyph, the intersection of this glyph's rect and and the visible rect.
@@ -103,20 +136,172 @@ namespace mcp
 
                 const float normalizedWidth = topLeftVisible.width / glyphDestRect.width;
                 const float normalizedHeight = topLeftVisible.height / glyphDestRect.height;
-                const int finalCropWidth = std::clamp(static_cast<int>(normalizedWidth * static_cast<float>(glyphData.pTextureData->width)), 0, glyphData.pTextureData->width);
-                const int finalCropHeight = std::clamp(static_cast<int>(normalizedHeight * static_cast<float>(glyphData.pTextureData->height)), 0, glyphData.pTextureData->height);
+                const int finalCropWidth = std::clamp(static_cast<int>(normalizedWidth * static_cast<float>(quad.crop.width)), 0, quad.crop.width);
+                const int finalCropHeight = std::clamp(static_cast<int>(normalizedHeight * static_cast<float>(quad.crop.height)), 0, quad.crop.height);
 
-                TextureRenderData data;
-                data.tint = {0,0,0};
-                data.pTexture = glyphData.pTextureData->pTexture;
                 data.destinationRect = topLeftVisible;
                 data.crop = {finalCropX, finalCropY, finalCropWidth, finalCropHeight};
+            }
+
+            DrawTexture(data);
+        }
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Blit our baked text texture, clipping it against the visible rect.
+    ///		@param anchor : Screen position of the text anchor.
+    ///		@param visibleRect : The visible rect of this Widget.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::RenderTargetTexture(const Vec2 anchor, const RectF& visibleRect) const
+    {
+        const RectF textRect
+        {
+            anchor.x + m_renderCache.bounds.x
+            , anchor.y + m_renderCache.bounds.y
+            , m_renderCache.bounds.width
+            , m_renderCache.bounds.height
+        };
 
-                DrawTexture(data);
+        const auto topLeftVisible = visibleRect.GetIntersectionAsRect(textRect);
+        if (!topLeftVisible.HasValidDimensions())
+            return;
 
+        TextureRenderData data;
+        data.pTexture = m_renderCache.pTargetTexture;
+        data.destinationRect = topLeftVisible;
+        data.crop =
+        {
+            static_cast<int>(topLeftVisible.x - textRect.x)
+            , static_cast<int>(topLeftVisible.y - textRect.y)
+            , static_cast<int>(topLeftVisible.width)
+            , static_cast<int>(topLeftVisible.height)
+        };
+
+        DrawTexture(data);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This only depends on the layout of the glyphs, so it only needs to be called when the text, font or wrapping width
+    //      changes - not when the Widget moves.
+    //		
+    ///		@brief : Rebuild the glyph quads for the current layout, and bake them to a texture if we are rendering to texture.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::RebuildRenderCache() const
+    {
+        auto& cache = m_renderCache;
+        cache.glyphQuads.clear();
+        cache.glyphQuads.reserve(m_glyphs.size());
+        cache.bounds = {};
+
+        float minX = 0.f;
+        float minY = 0.f;
+        float maxX = 0.f;
+        float maxY = 0.f;
+        size_t glyphIndex = 0;
+
+        for (const auto& line : m_lines)
+        {
+            // Offset of the line from the anchor, according to the text alignment.
+            const float lineOffsetX = -(static_cast<float>(line.lineWidth) * m_format.alignment.x);
+
+            for (size_t i = 0; i < line.glyphCount; ++i)
+            {
+                const auto& glyphData = m_glyphs[glyphIndex];
                 ++glyphIndex;
+
+                TextureRenderData data;
+                data.tint = {0,0,0};
+                data.pTexture = glyphData.pTextureData->pTexture;
+                data.destinationRect =
+                {
+                    static_cast<float>(glyphData.localPos.x) + lineOffsetX,
+                    static_cast<float>(glyphData.localPos.y),
+                    static_cast<float>(glyphData.pTextureData->width),
+                    static_cast<float>(glyphData.pTextureData->height)
+                };
+                data.crop = {0, 0, glyphData.pTextureData->width, glyphData.pTextureData->height};
+
+                const auto& dest = data.destinationRect;
+                if (cache.glyphQuads.empty())
+                {
+                    minX = dest.x;
+                    minY = dest.y;
+                    maxX = dest.x + dest.width;
+                    maxY = dest.y + dest.height;
+                }
+
+                else
+                {
+                    minX = std::min(minX, dest.x);
+                    minY = std::min(minY, dest.y);
+                    maxX = std::max(maxX, dest.x + dest.width);
+                    maxY = std::max(maxY, dest.y + dest.height);
+                }
+
+                cache.glyphQuads.emplace_back(data);
             }
         }
+
+        cache.bounds = {minX, minY, maxX - minX, maxY - minY};
+        cache.isDirty = false;
+
+        FreeTargetTexture();
+        if (m_format.renderToTexture)
+            BakeTargetTexture();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If we fail to create the texture, we just fall back to rendering the glyph quads.
+    //		
+    ///		@brief : Draw all of our glyph quads into a single texture, so the text is a single draw call each frame.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::BakeTargetTexture() const
+    {
+        auto& cache = m_renderCache;
+        if (cache.glyphQuads.empty())
+            return;
+
+        const Vec2Int size
+        {
+            static_cast<int>(std::ceil(cache.bounds.width))
+            , static_cast<int>(std::ceil(cache.bounds.height))
+        };
+
+        cache.pTargetTexture = CreateTargetTexture(size);
+        if (!cache.pTargetTexture)
+            return;
+
+        cache.targetGeneration = GetTargetTextureGeneration();
+
+        if (!SetTargetTexture(cache.pTargetTexture))
+        {
+            FreeTargetTexture();
+            return;
+        }
+
+        // Clear to transparent, then draw the glyphs relative to the top left of our bounds.
+        FillScreen(Color{0,0,0,0});
+
+        for (const auto& quad : cache.glyphQuads)
+        {
+            TextureRenderData data = quad;
+            data.destinationRect.x -= cache.bounds.x;
+            data.destinationRect.y -= cache.bounds.y;
+            DrawTexture(data);
+        }
+
+        // Go back to rendering to the window.
+        SetTargetTexture(nullptr);
+    }
+
+    void TextWidget::FreeTargetTexture() const
+    {
+        DestroyTargetTexture(m_renderCache.pTargetTexture);
+        m_renderCache.pTargetTexture = nullptr;
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -155,34 +340,98 @@ namespace mcp
         SetZOrder(GetZOffset());
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : If we are wrapping our text, a new width can change where our lines break, so we need to lay it out again.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::OnSizeChanged()
+    {
+        if (m_sizedToContent || !m_font.IsValid())
+            return;
+
+        RefreshText();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Set whether the text should be baked into a single texture, rather than drawing each glyph every frame.
+    ///         This is best for text that rarely changes.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::SetRenderToTexture(const bool renderToTexture)
+    {
+        if (m_format.renderToTexture == renderToTexture)
+            return;
+
+        m_format.renderToTexture = renderToTexture;
+        m_renderCache.isDirty = true;
+    }
+
     void TextWidget::SetFont(const Font& font)
     {
         m_font = font;
-        //RegenerateTextTexture();
-        SetGlyphData();
-
-        if (m_pParent)
-            GetParent()->OnChildSizeChanged();
+        RefreshText();
     }
 
     void TextWidget::SetText(const char* pText)
     {
         m_text = pText;
-        SetGlyphData();
-
-        if (m_pParent)
-            GetParent()->OnChildSizeChanged();
+        RefreshText();
     }
 
     void TextWidget::SetText(const std::string& text)
     {
         m_text = text;
+        RefreshText();
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Lay out the glyphs for our current text again, and notify our parent if our dimensions changed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::RefreshText()
+    {
+        const auto previousDimensions = m_textDimensions;
         SetGlyphData();
+        OnTextDimensionsChanged(previousDimensions);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Only a TextWidget that is sized to its content changes size with its text, so we don't bother our parent
+    //      in any other case.
+    //		
+    ///		@brief : Mark our render cache as dirty and let our parent know if our size changed.
+    ///		@param previousDimensions : The text dimensions before the text was changed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::OnTextDimensionsChanged(const Vec2Int& previousDimensions)
+    {
+        m_renderCache.isDirty = true;
 
-        if (m_pParent)
+        if (m_pParent && m_sizedToContent && !(previousDimensions == m_textDimensions))
             GetParent()->OnChildSizeChanged();
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //		
+    ///		@brief : Recalculate the total width and height of our text from our lines.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    void TextWidget::UpdateTextDimensions()
+    {
+        m_textDimensions = {};
+
+        for (const auto& line : m_lines)
+        {
+            if (line.lineWidth > m_textDimensions.x)
+                m_textDimensions.x = line.lineWidth;
+
+            m_textDimensions.y += line.lineHeight;
+        }
+    }
+
     bool TextWidget::Append(const char character)
     {
         const auto glyph = static_cast<uint32_t>(character);
@@ -194,14 +443,13 @@ namespace mcp
 
         // Append the character to our string.
         m_text += character;
+        const auto previousDimensions = m_textDimensions;
 
         // If this is the first glyph, then just add it.
         if (m_glyphs.empty())
         {
             m_lines.emplace_back(LineData{1, pTexture->width, m_font.GetFontHeight()});
             m_glyphs.emplace_back(pTexture, Vec2Int{} , glyph);
-
-            m_textDimensions = {m_lines.back().lineWidth, m_lines.back().lineHeight };
         }
 
         // Otherwise, we need handle the potential new line case:
@@ -231,6 +479,9 @@ namespace mcp
                     glyphPos.x = lastGlyph.localPos.x + distanceToPlaceGlyph;
                     m_glyphs.emplace_back(pTexture, glyphPos, glyph);
                     m_lines.back().glyphCount += 1;
+                    m_lines.back().lineWidth = glyphPos.x + pTexture->width;
+                    UpdateTextDimensions();
+                    OnTextDimensionsChanged(previousDimensions);
                     return true;
                 }
 
@@ -241,6 +492,8 @@ namespace mcp
                 // If the character is a space, then we just return without adding it.
                 if (glyph == ' ')
                 {
+                    UpdateTextDimensions();
+                    OnTextDimensionsChanged(previousDimensions);
                     return true;
                 }
 
@@ -279,8 +532,8 @@ namespace mcp
             m_lines.back().glyphCount += 1;
         }
 
-        if (m_pParent)
-            GetParent()->OnChildSizeChanged();
+        UpdateTextDimensions();
+        OnTextDimensionsChanged(previousDimensions);
         
         //MCP_LOG("TextWidget", "Line width: ", m_lines.back().lineWidth);
 
@@ -294,6 +547,7 @@ namespace mcp
 
         // Remove the last character in the text
         m_text.pop_back();
+        const auto previousDimensions = m_textDimensions;
 
         // Remove the last glyph
         m_glyphs.pop_back();
@@ -310,18 +564,20 @@ namespace mcp
             auto& line = m_lines.back();
             line.glyphCount -= 1;
 
-            // If we have no more glyphs on this line, then return.
+            // If we have no more glyphs on this line, then remove it.
             if (line.glyphCount == 0)
             {
                 m_lines.pop_back();
-                return;
             }
 
-            line.lineWidth = m_glyphs.back().localPos.x + m_glyphs.back().pTextureData->width;
+            else
+            {
+                line.lineWidth = m_glyphs.back().localPos.x + m_glyphs.back().pTextureData->width;
+            }
         }
 
-        if (m_pParent)
-            GetParent()->OnChildSizeChanged();
+        UpdateTextDimensions();
+        OnTextDimensionsChanged(previousDimensions);
     }
 
     //-----------------------------------------------------------------------------------------------------------------------------
@@ -424,6 +680,8 @@ namespace mcp
             format.alignment.y = std::clamp( child.GetAttributeValue<float>("y", 0.5f), 0.f, 1.f);
         }
 
+        format.renderToTexture = formatElement.GetAttributeValue<bool>("renderToTexture", false);
+
         return format;
     }
 
@@ -502,6 +760,7 @@ namespace mcp
         m_glyphs.clear();
         m_lines.clear();
         m_textDimensions = {};
+        m_renderCache.isDirty = true;
         if (m_text.Get().empty())
             return;
 
@@ -609,19 +868,9 @@ namespace mcp
                 ++i;
             }
 
-            // If completing the entire text, set our textDimensions and break
+            // If completing the entire text, break.
             if (i >= m_text.size())
-            {
-                for (const auto& line : m_lines)
-                {
-                    if (line.lineWidth > m_textDimensions.x)
-                        m_textDimensions.x = line.lineWidth;
-
-                    m_textDimensions.y += line.lineHeight;
-                }
-
                 break;
-            }
 
             // Once we complete a word, we need to add the space:
             const auto distanceToPlaceGlyph = i == 0 ? 0 : m_font.GetNextCharDistance(m_glyphs.back().glyph, ' ');
@@ -658,6 +907,8 @@ namespace mcp
             // The next word is at the 'next character'.
             wordStart = m_glyphs.size();
         }
+
+        UpdateTextDimensions();
     }
 
     static int GetTextWidget(lua_State* pState)
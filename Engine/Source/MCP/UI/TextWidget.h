@@ -4,6 +4,7 @@
 #include "Widget.h"
 #include "MCP/Accessibility/Localization.h"
 #include "MCP/Core/Resource/Font.h"
+#include "MCP/Graphics/Graphics.h"
 #include "MCP/Scene/IRenderable.h"
 #include "Utility/Types/Color.h"
 
@@ -18,6 +19,7 @@ namespace mcp
         int height                  = 0;
         Color foreground;
         Color background;
+        bool renderToTexture        = false;    // If true, the text is drawn once into a texture that is blit each frame.
 
         // Any kind of styling?
     };
@@ -47,6 +49,22 @@ namespace mcp
             int lineWidth = 0;
             int lineHeight = 0;
         };
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        //		NOTES:
+        //      The glyph quads are stored relative to the 'text anchor', the point where the first line starts when it has a
+        //      width of zero. This makes them independent of the Widget's position, so moving the Widget doesn't rebuild anything.
+        //		
+        ///		@brief : Cached render data for our laid out text. This is only rebuilt when the layout of the text changes.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        struct RenderCache
+        {
+            std::vector<TextureRenderData> glyphQuads;  // Glyph quads, with the destination relative to the text anchor.
+            RectF bounds;                               // The bounds of all the glyph quads, relative to the text anchor.
+            void* pTargetTexture = nullptr;             // Texture that the glyphs are baked into, when rendering to texture.
+            uint32_t targetGeneration = 0;              // Target texture generation that the glyphs were baked in.
+            bool isDirty = true;                        // Whether the cache needs to be rebuilt before the next render.
+        };
         
         TextFormatData m_format;            // Data about the Text styling
         std::vector<GlyphData> m_glyphs;    // The textures that make up our string.
@@ -54,6 +72,7 @@ namespace mcp
         LocalizedString m_text;             // Text that will be rendered.
         Font m_font;                        // The font resource that we are using.
         Vec2Int m_textDimensions;           // The total width and height of Text we are rendering.
+        mutable RenderCache m_renderCache;  // Cached glyph quads, rebuilt lazily on Render().
 
     public:
         TextWidget(const WidgetConstructionData& data, const char* pText, const TextFormatData& format);
@@ -65,6 +84,7 @@ namespace mcp
         void SetText(const char* pText);
         void SetText(const std::string& text);
         void SetFont(const Font& font);
+        void SetRenderToTexture(const bool renderToTexture);
         bool Append(const char character);
         void PopBack();
 
@@ -72,6 +92,7 @@ namespace mcp
         [[nodiscard]] size_t GetTextLength() const { return m_text.size(); }
         [[nodiscard]] const std::string& GetText() const { return m_text.Get(); }
         [[nodiscard]] const Font& GetFont() const { return m_font; }
+        [[nodiscard]] bool RendersToTexture() const { return m_format.renderToTexture; }
         [[nodiscard]] Vec2 GetCursorPosAtEnd() const;
         [[nodiscard]] virtual float GetRectWidth() const override;
         [[nodiscard]] virtual float GetRectHeight() const override;
@@ -86,6 +107,15 @@ namespace mcp
         [[nodiscard]] float GetLocalLineStartXPos(const size_t lineIndex) const;
         [[nodiscard]] float GetLocalLineStartYPos(const size_t lineIndex) const;
         void SetGlyphData();
+        void RefreshText();
+        void UpdateTextDimensions();
+        void OnTextDimensionsChanged(const Vec2Int& previousDimensions);
+        void RebuildRenderCache() const;
+        void BakeTargetTexture() const;
+        void FreeTargetTexture() const;
+        void RenderGlyphQuads(const Vec2 anchor, const RectF& visibleRect) const;
+        void RenderTargetTexture(const Vec2 anchor, const RectF& visibleRect) const;
+        virtual void OnSizeChanged() override;
         virtual void OnActive() override;
         virtual void OnInactive() override;
         virtual void OnZChanged() override;
@@ -660,6 +660,7 @@ namespace mcp
     void Widget::SetWidth(const float width)
     {
         m_width = width;
+        OnSizeChanged();
 
         if (m_pParent)
             GetParent()->OnChildSizeChanged();
@@ -673,6 +674,7 @@ namespace mcp
     void Widget::SetHeight(const float height)
     {
         m_height = height;
+        OnSizeChanged();
 
         if (m_pParent)
             GetParent()->OnChildSizeChanged();
@@ -687,6 +689,7 @@ namespace mcp
     {
         m_scale.x = xScale;
         m_scale.y = yScale;
+        OnSizeChanged();
 
         if (m_pParent)
             GetParent()->OnChildSizeChanged();
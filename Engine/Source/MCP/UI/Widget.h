@@ -181,6 +181,11 @@ namespace mcp
         virtual void OnActive() override;
         virtual void OnInactive() override;
         virtual void OnMove();
+
+        //-----------------------------------------------------------------------------------------------------------------------------
+        ///		@brief : Called when the base width, height or scale of this Widget is set.
+        //-----------------------------------------------------------------------------------------------------------------------------
+        virtual void OnSizeChanged() {}
         virtual void OnParentSet() override;
         void UpdateMaskingWidget(Widget* pMaskingWidget);
         virtual void OnZChanged() {}
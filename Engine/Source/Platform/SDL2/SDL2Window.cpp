@@ -21,6 +21,7 @@ namespace mcp
     SDL2Window::SDL2Window()
         : m_pWindow(nullptr)
         , m_pRenderer(nullptr)
+        , m_pFramebuffer(nullptr)
         , m_dimensions{}
     {
         //
@@ -36,10 +37,14 @@ namespace mcp
     //      Flags for SDL_Window: https://wiki.libsdl.org/SDL2/SDL_WindowFlags
     //
     ///		@brief : Create a new Window centered in the screen.
+    ///		@param isHeadless : If true, no window is created and we render to an in-memory framebuffer instead.
     ///		@returns : False if initialization fails, otherwise true.
     //-----------------------------------------------------------------------------------------------------------------------------
-    bool SDL2Window::Init(const char* pWindowName, const int width, const int height)
+    bool SDL2Window::Init(const char* pWindowName, const int width, const int height, const bool isHeadless)
     {
+        if (isHeadless)
+            return InitHeadless(width, height);
+
         m_dimensions.SetPosition(SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
 
         Uint32 flags{};
@@ -87,6 +92,55 @@ namespace mcp
         return true;
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      SDL's software renderer rasterizes directly into the surface, so textured quads, primitives, text, tint and alpha
+    //      all go through the same SdlRenderer code paths as the hardware renderer.
+    //
+    ///		@brief : Create an RGBA framebuffer in memory and a software renderer that draws into it.
+    ///		@returns : False if initialization fails, otherwise true.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool SDL2Window::InitHeadless(int width, int height)
+    {
+        // There is no desktop to be fullscreen on, so use the default size.
+        if (width == -1 || height == -1)
+        {
+            width = 1600;
+            height = 900;
+        }
+
+        m_dimensions = {0, 0, width, height};
+
+        m_pFramebuffer = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!m_pFramebuffer)
+        {
+            MCP_ERROR("SDLWindow", "Failed to create headless framebuffer! SDL_Error: ", SDL_GetError());
+            return false;
+        }
+
+        m_pRenderer = SDL_CreateSoftwareRenderer(m_pFramebuffer);
+        if (!m_pRenderer)
+        {
+            MCP_ERROR("SDLWindow", "Failed to create software SDL_Renderer! SDL_Error: ", SDL_GetError());
+            SDL_FreeSurface(m_pFramebuffer);
+            m_pFramebuffer = nullptr;
+            return false;
+        }
+
+        // Set the blend mode to allow alpha blending:
+        if (SDL_SetRenderDrawBlendMode(m_pRenderer, SDL_BLENDMODE_BLEND) < 0)
+        {
+            MCP_ERROR("SDLWindow", "Failed to Set the BlendMode of the Renderer! SDL_Error: ", SDL_GetError());
+            SDL_DestroyRenderer(m_pRenderer);
+            SDL_FreeSurface(m_pFramebuffer);
+            m_pRenderer = nullptr;
+            m_pFramebuffer = nullptr;
+            return false;
+        }
+
+        return true;
+    }
+
     bool SDL2Window::ProcessEvents()
     {
         SDL_Event sdlEvent;
@@ -186,6 +240,14 @@ namespace mcp
                     break;
                 }
 
+                // The renderer's device was reset, and the contents of our target textures are gone.
+                case SDL_RENDER_TARGETS_RESET:
+                case SDL_RENDER_DEVICE_RESET:
+                {
+                    OnTargetTexturesLost();
+                    break;
+                }
+
                 // TODO: Window Events.
                 // TODO: Controller Events.
 
@@ -245,5 +307,6 @@ namespace mcp
     {
         SDL_DestroyRenderer(m_pRenderer);
         SDL_DestroyWindow(m_pWindow);
+        SDL_FreeSurface(m_pFramebuffer);
     }
 }
\ No newline at end of file
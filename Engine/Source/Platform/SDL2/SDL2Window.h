@@ -5,6 +5,7 @@
 
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
 
 namespace mcp
 {
@@ -15,6 +16,7 @@ namespace mcp
     {
         SDL_Window* m_pWindow;      // Pointer to the window instance.
         SDL_Renderer* m_pRenderer;  // Pointer to the renderer for this window.
+        SDL_Surface* m_pFramebuffer;// In-memory RGBA framebuffer, when running headless.
         RectInt m_dimensions;       // Position and size data for this window.
         uint32_t m_mouseDownTimeStamp = 0;
         bool m_mouseDown = false;
@@ -23,7 +25,7 @@ namespace mcp
         SDL2Window();
         ~SDL2Window();
         
-        bool Init(const char* pWindowName, const int width, const int height);
+        bool Init(const char* pWindowName, const int width, const int height, const bool isHeadless);
 
         bool ProcessEvents();
 
@@ -33,5 +35,8 @@ namespace mcp
         [[nodiscard]] Vec2 GetMousePosition() const;
         [[nodiscard]] const RectInt& GetDimensions() const { return m_dimensions; }
         [[nodiscard]] SDL_Renderer* GetRenderer() const { return m_pRenderer; }
+
+    private:
+        bool InitHeadless(int width, int height);
     };
 }
\ No newline at end of file
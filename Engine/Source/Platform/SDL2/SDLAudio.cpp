@@ -2,8 +2,12 @@
 
 #include "SDLAudio.h"
 
+#include <algorithm>
+#include <string>
+
 #pragma warning(push)
 #pragma warning(disable : 26819)
+#include <SDL_hints.h>
 #include <SDL_mixer.h>
 #pragma warning(pop)
 
@@ -12,15 +16,28 @@
 #include "MCP/Audio/AudioTrack.h"
 #include "MCP/Debug/Log.h"
 
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Call SetDeviceSettings() first. The resampler hint is only read when the audio subsystem is initialized.
+//		
+///		@brief : Open the audio device.
+//-----------------------------------------------------------------------------------------------------------------------------
 bool SDLAudioManager::Init()
 {
+    const auto resamplerQuality = std::to_string(std::clamp(s_deviceSettings.resamplerQuality, 0, 3));
+    SDL_SetHint(SDL_HINT_AUDIO_RESAMPLING_MODE, resamplerQuality.c_str());
+
     if(SDL_AudioInit(nullptr) != 0)
     {
         MCP_ERROR("SDL", "Failed to initialize SDL_Audio! SDL_Error: ", SDL_GetError());
         return false;
     }
 
-    if (Mix_OpenAudio(MIX_DEFAULT_FREQUENCY, MIX_DEFAULT_FORMAT, MIX_DEFAULT_CHANNELS, 1024) < 0)
+    const int frequency = s_deviceSettings.frequency > 0 ? s_deviceSettings.frequency : MIX_DEFAULT_FREQUENCY;
+    const int channelCount = s_deviceSettings.channels > 0 ? s_deviceSettings.channels : MIX_DEFAULT_CHANNELS;
+    const int bufferSize = s_deviceSettings.bufferSize > 0 ? s_deviceSettings.bufferSize : 1024;
+
+    if (Mix_OpenAudio(frequency, MIX_DEFAULT_FORMAT, channelCount, bufferSize) < 0)
     {
         MCP_ERROR("SDL", "Failed to open SDL Mix_Audio: Mix_Error: ", Mix_GetError());
         return false;
@@ -34,15 +51,33 @@ bool SDLAudioManager::Init()
         return false;
     }
 
+    // Voices are placed on channels by offset in bytes, so we need the size of the device's audio. The device may not
+    // have given us what we asked for, so clips are converted to what we actually got.
+    Mix_QuerySpec(&s_deviceFrequency, &s_deviceFormat, &s_deviceChannels);
+    s_frameSize = (SDL_AUDIO_BITSIZE(s_deviceFormat) / 8) * s_deviceChannels;
+    s_bytesPerSecond = s_deviceFrequency * s_frameSize;
+
     // Set our channels to expire when they finish.
     Mix_ChannelFinished(&SDLAudioManager::OnChannelFinished);
+    Mix_HookMusicFinished(&SDLAudioManager::OnMusicFinished);
 
     return true;
 }
 
 void SDLAudioManager::Close()
 {
+    Mix_HaltChannel(-1);
+    StopMusic();
+
+    for (int channel = 0; channel < s_channelCount; ++channel)
+    {
+        StopChannel(channel);
+    }
+
     Mix_CloseAudio();
+    s_deviceFrequency = 0;
+    s_frameSize = 0;
+    s_bytesPerSecond = 0;
 }
 
 void SDLAudioManager::PauseChannel(const int channel)
@@ -97,6 +132,9 @@ int SDLAudioManager::PlayMusic(void* pResource, const float volume, const bool i
 {
     auto* pMusic = static_cast<Mix_Music*>(pResource);
 
+    // Don't let the music that we are replacing report that it finished.
+    StopMusic();
+
     // For now, just play the music.
     if (Mix_PlayMusic(pMusic, isLooping? -1 : 0) != 0)
     {
@@ -134,6 +172,177 @@ int SDLAudioManager::PlayClip(void* pResource, const float volume, const bool is
     return channel;
 }
 
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the length of a clip, in seconds.
+//-----------------------------------------------------------------------------------------------------------------------------
+float SDLAudioManager::GetClipLength(void* pResource)
+{
+    const auto* pChunk = static_cast<Mix_Chunk*>(pResource);
+    if (!pChunk || s_bytesPerSecond <= 0)
+        return 0.f;
+
+    return static_cast<float>(pChunk->alen) / static_cast<float>(s_bytesPerSecond);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Every clip is stored in the device's format, so mixing a clip is just scaling and adding its samples, no matter how
+//      many are playing. WAV files are converted with an SDL_AudioStream, which uses the resampler quality from the device
+//      settings. Any other format is decoded and converted by SDL_mixer, which always uses SDL's default resampler.
+//
+//      The device must be open, since we need its format.
+//
+///		@brief : Load a clip, converted to the device's format.
+///		@param pSource : The data to read from.
+///		@param freeSource : If true, pSource is closed once the clip has been loaded, even if it failed.
+///		@returns : The clip, or nullptr on failure.
+//-----------------------------------------------------------------------------------------------------------------------------
+void* SDLAudioManager::LoadClip(SDL_RWops* pSource, const bool freeSource)
+{
+    if (!pSource)
+        return nullptr;
+
+    if (s_deviceFrequency > 0)
+    {
+        const Sint64 start = SDL_RWtell(pSource);
+        if (auto* pChunk = ConvertWavToDeviceFormat(pSource))
+        {
+            if (freeSource)
+                SDL_RWclose(pSource);
+
+            return pChunk;
+        }
+
+        // Not a WAV file. Let SDL_mixer decode it from the beginning.
+        SDL_RWseek(pSource, start, RW_SEEK_SET);
+    }
+
+    return Mix_LoadWAV_RW(pSource, freeSource ? 1 : 0);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      This must be called before any clips are played on channels, since the channel state is reallocated.
+//
+///		@brief : Set the number of channels that clips can be played on.
+///		@returns : The number of channels that were allocated.
+//-----------------------------------------------------------------------------------------------------------------------------
+int SDLAudioManager::AllocateChannels(const int count)
+{
+    for (int channel = 0; channel < s_channelCount; ++channel)
+    {
+        StopChannel(channel);
+    }
+
+    s_channelCount = Mix_AllocateChannels(count);
+    s_pChannelFinished = std::make_unique<std::atomic<bool>[]>(static_cast<size_t>(s_channelCount));
+    s_channelTailChunks.assign(static_cast<size_t>(s_channelCount), nullptr);
+
+    for (int channel = 0; channel < s_channelCount; ++channel)
+    {
+        s_pChannelFinished[channel] = false;
+    }
+
+    return s_channelCount;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      SDL_mixer can't start a chunk partway through, so to resume a voice, we play a chunk that points at the rest of
+//      the clip's samples. Nothing is copied. The chunk only lives until the channel is stopped or played again.
+//
+///		@brief : Play a clip on a specific channel, which must not be playing anything.
+///		@param volume : Volume of the channel, from [0, 1].
+///		@param startTime : Seconds into the clip to start at. If this is past the start, the clip will only play to its end,
+///             even if isLooping is true.
+///		@returns : False if the clip failed to play, or if startTime was past the end of the clip.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SDLAudioManager::PlayClipOnChannel(void* pResource, const int channel, const float volume, const float startTime, const bool isLooping)
+{
+    if (channel < 0 || channel >= s_channelCount)
+        return false;
+
+    StopChannel(channel);
+
+    auto* pChunk = static_cast<Mix_Chunk*>(pResource);
+    const auto offset = static_cast<Uint32>(startTime * static_cast<float>(s_bytesPerSecond)) / s_frameSize * s_frameSize;
+
+    if (offset > 0)
+    {
+        if (offset >= pChunk->alen)
+            return false;
+
+        pChunk = Mix_QuickLoad_RAW(pChunk->abuf + offset, pChunk->alen - offset);
+        if (!pChunk)
+        {
+            MCP_ERROR("SDL", "Failed to create chunk to resume a clip! Mix_Error: ", Mix_GetError());
+            return false;
+        }
+
+        s_channelTailChunks[channel] = pChunk;
+    }
+
+    Mix_Volume(channel, static_cast<int>(volume * kMaxVolume));
+
+    if (Mix_PlayChannel(channel, pChunk, (isLooping && offset == 0) ? -1 : 0) < 0)
+    {
+        MCP_ERROR("SDL", "Failed to play clip on channel ", channel, "! Mix_Error: ", Mix_GetError());
+        StopChannel(channel);
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Stop whatever is playing on a channel right away. This doesn't count as the channel finishing.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SDLAudioManager::StopChannel(const int channel)
+{
+    if (channel < 0 || channel >= s_channelCount)
+        return;
+
+    // Halting calls OnChannelFinished() before it returns, so we can clear the flag right after.
+    Mix_HaltChannel(channel);
+    s_pChannelFinished[channel] = false;
+
+    if (s_channelTailChunks[channel])
+    {
+        Mix_FreeChunk(static_cast<Mix_Chunk*>(s_channelTailChunks[channel]));
+        s_channelTailChunks[channel] = nullptr;
+    }
+}
+
+void SDLAudioManager::SetChannelVolume(const int channel, const float volume)
+{
+    Mix_Volume(channel, static_cast<int>(volume * kMaxVolume));
+}
+
+void SDLAudioManager::StopMusic()
+{
+    Mix_HaltMusic();
+    s_musicFinished = false;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Returns true once for each time the music finished playing on its own.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SDLAudioManager::ConsumeMusicFinished()
+{
+    return s_musicFinished.exchange(false);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Returns true once for each time the channel finished playing on its own.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SDLAudioManager::ConsumeChannelFinished(const int channel)
+{
+    if (channel < 0 || channel >= s_channelCount)
+        return false;
+
+    return s_pChannelFinished[channel].exchange(false);
+}
+
 void SDLAudioManager::Mute()
 {
     s_musicVolume = Mix_VolumeMusic(0);
@@ -255,6 +464,66 @@ void SDLAudioManager::PauseChannels()
     Mix_Pause(-1);
 }
 
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Load a WAV file and convert it to the device's format.
+///		@returns : The clip, or nullptr if the source isn't a WAV file or it failed to convert.
+//-----------------------------------------------------------------------------------------------------------------------------
+void* SDLAudioManager::ConvertWavToDeviceFormat(SDL_RWops* pSource)
+{
+    SDL_AudioSpec sourceSpec;
+    Uint8* pSourceData = nullptr;
+    Uint32 sourceSize = 0;
+    if (!SDL_LoadWAV_RW(pSource, 0, &sourceSpec, &pSourceData, &sourceSize))
+        return nullptr;
+
+    Uint8* pDeviceData = pSourceData;
+    Uint32 deviceSize = sourceSize;
+
+    const bool needsConversion = sourceSpec.freq != s_deviceFrequency || sourceSpec.format != s_deviceFormat
+        || sourceSpec.channels != s_deviceChannels;
+
+    if (needsConversion)
+    {
+        pDeviceData = nullptr;
+
+        auto* pStream = SDL_NewAudioStream(sourceSpec.format, sourceSpec.channels, sourceSpec.freq
+            , s_deviceFormat, static_cast<Uint8>(s_deviceChannels), s_deviceFrequency);
+
+        if (pStream && SDL_AudioStreamPut(pStream, pSourceData, static_cast<int>(sourceSize)) == 0 && SDL_AudioStreamFlush(pStream) == 0)
+        {
+            // Keep whole frames only.
+            const int available = SDL_AudioStreamAvailable(pStream);
+            deviceSize = static_cast<Uint32>(available - available % s_frameSize);
+            pDeviceData = static_cast<Uint8*>(SDL_malloc(deviceSize > 0 ? deviceSize : 1));
+
+            if (pDeviceData)
+                deviceSize = static_cast<Uint32>(std::max(SDL_AudioStreamGet(pStream, pDeviceData, static_cast<int>(deviceSize)), 0));
+        }
+
+        if (pStream)
+            SDL_FreeAudioStream(pStream);
+
+        SDL_FreeWAV(pSourceData);
+
+        if (!pDeviceData)
+        {
+            MCP_ERROR("SDL", "Failed to convert clip to the device's format! SDL_Error: ", SDL_GetError());
+            return nullptr;
+        }
+    }
+
+    auto* pChunk = Mix_QuickLoad_RAW(pDeviceData, deviceSize);
+    if (!pChunk)
+    {
+        SDL_free(pDeviceData);
+        return nullptr;
+    }
+
+    // QuickLoad doesn't take ownership of the data. We allocated it with SDL, so Mix_FreeChunk() can free it for us.
+    pChunk->allocated = 1;
+    return pChunk;
+}
+
 void SDLAudioManager::PauseMusic()
 {
     Mix_PauseMusic();
@@ -262,10 +531,20 @@ void SDLAudioManager::PauseMusic()
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
+//      This is called on SDL's mixer thread, so we only flag the channel. The AudioVoiceManager picks it up on its next update.
 //		
 ///		@brief : Callback for when a Channel completes.
 //-----------------------------------------------------------------------------------------------------------------------------
 void SDLAudioManager::OnChannelFinished(const int channel)
 {
-    mcp::AudioManager::Get()->Internal_OnChannelFinished(channel);
+    if (channel >= 0 && channel < s_channelCount)
+        s_pChannelFinished[channel] = true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Callback for when the music completes. Like channels, this only sets a flag.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SDLAudioManager::OnMusicFinished()
+{
+    s_musicFinished = true;
 }
@@ -1,14 +1,33 @@
 #pragma once
 // SDLAudio.h
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+struct SDL_RWops;
+
 namespace mcp
 {
     class AudioClip;
     class AudioTrack;
 }
 
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Resampler quality matches SDL_HINT_AUDIO_RESAMPLING_MODE: 0 is SDL's default resampler, and 1-3 are the fast, medium
+//      and best libsamplerate modes, if it is available.
+//
+///		@brief : Settings for the opened audio device. 0 for frequency, channels or buffer size uses SDL_mixer's default.
+//-----------------------------------------------------------------------------------------------------------------------------
+struct SDLAudioDeviceSettings
+{
+    int frequency = 0;
+    int channels = 0;
+    int bufferSize = 1024;      // Sample frames per mix. Smaller is lower latency, but needs to be mixed more often.
+    int resamplerQuality = 0;
+};
+
 class SDLAudioManager
 {
     static inline int s_masterVolume = 0;
@@ -21,7 +40,22 @@ class SDLAudioManager
 
     static inline void* pCurrentMusicResource = nullptr;
 
+    // Channels are flagged as finished on SDL's mixer thread, and the flags are consumed on our audio thread.
+    static inline std::unique_ptr<std::atomic<bool>[]> s_pChannelFinished = nullptr;
+    static inline std::atomic<bool> s_musicFinished = false;
+    static inline std::vector<void*> s_channelTailChunks;   // Chunks that play the rest of a clip from partway through.
+    static inline int s_channelCount = 0;
+    static inline int s_bytesPerSecond = 0;
+    static inline int s_frameSize = 0;
+
+    // The device's format, which clips are converted to when they are loaded.
+    static inline SDLAudioDeviceSettings s_deviceSettings;
+    static inline int s_deviceFrequency = 0;
+    static inline uint16_t s_deviceFormat = 0;
+    static inline int s_deviceChannels = 0;
+
 public:
+    static void SetDeviceSettings(const SDLAudioDeviceSettings& settings) { s_deviceSettings = settings; }
     static bool Init();
     static void Close();
 
@@ -34,9 +68,20 @@ public:
 
     // Music:
     static int PlayMusic(void* pResource, const float volume, const bool isLooping);
+    static void StopMusic();
+    static bool ConsumeMusicFinished();
 
     // Clips:
     static int PlayClip(void* pResource, const float volume, const bool isLooping);
+    static float GetClipLength(void* pResource);
+    static void* LoadClip(SDL_RWops* pSource, const bool freeSource);
+
+    // Voices:
+    static int AllocateChannels(const int count);
+    static bool PlayClipOnChannel(void* pResource, const int channel, const float volume, const float startTime, const bool isLooping);
+    static void StopChannel(const int channel);
+    static void SetChannelVolume(const int channel, const float volume);
+    static bool ConsumeChannelFinished(const int channel);
     // End of the new interface:
 
     // TODO: Delete all below:
@@ -63,5 +108,7 @@ public:
 
 private:
     static void PauseChannels();
+    static void* ConvertWavToDeviceFormat(SDL_RWops* pSource);
     static void OnChannelFinished(const int channel);
+    static void OnMusicFinished();
 };
\ No newline at end of file
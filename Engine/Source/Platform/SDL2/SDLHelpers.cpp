@@ -2,8 +2,10 @@
 
 #include "SDLHelpers.h"
 
+#include <algorithm>
 #include <SDL_mouse.h>
 
+#include "MCP/Core/Resource/PackageStream.h"
 #include "MCP/Debug/Log.h"
 #include "MCP/Graphics/Graphics.h"
 #include "Utility/Types/Color.h"
@@ -221,4 +223,110 @@ namespace mcp
 
         return pTexture;
     }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Blend mode for textures whose color channels are already multiplied by their alpha.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    SDL_BlendMode GetPremultipliedBlendMode()
+    {
+        static const SDL_BlendMode kPremultipliedBlend = SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+            , SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+        return kPremultipliedBlend;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Returns true if the texture is drawn with the premultiplied blend mode.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool IsPremultiplied(SDL_Texture* pTexture)
+    {
+        SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+        return pTexture && SDL_GetTextureBlendMode(pTexture, &blendMode) == 0 && blendMode == GetPremultipliedBlendMode();
+    }
+
+    static PackageStream* GetPackageStream(SDL_RWops* pContext)
+    {
+        return static_cast<PackageStream*>(pContext->hidden.unknown.data1);
+    }
+
+    static Sint64 SDLCALL PackageStreamSize(SDL_RWops* pContext)
+    {
+        return static_cast<Sint64>(GetPackageStream(pContext)->GetSize());
+    }
+
+    static Sint64 SDLCALL PackageStreamSeek(SDL_RWops* pContext, const Sint64 offset, const int whence)
+    {
+        PackageStream::SeekOrigin origin = PackageStream::SeekOrigin::kBegin;
+        switch (whence)
+        {
+            case RW_SEEK_SET: origin = PackageStream::SeekOrigin::kBegin; break;
+            case RW_SEEK_CUR: origin = PackageStream::SeekOrigin::kCurrent; break;
+            case RW_SEEK_END: origin = PackageStream::SeekOrigin::kEnd; break;
+            default: return SDL_SetError("Unknown value for 'whence'");
+        }
+
+        const int64_t position = GetPackageStream(pContext)->Seek(offset, origin);
+        return position < 0 ? SDL_SetError("Failed to seek package stream") : position;
+    }
+
+    static size_t SDLCALL PackageStreamRead(SDL_RWops* pContext, void* pDest, const size_t size, const size_t maxCount)
+    {
+        if (size == 0)
+            return 0;
+
+        // Like SDL's own streams, only whole objects are read.
+        PackageStream* pStream = GetPackageStream(pContext);
+        const uint64_t remaining = pStream->GetSize() - pStream->GetPosition();
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(maxCount, remaining / size));
+
+        return pStream->Read(pDest, count * size) / size;
+    }
+
+    static size_t SDLCALL PackageStreamWrite([[maybe_unused]] SDL_RWops* pContext, [[maybe_unused]] const void* pSource, [[maybe_unused]] const size_t size, [[maybe_unused]] const size_t count)
+    {
+        SDL_SetError("Package streams are read-only");
+        return 0;
+    }
+
+    static int SDLCALL PackageStreamClose(SDL_RWops* pContext)
+    {
+        if (pContext->hidden.unknown.data2)
+            BLEACH_DELETE(GetPackageStream(pContext));
+
+        SDL_FreeRW(pContext);
+        return 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      This lets SDL_image, SDL_mixer and SDL_ttf read package entries with their *_RW() functions, without the entry being
+    //      decoded into memory first. Pass the SDL_RWops with freesrc = 1, so that it is closed along with the resource.
+    //
+    ///		@brief : Create an SDL_RWops that reads from a package stream.
+    ///		@param freeStreamOnClose : If true, the stream is freed when the SDL_RWops is closed.
+    ///		@returns : The SDL_RWops, or nullptr if it could not be allocated. The stream is freed on failure if freeStreamOnClose is true.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    SDL_RWops* CreatePackageRWops(PackageStream* pStream, const bool freeStreamOnClose)
+    {
+        SDL_RWops* pContext = pStream ? SDL_AllocRW() : nullptr;
+        if (!pContext)
+        {
+            MCP_ERROR("SDL", "Failed to create SDL_RWops for package stream! SDL_Error: ", SDL_GetError());
+            if (freeStreamOnClose)
+                BLEACH_DELETE(pStream);
+
+            return nullptr;
+        }
+
+        pContext->size = PackageStreamSize;
+        pContext->seek = PackageStreamSeek;
+        pContext->read = PackageStreamRead;
+        pContext->write = PackageStreamWrite;
+        pContext->close = PackageStreamClose;
+        pContext->type = SDL_RWOPS_UNKNOWN;
+        pContext->hidden.unknown.data1 = pStream;
+        pContext->hidden.unknown.data2 = freeStreamOnClose ? pContext : nullptr;
+
+        return pContext;
+    }
 }
\ No newline at end of file
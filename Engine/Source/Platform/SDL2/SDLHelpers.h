@@ -8,6 +8,7 @@
 #pragma warning(disable : 26819)
 #include <SDL_rect.h>
 #include <SDL_render.h>
+#include <SDL_rwops.h>
 #include <SDL_scancode.h>
 #pragma warning (pop)
 
@@ -19,6 +20,8 @@ struct Color;
 
 namespace mcp
 {
+    class PackageStream;
+
     // Keys
     MCPKey KeyToSDL(const SDL_Scancode scanCode);
     MCPMouseButton ToMouseButton(const uint8_t buttonCode);
@@ -39,4 +42,9 @@ namespace mcp
     SDL_RendererFlip FlipToSdl(const mcp::RenderFlip2D& flip);
 
     SDL_Texture* CreateTextureFromSurface(SDL_Surface* pSurface, Vec2Int& sizeOut);
+    SDL_BlendMode GetPremultipliedBlendMode();
+    bool IsPremultiplied(SDL_Texture* pTexture);
+
+    // Streams:
+    SDL_RWops* CreatePackageRWops(PackageStream* pStream, const bool freeStreamOnClose);
 }
\ No newline at end of file
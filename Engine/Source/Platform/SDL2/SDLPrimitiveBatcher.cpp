@@ -0,0 +1,363 @@
+// SDLPrimitiveBatcher.cpp
+
+#include "SDLPrimitiveBatcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include "SDLHelpers.h"
+#include "SDLRenderer.h"
+#include "MCP/Debug/Log.h"
+#include "MCP/Graphics/Graphics.h"
+
+namespace
+{
+    constexpr float kPi = 3.14159265358979f;
+
+    // The longest edge, in pixels, that we allow when tessellating a circle.
+    constexpr float kMaxCircleSegmentLength = 4.f;
+    constexpr int kMinCircleSegments = 12;
+    constexpr int kMaxCircleSegments = 128;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Lines with a thickness of 1 or less are drawn as a single pixel wide line. Without SDL_RenderGeometry, a thin line
+//      that starts where the last one ended (ex: a polyline or a path) extends the same line strip, so the whole chain is
+//      a single SDL_RenderDrawLinesF call.
+//
+///		@brief : Add a line between two points.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color)
+{
+    ++m_primitiveCount;
+    const SDL_Color sdlColor = mcp::ColorToSdl(color);
+
+    // Get the unit normal of the line.
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    const float nx = length > 0.f ? -dy / length : 0.f;
+    const float ny = length > 0.f ? dx / length : 1.f;
+    const float halfThickness = std::max(thickness, 1.f) * 0.5f;
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    const Vec2 offset {nx * halfThickness, ny * halfThickness};
+    AddQuad({a.x + offset.x, a.y + offset.y}, {b.x + offset.x, b.y + offset.y}, {b.x - offset.x, b.y - offset.y}, {a.x - offset.x, a.y - offset.y}, sdlColor);
+
+#else
+    const int lineCount = std::max(static_cast<int>(std::ceil(thickness)), 1);
+
+    if (lineCount == 1)
+    {
+        // Circles are strips too, so a line can continue one that it starts on.
+        if (!m_runs.empty() && m_runs.back().type == RunType::kLineStrip && IsSameColor(m_runs.back().color, sdlColor))
+        {
+            const auto& end = m_points.back();
+            if (end.x == a.x && end.y == a.y)
+            {
+                m_points.push_back({b.x, b.y});
+                ++m_runs.back().count;
+                return;
+            }
+        }
+
+        m_runs.push_back({RunType::kLineStrip, sdlColor, m_points.size(), 2});
+        m_points.push_back({a.x, a.y});
+        m_points.push_back({b.x, b.y});
+        return;
+    }
+
+    // Approximate a thick line with parallel 1 pixel lines.
+    auto& run = GetRun(RunType::kLines, sdlColor);
+
+    for (int i = 0; i < lineCount; ++i)
+    {
+        const float offset = -halfThickness + (static_cast<float>(i) + 0.5f);
+        m_points.push_back({a.x + nx * offset, a.y + ny * offset});
+        m_points.push_back({b.x + nx * offset, b.y + ny * offset});
+        run.count += 2;
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a 1 pixel wide rect outline.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddRect(const RectF& rect, const Color& color)
+{
+    ++m_primitiveCount;
+    const SDL_Color sdlColor = mcp::ColorToSdl(color);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    const float left = rect.x;
+    const float top = rect.y;
+    const float right = rect.x + rect.width;
+    const float bottom = rect.y + rect.height;
+
+    // Top, Bottom, Left, Right edges. The sides don't overlap the top and bottom, so alpha blends evenly.
+    AddQuad({left, top}, {right, top}, {right, top + 1.f}, {left, top + 1.f}, sdlColor);
+    AddQuad({left, bottom - 1.f}, {right, bottom - 1.f}, {right, bottom}, {left, bottom}, sdlColor);
+    AddQuad({left, top + 1.f}, {left + 1.f, top + 1.f}, {left + 1.f, bottom - 1.f}, {left, bottom - 1.f}, sdlColor);
+    AddQuad({right - 1.f, top + 1.f}, {right, top + 1.f}, {right, bottom - 1.f}, {right - 1.f, bottom - 1.f}, sdlColor);
+
+#else
+    auto& run = GetRun(RunType::kRects, sdlColor);
+    m_rects.emplace_back(mcp::RectToSdlF(rect));
+    ++run.count;
+    ++m_quadCount;
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a filled rect.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddFillRect(const RectF& rect, const Color& color)
+{
+    ++m_primitiveCount;
+    const SDL_Color sdlColor = mcp::ColorToSdl(color);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    const float right = rect.x + rect.width;
+    const float bottom = rect.y + rect.height;
+    AddQuad({rect.x, rect.y}, {right, rect.y}, {right, bottom}, {rect.x, bottom}, sdlColor);
+
+#else
+    auto& run = GetRun(RunType::kFillRects, sdlColor);
+    m_rects.emplace_back(mcp::RectToSdlF(rect));
+    ++run.count;
+    ++m_quadCount;
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      The outline is a 1 pixel wide ring, centered on the radius.
+//
+///		@brief : Add a circle outline.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddCircle(const Vec2& center, const float radius, const Color& color)
+{
+    ++m_primitiveCount;
+    const SDL_Color sdlColor = mcp::ColorToSdl(color);
+    const int segmentCount = GetCircleSegmentCount(radius);
+    const float step = (2.f * kPi) / static_cast<float>(segmentCount);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    const float innerRadius = std::max(radius - 0.5f, 0.f);
+    const float outerRadius = radius + 0.5f;
+    const int firstVertex = static_cast<int>(m_vertices.size());
+
+    for (int i = 0; i < segmentCount; ++i)
+    {
+        const float angle = step * static_cast<float>(i);
+        const float cosAngle = std::cos(angle);
+        const float sinAngle = std::sin(angle);
+        AddVertex(center.x + cosAngle * innerRadius, center.y + sinAngle * innerRadius, sdlColor);
+        AddVertex(center.x + cosAngle * outerRadius, center.y + sinAngle * outerRadius, sdlColor);
+    }
+
+    for (int i = 0; i < segmentCount; ++i)
+    {
+        const int inner = firstVertex + i * 2;
+        const int outer = inner + 1;
+        const int nextInner = firstVertex + ((i + 1) % segmentCount) * 2;
+        const int nextOuter = nextInner + 1;
+
+        m_indices.insert(m_indices.end(), {inner, outer, nextOuter, inner, nextOuter, nextInner});
+    }
+
+#else
+    // Each strip needs its own draw call, so it gets its own run.
+    m_runs.push_back({RunType::kLineStrip, sdlColor, m_points.size(), 0});
+    auto& run = m_runs.back();
+
+    for (int i = 0; i <= segmentCount; ++i)
+    {
+        const float angle = step * static_cast<float>(i);
+        m_points.push_back({center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius});
+        ++run.count;
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a filled circle.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddFillCircle(const Vec2& center, const float radius, const Color& color)
+{
+    ++m_primitiveCount;
+    const SDL_Color sdlColor = mcp::ColorToSdl(color);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    // Triangle fan around the center.
+    const int segmentCount = GetCircleSegmentCount(radius);
+    const float step = (2.f * kPi) / static_cast<float>(segmentCount);
+    const int centerVertex = AddVertex(center.x, center.y, sdlColor);
+
+    for (int i = 0; i < segmentCount; ++i)
+    {
+        const float angle = step * static_cast<float>(i);
+        AddVertex(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius, sdlColor);
+    }
+
+    for (int i = 0; i < segmentCount; ++i)
+    {
+        const int current = centerVertex + 1 + i;
+        const int next = centerVertex + 1 + ((i + 1) % segmentCount);
+        m_indices.insert(m_indices.end(), {centerVertex, current, next});
+    }
+
+#else
+    // One horizontal span per row of pixels.
+    auto& run = GetRun(RunType::kFillRects, sdlColor);
+    const int rowCount = static_cast<int>(std::ceil(radius));
+
+    for (int row = -rowCount; row < rowCount; ++row)
+    {
+        const float y = static_cast<float>(row) + 0.5f;
+        const float halfWidth = std::sqrt(std::max(radius * radius - y * y, 0.f));
+        if (halfWidth <= 0.f)
+            continue;
+
+        m_rects.push_back({center.x - halfWidth, center.y + static_cast<float>(row), halfWidth * 2.f, 1.f});
+        ++run.count;
+        ++m_quadCount;
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//
+///		@brief : Submit all of the accumulated primitives to the renderer, then clear the batch.
+///		@param pRenderer : Renderer to draw to.
+///		@param stats : The frame's RenderStats, which are updated with the work submitted.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::Flush(SDL_Renderer* pRenderer, mcp::RenderStats& stats)
+{
+    if (IsEmpty())
+        return;
+
+    stats.quads += m_quadCount;
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    if (SDL_RenderGeometry(pRenderer, nullptr, m_vertices.data(), static_cast<int>(m_vertices.size())
+        , m_indices.data(), static_cast<int>(m_indices.size())) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to render primitive geometry! SDL_Error: ", SDL_GetError());
+    }
+
+    ++stats.drawCalls;
+    stats.vertices += static_cast<uint32_t>(m_vertices.size());
+
+#else
+    stats.vertices += static_cast<uint32_t>(m_rects.size() * 4 + m_points.size());
+
+    for (const auto& run : m_runs)
+    {
+        SdlRenderer::SetDrawColor(Color{run.color.r, run.color.g, run.color.b, run.color.a});
+        const int count = static_cast<int>(run.count);
+        int errorCode = 0;
+
+        switch (run.type)
+        {
+            case RunType::kFillRects: errorCode = SDL_RenderFillRectsF(pRenderer, &m_rects[run.start], count); ++stats.drawCalls; break;
+            case RunType::kRects: errorCode = SDL_RenderDrawRectsF(pRenderer, &m_rects[run.start], count); ++stats.drawCalls; break;
+            case RunType::kLineStrip: errorCode = SDL_RenderDrawLinesF(pRenderer, &m_points[run.start], count); ++stats.drawCalls; break;
+
+            case RunType::kLines:
+            {
+                for (size_t i = run.start; i < run.start + run.count; i += 2)
+                {
+                    errorCode |= SDL_RenderDrawLineF(pRenderer, m_points[i].x, m_points[i].y, m_points[i + 1].x, m_points[i + 1].y);
+                    ++stats.drawCalls;
+                }
+                break;
+            }
+        }
+
+        if (errorCode != 0)
+        {
+            MCP_ERROR("SDL", "Failed to render primitive batch! SDL_Error: ", SDL_GetError());
+        }
+    }
+#endif
+
+    Clear();
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Discard the accumulated primitives without drawing them.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::Clear()
+{
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    m_vertices.clear();
+    m_indices.clear();
+#else
+    m_runs.clear();
+    m_rects.clear();
+    m_points.clear();
+#endif
+
+    m_primitiveCount = 0;
+    m_quadCount = 0;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the number of segments to use for a circle, so that each segment is at most a few pixels long.
+//-----------------------------------------------------------------------------------------------------------------------------
+int SdlPrimitiveBatcher::GetCircleSegmentCount(const float radius)
+{
+    const float circumference = 2.f * kPi * radius;
+    const int segments = static_cast<int>(std::ceil(circumference / kMaxCircleSegmentLength));
+    return std::clamp(segments, kMinCircleSegments, kMaxCircleSegments);
+}
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a quad as two triangles. The points should be in winding order.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlPrimitiveBatcher::AddQuad(const Vec2& a, const Vec2& b, const Vec2& c, const Vec2& d, const SDL_Color color)
+{
+    ++m_quadCount;
+    const int first = AddVertex(a.x, a.y, color);
+    AddVertex(b.x, b.y, color);
+    AddVertex(c.x, c.y, color);
+    AddVertex(d.x, d.y, color);
+
+    m_indices.insert(m_indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Add a vertex, and return its index.
+//-----------------------------------------------------------------------------------------------------------------------------
+int SdlPrimitiveBatcher::AddVertex(const float x, const float y, const SDL_Color color)
+{
+    m_vertices.push_back({{x, y}, color, {0.f, 0.f}});
+    return static_cast<int>(m_vertices.size()) - 1;
+}
+
+#else
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the last run if it matches the type and color, otherwise start a new run.
+//-----------------------------------------------------------------------------------------------------------------------------
+SdlPrimitiveBatcher::Run& SdlPrimitiveBatcher::GetRun(const RunType type, const SDL_Color color)
+{
+    if (!m_runs.empty())
+    {
+        auto& last = m_runs.back();
+        if (last.type == type && IsSameColor(last.color, color))
+            return last;
+    }
+
+    const bool usesRects = type == RunType::kFillRects || type == RunType::kRects;
+    m_runs.push_back({type, color, usesRects ? m_rects.size() : m_points.size(), 0});
+    return m_runs.back();
+}
+
+bool SdlPrimitiveBatcher::IsSameColor(const SDL_Color a, const SDL_Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+// SDLPrimitiveBatcher.h
+
+// ONLY INCLUDE THIS IN .CPP FILES.
+
+#include <vector>
+
+#pragma warning (push)
+#pragma warning(disable : 26819)
+#include <SDL_render.h>
+#include <SDL_version.h>
+#pragma warning (pop)
+
+#include "Utility/Types/Color.h"
+#include "Utility/Types/Rect.h"
+
+namespace mcp
+{
+    struct RenderStats;
+}
+
+// SDL_RenderGeometry was added in SDL 2.0.18. Older versions fall back to merging primitives into
+// runs of the same color and type, and submitting each run with SDL's batched rect/line calls.
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    #define MCP_SDL_HAS_RENDER_GEOMETRY 1
+#else
+    #define MCP_SDL_HAS_RENDER_GEOMETRY 0
+#endif
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Primitives are accumulated until Flush() is called. The SdlRenderer flushes before anything that isn't a primitive
+//      is drawn (textures, clearing, changing the render target, presenting) so the draw order is preserved.
+//		
+///		@brief : Tessellates primitive shapes (lines, rects, circles) into colored triangles and submits them in as few
+///         draw calls as possible.
+//-----------------------------------------------------------------------------------------------------------------------------
+class SdlPrimitiveBatcher
+{
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+#else
+    enum class RunType
+    {
+        kFillRects,     // SDL_RenderFillRectsF
+        kRects,         // SDL_RenderDrawRectsF
+        kLines,         // Pairs of points, one line each.
+        kLineStrip,     // A single connected line strip, SDL_RenderDrawLinesF. Thin lines and circle outlines.
+    };
+
+    struct Run
+    {
+        RunType type;
+        SDL_Color color;
+        size_t start;   // Index of the first rect or point.
+        size_t count;   // Number of rects or points.
+    };
+
+    std::vector<Run> m_runs;
+    std::vector<SDL_FRect> m_rects;
+    std::vector<SDL_FPoint> m_points;
+#endif
+
+    size_t m_primitiveCount = 0;
+    uint32_t m_quadCount = 0;       // Number of quads (or rects) in the batch, for RenderStats.
+
+public:
+    void AddLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color);
+    void AddRect(const RectF& rect, const Color& color);
+    void AddFillRect(const RectF& rect, const Color& color);
+    void AddCircle(const Vec2& center, const float radius, const Color& color);
+    void AddFillCircle(const Vec2& center, const float radius, const Color& color);
+
+    void Flush(SDL_Renderer* pRenderer, mcp::RenderStats& stats);
+    void Clear();
+
+    [[nodiscard]] bool IsEmpty() const { return m_primitiveCount == 0; }
+    [[nodiscard]] size_t GetPrimitiveCount() const { return m_primitiveCount; }
+
+private:
+    static int GetCircleSegmentCount(const float radius);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    void AddQuad(const Vec2& a, const Vec2& b, const Vec2& c, const Vec2& d, const SDL_Color color);
+    int AddVertex(const float x, const float y, const SDL_Color color);
+#else
+    Run& GetRun(const RunType type, const SDL_Color color);
+    static bool IsSameColor(const SDL_Color a, const SDL_Color b);
+#endif
+};
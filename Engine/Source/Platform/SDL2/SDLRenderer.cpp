@@ -9,15 +9,57 @@
 #include <SDL_ttf.h>
 #pragma warning(pop)
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include "MCP/Core/Application/Window/WindowBase.h"
 #include "MCP/Debug/Log.h"
 #include "MCP/Graphics/Graphics.h"
 #include "Platform/SDL2/SDLHelpers.h"
+#include "Platform/SDL2/SDLPrimitiveBatcher.h"
 
-bool SdlRenderer::Init()
+// Primitives drawn this frame that haven't been submitted yet.
+static SdlPrimitiveBatcher s_primitiveBatcher;
+
+// Shadow of the SDL state that we set, so that redundant calls can be skipped.
+struct SdlStateCache
+{
+    Color drawColor;
+    Color textureMod;                       // Color and alpha mods last set on pModTexture.
+    SDL_Texture* pLastTexture = nullptr;
+    SDL_Texture* pModTexture = nullptr;
+    bool isDrawColorValid = false;
+    bool isTextureModValid = false;
+};
+
+static SdlStateCache s_stateCache;
+
+// Offscreen target that a layer is rendered into at a reduced resolution. The texture is the size of the window, and only
+// the top left area of it, at the current scale, is drawn into, so changing the scale doesn't recreate the texture.
+struct SdlScaledTarget
+{
+    SDL_Texture* pTexture = nullptr;
+    Vec2Int size;
+    float scale = 1.f;
+    bool isActive = false;
+};
+
+static SdlScaledTarget s_scaledTarget;
+
+// Shared texture that is drawn in place of textures that are still loading. It belongs to s_pRenderer.
+static SDL_Texture* s_pPendingTexturePlaceholder = nullptr;
+static mcp::RenderStats s_currentFrameStats;
+static mcp::RenderStats s_lastFrameStats;
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      When headless, we use SDL's 'dummy' video driver so that we don't need a display to run.
+//
+///		@brief : Initialize SDL_Video, SDL_Image and SDL_ttf.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::Init(const bool isHeadless)
 {
-    if (SDL_VideoInit(nullptr) != 0)
+    if (SDL_VideoInit(isHeadless ? "dummy" : nullptr) != 0)
     {
         MCP_ERROR("SDL", "Failed to initialize SDL_Video! SDL_Error: ", SDL_GetError());
         return false;
@@ -51,12 +93,58 @@ bool SdlRenderer::SetRenderTarget(mcp::WindowBase* pWindow)
         return false;
     }
 
+    // We have a new SDL_Renderer, so none of our cached state applies.
+    InvalidateStateCache();
+
     return true;
 }
 
 void SdlRenderer::Display()
 {
+    FlushPrimitives();
     SDL_RenderPresent(s_pRenderer);
+    EndFrame();
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Store the current frame's stats as the last frame's, and start counting for a new frame.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::EndFrame()
+{
+    s_lastFrameStats = s_currentFrameStats;
+    s_currentFrameStats = {};
+
+    // The texture could be destroyed between frames, so don't trust the pointer.
+    s_stateCache.pLastTexture = nullptr;
+    s_stateCache.pModTexture = nullptr;
+    s_stateCache.isTextureModValid = false;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the stats of the last completed frame.
+//-----------------------------------------------------------------------------------------------------------------------------
+const mcp::RenderStats& SdlRenderer::GetLastFrameStats()
+{
+    return s_lastFrameStats;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Get the stats counted so far in the current frame.
+//-----------------------------------------------------------------------------------------------------------------------------
+const mcp::RenderStats& SdlRenderer::GetCurrentFrameStats()
+{
+    return s_currentFrameStats;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Call this if SDL state is changed outside the SdlRenderer.
+//
+///		@brief : Forget the cached render state, so that the next state change is always sent to SDL.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::InvalidateStateCache()
+{
+    s_stateCache = {};
 }
 
 void SdlRenderer::Close()
@@ -66,121 +154,213 @@ void SdlRenderer::Close()
     SDL_VideoQuit();
 }
 
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      SDL_RenderReadPixels is slow on hardware renderers, as it stalls the GPU. With the headless renderer it is just a copy
+//      out of the framebuffer surface.
+//
+///		@brief : Read the current render target into a tightly packed RGBA32 buffer.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::ReadPixels(std::vector<uint8_t>& outPixels, Vec2Int& outSize)
+{
+    FlushPrimitives();
+
+    if (SDL_GetRendererOutputSize(s_pRenderer, &outSize.x, &outSize.y) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to get renderer output size! SDL_Error: ", SDL_GetError());
+        return false;
+    }
+
+    const int pitch = outSize.x * 4;
+    outPixels.resize(static_cast<size_t>(pitch) * static_cast<size_t>(outSize.y));
+
+    if (SDL_RenderReadPixels(s_pRenderer, nullptr, SDL_PIXELFORMAT_RGBA32, outPixels.data(), pitch) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to read renderer pixels! SDL_Error: ", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Save a tightly packed RGBA32 buffer to a PNG file.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::SavePixels(const char* pFilepath, std::vector<uint8_t>& pixels, const Vec2Int& size)
+{
+    auto* pSurface = SDL_CreateRGBSurfaceWithFormatFrom(pixels.data(), size.x, size.y, 32, size.x * 4, SDL_PIXELFORMAT_RGBA32);
+    if (!pSurface)
+    {
+        MCP_ERROR("SDL", "Failed to create surface from pixels! SDL_Error: ", SDL_GetError());
+        return false;
+    }
+
+    const bool result = IMG_SavePNG(pSurface, pFilepath) == 0;
+    if (!result)
+    {
+        MCP_ERROR("SDL", "Failed to save PNG at path: ", pFilepath, " IMG_Error: ", IMG_GetError());
+    }
+
+    SDL_FreeSurface(pSurface);
+    return result;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Color::operator== ignores alpha, so we compare it separately.
+//
+///		@brief : Set the draw color, if it isn't already set.
+//-----------------------------------------------------------------------------------------------------------------------------
 void SdlRenderer::SetDrawColor(const Color& color)
 {
+    if (s_stateCache.isDrawColorValid && s_stateCache.drawColor == color && s_stateCache.drawColor.alpha == color.alpha)
+    {
+        ++s_currentFrameStats.skippedStateChanges;
+        return;
+    }
+
     if(SDL_SetRenderDrawColor(s_pRenderer, color.r, color.g, color.b, color.alpha) < 0)
     {
         MCP_ERROR("SDL", "Failed to set color! SDL_Error: ", SDL_GetError());
+        s_stateCache.isDrawColorValid = false;
+        return;
     }
+
+    s_stateCache.drawColor = color;
+    s_stateCache.isDrawColorValid = true;
+    ++s_currentFrameStats.stateChanges;
 }
 
 void SdlRenderer::FillScreen(const Color& color)
 {
+    // Anything batched before the clear would be drawn over anyway.
+    s_primitiveBatcher.Clear();
     SetDrawColor(color);
     if (SDL_RenderClear(s_pRenderer) != 0)
     {
         MCP_ERROR("SDL", "Failed to clear screen! SDL_Error: ", SDL_GetError());
     }
+
+    ++s_currentFrameStats.drawCalls;
 }
 
 void SdlRenderer::DrawLine(const Vec2Int& a, const Vec2Int& b, const Color& color)
 {
-    SetDrawColor(color);
-    if (SDL_RenderDrawLine(s_pRenderer, a.x, a.y, b.x, b.y) != 0)
-    {
-        MCP_ERROR("SDL", "Failed to draw line! SDL_Error: ", SDL_GetError());
-    }
+    s_primitiveBatcher.AddLine(Vec2{static_cast<float>(a.x), static_cast<float>(a.y)}, Vec2{static_cast<float>(b.x), static_cast<float>(b.y)}, 1.f, color);
 }
 
-void SdlRenderer::DrawFillRect(const RectInt& rect, const Color& color)
+void SdlRenderer::DrawLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color)
 {
-    SetDrawColor(color);
-    const auto sdlRect = mcp::RectToSdl(rect);
+    s_primitiveBatcher.AddLine(a, b, thickness, color);
+}
 
-    if (SDL_RenderFillRect(s_pRenderer, &sdlRect) != 0)
-    {
-        MCP_ERROR("SDL", "Failed to draw fill rect! SDL_Error: ", SDL_GetError());
-    }
+void SdlRenderer::DrawFillRect(const RectInt& rect, const Color& color)
+{
+    s_primitiveBatcher.AddFillRect(rect.GetRectAs<float>(), color);
 }
 
 void SdlRenderer::DrawFillRect(const RectF& rect, const Color& color)
 {
-    SetDrawColor(color);
-    const auto sdlRect = mcp::RectToSdlF(rect);
-
-    if (SDL_RenderFillRectF(s_pRenderer, &sdlRect) != 0)
-    {
-        MCP_ERROR("SDL", "Failed to draw fill rect! SDL_Error: ", SDL_GetError());
-    }
+    s_primitiveBatcher.AddFillRect(rect, color);
 }
 
 void SdlRenderer::DrawRect(const RectInt& rect, const Color& color)
 {
-    SetDrawColor(color);
-    const auto sdlRect = mcp::RectToSdl(rect);
-
-    if (SDL_RenderDrawRect(s_pRenderer, &sdlRect) != 0)
-    {
-        MCP_ERROR("SDL", "Failed to draw rect! SDL_Error: ", SDL_GetError());
-    }
+    s_primitiveBatcher.AddRect(rect.GetRectAs<float>(), color);
 }
 
 void SdlRenderer::DrawRect(const RectF& rect, const Color& color)
 {
-    SetDrawColor(color);
-    const auto sdlRect = mcp::RectToSdlF(rect);
+    s_primitiveBatcher.AddRect(rect, color);
+}
+
+void SdlRenderer::DrawCircle(const Vec2& pos, const float radius, const Color& color)
+{
+    s_primitiveBatcher.AddCircle(pos, radius, color);
+}
+
+void SdlRenderer::DrawFillCircle(const Vec2& pos, const float radius, const Color& color)
+{
+    s_primitiveBatcher.AddFillCircle(pos, radius, color);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Primitives are batched until something else needs to be drawn. This is called automatically before drawing textures,
+//      clearing, presenting or changing the render target, so you should only need it when calling SDL directly.
+//
+///		@brief : Submit any batched primitives to the renderer.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::FlushPrimitives()
+{
+    s_primitiveBatcher.Flush(s_pRenderer, s_currentFrameStats);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Premultiplied textures are blended with a source factor of ONE, so the alpha mod only changes how much of the
+//      background they cover. Their color has to be scaled by the alpha too, or fading one out would turn it into a glow.
+//
+///		@brief : Get the color and alpha mods that a texture should be drawn with, to apply a tint.
+///		@param isPremultiplied : Whether the texture uses the premultiplied blend mode. See mcp::IsPremultiplied().
+//-----------------------------------------------------------------------------------------------------------------------------
+static Color GetTextureMod(const Color& tint, const bool isPremultiplied)
+{
+    if (tint.alpha == 255 || !isPremultiplied)
+        return tint;
 
-    if (SDL_RenderDrawRectF(s_pRenderer, &sdlRect) != 0)
+    const auto scale = [&tint](const uint8_t channel) -> uint8_t
     {
-        MCP_ERROR("SDL", "Failed to draw rect! SDL_Error: ", SDL_GetError());
-    }
+        return static_cast<uint8_t>((static_cast<unsigned>(channel) * tint.alpha + 127u) / 255u);
+    };
+
+    return Color{scale(tint.r), scale(tint.g), scale(tint.b), tint.alpha};
 }
 
 //-----------------------------------------------------------------------------------------------------------------------------
 //		NOTES:
-//      Here is my reference. It is an example of the 'Midpoint Circle Algorithm'.
-//      https://stackoverflow.com/questions/38334081/howto-draw-circles-arcs-and-vector-graphics-in-sdl
+//      SDL stores the mods on each texture, but only the last texture we set them on is shadowed, which is the common case
+//      of drawing the same texture over and over. Setting a mod can break SDL's draw call batching, so it is worth skipping.
 //
-///		@brief : Draw a circle to the screen.
+///		@brief : Set the color and alpha mods of a texture, skipping the ones that are already set.
 //-----------------------------------------------------------------------------------------------------------------------------
-void SdlRenderer::DrawCircle(const Vec2& pos, const float radius, const Color& color)
+static void SetTextureMod(SDL_Texture* pTexture, const Color& mod)
 {
-    int errorCode = 0;
-    SetDrawColor(color);
+    const bool isShadowValid = s_stateCache.isTextureModValid && s_stateCache.pModTexture == pTexture;
 
-    const float diameter = radius * 2.f;
-    float x = radius - 1.f;
-    float y = 0.f;
-    float tx = 1.f;
-    float ty = 1.f;
-    float error = (tx - diameter);
-
-    while (x >= y)
-    {
-        // Each of the following renders an octant of the circle
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x + x, pos.y - y);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x + x, pos.y + y);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x - x, pos.y - y);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x - x, pos.y + y);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x + y, pos.y - x);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x + y, pos.y + x);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x - y, pos.y - x);
-        errorCode = SDL_RenderDrawPointF(s_pRenderer, pos.x - y, pos.y + x);
-
-        if (error <= 0.f)
+    if (!isShadowValid || s_stateCache.textureMod != mod)
+    {
+        if (SDL_SetTextureColorMod(pTexture, mod.r, mod.g, mod.b) != 0)
         {
-            ++y;
-            error += ty;
-            ty += 2.f;
+            MCP_ERROR("SDL", "Failed to set SDL_Texture Color! SDL_Error: ", SDL_GetError());
         }
 
-        if (error > 0.f)
+        ++s_currentFrameStats.stateChanges;
+    }
+
+    else
+    {
+        ++s_currentFrameStats.skippedStateChanges;
+    }
+
+    if (!isShadowValid || s_stateCache.textureMod.alpha != mod.alpha)
+    {
+        if (SDL_SetTextureAlphaMod(pTexture, mod.alpha) != 0)
         {
-            --x;
-            tx += 2.f;
-            error += (tx - diameter);
+            MCP_ERROR("SDL", "Failed to set SDL Alpha Alpha! SDL_Error: ", SDL_GetError());
         }
+
+        ++s_currentFrameStats.stateChanges;
     }
+
+    else
+    {
+        ++s_currentFrameStats.skippedStateChanges;
+    }
+
+    s_stateCache.pModTexture = pTexture;
+    s_stateCache.textureMod = mod;
+    s_stateCache.isTextureModValid = true;
 }
 
 void SdlRenderer::DrawTexture(const mcp::TextureRenderData& context)
@@ -190,18 +370,20 @@ void SdlRenderer::DrawTexture(const mcp::TextureRenderData& context)
     const SDL_FPoint center = mcp::Vec2ToSdlF(context.anglePivot);
     auto* pSdlTexture = static_cast<SDL_Texture*>(context.pTexture);
 
-    // Set the new tint color
-    if (SDL_SetTextureColorMod(pSdlTexture, context.tint.r, context.tint.g, context.tint.b) != 0)
-    {
-        MCP_ERROR("SDL", "Failed to set SDL_Texture Color! SDL_Error: ", SDL_GetError());
-    }
+    FlushPrimitives();
 
-    // Set the new alpha value.
-    if (SDL_SetTextureAlphaMod(pSdlTexture, context.tint.alpha) != 0)
+    if (pSdlTexture != s_stateCache.pLastTexture)
     {
-        MCP_ERROR("SDL", "Failed to set SDL Alpha Alpha! SDL_Error: ", SDL_GetError());
+        s_stateCache.pLastTexture = pSdlTexture;
+        ++s_currentFrameStats.textureBinds;
     }
 
+    SetTextureMod(pSdlTexture, GetTextureMod(context.tint, context.tint.alpha < 255 && mcp::IsPremultiplied(pSdlTexture)));
+
+    ++s_currentFrameStats.drawCalls;
+    ++s_currentFrameStats.quads;
+    s_currentFrameStats.vertices += 4;
+
     if (SDL_RenderCopyExF(
         s_pRenderer
         , pSdlTexture
@@ -214,4 +396,399 @@ void SdlRenderer::DrawTexture(const mcp::TextureRenderData& context)
     {
         MCP_ERROR("SDL", "Failed to draw texture! SDL_Error: ", SDL_GetError());
     }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      With SDL_RenderGeometry (SDL 2.0.18+), the whole batch is a single draw call, with the color of each quad stored in its
+//      vertices. On older versions, untextured quads are submitted as runs of the same color with SDL_RenderFillRectsF, and
+//      textured quads fall back to one SDL_RenderCopyF per quad.
+//
+///		@brief : Draw a batch of quads that share a texture.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::DrawQuads(void* pTexture, const RectInt& crop, const mcp::ColoredQuad* pQuads, const size_t count)
+{
+    auto* pSdlTexture = static_cast<SDL_Texture*>(pTexture);
+
+    FlushPrimitives();
+
+    if (pSdlTexture && pSdlTexture != s_stateCache.pLastTexture)
+    {
+        s_stateCache.pLastTexture = pSdlTexture;
+        ++s_currentFrameStats.textureBinds;
+    }
+
+    s_currentFrameStats.quads += static_cast<uint32_t>(count);
+    s_currentFrameStats.vertices += static_cast<uint32_t>(count * 4);
+
+    const bool isPremultiplied = mcp::IsPremultiplied(pSdlTexture);
+
+#if MCP_SDL_HAS_RENDER_GEOMETRY
+    static std::vector<SDL_Vertex> s_vertices;
+    static std::vector<int> s_indices;
+    s_vertices.clear();
+    s_indices.clear();
+    s_vertices.reserve(count * 4);
+    s_indices.reserve(count * 6);
+
+    // Texture coordinates of the crop, shared by every quad.
+    float u0 = 0.f;
+    float v0 = 0.f;
+    float u1 = 1.f;
+    float v1 = 1.f;
+
+    if (pSdlTexture)
+    {
+        int width = 0;
+        int height = 0;
+        SDL_QueryTexture(pSdlTexture, nullptr, nullptr, &width, &height);
+
+        if (width > 0 && height > 0)
+        {
+            u0 = static_cast<float>(crop.x) / static_cast<float>(width);
+            v0 = static_cast<float>(crop.y) / static_cast<float>(height);
+            u1 = static_cast<float>(crop.x + crop.width) / static_cast<float>(width);
+            v1 = static_cast<float>(crop.y + crop.height) / static_cast<float>(height);
+        }
+
+        // The vertex colors do the tinting, so the texture mods must not.
+        SetTextureMod(pSdlTexture, Color{255, 255, 255, 255});
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& quad = pQuads[i];
+        const SDL_Color color = mcp::ColorToSdl(GetTextureMod(quad.color, isPremultiplied));
+        const float right = quad.rect.x + quad.rect.width;
+        const float bottom = quad.rect.y + quad.rect.height;
+        const int first = static_cast<int>(s_vertices.size());
+
+        s_vertices.push_back(SDL_Vertex{SDL_FPoint{quad.rect.x, quad.rect.y}, color, SDL_FPoint{u0, v0}});
+        s_vertices.push_back(SDL_Vertex{SDL_FPoint{right, quad.rect.y}, color, SDL_FPoint{u1, v0}});
+        s_vertices.push_back(SDL_Vertex{SDL_FPoint{right, bottom}, color, SDL_FPoint{u1, v1}});
+        s_vertices.push_back(SDL_Vertex{SDL_FPoint{quad.rect.x, bottom}, color, SDL_FPoint{u0, v1}});
+
+        s_indices.insert(s_indices.end(), {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+
+    ++s_currentFrameStats.drawCalls;
+    if (SDL_RenderGeometry(s_pRenderer, pSdlTexture, s_vertices.data(), static_cast<int>(s_vertices.size())
+        , s_indices.data(), static_cast<int>(s_indices.size())) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to draw quad batch! SDL_Error: ", SDL_GetError());
+    }
+#else
+    if (!pSdlTexture)
+    {
+        static std::vector<SDL_FRect> s_rects;
+
+        size_t runStart = 0;
+        while (runStart < count)
+        {
+            const Color& color = pQuads[runStart].color;
+
+            // Collect every following quad with the same color.
+            s_rects.clear();
+            size_t runEnd = runStart;
+            while (runEnd < count && pQuads[runEnd].color == color && pQuads[runEnd].color.alpha == color.alpha)
+            {
+                s_rects.push_back(mcp::RectToSdlF(pQuads[runEnd].rect));
+                ++runEnd;
+            }
+
+            SetDrawColor(color);
+            ++s_currentFrameStats.drawCalls;
+            if (SDL_RenderFillRectsF(s_pRenderer, s_rects.data(), static_cast<int>(s_rects.size())) != 0)
+            {
+                MCP_ERROR("SDL", "Failed to draw quad batch! SDL_Error: ", SDL_GetError());
+            }
+
+            runStart = runEnd;
+        }
+
+        return;
+    }
+
+    const SDL_Rect sdlCrop = mcp::RectToSdl(crop);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& quad = pQuads[i];
+
+        // The shadow skips the mods when this quad has the same color as the last thing drawn with the texture, even if
+        // that was in a previous batch.
+        SetTextureMod(pSdlTexture, GetTextureMod(quad.color, isPremultiplied));
+
+        const SDL_FRect dst = mcp::RectToSdlF(quad.rect);
+        ++s_currentFrameStats.drawCalls;
+        if (SDL_RenderCopyF(s_pRenderer, pSdlTexture, &sdlCrop, &dst) != 0)
+        {
+            MCP_ERROR("SDL", "Failed to draw quad batch! SDL_Error: ", SDL_GetError());
+            return;
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      The texture is cleared to transparent black so that anything drawn into it can be blended over the scene afterwards.
+//		
+///		@brief : Create a texture that can be used as a render target.
+///		@param size : Width and height of the texture in pixels.
+///		@returns : Pointer to the SDL_Texture, or nullptr if the creation failed.
+//-----------------------------------------------------------------------------------------------------------------------------
+void* SdlRenderer::CreateTargetTexture(const Vec2Int& size)
+{
+    SDL_Texture* pTexture = SDL_CreateTexture(s_pRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+    if (!pTexture)
+    {
+        MCP_ERROR("SDL", "Failed to create target texture! SDL_Error: ", SDL_GetError());
+        return nullptr;
+    }
+
+    SDL_SetTextureBlendMode(pTexture, SDL_BLENDMODE_BLEND);
+    return pTexture;
+}
+
+void SdlRenderer::DestroyTargetTexture(void* pTexture)
+{
+    DestroyTexture(pTexture);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Every SDL_Texture should be destroyed through here, since a new texture could be created at the same address and
+//      would otherwise match our cached state.
+//
+///		@brief : Destroy a texture, and forget any cached state that refers to it.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::DestroyTexture(void* pTexture)
+{
+    if (!pTexture)
+        return;
+
+    if (s_stateCache.pModTexture == pTexture)
+    {
+        s_stateCache.pModTexture = nullptr;
+        s_stateCache.isTextureModValid = false;
+    }
+
+    if (s_stateCache.pLastTexture == pTexture)
+        s_stateCache.pLastTexture = nullptr;
+
+    SDL_DestroyTexture(static_cast<SDL_Texture*>(pTexture));
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//		
+///		@brief : Redirect all draw calls into a target texture. Passing nullptr will return rendering to the window.
+///		@returns : False if the target could not be set.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::SetTargetTexture(void* pTexture)
+{
+    // Primitives drawn so far belong to the current target.
+    FlushPrimitives();
+    ++s_currentFrameStats.targetSwitches;
+
+    // While a scaled render is active, 'the window' is the scaled target.
+    auto* pSdlTexture = static_cast<SDL_Texture*>(pTexture);
+    if (!pSdlTexture && s_scaledTarget.isActive)
+        pSdlTexture = s_scaledTarget.pTexture;
+
+    if (SDL_SetRenderTarget(s_pRenderer, pSdlTexture) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to set render target! SDL_Error: ", SDL_GetError());
+        return false;
+    }
+
+    // Setting a texture target resets the render scale, so it needs to be restored.
+    if (!pTexture && s_scaledTarget.isActive)
+        SDL_RenderSetScale(s_pRenderer, s_scaledTarget.scale, s_scaledTarget.scale);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Everything drawn until EndScaledRender() uses the same coordinates as the window; SDL's render scale shrinks it into
+//      the target. Render targets set in between will return to the scaled target instead of the window.
+//      
+//      A scale of 1 (or more) renders straight to the window, as there would be nothing to gain from the extra copy.
+//
+///		@brief : Redirect rendering into the offscreen scaled target, at a fraction of the window's resolution.
+///		@param scale : Fraction of the window's resolution to render at, in the range (0, 1].
+///		@returns : True if rendering is now going to the scaled target. If so, EndScaledRender() must be called.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::BeginScaledRender(const float scale)
+{
+    if (s_scaledTarget.isActive || scale >= 1.f || scale <= 0.f)
+        return false;
+
+    const RectInt& windowDimensions = s_pWindow->GetDimensions();
+    const Vec2Int windowSize {windowDimensions.width, windowDimensions.height};
+    if (windowSize.x <= 0 || windowSize.y <= 0)
+        return false;
+
+    // Only recreate the texture when the window changes size.
+    if (!s_scaledTarget.pTexture || !(s_scaledTarget.size == windowSize))
+    {
+        ReleaseScaledTarget();
+
+        s_scaledTarget.pTexture = SDL_CreateTexture(s_pRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, windowSize.x, windowSize.y);
+        if (!s_scaledTarget.pTexture)
+        {
+            MCP_ERROR("SDL", "Failed to create scaled render target! SDL_Error: ", SDL_GetError());
+            return false;
+        }
+
+        // The target is opaque, and is copied over the window without blending. It is upscaled with linear filtering.
+        SDL_SetTextureBlendMode(s_scaledTarget.pTexture, SDL_BLENDMODE_NONE);
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+        SDL_SetTextureScaleMode(s_scaledTarget.pTexture, SDL_ScaleModeLinear);
+#endif
+        s_scaledTarget.size = windowSize;
+    }
+
+    FlushPrimitives();
+    ++s_currentFrameStats.targetSwitches;
+
+    if (SDL_SetRenderTarget(s_pRenderer, s_scaledTarget.pTexture) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to set scaled render target! SDL_Error: ", SDL_GetError());
+        return false;
+    }
+
+    s_scaledTarget.scale = scale;
+    s_scaledTarget.isActive = true;
+    SDL_RenderSetScale(s_pRenderer, scale, scale);
+
+    // The target still holds last frame's contents.
+    FillScreen(Color{0,0,0});
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      Does nothing if BeginScaledRender() didn't return true.
+//
+///		@brief : Return rendering to the window, and upscale the scaled target onto it with a single copy.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::EndScaledRender()
+{
+    if (!s_scaledTarget.isActive)
+        return;
+
+    FlushPrimitives();
+    s_scaledTarget.isActive = false;
+    ++s_currentFrameStats.targetSwitches;
+
+    // Going back to the window restores the window's render scale.
+    if (SDL_SetRenderTarget(s_pRenderer, nullptr) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to return to the window from the scaled render target! SDL_Error: ", SDL_GetError());
+        return;
+    }
+
+    const SDL_Rect source
+    {
+        0
+        , 0
+        , std::min(static_cast<int>(std::ceil(static_cast<float>(s_scaledTarget.size.x) * s_scaledTarget.scale)), s_scaledTarget.size.x)
+        , std::min(static_cast<int>(std::ceil(static_cast<float>(s_scaledTarget.size.y) * s_scaledTarget.scale)), s_scaledTarget.size.y)
+    };
+
+    ++s_currentFrameStats.drawCalls;
+    ++s_currentFrameStats.quads;
+    s_currentFrameStats.vertices += 4;
+    s_stateCache.pLastTexture = s_scaledTarget.pTexture;
+    ++s_currentFrameStats.textureBinds;
+
+    if (SDL_RenderCopy(s_pRenderer, s_scaledTarget.pTexture, &source, nullptr) != 0)
+    {
+        MCP_ERROR("SDL", "Failed to copy the scaled render target to the window! SDL_Error: ", SDL_GetError());
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      This must be called before the SDL_Renderer is destroyed.
+//
+///		@brief : Destroy the scaled target texture. It will be recreated the next time it is needed.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::ReleaseScaledTarget()
+{
+    if (s_scaledTarget.isActive)
+        EndScaledRender();
+
+    DestroyTexture(s_scaledTarget.pTexture);
+
+    s_scaledTarget.pTexture = nullptr;
+    s_scaledTarget.size = {};
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      This is shared by every texture that is waiting on an async load, and is created the first time it is needed. It
+//      belongs to the current SDL_Renderer, so ReleasePendingTexturePlaceholder() must be called before that is destroyed.
+//
+///		@brief : Get the small checkerboard texture that is drawn in place of a texture that is still loading.
+///		@param sizeOut : Size of the placeholder texture.
+///		@returns : Nullptr if the placeholder couldn't be created.
+//-----------------------------------------------------------------------------------------------------------------------------
+void* SdlRenderer::GetPendingTexturePlaceholder(Vec2Int& sizeOut)
+{
+    static constexpr int kPlaceholderSize = 2;
+
+    sizeOut = {kPlaceholderSize, kPlaceholderSize};
+
+    if (s_pPendingTexturePlaceholder)
+        return s_pPendingTexturePlaceholder;
+
+    SDL_Surface* pSurface = SDL_CreateRGBSurfaceWithFormat(0, kPlaceholderSize, kPlaceholderSize, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!pSurface)
+    {
+        MCP_ERROR("SDL", "Failed to create the pending texture placeholder! SDL_Error: ", SDL_GetError());
+        return nullptr;
+    }
+
+    const Uint32 light = SDL_MapRGBA(pSurface->format, 96, 96, 96, 160);
+    const Uint32 dark = SDL_MapRGBA(pSurface->format, 48, 48, 48, 160);
+    auto* pPixels = static_cast<Uint32*>(pSurface->pixels);
+    const int pitch = pSurface->pitch / static_cast<int>(sizeof(Uint32));
+
+    for (int y = 0; y < kPlaceholderSize; ++y)
+    {
+        for (int x = 0; x < kPlaceholderSize; ++x)
+        {
+            pPixels[y * pitch + x] = ((x + y) % 2 == 0) ? light : dark;
+        }
+    }
+
+    Vec2Int size;
+    s_pPendingTexturePlaceholder = mcp::CreateTextureFromSurface(pSurface, size);
+    return s_pPendingTexturePlaceholder;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+///		@brief : Check if a texture is the shared pending texture placeholder, which must not be destroyed by its users.
+//-----------------------------------------------------------------------------------------------------------------------------
+bool SdlRenderer::IsPendingTexturePlaceholder(const void* pTexture)
+{
+    return pTexture && pTexture == s_pPendingTexturePlaceholder;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+//		NOTES:
+//      This must be called before the SDL_Renderer is destroyed.
+//
+///		@brief : Destroy the pending texture placeholder. It will be recreated the next time it is needed.
+//-----------------------------------------------------------------------------------------------------------------------------
+void SdlRenderer::ReleasePendingTexturePlaceholder()
+{
+    DestroyTexture(s_pPendingTexturePlaceholder);
+
+    s_pPendingTexturePlaceholder = nullptr;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 // SDLGraphics.h
 
+#include <vector>
 #include "Utility/Types/Rect.h"
 
 struct SDL_Renderer;
@@ -9,6 +10,8 @@ namespace mcp
 {
     class WindowBase;
     struct TextureRenderData;
+    struct ColoredQuad;
+    struct RenderStats;
 }
 
 class SdlRenderer
@@ -17,7 +20,7 @@ class SdlRenderer
     inline static SDL_Renderer* s_pRenderer = nullptr;
 
 public:
-    static bool Init();
+    static bool Init(const bool isHeadless);
     static bool SetRenderTarget(mcp::WindowBase* pWindow);
     static void Display();
     static void Close();
@@ -25,10 +28,35 @@ public:
     static void FillScreen(const Color& color);
 
     static void DrawLine(const Vec2Int& a, const Vec2Int& b, const Color& color);
+    static void DrawLine(const Vec2& a, const Vec2& b, const float thickness, const Color& color);
     static void DrawFillRect(const RectInt& rect, const Color& color);
     static void DrawFillRect(const RectF& rect, const Color& color);
     static void DrawRect(const RectInt& rect, const Color& color);
     static void DrawRect(const RectF& rect, const Color& color);
     static void DrawCircle(const Vec2& pos, const float radius, const Color& color);
+    static void DrawFillCircle(const Vec2& pos, const float radius, const Color& color);
+    static void FlushPrimitives();
     static void DrawTexture(const mcp::TextureRenderData& context);
+    static void DrawQuads(void* pTexture, const RectInt& crop, const mcp::ColoredQuad* pQuads, const size_t count);
+
+    static void* CreateTargetTexture(const Vec2Int& size);
+    static void DestroyTargetTexture(void* pTexture);
+    static void DestroyTexture(void* pTexture);
+    static bool SetTargetTexture(void* pTexture);
+
+    static bool BeginScaledRender(const float scale);
+    static void EndScaledRender();
+    static void ReleaseScaledTarget();
+
+    static void* GetPendingTexturePlaceholder(Vec2Int& sizeOut);
+    static bool IsPendingTexturePlaceholder(const void* pTexture);
+    static void ReleasePendingTexturePlaceholder();
+
+    static void EndFrame();
+    static const mcp::RenderStats& GetLastFrameStats();
+    static const mcp::RenderStats& GetCurrentFrameStats();
+    static void InvalidateStateCache();
+
+    static bool ReadPixels(std::vector<uint8_t>& outPixels, Vec2Int& outSize);
+    static bool SavePixels(const char* pFilepath, std::vector<uint8_t>& pixels, const Vec2Int& size);
 };
@@ -2,6 +2,9 @@
 
 #include "MCP/Core/Resource/ResourceManager.h"
 
+#include <algorithm>
+#include <memory>
+
 #pragma warning(push)
 #pragma warning(disable : 26819)
 #include <SDL_image.h>
@@ -11,10 +14,15 @@
 #pragma warning(pop)
 
 #include "MCP/Core/Application/Window/WindowBase.h"
+#include "Platform/SDL2/SDLAudio.h"
 #include "Platform/SDL2/SDLHelpers.h"
+#include "Platform/SDL2/SDLRenderer.h"
+#include "MCP/Graphics/CookedTexture.h"
 #include "MCP/Graphics/Graphics.h"
+#include "MCP/Graphics/RenderCapture.h"
 #include "MCP/Graphics/Texture.h"
 #include "MCP/Core/Resource/Font.h"
+#include "MCP/Core/Resource/PackageStream.h"
 #include "MCP/Audio/AudioResource.h"
 
 namespace mcp
@@ -24,75 +32,341 @@ namespace mcp
     //      SDL_TEXTURES
     //--------------------------------------------------------------------------------------------------------
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : A decoded image that is waiting to be uploaded.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    struct DecodedImage
+    {
+        SDL_Surface* pSurface = nullptr;
+        bool isPremultiplied = false;
+        double decompressMs = 0.0;      // Time spent decompressing the package entry, if it was decoded from a stream.
+    };
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      There is no decode step: the pixels are copied (or LZ decompressed) straight into the surface. If canReferenceData
+    //      is true and the pixels are stored, the surface points at the data instead, so the data must outlive the surface.
+    //
+    ///		@brief : Create a surface from a cooked texture (see CookedTexture.h).
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static DecodedImage CreateSurfaceFromCookedTexture(const char* pData, const size_t dataSize, const bool canReferenceData)
+    {
+        CookedTextureHeader header;
+        if (!ReadCookedTextureHeader(pData, dataSize, header))
+            return {};
+
+        const int width = static_cast<int>(header.width);
+        const int height = static_cast<int>(header.height);
+        const bool isPremultiplied = header.format == static_cast<uint8_t>(CookedPixelFormat::kRGBA8Premultiplied);
+
+        if (canReferenceData && header.codec == static_cast<uint8_t>(PackageCodec::kStore))
+        {
+            // SDL doesn't write to the pixels of a surface it only uploads.
+            auto* pPixels = const_cast<char*>(pData + sizeof(CookedTextureHeader));
+            return {SDL_CreateRGBSurfaceWithFormatFrom(pPixels, width, height, 32, static_cast<int>(header.pitch), SDL_PIXELFORMAT_RGBA32), isPremultiplied};
+        }
+
+        SDL_Surface* pSurface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!pSurface)
+            return {};
+
+        if (!DecodeCookedTexture(header, pData, pSurface->pixels, static_cast<size_t>(pSurface->pitch)))
+        {
+            MCP_ERROR("SDL", "Failed to decompress cooked texture pixels!");
+            SDL_FreeSurface(pSurface);
+            return {};
+        }
+
+        return {pSurface, isPremultiplied};
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Decode an image from memory. Cooked textures are found by their signature, anything else goes to SDL_image.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static DecodedImage DecodeImage(const char* pData, const size_t dataSize, const bool canReferenceData)
+    {
+        if (IsCookedTexture(pData, dataSize))
+            return CreateSurfaceFromCookedTexture(pData, dataSize, canReferenceData);
+
+        SDL_RWops* pSdlData = SDL_RWFromConstMem(pData, static_cast<int>(dataSize));
+        if (!pSdlData)
+            return {};
+
+        // Passing 1 frees the SDL_RWops when we are done.
+        return {IMG_Load_RW(pSdlData, 1), false};
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Decode an image from an SDL_RWops, which is closed when we are done. Cooked textures are found by their
+    ///             signature, anything else goes to SDL_image.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static DecodedImage DecodeImageRW(SDL_RWops* pSource)
+    {
+        if (!pSource)
+            return {};
+
+        uint32_t signature = 0;
+        const bool isCooked = SDL_RWread(pSource, &signature, sizeof(signature), 1) == 1 && signature == kCookedTextureSignature;
+        SDL_RWseek(pSource, 0, RW_SEEK_SET);
+
+        if (!isCooked)
+            return {IMG_Load_RW(pSource, 1), false};
+
+        std::vector<char> data(static_cast<size_t>(std::max<Sint64>(SDL_RWsize(pSource), 0)));
+        const bool wasRead = !data.empty() && SDL_RWread(pSource, data.data(), data.size(), 1) == 1;
+        SDL_RWclose(pSource);
+
+        if (!wasRead)
+            return {};
+
+        return CreateSurfaceFromCookedTexture(data.data(), data.size(), false);
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Decode an image file. Cooked textures are found by their signature, anything else goes to SDL_image.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static DecodedImage DecodeImageFile(const char* pPath)
+    {
+        return DecodeImageRW(SDL_RWFromFile(pPath, "rb"));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      If the entry is in memory, it is decoded from there. Otherwise, SDL_image reads the entry as it is inflated.
+    //
+    ///		@brief : Decode an image from a package stream. The stream is not freed.
+    ///		@param canReferenceData : If true, the stream outlives the decoded surface, so stored cooked pixels are not copied.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static DecodedImage DecodeImageStream(PackageStream* pStream, const bool canReferenceData)
+    {
+        if (const char* pData = pStream->GetData())
+            return DecodeImage(pData, static_cast<size_t>(pStream->GetSize()), canReferenceData);
+
+        return DecodeImageRW(CreatePackageRWops(pStream, false));
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Premultiplied textures need their own blend mode, or their edges are darkened twice.
+    //
+    ///		@brief : Upload a decoded image to a texture. The surface is freed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static SDL_Texture* CreateTextureFromImage(const DecodedImage& image, Vec2Int& sizeOut)
+    {
+        auto* pTexture = CreateTextureFromSurface(image.pSurface, sizeOut);
+
+        if (pTexture && image.isPremultiplied)
+            SDL_SetTextureBlendMode(pTexture, GetPremultipliedBlendMode());
+
+        return pTexture;
+    }
+
     template <>
     TextureData* ResourceContainer<TextureData, DiskResourceRequest>::LoadFromDiskImpl(const DiskResourceRequest& request)
     {
-        SDL_Surface* pSurface = IMG_Load(request.path.GetCStr());
+        const DecodedImage image = DecodeImageFile(request.path.GetCStr());
 
-        if (!pSurface)
+        if (!image.pSurface)
         {
             MCP_ERROR("SDL", "Failed to Load SDL_Surface at filepath: ", request.path.GetCStr(), ". SDL_Error: ", SDL_GetError());
             return nullptr;
         }
 
         Vec2Int sizeOut = {};
-        auto* pTexture = CreateTextureFromSurface(pSurface, sizeOut);
+        auto* pTexture = CreateTextureFromImage(image, sizeOut);
+        RenderCapture::RegisterTexture(pTexture, request);
 
         return BLEACH_NEW(TextureData(pTexture, sizeOut.x, sizeOut.y));
     }
 
     template <>
-    TextureData* ResourceContainer<TextureData, DiskResourceRequest>::LoadFromRawDataImpl(char* pRawData, const int dataSize, [[maybe_unused]] const DiskResourceRequest& request)
+    TextureData* ResourceContainer<TextureData, DiskResourceRequest>::LoadFromStreamImpl(PackageStream* pStream, const DiskResourceRequest& request)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        // TODO: Check for nullptr.
-
-        SDL_Surface* pSurface = IMG_Load_RW(pSdlData, 0);
+        // The stream is freed after the upload, so stored cooked pixels can be uploaded without a copy.
+        const DecodedImage image = DecodeImageStream(pStream, true);
 
-        if (!pSurface)
+        if (!image.pSurface)
         {
-            MCP_ERROR("SDL", "Failed to Load SDL_Surface from raw data! SDL_Error: ", SDL_GetError());
+            MCP_ERROR("SDL", "Failed to Load SDL_Surface from package: ", request.path.GetCStr(), ". SDL_Error: ", SDL_GetError());
+            BLEACH_DELETE(pStream);
             return nullptr;
         }
 
         Vec2Int sizeOut = {};
-        auto* pTexture = CreateTextureFromSurface(pSurface, sizeOut);
+        auto* pTexture = CreateTextureFromImage(image, sizeOut);
+        BLEACH_DELETE(pStream);
+        RenderCapture::RegisterTexture(pTexture, request);
 
         return BLEACH_NEW(TextureData(pTexture, sizeOut.x, sizeOut.y));
     }
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The decode (IMG_Load, or the copy of a cooked texture) runs on a worker thread, and only produces an SDL_Surface.
+    //      Creating the SDL_Texture has to happen on the main thread, since the renderer is not thread-safe. The TextureData is
+    //      updated in place when the upload completes, so every Texture that references it will start drawing the real image.
+    //
+    ///		@brief : Create a placeholder TextureData and submit the job to decode and upload the image.
+    ///		@param request : Request of the image. The path is used for loading if there is no stream, and for error messages.
+    ///		@param pStream : Stream of the image's package entry. If null, the image is loaded from the path.
+    ///		@param priority : Priority of the decode and upload jobs.
+    ///		@param onComplete : Called at the end of the upload, with whether the texture was created, and the time spent
+    ///             decompressing the stream.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    static TextureData* SubmitTextureLoad(const DiskResourceRequest& request, std::shared_ptr<PackageStream>&& pStream, const LoadPriority priority, std::function<void(const bool, const double)>&& onComplete)
+    {
+        const char* pPath = request.path.GetCStr();
+
+        Vec2Int placeholderSize;
+        auto* pPlaceholder = SdlRenderer::GetPendingTexturePlaceholder(placeholderSize);
+        auto* pTextureData = BLEACH_NEW(TextureData(pPlaceholder, placeholderSize.x, placeholderSize.y));
+
+        auto decode = [path = std::string(pPath), pStream = std::move(pStream)]() mutable -> void*
+        {
+            // The stream is freed as soon as we are done with it, so cooked pixels are always copied into the surface.
+            DecodedImage image = pStream ? DecodeImageStream(pStream.get(), false) : DecodeImageFile(path.c_str());
+            if (pStream)
+                image.decompressMs = pStream->GetDecodeMs();
+
+            pStream.reset();
+
+            if (!image.pSurface)
+                return nullptr;
+
+            return BLEACH_NEW(DecodedImage(image));
+        };
+
+        auto upload = [pTextureData, request, onComplete = std::move(onComplete)](void* pDecodedData)
+        {
+            pTextureData->pendingJob = nullptr;
+
+            // SDL's error string is per-thread, so we can't report the decode error here.
+            if (!pDecodedData)
+            {
+                MCP_ERROR("SDL", "Failed to decode SDL_Surface at filepath: ", request.path.GetCStr());
+                onComplete(false, 0.0);
+                return;
+            }
+
+            auto* pImage = static_cast<DecodedImage*>(pDecodedData);
+            const double decompressMs = pImage->decompressMs;
+            Vec2Int sizeOut = {};
+            auto* pTexture = CreateTextureFromImage(*pImage, sizeOut);
+            BLEACH_DELETE(pImage);
+
+            if (!pTexture)
+            {
+                onComplete(false, decompressMs);
+                return;
+            }
+
+            RenderCapture::RegisterTexture(pTexture, request);
+            pTextureData->pTexture = pTexture;
+            pTextureData->width = sizeOut.x;
+            pTextureData->height = sizeOut.y;
+            onComplete(true, decompressMs);
+        };
+
+        auto discard = [](void* pDecodedData)
+        {
+            auto* pImage = static_cast<DecodedImage*>(pDecodedData);
+            SDL_FreeSurface(pImage->pSurface);
+            BLEACH_DELETE(pImage);
+        };
+
+        pTextureData->pendingJob = ResourceManager::Get()->GetAsyncLoader().Submit(std::move(decode), std::move(upload), std::move(discard), priority);
+        if (!pTextureData->pendingJob)
+        {
+            BLEACH_DELETE(pTextureData);
+            return nullptr;
+        }
+
+        return pTextureData;
+    }
+
+    template <>
+    TextureData* ResourceContainer<TextureData, DiskResourceRequest>::LoadFromDiskAsyncImpl(const DiskResourceRequest& request, const LoadPriority priority, CompleteFunc&& onComplete)
+    {
+        return SubmitTextureLoad(request, nullptr, priority, std::move(onComplete));
+    }
+
+    template <>
+    TextureData* ResourceContainer<TextureData, DiskResourceRequest>::LoadFromStreamAsyncImpl(PackageStream* pStream, const DiskResourceRequest& request, const LoadPriority priority, CompleteFunc&& onComplete)
+    {
+        // The decode job's lambda has to be copyable, so it shares the stream.
+        std::shared_ptr<PackageStream> pSharedStream(pStream, [](PackageStream* pStreamToFree) { BLEACH_DELETE(pStreamToFree); });
+        return SubmitTextureLoad(request, std::move(pSharedStream), priority, std::move(onComplete));
+    }
+
+    template <>
+    void ResourceContainer<TextureData, DiskResourceRequest>::FinishAsyncLoadImpl(TextureData* pTextureData)
+    {
+        // The upload clears the pending job, so we complete a copy of the handle.
+        const AsyncJobHandle job = pTextureData->pendingJob;
+        ResourceManager::Get()->GetAsyncLoader().Complete(job);
+    }
+
     template<>
     void ResourceContainer<TextureData, DiskResourceRequest>::FreeResourceImpl(TextureData* pTextureData)
     {
-        SDL_DestroyTexture(static_cast<SDL_Texture*>(pTextureData->pTexture));
+        // If we are still loading, the job will throw away the decoded image.
+        AsyncResourceLoader::Cancel(pTextureData->pendingJob);
+
+        // The placeholder is shared, so only destroy the texture if it is our own.
+        if (!SdlRenderer::IsPendingTexturePlaceholder(pTextureData->pTexture))
+        {
+            RenderCapture::UnregisterTexture(pTextureData->pTexture);
+            SdlRenderer::DestroyTexture(pTextureData->pTexture);
+        }
+
         BLEACH_DELETE(pTextureData);
         pTextureData = nullptr;
     }
+
+    template<>
+    ResourceMemoryUsage ResourceContainer<TextureData, DiskResourceRequest>::GetMemoryUsageImpl(const TextureData* pTextureData) const
+    {
+        // Every texture is created as 32 bits per pixel.
+        return {sizeof(TextureData), static_cast<size_t>(pTextureData->width) * static_cast<size_t>(pTextureData->height) * 4};
+    }
+
+    template<>
+    const char* ResourceContainer<TextureData, DiskResourceRequest>::GetTypeNameImpl() const
+    {
+        return "Texture";
+    }
 #endif
 
     //--------------------------------------------------------------------------------------------------------
     //      AUDIO RESOURCE DATA
     //--------------------------------------------------------------------------------------------------------
 
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Chunks are converted to the device's format here, once, instead of every time that they are mixed.
+    //
+    ///		@brief : Load a chunk from disk.
+    //-----------------------------------------------------------------------------------------------------------------------------
     Mix_Chunk* LoadMixChunk(const char* pPath)
     {
-        auto* pChunk = Mix_LoadWAV(pPath);
+        auto* pChunk = static_cast<Mix_Chunk*>(SDLAudioManager::LoadClip(SDL_RWFromFile(pPath, "rb"), true));
         if (!pChunk)
         {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk at filepath: ", pPath);
+            MCP_ERROR("SDL", "Failed to load Mix_Chunk at filepath: ", pPath, ". Mix_Error: ", Mix_GetError());
             return nullptr;
         }
 
         return pChunk;
     }
 
-    Mix_Chunk* LoadMixChunkRaw(void* pRawData, const int dataSize)
+    Mix_Chunk* LoadMixChunkStream(PackageStream* pStream)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        auto* pChunk = Mix_LoadWAV_RW(pSdlData, 0);
+        // Passing 1 closes the SDL_RWops, which frees the stream, once the chunk has been decoded.
+        SDL_RWops* pSdlData = CreatePackageRWops(pStream, true);
+        auto* pChunk = static_cast<Mix_Chunk*>(SDLAudioManager::LoadClip(pSdlData, true));
         if (!pChunk)
         {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk from data! SDL_Error: ", Mix_GetError());
+            MCP_ERROR("SDL", "Failed to load Mix_Chunk from package stream! SDL_Error: ", Mix_GetError());
             return nullptr;
         }
 
@@ -111,13 +385,20 @@ namespace mcp
         return pMusic;
     }
 
-    Mix_Music* LoadMixMusicRaw(void* pRawData, const int dataSize)
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      SDL_mixer reads music as it plays, on the audio thread. The music owns the SDL_RWops, so the stream is freed with
+    //      Mix_FreeMusic(), and the track never has to be held in memory.
+    //
+    ///		@brief : Open music that is streamed from a package.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    Mix_Music* LoadMixMusicStream(PackageStream* pStream)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        auto* pMusic = Mix_LoadMUS_RW(pSdlData, 0);
+        SDL_RWops* pSdlData = CreatePackageRWops(pStream, true);
+        auto* pMusic = pSdlData ? Mix_LoadMUS_RW(pSdlData, 1) : nullptr;
         if (!pMusic)
         {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk from data! SDL_Error: ", Mix_GetError());
+            MCP_ERROR("SDL", "Failed to load Mix_Music from package stream! SDL_Error: ", Mix_GetError());
             return nullptr;
         }
 
@@ -150,11 +431,11 @@ namespace mcp
     }
 
     template <>
-    AudioResourceData* ResourceContainer<AudioResourceData, AudioResourceRequest>::LoadFromRawDataImpl(char* pRawData, const int dataSize, const AudioResourceRequest& request)
+    AudioResourceData* ResourceContainer<AudioResourceData, AudioResourceRequest>::LoadFromStreamImpl(PackageStream* pStream, const AudioResourceRequest& request)
     {
         if (request.isMusicResource)
         {
-            auto* pResource = LoadMixChunkRaw(pRawData, dataSize);
+            auto* pResource = LoadMixMusicStream(pStream);
             if (!pResource)
                 return nullptr;
 
@@ -164,7 +445,7 @@ namespace mcp
             return pResourceData;
         }
 
-        auto* pResource = LoadMixChunkRaw(pRawData, dataSize);
+        auto* pResource = LoadMixChunkStream(pStream);
         if (!pResource)
                 return nullptr;
 
@@ -191,6 +472,22 @@ namespace mcp
         pResourceData = nullptr;
     }
 
+    template <>
+    ResourceMemoryUsage ResourceContainer<AudioResourceData, AudioResourceRequest>::GetMemoryUsageImpl(const AudioResourceData* pResourceData) const
+    {
+        // Music is streamed, so we can't know how much memory it will use.
+        if (pResourceData->isMusicResource)
+            return {};
+
+        return {static_cast<const Mix_Chunk*>(pResourceData->pResource)->alen, 0};
+    }
+
+    template <>
+    const char* ResourceContainer<AudioResourceData, AudioResourceRequest>::GetTypeNameImpl() const
+    {
+        return "AudioResource";
+    }
+
     //--------------------------------------------------------------------------------------------------------
     //      MIX_CHUNK
     //--------------------------------------------------------------------------------------------------------
@@ -198,28 +495,13 @@ namespace mcp
     template <>
     Mix_Chunk* ResourceContainer<Mix_Chunk, DiskResourceRequest>::LoadFromDiskImpl(const DiskResourceRequest& request)
     {
-        auto* pChunk = Mix_LoadWAV(request.path.GetCStr());
-        if (!pChunk)
-        {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk at filepath: ", request.path.GetCStr());
-            return nullptr;
-        }
-
-        return pChunk;
+        return LoadMixChunk(request.path.GetCStr());
     }
 
     template <>
-    Mix_Chunk* ResourceContainer<Mix_Chunk, DiskResourceRequest>::LoadFromRawDataImpl(char* pRawData, const int dataSize, [[maybe_unused]] const DiskResourceRequest& request)
+    Mix_Chunk* ResourceContainer<Mix_Chunk, DiskResourceRequest>::LoadFromStreamImpl(PackageStream* pStream, [[maybe_unused]] const DiskResourceRequest& request)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        auto* pChunk = Mix_LoadWAV_RW(pSdlData, 0);
-        if (!pChunk)
-        {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk from data! SDL_Error: ", Mix_GetError());
-            return nullptr;
-        }
-
-        return pChunk;
+        return LoadMixChunkStream(pStream);
     }
 
     template <>
@@ -228,6 +510,18 @@ namespace mcp
         Mix_FreeChunk(pChunk);
     }
 
+    template <>
+    ResourceMemoryUsage ResourceContainer<Mix_Chunk, DiskResourceRequest>::GetMemoryUsageImpl(const Mix_Chunk* pChunk) const
+    {
+        return {pChunk->alen, 0};
+    }
+
+    template <>
+    const char* ResourceContainer<Mix_Chunk, DiskResourceRequest>::GetTypeNameImpl() const
+    {
+        return "AudioClip";
+    }
+
     //--------------------------------------------------------------------------------------------------------
     //      MIX_MUSIC
     //--------------------------------------------------------------------------------------------------------
@@ -246,17 +540,9 @@ namespace mcp
     }
 
     template <>
-    Mix_Music* ResourceContainer<Mix_Music, DiskResourceRequest>::LoadFromRawDataImpl(char* pRawData, const int dataSize, [[maybe_unused]] const DiskResourceRequest& request)
+    Mix_Music* ResourceContainer<Mix_Music, DiskResourceRequest>::LoadFromStreamImpl(PackageStream* pStream, [[maybe_unused]] const DiskResourceRequest& request)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        auto* pMusic = Mix_LoadMUS_RW(pSdlData, 0);
-        if (!pMusic)
-        {
-            MCP_ERROR("SDL", "Failed to load Mix_Chunk from data! SDL_Error: ", Mix_GetError());
-            return nullptr;
-        }
-
-        return pMusic;
+        return LoadMixMusicStream(pStream);
     }
 
     template <>
@@ -265,6 +551,19 @@ namespace mcp
         Mix_FreeMusic(pFont);
     }
 
+    template <>
+    ResourceMemoryUsage ResourceContainer<Mix_Music, DiskResourceRequest>::GetMemoryUsageImpl([[maybe_unused]] const Mix_Music* pMusic) const
+    {
+        // Music is streamed, so we can't know how much memory it will use. It is never cached.
+        return {};
+    }
+
+    template <>
+    const char* ResourceContainer<Mix_Music, DiskResourceRequest>::GetTypeNameImpl() const
+    {
+        return "AudioTrack";
+    }
+
     //--------------------------------------------------------------------------------------------------------
     //      TTF_FONTS
     //--------------------------------------------------------------------------------------------------------
@@ -323,13 +622,14 @@ namespace mcp
     }
 
     template <>
-    FontData* ResourceContainer<FontData, FontResourceRequest>::LoadFromRawDataImpl(char* pRawData, const int dataSize, const FontResourceRequest& request)
+    FontData* ResourceContainer<FontData, FontResourceRequest>::LoadFromStreamImpl(PackageStream* pStream, const FontResourceRequest& request)
     {
-        SDL_RWops* pSdlData = SDL_RWFromMem(pRawData, dataSize);
-        auto* pFont = TTF_OpenFontRW(pSdlData, 0, request.fontSize);
+        // SDL_ttf reads glyphs from the font file as they are needed, so the font owns the stream until it is closed.
+        SDL_RWops* pSdlData = CreatePackageRWops(pStream, true);
+        auto* pFont = pSdlData ? TTF_OpenFontRW(pSdlData, 1, request.fontSize) : nullptr;
         if (!pFont)
         {
-            MCP_ERROR("SDL", "Failed to load TTF_Font from raw data! TTF_Error: ", TTF_GetError());
+            MCP_ERROR("SDL", "Failed to load TTF_Font from package stream! TTF_Error: ", TTF_GetError());
             return nullptr;
         }
 
@@ -366,11 +666,36 @@ namespace mcp
             if (!pTextureData)
                 continue;
 
-            SDL_DestroyTexture(static_cast<SDL_Texture*>(pTextureData->pTexture));
+            SdlRenderer::DestroyTexture(pTextureData->pTexture);
             BLEACH_DELETE(pTextureData);
             pTextureData = nullptr;
         }
 
         BLEACH_DELETE(pFont);
     }
+
+    template <>
+    ResourceMemoryUsage ResourceContainer<FontData, FontResourceRequest>::GetMemoryUsageImpl(const FontData* pFont) const
+    {
+        // The glyph textures are most of the cost. TTF_Font's own memory is small, and its file data is streamed from the package.
+        ResourceMemoryUsage usage;
+        usage.cpuBytes = sizeof(FontData) + pFont->m_glyphTextures.capacity() * sizeof(TextureData*);
+
+        for (const auto* pTextureData : pFont->m_glyphTextures)
+        {
+            if (pTextureData)
+            {
+                usage.cpuBytes += sizeof(TextureData);
+                usage.gpuBytes += static_cast<size_t>(pTextureData->width) * static_cast<size_t>(pTextureData->height) * 4;
+            }
+        }
+
+        return usage;
+    }
+
+    template <>
+    const char* ResourceContainer<FontData, FontResourceRequest>::GetTypeNameImpl() const
+    {
+        return "Font";
+    }
 }
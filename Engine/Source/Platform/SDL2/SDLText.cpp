@@ -10,6 +10,7 @@
 #include "SDLText.h"
 
 #include "SDLHelpers.h"
+#include "SDLRenderer.h"
 #include "MCP/Debug/Assert.h"
 
 void SetFontSize(TTF_Font* pFont, const int size)
@@ -94,5 +95,5 @@ int GetCursorDistance(_TTF_Font* pFont, const uint32_t glyph)
 
 void FreeTextTexture(SDL_Texture* pTexture)
 {
-    SDL_DestroyTexture(pTexture);
+    SdlRenderer::DestroyTexture(pTexture);
 }
\ No newline at end of file
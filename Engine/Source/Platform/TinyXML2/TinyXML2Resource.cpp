@@ -36,4 +36,17 @@ namespace mcp
         pDoc->Clear();
         BLEACH_DELETE(pDoc);
     }
+
+    template <>
+    ResourceMemoryUsage ResourceContainer<tinyxml2::XMLDocument, DiskResourceRequest>::GetMemoryUsageImpl([[maybe_unused]] const tinyxml2::XMLDocument* pDoc) const
+    {
+        // tinyxml2 doesn't report how much memory a document uses, so documents are never cached.
+        return {};
+    }
+
+    template <>
+    const char* ResourceContainer<tinyxml2::XMLDocument, DiskResourceRequest>::GetTypeNameImpl() const
+    {
+        return "XMLDocument";
+    }
 }
@@ -0,0 +1,398 @@
+// Main.cpp
+//
+// Writes a native asset package (see PackageFormat.h) from a list of files and directories. Directories are added
+// recursively. Each asset is named by its path as given, with forward slashes, so run the packer from the directory that the
+// game loads assets relative to (ex: 'AssetPacker Game.mcpak Assets' names an asset 'Assets/Images/Player.png').
+//
+// Codecs:
+//      auto  : Already compressed formats (images, audio, LZ cooked textures) are stored. Everything else uses the LZ codec,
+//              unless it saves less than 10%, in which case it is stored. This is the default.
+//      store : Nothing is compressed.
+//      zlib  : Deflate everything that gets smaller. Slower to load, but smaller on disk.
+//      lz    : Use the LZ codec for everything that gets smaller.
+//
+// Usage: AssetPacker <output> <file or directory>... [--codec=auto|store|zlib|lz]
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#define ZLIB_WINAPI
+#include <zlib.h>
+#include "MCP/Core/Resource/AssetPackage.h"
+#include "MCP/Core/Resource/LzCodec.h"
+#include "MCP/Core/Resource/PackageFormat.h"
+#include "MCP/Graphics/CookedTexture.h"
+#include "Utility/Generic/Hash.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    enum class CodecOption
+    {
+        kAuto,
+        kStore,
+        kZlib,
+        kLz,
+    };
+
+    struct InputFile
+    {
+        std::string name;
+        fs::path path;
+        uint64_t pathHash = 0;
+        uint32_t size = 0;
+        uint32_t checksum = 0;
+        size_t uniqueIndex = 0;     // Index of the stored data this file uses.
+    };
+
+    struct UniqueData
+    {
+        size_t firstFile = 0;       // The file that this data was read from.
+        uint64_t offset = 0;
+        uint32_t storedSize = 0;
+        mcp::PackageCodec codec = mcp::PackageCodec::kStore;
+    };
+
+    bool ReadFile(const fs::path& path, std::vector<uint8_t>& data)
+    {
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.string().c_str(), "rb") != 0 || !pFile)
+            return false;
+
+        std::error_code error;
+        const auto size = fs::file_size(path, error);
+        data.resize(error ? 0 : static_cast<size_t>(size));
+
+        const bool succeeded = !error && (data.empty() || fread(data.data(), data.size(), 1, pFile) == 1);
+        fclose(pFile);
+        return succeeded;
+    }
+
+    bool Write(FILE* pFile, const void* pData, const size_t size)
+    {
+        return size == 0 || fwrite(pData, size, 1, pFile) == 1;
+    }
+
+    bool WriteZeros(FILE* pFile, size_t count)
+    {
+        static constexpr uint8_t kZeros[mcp::kPackageAlignment] = {};
+
+        while (count > 0)
+        {
+            const size_t toWrite = std::min(count, sizeof(kZeros));
+            if (!Write(pFile, kZeros, toWrite))
+                return false;
+
+            count -= toWrite;
+        }
+
+        return true;
+    }
+
+    uint64_t AlignUp(const uint64_t value)
+    {
+        return (value + mcp::kPackageAlignment - 1) / mcp::kPackageAlignment * mcp::kPackageAlignment;
+    }
+
+    bool IsAlreadyCompressed(const fs::path& path, const std::vector<uint8_t>& data)
+    {
+        // Cooked textures keep the source image's name, so check the data instead of the extension.
+        if (mcp::IsCookedTexture(data.data(), data.size()))
+        {
+            mcp::CookedTextureHeader header;
+            std::memcpy(&header, data.data(), sizeof(header));
+            return header.codec != static_cast<uint8_t>(mcp::PackageCodec::kStore);
+        }
+
+        static constexpr const char* kCompressedExtensions[] = { ".png", ".jpg", ".jpeg", ".webp", ".ogg", ".mp3", ".flac", ".zip", ".mcpak" };
+
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const char c) { return static_cast<char>(std::tolower(c)); });
+
+        return std::any_of(std::begin(kCompressedExtensions), std::end(kCompressedExtensions), [&extension](const char* pExtension)
+        {
+            return extension == pExtension;
+        });
+    }
+
+    bool CompressZlib(const std::vector<uint8_t>& source, std::vector<uint8_t>& dest)
+    {
+        // Raw deflate, with no zlib header, just like a zip entry.
+        z_stream zStream{};
+        if (deflateInit2(&zStream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return false;
+
+        dest.resize(deflateBound(&zStream, static_cast<uLong>(source.size())));
+        zStream.next_in = const_cast<Bytef*>(source.data());
+        zStream.avail_in = static_cast<uInt>(source.size());
+        zStream.next_out = dest.data();
+        zStream.avail_out = static_cast<uInt>(dest.size());
+
+        const bool succeeded = deflate(&zStream, Z_FINISH) == Z_STREAM_END;
+        dest.resize(zStream.total_out);
+        deflateEnd(&zStream);
+        return succeeded;
+    }
+
+    bool CompressLz(const std::vector<uint8_t>& source, std::vector<uint8_t>& dest)
+    {
+        dest.resize(mcp::LzCompressBound(source.size()));
+        const size_t size = mcp::LzCompress(source.data(), source.size(), dest.data(), dest.size());
+        dest.resize(size);
+        return size > 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Encode the data with the codec that was asked for, falling back to storing it when that doesn't help.
+    ///		@returns : The data to write. Either 'source' or 'scratch'.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    const std::vector<uint8_t>& Encode(const std::vector<uint8_t>& source, const fs::path& path, const CodecOption option, std::vector<uint8_t>& scratch, mcp::PackageCodec& codecOut)
+    {
+        codecOut = mcp::PackageCodec::kStore;
+
+        if (option == CodecOption::kStore || source.empty() || (option == CodecOption::kAuto && IsAlreadyCompressed(path, source)))
+            return source;
+
+        const bool useZlib = option == CodecOption::kZlib;
+        if (!(useZlib ? CompressZlib(source, scratch) : CompressLz(source, scratch)))
+            return source;
+
+        // In auto, only compress when it is worth the cost of decoding.
+        const size_t maxSize = option == CodecOption::kAuto ? source.size() - source.size() / 10 : source.size() - 1;
+        if (scratch.size() > maxSize)
+            return source;
+
+        codecOut = useZlib ? mcp::PackageCodec::kZlib : mcp::PackageCodec::kLz;
+        return scratch;
+    }
+
+    bool AddInput(const fs::path& input, std::vector<InputFile>& files)
+    {
+        std::error_code error;
+        if (fs::is_directory(input, error))
+        {
+            for (const auto& item : fs::recursive_directory_iterator(input, error))
+            {
+                if (item.is_regular_file())
+                    files.push_back({ item.path().lexically_normal().generic_string(), item.path() });
+            }
+        }
+
+        else if (fs::is_regular_file(input, error))
+        {
+            files.push_back({ input.lexically_normal().generic_string(), input });
+        }
+
+        else
+        {
+            std::cout << "Input '" << input.string() << "' is not a file or directory!\n";
+            return false;
+        }
+
+        return !error;
+    }
+
+    bool Verify(const char* pOutputPath, const std::vector<InputFile>& files)
+    {
+        mcp::AssetPackage package;
+        if (!package.LoadPackage(pOutputPath))
+            return false;
+
+        for (const auto& file : files)
+        {
+            const mcp::RawData* pData = package.GetRawData(file.pathHash);
+            if (!pData || static_cast<uint32_t>(pData->size) != file.size
+                || crc32(0L, reinterpret_cast<const Bytef*>(pData->pData), static_cast<uInt>(pData->size)) != file.checksum)
+            {
+                std::cout << "Verify failed! '" << file.name << "' does not match the source file.\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: AssetPacker <output> <file or directory>... [--codec=auto|store|zlib|lz]\n";
+        return -1;
+    }
+
+    const char* pOutputPath = argv[1];
+    CodecOption codecOption = CodecOption::kAuto;
+    std::vector<InputFile> files;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--codec=", 8) == 0)
+        {
+            const std::string codec = argv[i] + 8;
+            if (codec == "auto") codecOption = CodecOption::kAuto;
+            else if (codec == "store") codecOption = CodecOption::kStore;
+            else if (codec == "zlib") codecOption = CodecOption::kZlib;
+            else if (codec == "lz") codecOption = CodecOption::kLz;
+            else
+            {
+                std::cout << "Unknown codec: " << codec << "\n";
+                return -1;
+            }
+
+            continue;
+        }
+
+        if (!AddInput(argv[i], files))
+            return -1;
+    }
+
+    if (files.empty())
+    {
+        std::cout << "No files to pack!\n";
+        return -1;
+    }
+
+    for (auto& file : files)
+        file.pathHash = HashString64(file.name.c_str());
+
+    // The table of contents is sorted by hash, so the runtime can binary search it. Two different paths with the same hash
+    // could never both be found, so that is an error.
+    std::sort(files.begin(), files.end(), [](const InputFile& left, const InputFile& right)
+    {
+        return left.pathHash < right.pathHash || (left.pathHash == right.pathHash && left.name < right.name);
+    });
+
+    for (size_t i = 1; i < files.size(); ++i)
+    {
+        if (files[i].pathHash == files[i - 1].pathHash)
+        {
+            if (files[i].name == files[i - 1].name)
+                std::cout << "'" << files[i].name << "' was added more than once!\n";
+            else
+                std::cout << "'" << files[i].name << "' and '" << files[i - 1].name << "' have the same path hash! Rename one of them.\n";
+
+            return -1;
+        }
+    }
+
+    FILE* pFile = nullptr;
+    if (fopen_s(&pFile, pOutputPath, "wb") != 0 || !pFile)
+    {
+        std::cout << "Failed to open '" << pOutputPath << "' for write.\n";
+        return -1;
+    }
+
+    // Leave room for the header and table of contents, which are written once the offsets are known.
+    const uint64_t tocSize = files.size() * sizeof(mcp::PackageTocEntry);
+    uint64_t offset = AlignUp(sizeof(mcp::PackageHeader) + tocSize);
+    bool succeeded = WriteZeros(pFile, static_cast<size_t>(offset));
+
+    std::vector<UniqueData> uniqueData;
+    std::unordered_multimap<uint64_t, size_t> contentToUnique;  // (checksum << 32 | size) -> index into uniqueData.
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> otherData;
+    std::vector<uint8_t> scratch;
+    uint64_t totalSize = 0;
+    size_t codecCounts[static_cast<size_t>(mcp::PackageCodec::kCount)] = {};
+
+    for (size_t i = 0; i < files.size() && succeeded; ++i)
+    {
+        auto& file = files[i];
+        if (!ReadFile(file.path, data) || data.size() > UINT32_MAX)
+        {
+            std::cout << "Failed to read '" << file.path.string() << "'.\n";
+            succeeded = false;
+            break;
+        }
+
+        file.size = static_cast<uint32_t>(data.size());
+        file.checksum = static_cast<uint32_t>(crc32(0L, data.data(), static_cast<uInt>(data.size())));
+        totalSize += file.size;
+
+        // If we have already written the same contents, point at that instead.
+        const uint64_t contentKey = (static_cast<uint64_t>(file.checksum) << 32) | file.size;
+        bool isDuplicate = false;
+
+        const auto [first, last] = contentToUnique.equal_range(contentKey);
+        for (auto it = first; it != last && !isDuplicate; ++it)
+        {
+            if (ReadFile(files[uniqueData[it->second].firstFile].path, otherData) && otherData == data)
+            {
+                file.uniqueIndex = it->second;
+                isDuplicate = true;
+            }
+        }
+
+        if (isDuplicate)
+            continue;
+
+        UniqueData unique;
+        unique.firstFile = i;
+
+        const auto& encoded = Encode(data, file.path, codecOption, scratch, unique.codec);
+
+        const uint64_t alignedOffset = AlignUp(offset);
+        succeeded = WriteZeros(pFile, static_cast<size_t>(alignedOffset - offset)) && Write(pFile, encoded.data(), encoded.size());
+
+        unique.offset = alignedOffset;
+        unique.storedSize = static_cast<uint32_t>(encoded.size());
+        offset = alignedOffset + encoded.size();
+
+        file.uniqueIndex = uniqueData.size();
+        contentToUnique.emplace(contentKey, uniqueData.size());
+        uniqueData.push_back(unique);
+        ++codecCounts[static_cast<size_t>(unique.codec)];
+    }
+
+    std::vector<mcp::PackageTocEntry> toc(files.size());
+    for (size_t i = 0; i < files.size() && succeeded; ++i)
+    {
+        const auto& unique = uniqueData[files[i].uniqueIndex];
+
+        toc[i].pathHash = files[i].pathHash;
+        toc[i].offset = unique.offset;
+        toc[i].storedSize = unique.storedSize;
+        toc[i].size = files[i].size;
+        toc[i].checksum = files[i].checksum;
+        toc[i].codec = static_cast<uint8_t>(unique.codec);
+    }
+
+    mcp::PackageHeader header;
+    header.signature = mcp::kPackageSignature;
+    header.version = mcp::kPackageVersion;
+    header.entryCount = static_cast<uint32_t>(files.size());
+    header.alignment = mcp::kPackageAlignment;
+    header.tocOffset = sizeof(mcp::PackageHeader);
+    header.tocChecksum = static_cast<uint32_t>(crc32(0L, reinterpret_cast<const Bytef*>(toc.data()), static_cast<uInt>(tocSize)));
+
+    succeeded = succeeded
+        && fseek(pFile, 0, SEEK_SET) == 0
+        && Write(pFile, &header, sizeof(header))
+        && Write(pFile, toc.data(), static_cast<size_t>(tocSize));
+
+    if (fclose(pFile) != 0 || !succeeded)
+    {
+        std::cout << "Failed to write package '" << pOutputPath << "'.\n";
+        return -1;
+    }
+
+    if (!Verify(pOutputPath, files))
+        return -1;
+
+    std::cout << "Packed " << files.size() << " files (" << uniqueData.size() << " unique) into '" << pOutputPath << "'\n"
+        << "    Source: " << totalSize << " bytes | Package: " << offset << " bytes\n"
+        << "    Stored: " << codecCounts[static_cast<size_t>(mcp::PackageCodec::kStore)]
+        << " | zlib: " << codecCounts[static_cast<size_t>(mcp::PackageCodec::kZlib)]
+        << " | LZ: " << codecCounts[static_cast<size_t>(mcp::PackageCodec::kLz)] << "\n";
+
+    return 0;
+}
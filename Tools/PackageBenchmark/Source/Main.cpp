@@ -0,0 +1,266 @@
+// Main.cpp
+//
+// Measures how fast an AssetPackage can be made resident with different numbers of threads. If the package doesn't exist,
+// a synthetic one is written first: a zip of deflated entries of mixed sizes, with every 8th entry stored, like the
+// already-compressed images and sounds in a real package.
+//
+// Usage: PackageBenchmark <package> [sizeMB] [entryCount] [iterations]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#define ZLIB_WINAPI
+#include <zlib.h>
+#include "MCP/Core/Resource/AssetPackage.h"
+#include "MCP/Core/Resource/Zip.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+namespace
+{
+    struct SyntheticEntry
+    {
+        std::string name;
+        uint32_t crc = 0;
+    };
+
+    // Small xorshift, so the package is the same every time.
+    uint32_t NextRandom(uint32_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Fill with words from a small dictionary and some noise, which deflates at roughly 3:1 like text and level data.
+    void FillEntryData(std::vector<uint8_t>& data, uint32_t& state)
+    {
+        static constexpr const char* kWords[] = { "tile ", "sprite ", "layer ", "collider ", "position ", "scale ", "0.5 ", "128 ", "<Object>", "</Object>\n" };
+        static constexpr size_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+        size_t i = 0;
+        while (i < data.size())
+        {
+            const uint32_t random = NextRandom(state);
+            if ((random & 7) == 0)
+            {
+                data[i++] = static_cast<uint8_t>(random >> 8);
+                continue;
+            }
+
+            for (const char* pChar = kWords[(random >> 8) % kWordCount]; *pChar && i < data.size(); ++pChar)
+                data[i++] = static_cast<uint8_t>(*pChar);
+        }
+    }
+
+    bool Write(FILE* pFile, const void* pData, const size_t size)
+    {
+        return size == 0 || fwrite(pData, size, 1, pFile) == 1;
+    }
+
+    bool WriteSyntheticPackage(const char* pPath, const size_t totalSize, const uint32_t entryCount, std::vector<SyntheticEntry>& entries)
+    {
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, pPath, "wb") != 0 || !pFile)
+        {
+            std::cout << "Failed to open '" << pPath << "' for write.\n";
+            return false;
+        }
+
+        std::vector<mcp::FileHeader> fileHeaders;
+        fileHeaders.reserve(entryCount);
+
+        const size_t averageSize = std::max<size_t>(totalSize / entryCount, 1);
+        uint32_t state = 0x12345678;
+        uint32_t offset = 0;
+        bool succeeded = true;
+
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> compressed;
+
+        for (uint32_t i = 0; i < entryCount && succeeded; ++i)
+        {
+            // Sizes range from a quarter to 1.75x the average, so the workers get uneven jobs.
+            data.resize(averageSize / 4 + NextRandom(state) % (averageSize * 3 / 2 + 1));
+            FillEntryData(data, state);
+
+            const bool isStored = (i % 8) == 7;
+            const uLong crc = crc32(0L, data.data(), static_cast<uInt>(data.size()));
+
+            const uint8_t* pEntryData = data.data();
+            size_t entrySize = data.size();
+
+            if (!isStored)
+            {
+                // Zip entries are raw deflate streams, with no zlib header.
+                z_stream zStream{};
+                deflateInit2(&zStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+                compressed.resize(deflateBound(&zStream, static_cast<uLong>(data.size())));
+
+                zStream.next_in = data.data();
+                zStream.avail_in = static_cast<uInt>(data.size());
+                zStream.next_out = compressed.data();
+                zStream.avail_out = static_cast<uInt>(compressed.size());
+                succeeded = deflate(&zStream, Z_FINISH) == Z_STREAM_END;
+
+                entrySize = zStream.total_out;
+                pEntryData = compressed.data();
+                deflateEnd(&zStream);
+            }
+
+            SyntheticEntry entry;
+            entry.name = "Synthetic/Entry_" + std::to_string(i) + ".bin";
+            entry.crc = static_cast<uint32_t>(crc);
+
+            mcp::DataHeader dataHeader;
+            dataHeader.signature = mcp::kDataSignature;
+            dataHeader.version = 20;
+            dataHeader.compression = isStored ? 0 : Z_DEFLATED;
+            dataHeader.crcCode = entry.crc;
+            dataHeader.compressedSize = static_cast<uint32_t>(entrySize);
+            dataHeader.uncompressedSize = static_cast<uint32_t>(data.size());
+            dataHeader.nameLength = static_cast<uint16_t>(entry.name.size());
+
+            mcp::FileHeader fileHeader;
+            fileHeader.signature = mcp::kFileSignature;
+            fileHeader.versionMade = 20;
+            fileHeader.versionNeeded = 20;
+            fileHeader.compression = dataHeader.compression;
+            fileHeader.crcCode = dataHeader.crcCode;
+            fileHeader.compressedSize = dataHeader.compressedSize;
+            fileHeader.uncompressedSize = dataHeader.uncompressedSize;
+            fileHeader.nameLength = dataHeader.nameLength;
+            fileHeader.dataOffset = offset;
+
+            succeeded = succeeded
+                && Write(pFile, &dataHeader, sizeof(dataHeader))
+                && Write(pFile, entry.name.data(), entry.name.size())
+                && Write(pFile, pEntryData, entrySize);
+
+            offset += static_cast<uint32_t>(sizeof(dataHeader) + entry.name.size() + entrySize);
+            fileHeaders.push_back(fileHeader);
+            entries.push_back(std::move(entry));
+        }
+
+        const uint32_t dirOffset = offset;
+        for (size_t i = 0; i < fileHeaders.size() && succeeded; ++i)
+        {
+            succeeded = Write(pFile, &fileHeaders[i], sizeof(mcp::FileHeader))
+                && Write(pFile, entries[i].name.data(), entries[i].name.size());
+
+            offset += static_cast<uint32_t>(sizeof(mcp::FileHeader) + entries[i].name.size());
+        }
+
+        mcp::ZipHeader zipHeader;
+        zipHeader.signature = mcp::kZipSignature;
+        zipHeader.numberOfFiles = static_cast<uint16_t>(fileHeaders.size());
+        zipHeader.totalFiles = zipHeader.numberOfFiles;
+        zipHeader.dirSize = offset - dirOffset;
+        zipHeader.dirOffset = dirOffset;
+
+        succeeded = succeeded && Write(pFile, &zipHeader, sizeof(zipHeader));
+
+        if (fclose(pFile) != 0 || !succeeded)
+        {
+            std::cout << "Failed to write the synthetic package to '" << pPath << "'.\n";
+            return false;
+        }
+
+        std::cout << "Wrote synthetic package '" << pPath << "' with " << entries.size() << " entries (" << offset / (1024 * 1024) << "MB on disk).\n";
+        return true;
+    }
+
+    bool VerifyEntries(mcp::AssetPackage& package, const std::vector<SyntheticEntry>& entries)
+    {
+        for (const auto& entry : entries)
+        {
+            const mcp::RawData* pData = package.GetRawData(entry.name.c_str());
+            if (!pData || crc32(0L, reinterpret_cast<const Bytef*>(pData->pData), static_cast<uInt>(pData->size)) != entry.crc)
+            {
+                std::cout << "Entry '" << entry.name << "' does not match the data that was written!\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: PackageBenchmark <package> [sizeMB] [entryCount] [iterations]\n";
+        return -1;
+    }
+
+    const char* pPackagePath = argv[1];
+    const size_t sizeMB = argc > 2 ? static_cast<size_t>(std::max(std::atoi(argv[2]), 1)) : 512;
+    const uint32_t entryCount = argc > 3 ? static_cast<uint32_t>(std::clamp(std::atoi(argv[3]), 1, 0xFFFF)) : 1024;
+    const int iterations = argc > 4 ? std::max(std::atoi(argv[4]), 1) : 3;
+
+    // Only write the package if it doesn't already exist, so the same package can be compared across builds.
+    std::vector<SyntheticEntry> entries;
+    FILE* pExisting = nullptr;
+    if (fopen_s(&pExisting, pPackagePath, "rb") == 0 && pExisting)
+    {
+        fclose(pExisting);
+    }
+
+    else if (!WriteSyntheticPackage(pPackagePath, sizeMB * 1024 * 1024, entryCount, entries))
+    {
+        return -1;
+    }
+
+    std::vector<unsigned> threadCounts;
+    const unsigned hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned count = 1; count < hardwareThreads; count *= 2)
+        threadCounts.push_back(count);
+
+    threadCounts.push_back(hardwareThreads);
+
+    double singleThreadMs = 0.0;
+    std::cout << "Threads | Best (ms) | MB/s | Speedup\n";
+
+    for (const unsigned threadCount : threadCounts)
+    {
+        double bestMs = 0.0;
+        size_t inflatedBytes = 0;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            mcp::AssetPackage package;
+            if (!package.LoadPackage(pPackagePath))
+                return -1;
+
+            HighPrecisionTimer timer;
+            timer.Start();
+            const bool succeeded = package.MakeResident(threadCount);
+            const double elapsedMs = timer.GetTimer();
+
+            if (!succeeded)
+                return -1;
+
+            // Check the data once, on the first run with the most threads.
+            if (threadCount == threadCounts.back() && i == 0 && !entries.empty() && !VerifyEntries(package, entries))
+                return -1;
+
+            inflatedBytes = package.GetCachedBytes();
+            if (i == 0 || elapsedMs < bestMs)
+                bestMs = elapsedMs;
+        }
+
+        if (threadCount == 1)
+            singleThreadMs = bestMs;
+
+        const double megabytesPerSecond = static_cast<double>(inflatedBytes) / (1024.0 * 1024.0) / (bestMs / 1000.0);
+        std::cout << threadCount << " | " << bestMs << " | " << megabytesPerSecond << " | " << singleThreadMs / bestMs << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+// Main.cpp
+//
+// Measures how long a ParticlePool takes to update a full pool of particles. When the engine is built with SSE2, the scalar
+// update is timed too, to show what the SIMD path saves.
+//
+// Usage: ParticleBenchmark [particleCount] [frameCount]
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include "MCP/Graphics/ParticlePool.h"
+
+int main(int argc, char** argv)
+{
+    const size_t particleCount = argc > 1 ? static_cast<size_t>(std::max(std::atoi(argv[1]), 1)) : 100000;
+    const size_t frameCount = argc > 2 ? static_cast<size_t>(std::max(std::atoi(argv[2]), 1)) : 300;
+
+    const auto result = mcp::ParticlePool::RunBenchmark(particleCount, frameCount);
+
+    std::cout << particleCount << " particles, " << frameCount << " frames\n";
+    std::cout << "Update | Avg (ms) | Min (ms) | ns / particle\n";
+
+    const auto printRow = [particleCount](const char* pName, const double averageMs, const double minMs)
+    {
+        std::cout << pName << " | " << averageMs << " | " << minMs << " | " << averageMs * 1000000.0 / static_cast<double>(particleCount) << '\n';
+    };
+
+    printRow(mcp::ParticlePool::IsSimdEnabled() ? "SSE2" : "Scalar", result.averageMs, result.minMs);
+
+    if (mcp::ParticlePool::IsSimdEnabled())
+    {
+        printRow("Scalar", result.scalarAverageMs, result.scalarMinMs);
+        std::cout << "Speedup: " << result.scalarAverageMs / result.averageMs << "x\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Main.cpp
+//
+// Replays a render capture written by Graphics.CaptureFrames() and reports how long each command took.
+// Run it from the game's directory, so that Config\ProjectSettings.xml and the captured texture paths resolve. The
+// project settings decide the Renderer backend, so setting <Renderer backend="Headless"/> runs the replay without a window.
+//
+// Usage: RenderReplay <capture> [iterations] [csvOutput] [gameSystems]
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include "MCP/Core/Application/Application.h"
+#include "MCP/Graphics/RenderReplay.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: RenderReplay <capture> [iterations] [csvOutput] [gameSystems]\n";
+        return -1;
+    }
+
+    const char* pCapturePath = argv[1];
+    const int iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 1;
+    const char* pCsvPath = argc > 3 ? argv[3] : nullptr;
+    const char* pGameSystemsPath = argc > 4 ? argv[4] : "";
+
+    mcp::ApplicationContext context;
+    context.args.count = static_cast<size_t>(argc);
+    context.args.args = argv;
+
+    mcp::Application::Create(context);
+    if (!mcp::Application::Get()->Init(pGameSystemsPath))
+    {
+        mcp::Application::Destroy();
+        return -1;
+    }
+
+    int result = 0;
+
+    // Scoped so that the replay's textures are released before the Renderer is closed.
+    {
+        mcp::RenderReplay replay;
+        if (replay.Load(pCapturePath) && replay.Run(static_cast<uint32_t>(iterations), pCsvPath))
+            replay.LogResults();
+        else
+            result = -1;
+    }
+
+    mcp::Application::Destroy();
+    return result;
+}
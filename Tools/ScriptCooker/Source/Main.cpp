@@ -0,0 +1,222 @@
+// Main.cpp
+//
+// Precompiles Lua scripts into Lua bytecode, so the game never has to compile them at runtime. Directories are added
+// recursively, and only .lua files are cooked. Each script is written to the output directory under its path as given, keeping
+// the source's file name, so the output directory can replace the source directory (or be packed with AssetPacker) without
+// changing any scene or script that refers to it. LuaContext loads bytecode and source the same way. Run the cooker from the
+// directory that the game loads scripts relative to.
+//
+// The bytecode is only valid for the Lua version that the engine is built with, so cook again whenever Lua is updated.
+//
+// Options:
+//      --strip : Remove debug info (line numbers and local names) from the bytecode. Smaller, but errors no longer say where
+//                in the script they happened.
+//
+// Usage: ScriptCooker <output directory> <file or directory>... [--strip]
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "LuaSource.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct InputScript
+    {
+        std::string name;
+        fs::path path;
+    };
+
+    bool ReadFile(const fs::path& path, std::vector<char>& data)
+    {
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.string().c_str(), "rb") != 0 || !pFile)
+            return false;
+
+        std::error_code error;
+        const auto size = fs::file_size(path, error);
+        data.resize(error ? 0 : static_cast<size_t>(size));
+
+        const bool succeeded = !error && (data.empty() || fread(data.data(), data.size(), 1, pFile) == 1);
+        fclose(pFile);
+        return succeeded;
+    }
+
+    bool WriteFile(const fs::path& path, const std::string& data)
+    {
+        std::error_code error;
+        if (path.has_parent_path())
+            fs::create_directories(path.parent_path(), error);
+
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.string().c_str(), "wb") != 0 || !pFile)
+            return false;
+
+        const bool succeeded = data.empty() || fwrite(data.data(), data.size(), 1, pFile) == 1;
+        return fclose(pFile) == 0 && succeeded;
+    }
+
+    bool IsScript(const fs::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const char c) { return static_cast<char>(std::tolower(c)); });
+
+        return extension == ".lua";
+    }
+
+    bool AddInput(const fs::path& input, std::vector<InputScript>& scripts)
+    {
+        std::error_code error;
+        if (fs::is_directory(input, error))
+        {
+            for (const auto& item : fs::recursive_directory_iterator(input, error))
+            {
+                if (item.is_regular_file() && IsScript(item.path()))
+                    scripts.push_back({ item.path().lexically_normal().generic_string(), item.path() });
+            }
+        }
+
+        else if (fs::is_regular_file(input, error))
+        {
+            scripts.push_back({ input.lexically_normal().generic_string(), input });
+        }
+
+        else
+        {
+            std::cout << "Input '" << input.string() << "' is not a file or directory!\n";
+            return false;
+        }
+
+        return !error;
+    }
+
+    int WriteBytecode([[maybe_unused]] lua_State* pState, const void* pData, const size_t size, void* pUserData)
+    {
+        static_cast<std::string*>(pUserData)->append(static_cast<const char*>(pData), size);
+        return 0;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      The chunk name matches the one that LuaContext gives scripts that it compiles itself, so error messages look the same
+    //      either way.
+    //
+    ///		@brief : Compile a script's source into bytecode.
+    ///		@returns : False if the script has a syntax error, which is printed.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    bool CompileScript(lua_State* pState, const InputScript& script, const std::vector<char>& source, const bool strip, std::string& bytecode)
+    {
+        const std::string chunkName = "@" + script.name;
+        if (luaL_loadbufferx(pState, source.data(), source.size(), chunkName.c_str(), "t") != LUA_OK)
+        {
+            std::cout << "Failed to compile '" << script.name << "': " << lua_tostring(pState, -1) << "\n";
+            lua_pop(pState, 1);
+            return false;
+        }
+
+        bytecode.clear();
+        const bool succeeded = lua_dump(pState, &WriteBytecode, &bytecode, strip ? 1 : 0) == 0;
+        lua_pop(pState, 1);
+        return succeeded;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: ScriptCooker <output directory> <file or directory>... [--strip]\n";
+        return -1;
+    }
+
+    const fs::path outputDirectory = argv[1];
+    bool strip = false;
+    std::vector<InputScript> scripts;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--strip") == 0)
+        {
+            strip = true;
+            continue;
+        }
+
+        if (!AddInput(argv[i], scripts))
+            return -1;
+    }
+
+    if (scripts.empty())
+    {
+        std::cout << "No scripts to cook!\n";
+        return -1;
+    }
+
+    // Compiling doesn't run anything, so the state doesn't need any libraries.
+    lua_State* pState = luaL_newstate();
+    if (!pState)
+    {
+        std::cout << "Failed to create a lua state!\n";
+        return -1;
+    }
+
+    std::vector<char> source;
+    std::string bytecode;
+    uint64_t sourceBytes = 0;
+    uint64_t cookedBytes = 0;
+    int result = 0;
+
+    for (const auto& script : scripts)
+    {
+        if (!ReadFile(script.path, source))
+        {
+            std::cout << "Failed to read '" << script.path.string() << "'.\n";
+            result = -1;
+            break;
+        }
+
+        // Text scripts can't start with the bytecode signature's escape character.
+        if (!source.empty() && source[0] == LUA_SIGNATURE[0])
+        {
+            std::cout << "'" << script.name << "' is already cooked! Cook from the source scripts.\n";
+            result = -1;
+            break;
+        }
+
+        const fs::path outputPath = outputDirectory / script.name;
+        std::error_code error;
+        if (fs::equivalent(outputPath, script.path, error))
+        {
+            std::cout << "Cooking '" << script.name << "' would overwrite the source script! Use a different output directory.\n";
+            result = -1;
+            break;
+        }
+
+        if (!CompileScript(pState, script, source, strip, bytecode) || !WriteFile(outputPath, bytecode))
+        {
+            std::cout << "Failed to cook '" << script.name << "' to '" << outputPath.string() << "'.\n";
+            result = -1;
+            break;
+        }
+
+        sourceBytes += source.size();
+        cookedBytes += bytecode.size();
+    }
+
+    lua_close(pState);
+
+    if (result != 0)
+        return result;
+
+    std::cout << "Cooked " << scripts.size() << " scripts into '" << outputDirectory.string() << "'\n"
+        << "    Source: " << sourceBytes << " bytes | Bytecode: " << cookedBytes << " bytes\n";
+
+    return 0;
+}
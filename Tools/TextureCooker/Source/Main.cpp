@@ -0,0 +1,369 @@
+// Main.cpp
+//
+// Converts source images into cooked textures (see CookedTexture.h), so the game can load them with no PNG decode.
+// Directories are added recursively. Each cooked texture is written to the output directory under its path as given, keeping
+// the source's file name, so the output directory can replace the source directory (or be packed with AssetPacker) without
+// changing any scene that requests the images. Run the cooker from the directory that the game loads assets relative to.
+//
+// Options:
+//      --codec=lz|store : Compress the pixels with the LZ codec (the default), or store them uncompressed.
+//      --premultiply    : Multiply the color channels by alpha. The engine draws these with a premultiplied blend mode.
+//      --benchmark      : Don't write anything. Instead, report how long the images take to load per megapixel from the
+//                         source file (SDL_image) and as cooked textures.
+//      --iterations=N   : Number of times each image is loaded in the benchmark. The best time is reported.
+//
+// Usage: TextureCooker <output directory> <file or directory>... [--codec=lz|store] [--premultiply]
+//        TextureCooker --benchmark <file or directory>... [--iterations=N]
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#define SDL_MAIN_HANDLED
+#pragma warning(push)
+#pragma warning(disable : 26819)
+#include <SDL_image.h>
+#pragma warning(pop)
+#include "MCP/Graphics/CookedTexture.h"
+#include "Utility/Time/HighPrecisionTimer.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct InputImage
+    {
+        std::string name;
+        fs::path path;
+    };
+
+    bool ReadFile(const fs::path& path, std::vector<uint8_t>& data)
+    {
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.string().c_str(), "rb") != 0 || !pFile)
+            return false;
+
+        std::error_code error;
+        const auto size = fs::file_size(path, error);
+        data.resize(error ? 0 : static_cast<size_t>(size));
+
+        const bool succeeded = !error && (data.empty() || fread(data.data(), data.size(), 1, pFile) == 1);
+        fclose(pFile);
+        return succeeded;
+    }
+
+    bool WriteFile(const fs::path& path, const std::vector<uint8_t>& data)
+    {
+        std::error_code error;
+        if (path.has_parent_path())
+            fs::create_directories(path.parent_path(), error);
+
+        FILE* pFile = nullptr;
+        if (fopen_s(&pFile, path.string().c_str(), "wb") != 0 || !pFile)
+            return false;
+
+        const bool succeeded = data.empty() || fwrite(data.data(), data.size(), 1, pFile) == 1;
+        return fclose(pFile) == 0 && succeeded;
+    }
+
+    bool IsImage(const fs::path& path)
+    {
+        static constexpr const char* kImageExtensions[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tga" };
+
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const char c) { return static_cast<char>(std::tolower(c)); });
+
+        return std::any_of(std::begin(kImageExtensions), std::end(kImageExtensions), [&extension](const char* pExtension)
+        {
+            return extension == pExtension;
+        });
+    }
+
+    bool AddInput(const fs::path& input, std::vector<InputImage>& images)
+    {
+        std::error_code error;
+        if (fs::is_directory(input, error))
+        {
+            for (const auto& item : fs::recursive_directory_iterator(input, error))
+            {
+                if (item.is_regular_file() && IsImage(item.path()))
+                    images.push_back({ item.path().lexically_normal().generic_string(), item.path() });
+            }
+        }
+
+        else if (fs::is_regular_file(input, error))
+        {
+            images.push_back({ input.lexically_normal().generic_string(), input });
+        }
+
+        else
+        {
+            std::cout << "Input '" << input.string() << "' is not a file or directory!\n";
+            return false;
+        }
+
+        return !error;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Decode a source image with SDL_image, and convert it to RGBA8.
+    ///		@returns : The converted surface, or nullptr if the image couldn't be loaded. Free with SDL_FreeSurface().
+    //-----------------------------------------------------------------------------------------------------------------------------
+    SDL_Surface* DecodeSourceImage(const std::vector<uint8_t>& fileData)
+    {
+        SDL_RWops* pSdlData = SDL_RWFromConstMem(fileData.data(), static_cast<int>(fileData.size()));
+        if (!pSdlData)
+            return nullptr;
+
+        SDL_Surface* pSurface = IMG_Load_RW(pSdlData, 1);
+        if (!pSurface || pSurface->format->format == SDL_PIXELFORMAT_RGBA32)
+            return pSurface;
+
+        SDL_Surface* pConverted = SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(pSurface);
+        return pConverted;
+    }
+
+    bool CookImage(const std::vector<uint8_t>& fileData, const bool premultiply, const mcp::PackageCodec codec, std::vector<uint8_t>& cookedOut)
+    {
+        SDL_Surface* pSurface = DecodeSourceImage(fileData);
+        if (!pSurface)
+        {
+            std::cout << "    SDL_image failed to decode the image: " << IMG_GetError() << "\n";
+            return false;
+        }
+
+        const bool succeeded = mcp::CookTexture(pSurface->pixels, static_cast<uint32_t>(pSurface->w), static_cast<uint32_t>(pSurface->h)
+            , static_cast<uint32_t>(pSurface->pitch), premultiply, codec, cookedOut);
+
+        SDL_FreeSurface(pSurface);
+        return succeeded;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    //		NOTES:
+    //      Cooked textures are loaded the same way the engine does: an RGBA32 surface is created, and the pixels are copied
+    //      or decompressed into it.
+    //
+    ///		@brief : Load a cooked texture into a new surface.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    SDL_Surface* LoadCookedImage(const std::vector<uint8_t>& cooked)
+    {
+        mcp::CookedTextureHeader header;
+        if (!mcp::ReadCookedTextureHeader(cooked.data(), cooked.size(), header))
+            return nullptr;
+
+        SDL_Surface* pSurface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(header.width), static_cast<int>(header.height), 32, SDL_PIXELFORMAT_RGBA32);
+        if (pSurface && !mcp::DecodeCookedTexture(header, cooked.data(), pSurface->pixels, static_cast<size_t>(pSurface->pitch)))
+        {
+            SDL_FreeSurface(pSurface);
+            return nullptr;
+        }
+
+        return pSurface;
+    }
+
+    //-----------------------------------------------------------------------------------------------------------------------------
+    ///		@brief : Run the load a number of times and return the best time, in milliseconds.
+    //-----------------------------------------------------------------------------------------------------------------------------
+    double TimeBestLoad(const int iterations, const std::function<SDL_Surface*()>& load)
+    {
+        double bestMs = -1.0;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            HighPrecisionTimer timer;
+            timer.Start();
+            SDL_Surface* pSurface = load();
+            const double elapsedMs = timer.GetTimer();
+
+            if (!pSurface)
+                return -1.0;
+
+            SDL_FreeSurface(pSurface);
+            if (bestMs < 0.0 || elapsedMs < bestMs)
+                bestMs = elapsedMs;
+        }
+
+        return bestMs;
+    }
+
+    int RunBenchmark(const std::vector<InputImage>& images, const int iterations)
+    {
+        double totalMegapixels = 0.0;
+        double totalSourceMs = 0.0;
+        double totalStoredMs = 0.0;
+        double totalLzMs = 0.0;
+        std::vector<uint8_t> fileData;
+        std::vector<uint8_t> stored;
+        std::vector<uint8_t> lz;
+
+        std::cout << "Image | Megapixels | Source ms/MP | Stored ms/MP | LZ ms/MP | Source bytes | Stored bytes | LZ bytes\n";
+
+        for (const auto& image : images)
+        {
+            if (!ReadFile(image.path, fileData)
+                || !CookImage(fileData, false, mcp::PackageCodec::kStore, stored)
+                || !CookImage(fileData, false, mcp::PackageCodec::kLz, lz))
+            {
+                std::cout << "Failed to load '" << image.name << "'.\n";
+                return -1;
+            }
+
+            mcp::CookedTextureHeader header;
+            if (!mcp::ReadCookedTextureHeader(stored.data(), stored.size(), header))
+                return -1;
+
+            // The source path is what the engine did before: decode the file, in whatever format SDL_image gives back.
+            const double sourceMs = TimeBestLoad(iterations, [&fileData]()
+            {
+                SDL_RWops* pSdlData = SDL_RWFromConstMem(fileData.data(), static_cast<int>(fileData.size()));
+                return pSdlData ? IMG_Load_RW(pSdlData, 1) : nullptr;
+            });
+
+            const double storedMs = TimeBestLoad(iterations, [&stored]() { return LoadCookedImage(stored); });
+            const double lzMs = TimeBestLoad(iterations, [&lz]() { return LoadCookedImage(lz); });
+
+            if (sourceMs < 0.0 || storedMs < 0.0 || lzMs < 0.0)
+            {
+                std::cout << "Failed to load '" << image.name << "'.\n";
+                return -1;
+            }
+
+            const double megapixels = static_cast<double>(header.width) * header.height / 1000000.0;
+            totalMegapixels += megapixels;
+            totalSourceMs += sourceMs;
+            totalStoredMs += storedMs;
+            totalLzMs += lzMs;
+
+            std::cout << image.name << " | " << megapixels << " | " << sourceMs / megapixels << " | " << storedMs / megapixels << " | " << lzMs / megapixels
+                << " | " << fileData.size() << " | " << stored.size() << " | " << lz.size() << "\n";
+        }
+
+        std::cout << "Total | " << totalMegapixels << " | " << totalSourceMs / totalMegapixels << " | " << totalStoredMs / totalMegapixels
+            << " | " << totalLzMs / totalMegapixels << "\n"
+            << "Speedup over source: Stored " << totalSourceMs / totalStoredMs << "x | LZ " << totalSourceMs / totalLzMs << "x\n";
+
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: TextureCooker <output directory> <file or directory>... [--codec=lz|store] [--premultiply]\n"
+            << "       TextureCooker --benchmark <file or directory>... [--iterations=N]\n";
+        return -1;
+    }
+
+    const bool isBenchmark = std::strcmp(argv[1], "--benchmark") == 0;
+    const fs::path outputDirectory = isBenchmark ? fs::path() : fs::path(argv[1]);
+    mcp::PackageCodec codec = mcp::PackageCodec::kLz;
+    bool premultiply = false;
+    int iterations = 5;
+    std::vector<InputImage> images;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--codec=", 8) == 0)
+        {
+            const std::string codecName = argv[i] + 8;
+            if (codecName == "lz") codec = mcp::PackageCodec::kLz;
+            else if (codecName == "store") codec = mcp::PackageCodec::kStore;
+            else
+            {
+                std::cout << "Unknown codec: " << codecName << "\n";
+                return -1;
+            }
+
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--premultiply") == 0)
+        {
+            premultiply = true;
+            continue;
+        }
+
+        if (std::strncmp(argv[i], "--iterations=", 13) == 0)
+        {
+            iterations = std::max(std::atoi(argv[i] + 13), 1);
+            continue;
+        }
+
+        if (!AddInput(argv[i], images))
+            return -1;
+    }
+
+    if (images.empty())
+    {
+        std::cout << "No images to cook!\n";
+        return -1;
+    }
+
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+
+    if (isBenchmark)
+    {
+        const int result = RunBenchmark(images, iterations);
+        IMG_Quit();
+        return result;
+    }
+
+    std::vector<uint8_t> fileData;
+    std::vector<uint8_t> cooked;
+    uint64_t sourceBytes = 0;
+    uint64_t cookedBytes = 0;
+
+    for (const auto& image : images)
+    {
+        if (!ReadFile(image.path, fileData))
+        {
+            std::cout << "Failed to read '" << image.path.string() << "'.\n";
+            IMG_Quit();
+            return -1;
+        }
+
+        // Cooking an image twice would cook the cooked data, which SDL_image can't read.
+        if (mcp::IsCookedTexture(fileData.data(), fileData.size()))
+        {
+            std::cout << "'" << image.name << "' is already cooked! Cook from the source images.\n";
+            IMG_Quit();
+            return -1;
+        }
+
+        const fs::path outputPath = outputDirectory / image.name;
+        std::error_code error;
+        if (fs::equivalent(outputPath, image.path, error))
+        {
+            std::cout << "Cooking '" << image.name << "' would overwrite the source image! Use a different output directory.\n";
+            IMG_Quit();
+            return -1;
+        }
+
+        if (!CookImage(fileData, premultiply, codec, cooked) || !WriteFile(outputPath, cooked))
+        {
+            std::cout << "Failed to cook '" << image.name << "' to '" << outputPath.string() << "'.\n";
+            IMG_Quit();
+            return -1;
+        }
+
+        sourceBytes += fileData.size();
+        cookedBytes += cooked.size();
+    }
+
+    IMG_Quit();
+
+    std::cout << "Cooked " << images.size() << " images into '" << outputDirectory.string() << "'\n"
+        << "    Source: " << sourceBytes << " bytes | Cooked: " << cookedBytes << " bytes\n";
+
+    return 0;
+}